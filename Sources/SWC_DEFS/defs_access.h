@@ -115,11 +115,25 @@
 /*---------------------------------------------------------------------------------------------------------*/
 /* Direct register access                                                                                  */
 /*---------------------------------------------------------------------------------------------------------*/
+#ifndef BOOTBLOCK_MMIO_PROFILE
 #define      REG_READ(reg)                                                                                 \
             _REG_READ_AUX_(_GET_REG_ADDR(reg), _GET_REG_ACCESSTYPE(reg), _GET_REG_SIZE(reg))
 
 #define      REG_WRITE(reg,val)                                                                            \
             _REG_WRITE_AUX_((val),_GET_REG_ADDR(reg),_GET_REG_ACCESSTYPE(reg), _GET_REG_SIZE(reg))
+#else
+/*---------------------------------------------------------------------------------------------------------*/
+/* Register access profiler (source/mmio_prof.c): every access is counted per register and per call site  */
+/*---------------------------------------------------------------------------------------------------------*/
+UINT64 MMIO_PROF_Read (UINT64 addr, UINT32 size);
+void   MMIO_PROF_Write (UINT64 addr, UINT32 size, UINT64 val);
+
+#define      REG_READ(reg)                                                                                 \
+            ((_CASTING_FROM(_GET_REG_SIZE(reg)))MMIO_PROF_Read((UINT64)(_GET_REG_ADDR(reg)), _GET_REG_SIZE(reg)))
+
+#define      REG_WRITE(reg,val)                                                                            \
+            MMIO_PROF_Write((UINT64)(_GET_REG_ADDR(reg)), _GET_REG_SIZE(reg), (UINT64)(val))
+#endif
 
 
 /*---------------------------------------------------------------------------------------------------------*/
@@ -37,6 +37,23 @@ typedef UINT                BOOLEAN;
 /*---------------------------------------------------------------------------------------------------------*/
 /* Core dependent MEM definitions                                                                          */
 /*---------------------------------------------------------------------------------------------------------*/
+#ifdef BOOTBLOCK_SIM
+/*---------------------------------------------------------------------------------------------------------*/
+/* Host simulation build (Sources/sim): the register accesses go to the MMIO model                         */
+/*---------------------------------------------------------------------------------------------------------*/
+UINT64 SIM_MMIO_Read (UINT64 addr, UINT size);
+void   SIM_MMIO_Write (UINT64 addr, UINT size, UINT64 val);
+
+#define MEMR8(a)            ((UINT8) SIM_MMIO_Read((UINT64)(a), 1))
+#define MEMR16(a)           ((UINT16)SIM_MMIO_Read((UINT64)(a), 2))
+#define MEMR32(a)           ((UINT32)SIM_MMIO_Read((UINT64)(a), 4))
+#define MEMR64(a)           ((UINT64)SIM_MMIO_Read((UINT64)(a), 8))
+
+#define MEMW8(a,v)          SIM_MMIO_Write((UINT64)(a), 1, (UINT8)(v))
+#define MEMW16(a,v)         SIM_MMIO_Write((UINT64)(a), 2, (UINT16)(v))
+#define MEMW32(a,v)         SIM_MMIO_Write((UINT64)(a), 4, (UINT32)(v))
+#define MEMW64(a,v)         SIM_MMIO_Write((UINT64)(a), 8, (UINT64)(v))
+#else
 #define MEMR8(a)            (*(PTR8) (a))
 #define MEMR16(a)           (*(PTR16)(a))
 #define MEMR32(a)           (*(PTR32)(a))
@@ -46,6 +63,7 @@ typedef UINT                BOOLEAN;
 #define MEMW16(a,v)         ((*((PTR16) (a))) = ((UINT16)(v)))
 #define MEMW32(a,v)         ((*((PTR32) (a))) = ((UINT32)(v)))
 #define MEMW64(a,v)         ((*((PTR64) (a))) = ((UINT64)(v)))
+#endif
 
 /*---------------------------------------------------------------------------------------------------------*/
 /* Core dependent IO definitions                                                                           */
@@ -529,5 +547,32 @@ typedef UINT                BOOLEAN;
     #warning Warning: x_INTERRUPTS and ICHACHE_x macros are not defined for current compiler
 #endif
 
+#ifdef BOOTBLOCK_SIM
+/*---------------------------------------------------------------------------------------------------------*/
+/* Host simulation build: single core, no interrupts and no caches                                         */
+/*---------------------------------------------------------------------------------------------------------*/
+#undef ASSERT
+#undef CPU_WAIT_FOR_EVENT
+#undef CPU_IDLE
+#undef ENABLE_INTERRUPTS
+#undef DISABLE_INTERRUPTS
+#undef INTERRUPTS_SAVE_DISABLE
+#undef INTERRUPTS_RESTORE
+#undef ICACHE_SAVE_DISABLE
+#undef ICACHE_SAVE_ENABLE
+#undef ICACHE_RESTORE
+
+#define ASSERT(cond)
+#define CPU_WAIT_FOR_EVENT()
+#define CPU_IDLE()
+#define ENABLE_INTERRUPTS()
+#define DISABLE_INTERRUPTS()
+#define INTERRUPTS_SAVE_DISABLE(var)    { var = 0; }
+#define INTERRUPTS_RESTORE(var)         (void)(var)
+#define ICACHE_SAVE_DISABLE(var)        { var = 0; }
+#define ICACHE_SAVE_ENABLE(var)         { var = 0; }
+#define ICACHE_RESTORE(var)             (void)(var)
+#endif
+
 
 #endif /* _DEFS_ARM_H_ */
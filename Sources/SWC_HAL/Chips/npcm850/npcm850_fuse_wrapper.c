@@ -25,6 +25,105 @@
 #define        FUSE_ARRAY_MAX_SIZE    256
 static UINT8   fuse_encoded[FUSE_ARRAY_MAX_SIZE] = {0};
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* RAM shadow of the first FUSE_SHADOW_SIZE bytes of the key array (encoded, as in the OTP). A byte is    */
+/* read from the OTP once, FUSE_WRPR_get decodes from the shadow. Wiped by FUSE_WRPR_Scrub                */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef FUSE_SHADOW_SIZE
+#define        FUSE_SHADOW_SIZE       256
+#endif
+static UINT8   fuse_shadow[FUSE_SHADOW_SIZE];
+static UINT32  fuse_shadow_valid[FUSE_SHADOW_SIZE / 32];
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        FUSE_WRPR_Fill_l                                                                       */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  fuse_address    -   address in the fuse\key array                                      */
+/*                  fuse_length     -   length in bytes inside the fuse array                              */
+/*                                                                                                         */
+/* Returns:         pointer to the range in the shadow, NULL if it is out of the shadow                    */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Read the missing bytes of the range into the shadow, one FUSE_ReadBlock per run of     */
+/*                  missing bytes.                                                                         */
+/*---------------------------------------------------------------------------------------------------------*/
+static const UINT8* FUSE_WRPR_Fill_l (UINT16 fuse_address, UINT16 fuse_length)
+{
+    UINT32 addr  = fuse_address;
+    UINT32 end   = (UINT32)fuse_address + fuse_length;
+    UINT32 start;
+
+    if (end > FUSE_SHADOW_SIZE)
+    {
+        return NULL;
+    }
+
+    while (addr < end)
+    {
+        if (fuse_shadow_valid[addr / 32] & (1UL << (addr % 32)))
+        {
+            addr++;
+            continue;
+        }
+
+        start = addr;
+        while ((addr < end) && !(fuse_shadow_valid[addr / 32] & (1UL << (addr % 32))))
+        {
+            fuse_shadow_valid[addr / 32] |= (1UL << (addr % 32));
+            addr++;
+        }
+
+        FUSE_ReadBlock(KEY_SA, (UINT16)start, &fuse_shadow[start], (UINT16)(addr - start));
+    }
+
+    return &fuse_shadow[fuse_address];
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        FUSE_WRPR_Load                                                                         */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  ranges          -   fuse ranges used by the caller                                     */
+/*                  count           -   number of ranges                                                   */
+/*                                                                                                         */
+/* Returns:         DEFS_STATUS_OK, DEFS_STATUS_INVALID_PARAMETER if a range is out of the shadow          */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Read all the ranges into the shadow in one pass, before the FUSE_WRPR_get calls.       */
+/*---------------------------------------------------------------------------------------------------------*/
+DEFS_STATUS FUSE_WRPR_Load (const FUSE_WRPR_RANGE_T *ranges, UINT32 count)
+{
+    UINT32 i;
+    DEFS_STATUS status = DEFS_STATUS_OK;
+
+    for (i = 0; i < count; i++)
+    {
+        if (FUSE_WRPR_Fill_l(ranges[i].fuse_address, ranges[i].fuse_length) == NULL)
+        {
+            status = DEFS_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return status;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        FUSE_WRPR_Scrub                                                                        */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:    next FUSE_WRPR_get reads the OTP again                                                 */
+/* Description:                                                                                            */
+/*                  Wipe the shadow and the encoded buffer. Call before handing off to the next stage.     */
+/*---------------------------------------------------------------------------------------------------------*/
+void FUSE_WRPR_Scrub (void)
+{
+    memset(fuse_shadow, 0, sizeof(fuse_shadow));
+    memset(fuse_shadow_valid, 0, sizeof(fuse_shadow_valid));
+    memset(fuse_encoded, 0, sizeof(fuse_encoded));
+}
 
 /*---------------------------------------------------------------------------------------------------------*/
 /* Function:        FUSE_WRPR_get                                                                          */
@@ -38,11 +137,12 @@ static UINT8   fuse_encoded[FUSE_ARRAY_MAX_SIZE] = {0};
 /* Returns:                                                                                                */
 /* Side effects:                                                                                           */
 /* Description:                                                                                            */
-/*                  This routine read a value from the fuses.                                              */
+/*                  This routine read a value from the fuses. Ranges in the shadow are read from the OTP   */
+/*                  only the first time.                                                                   */
 /*---------------------------------------------------------------------------------------------------------*/
 DEFS_STATUS FUSE_WRPR_get (UINT16 fuse_address, UINT16 fuse_length, FUSE_ECC_TYPE_T fuse_ecc, UINT8* value)
 {
-    UINT16 iCnt = 0;
+    const UINT8* encoded;
 
     DEFS_STATUS status = DEFS_STATUS_OK;
 
@@ -51,29 +151,32 @@ DEFS_STATUS FUSE_WRPR_get (UINT16 fuse_address, UINT16 fuse_length, FUSE_ECC_TYP
     /*-----------------------------------------------------------------------------------------------------*/
     /* Read the fuses                                                                                      */
     /*-----------------------------------------------------------------------------------------------------*/
-    // if no parity
-    if ( (FUSE_ECC_TYPE_T)fuse_ecc == FUSE_ECC_NONE )
+    encoded = FUSE_WRPR_Fill_l(fuse_address, fuse_length);
+    if (encoded == NULL)
     {
-        for (iCnt = 0; iCnt < fuse_length ; iCnt++)
-        {
-            FUSE_Read(KEY_SA, fuse_address + iCnt , &value[iCnt]);
-        }
-    }
-    else
-    {
-        for (iCnt = 0; iCnt < fuse_length ; iCnt++)
-        {
-            FUSE_Read(KEY_SA, fuse_address + iCnt , &fuse_encoded[iCnt]);
-        }
-
+        FUSE_ReadBlock(KEY_SA, fuse_address, fuse_encoded, fuse_length);
+        encoded = fuse_encoded;
     }
 
     /*-----------------------------------------------------------------------------------------------------*/
-    /* Either encode the data or read it as is                                                             */
+    /* Either decode the data or read it as is                                                             */
     /*-----------------------------------------------------------------------------------------------------*/
-    if ( (FUSE_ECC_TYPE_T)fuse_ecc == FUSE_ECC_NIBBLE_PARITY)
+    switch (fuse_ecc)
     {
-        status = FUSE_NibParEccDecode(fuse_encoded, value, fuse_length);
+        case FUSE_ECC_NIBBLE_PARITY:
+            status = FUSE_NibParEccDecode(encoded, value, fuse_length);
+            break;
+
+        case FUSE_ECC_MAJORITY:
+            status = FUSE_MajRulEccDecode(encoded, value, fuse_length);
+            break;
+
+        case FUSE_ECC_NONE:
+            memcpy(value, encoded, fuse_length);
+            break;
+
+        default:
+            break;
     }
 
     return status;
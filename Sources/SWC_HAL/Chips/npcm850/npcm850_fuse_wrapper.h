@@ -19,7 +19,19 @@
 #include "defs.h"
 
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Fuse range, initialized from a property: { DIE_INFORMATION_ALL }                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct
+{
+    UINT16              fuse_address;
+    UINT16              fuse_length;
+    FUSE_ECC_TYPE_T     fuse_ecc;
+} FUSE_WRPR_RANGE_T;
+
 DEFS_STATUS FUSE_WRPR_get            (UINT16 fuse_address, UINT16 fuse_length, FUSE_ECC_TYPE_T fuse_ecc, UINT8* value);
+DEFS_STATUS FUSE_WRPR_Load           (const FUSE_WRPR_RANGE_T *ranges, UINT32 count);
+void        FUSE_WRPR_Scrub          (void);
 
 #endif // _FUSE_WRAPPER_
 #endif // #ifdef FUSE_MODULE_TYPE
@@ -31,6 +31,13 @@
 /*---------------------------------------------------------------------------------------------------------*/
 #include "../4/clk_drv.h"
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Prints of this driver are logged as the CLK module (HAL_LOG in hal_cfg.h)                               */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          CLK
+#endif
 
 /*---------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------*/
@@ -1640,6 +1647,13 @@ UINT32 CLK_Delay_MicroSec (UINT32 microSec)
                 break;
             }
         }
+
+#ifdef CLK_DELAY_POLL_HOOK
+        /*-------------------------------------------------------------------------------------------------*/
+        /* Let the application use the busy wait (e.g. to send its log)                                    */
+        /*-------------------------------------------------------------------------------------------------*/
+        CLK_DELAY_POLL_HOOK();
+#endif
     }
 
     return microSec + (_1MHz_ * (iUsCnt2[1] - iUsCnt1[1])) + (iUsCnt2[0] - iUsCnt1[0]) / EXT_CLOCK_FREQUENCY_MHZ;
@@ -2893,3 +2907,7 @@ void CLK_PrintVersion (void)
     HAL_PRINT("CLK        = %d\n", CLK_MODULE_TYPE);
 }
 
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          HAL
+#endif
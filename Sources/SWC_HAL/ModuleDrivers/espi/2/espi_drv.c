@@ -26,6 +26,14 @@
 #include <stdlib.h>
 #endif
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Prints of this driver are logged as the ESPI module (HAL_LOG in hal_cfg.h)                              */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          ESPI
+#endif
+
 /*---------------------------------------------------------------------------------------------------------*/
 /* Module Dependencies                                                                                     */
 /*---------------------------------------------------------------------------------------------------------*/
@@ -10630,3 +10638,7 @@ static void ESPI_EnableEspiRstMiwuInterrupt_l (BOOLEAN enable)
 }
 #endif //ESPI_ESPI_RST_ERRATA_ISSUE
 
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          HAL
+#endif
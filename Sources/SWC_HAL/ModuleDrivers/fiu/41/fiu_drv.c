@@ -42,6 +42,14 @@
 /*---------------------------------------------------------------------------------------------------------*/
 #include "fiu_regs.h"
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Prints of this driver are logged as the FIU module (HAL_LOG in hal_cfg.h)                               */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          FIU
+#endif
+
 /*---------------------------------------------------------------------------------------------------------*/
 /* Local Defines                                                                                           */
 /*---------------------------------------------------------------------------------------------------------*/
@@ -1976,5 +1984,10 @@ void FIU_PrintVersion (void)
 {
     HAL_PRINT("FIU         = %X\n", MODULE_VERSION(FIU_MODULE_TYPE));
 }
+
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          HAL
+#endif
 #endif // _FIU_DRV_C
 
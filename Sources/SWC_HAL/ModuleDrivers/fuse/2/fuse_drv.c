@@ -28,6 +28,13 @@
 #include "fuse_drv.h"
 #include "fuse_regs.h"
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Prints of this driver are logged as the FUSE module (HAL_LOG in hal_cfg.h)                              */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          FUSE
+#endif
 
 /*---------------------------------------------------------------------------------------------------------*/
 /* Fuse module constant definitions                                                                        */
@@ -278,6 +285,51 @@ void FUSE_Read (FUSE_STORAGE_ARRAY_T arr,
 }
 #endif
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        FUSE_ReadBlock                                                                         */
+/*                                                                                                         */
+/* Parameters:      arr  - Storage Array type [input].                                                     */
+/*                  addr - Byte-address of the first byte [input].                                         */
+/*                  data - Pointer to result [output].                                                     */
+/*                  size - Number of bytes to read [input].                                                */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:     Read consecutive bytes from an OTP storage array. Same as FUSE_Read per byte, but the  */
+/*                  array is idle after each read completes, so the idle wait and the FDATA clean are      */
+/*                  done once for the block instead of once per byte.                                      */
+/*---------------------------------------------------------------------------------------------------------*/
+void FUSE_ReadBlock (FUSE_STORAGE_ARRAY_T arr,
+                     UINT16               addr,
+                     UINT8               *data,
+                     UINT16               size
+)
+{
+#if TIP_DUMMY_OTP_ON_RAM
+    UINT16 i;
+
+    for (i = 0; i < size; i++)
+    {
+        FUSE_Read(arr, addr + i, &data[i]);
+    }
+#else
+    UINT16 i;
+
+    /* Wait for the Fuse Box Idle */
+    FUSE_WaitForOTPReadyWithTimeout(arr, FUSE_RDY_MAX_READY_PULSES);
+
+    for (i = 0; i < size; i++)
+    {
+        SET_REG_FIELD(FADDR, FADDR_BYTEADDR, addr + i);
+        REG_WRITE(FCTL, READ_INIT);
+        FUSE_WaitForOTPReadyWithTimeout(arr, FUSE_RDY_MAX_READY_PULSES);
+        data[i] = READ_REG_FIELD(FDATA, FDATA_FDATA);
+    }
+
+    /* Clean FDATA contents to prevent unauthorized software from reading sensitive information */
+    SET_REG_FIELD(FDATA, FDATA_FDATA, FDATA_CLEAN_VALUE);
+#endif
+}
+
 void FUSE_SetBlockAccess (_UNUSED_ FUSE_STORAGE_ARRAY_T array,
                           UINT32 block,
                           BOOLEAN lockForRead,
@@ -731,193 +783,7 @@ DEFS_STATUS FUSE_LockAccess (FUSE_STORAGE_ARRAY_T array, UINT8 lockForRead, UINT
 /*---------------------------------------------------------------------------------------------------------*/
 
 
-/*---------------------------------------------------------------------------------------------------------*/
-/* Function:        FUSE_NibParEccDecode                                                                   */
-/*                                                                                                         */
-/* Parameters:                                                                                             */
-/*                  datain -       pointer to encoded data buffer (buffer size should be 2 x dataout)      */
-/*                  dataout -      pointer to decoded data buffer                                          */
-/*                  encoded_size - size of encoded data (decoded data x 2)                                 */
-/*                                                                                                         */
-/* Returns:         DEFS_STATUS_OK on successful read completion, HAL_ERROR_* otherwise.                   */
-/* Side effects:                                                                                           */
-/* Description:                                                                                            */
-/*                  Decodes the data according to nibble parity ECC scheme.                                */
-/*                  Size specifies the encoded data size.                                                  */
-/*                  Decodes whole bytes only                                                               */
-/*---------------------------------------------------------------------------------------------------------*/
-DEFS_STATUS FUSE_NibParEccDecode (
-    const UINT8  *datain,
-    UINT8  *dataout,
-    UINT32  encoded_size
-)
-{
-    UINT32 i;
-    DEFS_STATUS status = DEFS_STATUS_OK;
-
-    /*
-       nibble_decode
-       LSB is the decode value
-       MSB: if 0xf than more than 1 bit error
-            else it is the corrected bit place + 1. For example:
-              if MSB==0x1 the corrected bit is bit 0
-              if MSB==0x8 the corrected bit is bit 7
-    */
-    const UINT8 nibble_decode[256] = {
-        0x00, 0x10, 0x20, 0xf3, 0x30, 0xf5, 0xf6, 0x4f, 0x40, 0xf9, 0xfa, 0x3f, 0xfc, 0x2f, 0x1f, 0x0f,
-        0x50, 0x71, 0x82, 0xf3, 0xf4, 0x65, 0xf6, 0xf7, 0xf8, 0xf9, 0x6a, 0xfb, 0xfc, 0x8d, 0x7e, 0x5f,
-        0x60, 0xf1, 0xf2, 0xf3, 0x74, 0x55, 0xf6, 0x87, 0x88, 0xf9, 0x5a, 0x7b, 0xfc, 0xfd, 0xfe, 0x6f,
-        0xf0, 0x35, 0x4a, 0xf3, 0x15, 0x05, 0xf6, 0x25, 0x2a, 0xf9, 0x0a, 0x1a, 0xfc, 0x45, 0x3a, 0xff,
-        0x70, 0x51, 0xf2, 0x83, 0x64, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0x6b, 0x8c, 0xfd, 0x5e, 0x7f,
-        0x11, 0x01, 0xf2, 0x21, 0xf4, 0x31, 0x4e, 0xf7, 0xf8, 0x41, 0x3e, 0xfb, 0x2e, 0xfd, 0x0e, 0x1e,
-        0x34, 0xf1, 0xf2, 0x4b, 0x04, 0x14, 0x24, 0xf7, 0xf8, 0x2b, 0x1b, 0x0b, 0x44, 0xfd, 0xfe, 0x3b,
-        0xf0, 0x61, 0xf2, 0xf3, 0x54, 0x75, 0x86, 0xf7, 0xf8, 0x89, 0x7a, 0x5b, 0xfc, 0xfd, 0x6e, 0xff,
-        0x80, 0xf1, 0x52, 0x73, 0xf4, 0xf5, 0xf6, 0x67, 0x68, 0xf9, 0xfa, 0xfb, 0x7c, 0x5d, 0xfe, 0x8f,
-        0x22, 0xf1, 0x02, 0x12, 0xf4, 0x4d, 0x32, 0xf7, 0xf8, 0x3d, 0x42, 0xfb, 0x1d, 0x0d, 0xfe, 0x2d,
-        0x48, 0xf1, 0xf2, 0x37, 0xf4, 0x27, 0x17, 0x07, 0x08, 0x18, 0x28, 0xfb, 0x38, 0xfd, 0xfe, 0x47,
-        0xf0, 0xf1, 0x62, 0xf3, 0xf4, 0x85, 0x76, 0x57, 0x58, 0x79, 0x8a, 0xfb, 0xfc, 0x6d, 0xfe, 0xff,
-        0xf0, 0x23, 0x13, 0x03, 0x4c, 0xf5, 0xf6, 0x33, 0x3c, 0xf9, 0xfa, 0x43, 0x0c, 0x1c, 0x2c, 0xff,
-        0xf0, 0x81, 0x72, 0x53, 0xf4, 0xf5, 0x66, 0xf7, 0xf8, 0x69, 0xfa, 0xfb, 0x5c, 0x7d, 0x8e, 0xff,
-        0xf0, 0xf1, 0xf2, 0x63, 0x84, 0xf5, 0x56, 0x77, 0x78, 0x59, 0xfa, 0x8b, 0x6c, 0xfd, 0xfe, 0xff,
-        0xf0, 0x49, 0x36, 0xf3, 0x26, 0xf5, 0x06, 0x16, 0x19, 0x09, 0xfa, 0x29, 0xfc, 0x39, 0x46, 0xff};
-
-#define LSNF    0, 4
-#define MSNF    4, 4
-
-    for (i = 0; i < encoded_size; i++)
-    {
-        UINT8 decoded = nibble_decode[datain[i]];
-        if (i % 2)
-        {//Decode higher nibble
-            SET_VAR_FIELD(dataout[i/2], MSNF, LSN(decoded));
-        }
-        else
-        {//Decode lower nibble
-            SET_VAR_FIELD(dataout[i/2], LSNF, LSN(decoded));
-        }
-
-        if (0xf == MSN(decoded))
-            status = DEFS_STATUS_BAD_CHECKSUM;
-    }
-
-    return status;
-}
-
-/*---------------------------------------------------------------------------------------------------------*/
-/* Function:        FUSE_NibParEccEncode                                                                   */
-/*                                                                                                         */
-/* Parameters:                                                                                             */
-/*                  datain -       pointer to decoded data buffer (buffer size should be 2 x dataout)      */
-/*                  dataout -      pointer to encoded data buffer                                          */
-/*                  encoded_size - size of encoded data (decoded data x 2)                                 */
-/*                                                                                                         */
-/* Returns:         DEFS_STATUS_OK on successful read completion, HAL_ERROR_* otherwise.                   */
-/* Side effects:                                                                                           */
-/* Description:                                                                                            */
-/*                  Decodes the data according to nibble parity ECC scheme.                                */
-/*                  Size specifies the encoded data size.                                                  */
-/*                  Decodes whole bytes only                                                               */
-/*---------------------------------------------------------------------------------------------------------*/
-DEFS_STATUS FUSE_NibParEccEncode (
-    const UINT8 *datain,
-    UINT8 *dataout,
-    UINT32 encoded_size
-)
-{
-    UINT32 i;
-    UINT32 decoded_size = encoded_size/2;
-    const UINT8 nibble_encode[16] = {
-        0x00, 0x51, 0x92, 0xc3, 0x64, 0x35, 0xf6, 0xa7, 0xa8, 0xf9, 0x3a, 0x6b, 0xcc, 0x9d, 0x5e, 0x0f};
-
-    for (i = 0; i < decoded_size; i++)
-    {
-        dataout[i*2]   = nibble_encode[LSN(datain[i])];
-        dataout[i*2+1] = nibble_encode[MSN(datain[i])];
-    }
-
-    return DEFS_STATUS_OK;
-}
-
-/*---------------------------------------------------------------------------------------------------------*/
-/* Function:        FUSE_MajRulEccDecode                                                                   */
-/*                                                                                                         */
-/* Parameters:                                                                                             */
-/*                  datain -       pointer to encoded data buffer (buffer size should be 3 x dataout)      */
-/*                  dataout -      pointer to decoded data buffer                                          */
-/*                  encoded_size - size of encoded data (decoded data x 3)                                 */
-/*                                                                                                         */
-/* Returns:         DEFS_STATUS_OK on successful read completion, DEFS_ERROR_* otherwise.                   */
-/* Side effects:                                                                                           */
-/* Description:                                                                                            */
-/*                  Decodes the data according to Major Rule ECC scheme.                                   */
-/*                  Size specifies the encoded data size.                                                  */
-/*                  Decodes whole bytes only                                                               */
-/*---------------------------------------------------------------------------------------------------------*/
-DEFS_STATUS FUSE_MajRulEccDecode (
-    const UINT8 *datain,
-    UINT8 *dataout,
-    UINT32 encoded_size
-)
-{
-    UINT  byte;
-    UINT32 decoded_size;
-
-    if (encoded_size % 3)
-        return DEFS_STATUS_INVALID_PARAMETER;
-
-    decoded_size = encoded_size/3;
-
-    for (byte = 0; byte < decoded_size; byte++)
-    {
-        UINT8 byte0 = datain[decoded_size*0+byte];
-        UINT8 byte1 = datain[decoded_size*1+byte];
-        UINT8 byte2 = datain[decoded_size*2+byte];
-
-        dataout[byte] = (byte1 & (byte0 | byte2)) | (byte0 & byte2);
-    }
-    return DEFS_STATUS_OK;
-
-}
-
-/*---------------------------------------------------------------------------------------------------------*/
-/* Function:        FUSE_MajRulEccEncode                                                                   */
-/*                                                                                                         */
-/* Parameters:                                                                                             */
-/*                  datain -       pointer to decoded data buffer (buffer size should be 3 x dataout)      */
-/*                  dataout -      pointer to encoded data buffer                                          */
-/*                  encoded_size - size of encoded data (decoded data x 3)                                 */
-/*                                                                                                         */
-/* Returns:         DEFS_STATUS_OK on successful read completion, DEFS_ERROR_* otherwise.                   */
-/* Side effects:                                                                                           */
-/* Description:                                                                                            */
-/*                  Decodes the data according to Major Rule ECC scheme.                                   */
-/*                  Size specifies the encoded data size.                                                  */
-/*                  Decodes whole bytes only                                                               */
-/*---------------------------------------------------------------------------------------------------------*/
-DEFS_STATUS FUSE_MajRulEccEncode (
-    const UINT8 *datain,
-    UINT8 *dataout,
-    UINT32 encoded_size
-)
-{
-    UINT  byte;
-    UINT32 decoded_size;
-
-    if (encoded_size % 3)
-        return DEFS_STATUS_INVALID_PARAMETER;
-
-    decoded_size = encoded_size/3;
-
-    for (byte = 0; byte < decoded_size; byte++)
-    {
-        dataout[decoded_size*0+byte] = datain[byte];
-        dataout[decoded_size*1+byte] = datain[byte];
-        dataout[decoded_size*2+byte] = datain[byte];
-    }
-
-    return DEFS_STATUS_OK;
-
-}
+#include "fuse_ecc.c"
 
 /*---------------------------------------------------------------------------------------------------------*/
 /* Function:        FUSE_ReadFustrap                                                                       */
@@ -1006,4 +872,7 @@ void FUSE_PrintVersion (void)
 
 }
 
-
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          HAL
+#endif
@@ -73,6 +73,7 @@ UINT32        FUSE_Get_Prog_Magic_Word (void);
 
 DEFS_STATUS   FUSE_Init                      (void);
 void          FUSE_Read                      (FUSE_STORAGE_ARRAY_T arr, UINT16 addr, UINT8 *data);
+void          FUSE_ReadBlock                 (FUSE_STORAGE_ARRAY_T arr, UINT16 addr, UINT8 *data, UINT16 size);
 
 
 #if defined (AES_MODULE_TYPE)
@@ -381,6 +381,7 @@ UINT32 __enable_irq_ret_psr_i(void)
     a_old_i_bit = 0;
     a_psr = 0;
 
+#ifndef BOOTBLOCK_SIM
     __asm __volatile__ (
         "MRS %[a_psr], DAIF                   \n\t" // Read current DAIF flags
         "AND %[a_old_i_bit], %[a_psr], #0x80  \n\t" // Extract IRQ mask bit (I bit)
@@ -389,6 +390,7 @@ UINT32 __enable_irq_ret_psr_i(void)
         "MOV %[a_old_i_bit], %[a_old_i_bit], lsr #7 \n\t" // Shift I bit to get its previous state (0 or 1)
         : [a_old_i_bit]"+r"(a_old_i_bit), [a_psr]"+r"(a_psr)
     );
+#endif
 
     return a_old_i_bit;
 }
@@ -410,6 +412,7 @@ UINT32 __disable_irq_ret_psr_i(void)
     old_i_bit = 0;
     psr = 0;
 
+#ifndef BOOTBLOCK_SIM
     __asm __volatile__ (
         "MRS %[psr], DAIF                   \n\t" // Read the current DAIF register value into x0
         "AND %[old_i_bit], %[psr], #0x80              \n\t" // Extract the IRQ mask bit (I bit) from x0 and store it in x1
@@ -417,6 +420,7 @@ UINT32 __disable_irq_ret_psr_i(void)
         "MSR DAIF, %[psr]                   \n\t" // Write the modified value back to the DAIF register
         "MOV %[old_i_bit], %[old_i_bit], LSR #7  \n\t" // Shift the extracted IRQ bit right by 7 to get its state (0 or 1)
         : [old_i_bit]"+r"(old_i_bit), [psr]"+r"(psr) );
+#endif
 	
     return old_i_bit;
 }
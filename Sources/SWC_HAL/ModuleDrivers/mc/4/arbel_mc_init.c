@@ -17,13 +17,55 @@
 
 #define MC_AHB_TIP_CP_RDLEN   0
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* MC init register tables: one {offset, mask, value} entry per register. A layer is a table sorted by     */
+/* offset, with at most one entry per register                                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct
+{
+	UINT32  offset;                 /* from MC_BASE                                                    */
+	UINT32  mask;                   /* bits to write, all ones for a write without read                */
+	UINT32  value;
+} MC_INIT_REG_T;
+
+typedef struct
+{
+	const MC_INIT_REG_T    *tbl;
+	UINT32                  count;
+} MC_INIT_LAYER_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* DRAM speed grade: the timing of MC_Init_DDR_Setup, the delta tables of the MC init and the SCL / DLL    */
+/* settings of ddr_phy_cfg1                                                                                */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct
+{
+	ENUM_DRAM_CLK_TYPE      type;
+	const char             *name;
+	UINT8                   cas_latency;        /* CL                                              */
+	UINT8                   cas_write_latency;  /* CWL                                             */
+	UINT8                   tCCD_L;
+	UINT8                   mr0_wr_rtp;         /* MR0 A11:A9, write recovery and read to precharge */
+	const MC_INIT_LAYER_T  *delta;              /* one layer per table of mc_init_grade           */
+	UINT32                  scl_config_1;       /* SCL_CONFIG_1 with STATIC_SCL_CONFIG             */
+	UINT32                  scl_config_2;       /* SCL_CONFIG_2 with STATIC_SCL_CONFIG             */
+	UINT32                  dyn_wr_bit_lvl;     /* DYNAMIC_WRITE_BIT_LVL                           */
+	UINT32                  scl_config_4;       /* SCL_CONFIG_4                                    */
+	UINT32                  recalib_cnt;        /* PHY_DLL_RECALIB_recalib_cnt                     */
+} MC_GRADE_T;
+
+#ifdef MC_INIT_REFERENCE
 #ifdef MC_CAPABILITY_CLK_TYPE_1600
 static void mc_init_1600 (DDR_Setup *ddr_setup);
 #endif
 static void mc_init_2133 (DDR_Setup *ddr_setup);
-static void mc_print_priority_AXI (void);
 static void mc_setup_AXI_parameters (void);
 static void mc_setup_AXI_relative_priority (void);
+#else
+static void mc_init_grade (DDR_Setup *ddr_setup, const MC_GRADE_T *grade);
+#endif
+static const MC_GRADE_T *mc_grade_l (ENUM_DRAM_CLK_TYPE type);
+static void mc_print_priority_AXI (void);
 static void mc_setup_AXI_ranges (void);
 
 /*---------------------------------------------------------------------------------------------------------*/
@@ -39,24 +81,21 @@ static void mc_setup_AXI_ranges (void);
 /*---------------------------------------------------------------------------------------------------------*/
 void arbel_mc_init (DDR_Setup *ddr_setup)
 {
-	if (ddr_setup->dram_type_clk > DRAM_CLK_TYPE_1600)
-	{
-		HAL_PRINT("Memory: DDR4-2133\n");
-		HAL_PRINT("DDR Freq: %d MHz\n\n", CLK_GetMCFreq() / 1000000);
-		mc_init_2133(ddr_setup);
-	}
+	const MC_GRADE_T *grade = mc_grade_l(ddr_setup->dram_type_clk);
+
+	HAL_PRINT("Memory: %s\n", grade->name);
+	HAL_PRINT("DDR Freq: %d MHz\n\n", CLK_GetMCFreq() / 1000000);
+#ifndef MC_INIT_REFERENCE
+	mc_init_grade(ddr_setup, grade);
+#else
 #ifdef MC_CAPABILITY_CLK_TYPE_1600
-	else
+	if (grade->type == DRAM_CLK_TYPE_1600)
 	{
-		HAL_PRINT("mc_init DRAM 1600 settings\n");
 		mc_init_1600(ddr_setup);
 	}
-
-#else
 	else
+#endif
 	{
-		HAL_PRINT(KRED "mc_init for DRAM 1600 settings - not supported! Reverting to 2133\n" KNRM);
-		ddr_setup->dram_type_clk = DRAM_CLK_TYPE_2133;
 		mc_init_2133(ddr_setup);
 	}
 #endif
@@ -64,6 +103,84 @@ void arbel_mc_init (DDR_Setup *ddr_setup)
 }
 
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* MC init tables: tools/mc_init_gen.py folds the constant register writes of mc_init_1600 / mc_init_2133  */
+/* (with mc_setup_AXI_parameters and mc_setup_AXI_relative_priority) into arbel_mc_init_tbl.c:             */
+/*   - base tables: the writes common to all the speed grades                                              */
+/*   - delta tables per speed grade (MC_GRADE_T): the writes that differ                                   */
+/*   - setup tables, filled in mc_init_grade: the ddr_setup values (CL / CWL of the grade, MR1 with the    */
+/*     DRAM drive and ODT of the header)                                                                   */
+/* mc_init_apply_l merges the layers by offset, later layers override: one register access per register.   */
+/* The code of mc_init_1600 / mc_init_2133 is the source of the tables and is built only with              */
+/* MC_INIT_REFERENCE: run python3 tools/mc_init_gen.py after changing it                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef MC_INIT_REFERENCE
+#define MC_INIT_OFFSET(reg)             ((UINT32)((_GET_REG_ADDR(reg)) - MC_BASE))
+#define MC_INIT_REG(offset)             (MC_BASE + (offset)), MC_ACCESS, 32
+#define MC_INIT_LAYERS                  3               /* base, speed grade, setup                        */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        mc_init_apply_l                                                                        */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  layer  - MC init tables, sorted by offset                                              */
+/*                  layers - number of tables, up to MC_INIT_LAYERS                                        */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Merges the tables by offset, the entries of later tables override the bits of the      */
+/*                  earlier ones. One read-modify-write per register, or one write if all the bits are set */
+/*---------------------------------------------------------------------------------------------------------*/
+static void mc_init_apply_l (const MC_INIT_LAYER_T *layer, UINT32 layers)
+{
+	UINT32 pos[MC_INIT_LAYERS] = {0};
+	UINT32 offset;
+	UINT32 mask;
+	UINT32 value;
+	UINT32 i;
+
+	while (TRUE)
+	{
+		offset = 0xFFFFFFFF;
+		for (i = 0; i < layers; i++)
+		{
+			if ((pos[i] < layer[i].count) && (layer[i].tbl[pos[i]].offset < offset))
+			{
+				offset = layer[i].tbl[pos[i]].offset;
+			}
+		}
+		if (offset == 0xFFFFFFFF)
+		{
+			return;
+		}
+
+		mask = 0;
+		value = 0;
+		for (i = 0; i < layers; i++)
+		{
+			if ((pos[i] < layer[i].count) && (layer[i].tbl[pos[i]].offset == offset))
+			{
+				mask |= layer[i].tbl[pos[i]].mask;
+				value = (value & ~layer[i].tbl[pos[i]].mask) | layer[i].tbl[pos[i]].value;
+				pos[i]++;
+			}
+		}
+
+		if (mask == 0xFFFFFFFF)
+		{
+			REG_WRITE(MC_INIT_REG(offset), value);
+		}
+		else
+		{
+			REG_WRITE(MC_INIT_REG(offset), (REG_READ(MC_INIT_REG(offset)) & ~mask) | value);
+		}
+	}
+}
+
+#include "arbel_mc_init_tbl.c"
+
+#else // MC_INIT_REFERENCE
+
 /*---------------------------------------------------------------------------------------------------------*/
 /* Function:        mc_init_2133                                                                           */
 /*                                                                                                         */
@@ -16872,6 +16989,53 @@ static void mc_init_2133 (DDR_Setup *ddr_setup)
 
 
 
+}
+#endif // MC_INIT_REFERENCE
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* DRAM speed grades, the first one is the default. A speed grade without MC_INIT_REFERENCE code adds its  */
+/* own delta tables (sorted by offset, over the base tables of arbel_mc_init_tbl.c) next to this table     */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef MC_INIT_REFERENCE
+#define MC_INIT_DELTA(delta)            delta
+#else
+#define MC_INIT_DELTA(delta)            NULL
+#endif
+
+static const MC_GRADE_T mc_grades[] =
+{
+	{ DRAM_CLK_TYPE_2133, "DDR4-2133", 0xF, 0xE, 6, 0x3, MC_INIT_DELTA(mc_init_2133_delta),
+	  0x01000081 | 1 << 3 | 4 << 12, 0x80000701 | 1 << 12, 0x0002e261, 0x00000001, 0x854 },
+#ifdef MC_CAPABILITY_CLK_TYPE_1600
+	// NTIL: check if the correct value should be B or D! CWL: TODO: or 0x0B?
+	// Check the MR 0 value for 800! Why was the DLL reset set
+	{ DRAM_CLK_TYPE_1600, "DDR4-1600", 0xB, 0xD, 5, 0x1, MC_INIT_DELTA(mc_init_1600_delta),
+	  0x01000061 | 1 << 3 | 4 << 12, 0x81000601 | 1 << 12, 0x0002b251, 0x00000000, 0x640 },
+#endif
+};
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        mc_grade_l                                                                             */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  type - DRAM clock type                                                                 */
+/* Returns:         speed grade of the type, the default one if it is not supported                        */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine finds the speed grade of a DRAM clock type                                */
+/*---------------------------------------------------------------------------------------------------------*/
+static const MC_GRADE_T *mc_grade_l (ENUM_DRAM_CLK_TYPE type)
+{
+	UINT32 i;
+
+	for (i = 0; i < ARRAY_SIZE(mc_grades); i++)
+	{
+		if (mc_grades[i].type == type)
+		{
+			return &mc_grades[i];
+		}
+	}
+	return &mc_grades[0];
 }
 
 
@@ -16940,6 +17104,7 @@ static void     MC_write_mr_regs_single (UINT8 Index, UINT32 Data)
 }
 
 
+#ifdef MC_INIT_REFERENCE
 /*---------------------------------------------------------------------------------------------------------*/
 /* Function:        mc_setup_AXI_parameters                                                                */
 /*                                                                                                         */
@@ -24348,6 +24513,7 @@ static void mc_setup_AXI_relative_priority(void)
 
 	//mc_print_priority_AXI();
 }
+#endif // MC_INIT_REFERENCE
 
 #ifdef SECURE_DDR
 	#include "arbel_mc_security.c"
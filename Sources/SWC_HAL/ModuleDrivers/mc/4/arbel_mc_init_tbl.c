@@ -0,0 +1,527 @@
+/*----------------------------------------------------------------------------*/
+/* SPDX-License-Identifier: GPL-2.0                                           */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   arbel_mc_init_tbl.c                                                      */
+/*            This file contains the MC init register tables.                 */
+/*            Generated by tools/mc_init_gen.py from arbel_mc_init.c          */
+/*            (MC_INIT_REFERENCE code), do not edit                           */
+/* Project:                                                                   */
+/*            SWC HAL                                                         */
+/*----------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Base tables: the register writes common to all the speed grades                                         */
+/*---------------------------------------------------------------------------------------------------------*/
+static const MC_INIT_REG_T mc_init_base_0[] =
+{
+	{ MC_INIT_OFFSET(DENALI_CTL_0),       0x00000F00, BUILD_FIELD_VAL(DENALI_CTL_0_DRAM_CLASS, 0xa) },
+	{ MC_INIT_OFFSET(DENALI_CTL_30),      0xFFFF0F00, BUILD_FIELD_VAL(DENALI_CTL_30_CA_PARITY_LAT, 0x4) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_30_TMOD_PAR, 0x1c) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_30_TMRD_PAR, 0x1c) },
+	{ MC_INIT_OFFSET(DENALI_CTL_35),      0x00FFFFFF, BUILD_FIELD_VAL(DENALI_CTL_35_TRTP_AP, 0x6) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_35_TMRD, 0x8) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_35_TMOD, 0x18) },
+	{ MC_INIT_OFFSET(DENALI_CTL_41),      0x00000101, BUILD_FIELD_VAL(DENALI_CTL_41_OPTIMAL_RMODW_EN, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_41_MC_RESERVED2, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_43),      0x01000000, BUILD_FIELD_VAL(DENALI_CTL_43_TREF_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_50),      0xFFFFFF07, BUILD_FIELD_VAL(DENALI_CTL_50_MC_RESERVED6, 0x21) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_50_MC_RESERVED7, 0x40) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_50_MC_RESERVED8, 0x10) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_50_MC_RESERVED9, 0x80) },
+	{ MC_INIT_OFFSET(DENALI_CTL_51),      0xFFFFFFFF, BUILD_FIELD_VAL(DENALI_CTL_51_UPD_CTRLUPD_NORM_THRESHOLD, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_51_UPD_CTRLUPD_HIGH_THRESHOLD, 0x4) },
+	{ MC_INIT_OFFSET(DENALI_CTL_52),      0xFFFFFFFF, BUILD_FIELD_VAL(DENALI_CTL_52_UPD_CTRLUPD_TIMEOUT, 0x5) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_52_UPD_CTRLUPD_SW_PROMOTE_THRESHOLD, 0x4) },
+	{ MC_INIT_OFFSET(DENALI_CTL_64),      0x0F0F0000, BUILD_FIELD_VAL(DENALI_CTL_64_LPI_SR_SHORT_WAKEUP, 0x7) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_64_LPI_SR_LONG_WAKEUP, 0x9) },
+	{ MC_INIT_OFFSET(DENALI_CTL_67),      0x00070FFF, BUILD_FIELD_VAL(DENALI_CTL_67_LPI_WAKEUP_TIMEOUT, 0x4) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_67_TDFI_LP_RESP, 0x7) },
+	{ MC_INIT_OFFSET(DENALI_CTL_72),      0x00000100, BUILD_FIELD_VAL(DENALI_CTL_72_LPC_SR_ZQ_EN, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_73),      0x07FFFFFF, BUILD_FIELD_VAL(DENALI_CTL_73_WRITE_MODEREG, 0x0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_78),      0x0001FFFF, BUILD_FIELD_VAL(DENALI_CTL_78_MRSINGLE_DATA_0, 0x0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_79),      0x0001FFFF, BUILD_FIELD_VAL(DENALI_CTL_79_MR3_DATA_0, 0x0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_80),      0x0001FFFF, BUILD_FIELD_VAL(DENALI_CTL_80_MR4_DATA_0, 0x0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_81),      0x0001FFFF, BUILD_FIELD_VAL(DENALI_CTL_81_MR5_DATA_0, 0x400) },
+	{ MC_INIT_OFFSET(DENALI_CTL_91),      0x0F030000, BUILD_FIELD_VAL(DENALI_CTL_91_INLINE_ECC_BANK_OFFSET, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_91_ECC_ENABLE, 0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_92),      0x0F010100, BUILD_FIELD_VAL(DENALI_CTL_92_ECC_READ_CACHING_EN, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_92_ECC_WRITE_COMBINING_EN, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_92_MC_RESERVED13, 0x8) },
+	{ MC_INIT_OFFSET(DENALI_CTL_93),      0x01000001, BUILD_FIELD_VAL(DENALI_CTL_93_MC_RESERVED14, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_93_ECC_WRITEBACK_EN, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_104),     0x3FFF3FFF, BUILD_FIELD_VAL(DENALI_CTL_104_NON_ECC_REGION_START_ADDR_0, 0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_104_NON_ECC_REGION_END_ADDR_0, _2GB_) },
+	{ MC_INIT_OFFSET(DENALI_CTL_112),     0xFF0000FF, BUILD_FIELD_VAL(DENALI_CTL_112_NON_ECC_REGION_ENABLE, 0x0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_112_ECC_SCRUB_LEN, 0x8) },
+	{ MC_INIT_OFFSET(DENALI_CTL_113),     0x00FFFF00, BUILD_FIELD_VAL(DENALI_CTL_113_ECC_SCRUB_INTERVAL, 0x3e8) },
+	{ MC_INIT_OFFSET(DENALI_CTL_114),     0x0000FFFF, BUILD_FIELD_VAL(DENALI_CTL_114_ECC_SCRUB_IDLE_CNT, 0x64) },
+	{ MC_INIT_OFFSET(DENALI_CTL_118),     0x1F1F0000, BUILD_FIELD_VAL(DENALI_CTL_118_AREF_NORM_THRESHOLD, 0x11) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_118_AREF_HIGH_THRESHOLD, 0x15) },
+	{ MC_INIT_OFFSET(DENALI_CTL_119),     0x000F1F1F, BUILD_FIELD_VAL(DENALI_CTL_119_AREF_MAX_DEFICIT, 0x18) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_119_AREF_MAX_CREDIT, 0xc) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_119_AREF_CMD_MAX_PER_TREFI, 0x4) },
+	{ MC_INIT_OFFSET(DENALI_CTL_122),     0x0FFF0007, BUILD_FIELD_VAL(DENALI_CTL_122_MC_RESERVED15, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_122_ZQINIT, 0xf00) },
+	{ MC_INIT_OFFSET(DENALI_CTL_125),     0x1F00000F, BUILD_FIELD_VAL(DENALI_CTL_125_COL_DIFF, 0x2) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_125_APREBIT, 0xa) },
+	{ MC_INIT_OFFSET(DENALI_CTL_126),     0x0001FFFF, BUILD_FIELD_VAL(DENALI_CTL_126_AGE_COUNT, 0xff) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_126_COMMAND_AGE_COUNT, 0xff) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_126_ADDR_CMP_EN, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_127),     0x01010101, BUILD_FIELD_VAL(DENALI_CTL_127_BANK_SPLIT_EN, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_127_PLACEMENT_EN, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_127_PRIORITY_EN, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_127_RW_SAME_EN, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_128),     0x01070301, BUILD_FIELD_VAL(DENALI_CTL_128_RW_SAME_PAGE_EN, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_128_DISABLE_RW_GROUP_W_BNK_CONFLICT, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_128_NUM_Q_ENTRIES_ACT_DISABLE, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_128_SWAP_EN, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_129),     0x000F0001, BUILD_FIELD_VAL(DENALI_CTL_129_DISABLE_RD_INTERLEAVE, 0x0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_129_BURST_ON_FLY_BIT, 0xc) },
+	{ MC_INIT_OFFSET(DENALI_CTL_131),     0x01010000, BUILD_FIELD_VAL(DENALI_CTL_131_CTRLUPD_REQ_PER_AREF_EN, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_131_CTRLUPD_AREF_HP_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_132),     0x00000100, BUILD_FIELD_VAL(DENALI_CTL_132_RD_PREAMBLE_TRAINING_EN, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_133),     0x01000000, BUILD_FIELD_VAL(DENALI_CTL_133_BG_ROTATE_EN, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_172),     0x00000100, BUILD_FIELD_VAL(DENALI_CTL_172_VREF_CS, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_173),     0x00007F7F, BUILD_FIELD_VAL(DENALI_CTL_173_VREF_VAL_DEV0_0, 0x67) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_173_VREF_VAL_DEV1_0, 0x67) },
+};
+
+static const MC_INIT_REG_T mc_init_base_1[] =
+{
+	{ MC_INIT_OFFSET(DENALI_CTL_174),     0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_174_AHB4_WRLEN, 0xf) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_174_AHB4_RDLEN, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_174_AHB5_WRLEN, 0xf) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_174_AHB5_RDLEN, 0x3) },
+	{ MC_INIT_OFFSET(DENALI_CTL_175),     0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_175_AHB6_WRLEN, MC_AHB_TIP_CP_RDLEN) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_175_AHB6_RDLEN, MC_AHB_TIP_CP_RDLEN) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_175_AHB7_WRLEN, 0xf) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_175_AHB7_RDLEN, 0x3) },
+	{ MC_INIT_OFFSET(DENALI_CTL_176),     0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_176_AHB8_WRLEN, 0xf) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_176_AHB8_RDLEN, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_176_AHB9_WRLEN, 0xf) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_176_AHB9_RDLEN, 0x3) },
+	{ MC_INIT_OFFSET(DENALI_CTL_177),     0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_177_AHB10_WRLEN, 0xf) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_177_AHB10_RDLEN, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_177_AHB11_WRLEN, 0xf) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_177_AHB11_RDLEN, 0x3) },
+	{ MC_INIT_OFFSET(DENALI_CTL_178),     0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_178_AHB12_WRLEN, 0xf) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_178_AHB12_RDLEN, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_178_AHB13_WRLEN, MC_AHB_TIP_CP_RDLEN) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_178_AHB13_RDLEN, MC_AHB_TIP_CP_RDLEN) },
+	{ MC_INIT_OFFSET(DENALI_CTL_179),     0x01000F0F, BUILD_FIELD_VAL(DENALI_CTL_179_AHB14_WRLEN, 0xf) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_179_AHB14_RDLEN, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_179_AXI0_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_180),     0x00000707, BUILD_FIELD_VAL(DENALI_CTL_180_AXI0_R_PRIORITY, PRTY_GRP_AXI0_GFX1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_180_AXI0_W_PRIORITY, PRTY_GRP_AXI0_GFX1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_181),     0x00070701, BUILD_FIELD_VAL(DENALI_CTL_181_AXI1_R_PRIORITY, PRTY_GRP_AXI1_BMC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_181_AXI1_W_PRIORITY, PRTY_GRP_AXI1_BMC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_181_AXI1_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_182),     0x07070100, BUILD_FIELD_VAL(DENALI_CTL_182_AXI2_R_PRIORITY, PRTY_GRP_AXI2_GFX0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_182_AXI2_W_PRIORITY, PRTY_GRP_AXI2_GFX0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_182_AXI2_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_183),     0x07010000, BUILD_FIELD_VAL(DENALI_CTL_183_AXI3_R_PRIORITY, PRTY_GRP_AXI3_PCIERC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_183_AXI3_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_184),     0x01000007, BUILD_FIELD_VAL(DENALI_CTL_184_AXI3_W_PRIORITY, PRTY_GRP_AXI3_PCIERC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_184_AXI4_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_185),     0x00000707, BUILD_FIELD_VAL(DENALI_CTL_185_AXI4_R_PRIORITY, PRTY_GRP_AXI4_USBD_EMMC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_185_AXI4_W_PRIORITY, PRTY_GRP_AXI4_USBD_EMMC) },
+	{ MC_INIT_OFFSET(DENALI_CTL_186),     0x00070701, BUILD_FIELD_VAL(DENALI_CTL_186_AXI5_R_PRIORITY, PRTY_GRP_AXI5_USBH) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_186_AXI5_W_PRIORITY, PRTY_GRP_AXI5_USBH) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_186_AXI5_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_187),     0x07070100, BUILD_FIELD_VAL(DENALI_CTL_187_AXI6_R_PRIORITY, PRTY_GRP_AXI6_COP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_187_AXI6_W_PRIORITY, PRTY_GRP_AXI6_COP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_187_AXI6_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_188),     0x07010000, BUILD_FIELD_VAL(DENALI_CTL_188_AXI7_R_PRIORITY, PRTY_GRP_AXI7_GMAC1_RD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_188_AXI7_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_189),     0x01000007, BUILD_FIELD_VAL(DENALI_CTL_189_AXI7_W_PRIORITY, PRTY_GRP_AXI7_GMAC1_WR) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_189_AXI8_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_190),     0x00000707, BUILD_FIELD_VAL(DENALI_CTL_190_AXI8_R_PRIORITY, PRTY_GRP_AXI8_GMAC2_RD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_190_AXI8_W_PRIORITY, PRTY_GRP_AXI8_GMAC2_WR) },
+	{ MC_INIT_OFFSET(DENALI_CTL_191),     0x00070701, BUILD_FIELD_VAL(DENALI_CTL_191_AXI9_R_PRIORITY, PRTY_GRP_AXI9_GMAC34_GDMA_VDMA) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_191_AXI9_W_PRIORITY, PRTY_GRP_AXI9_GMAC34_GDMA_VDMA) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_191_AXI9_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_192),     0x07070100, BUILD_FIELD_VAL(DENALI_CTL_192_AXI10_R_PRIORITY, PRTY_GRP_AXI10_ECE) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_192_AXI10_W_PRIORITY, PRTY_GRP_AXI10_ECE) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_192_AXI10_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_193),     0x07010000, BUILD_FIELD_VAL(DENALI_CTL_193_AXI11_R_PRIORITY, PRTY_GRP_AXI11_VCD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_193_AXI11_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_194),     0x01000007, BUILD_FIELD_VAL(DENALI_CTL_194_AXI11_W_PRIORITY, PRTY_GRP_AXI11_VCD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_194_AXI12_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_195),     0x00000707, BUILD_FIELD_VAL(DENALI_CTL_195_AXI12_R_PRIORITY, PRTY_GRP_AXI12_VCD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_195_AXI12_W_PRIORITY, PRTY_GRP_AXI12_VCD) },
+	{ MC_INIT_OFFSET(DENALI_CTL_196),     0x00070701, BUILD_FIELD_VAL(DENALI_CTL_196_AXI13_R_PRIORITY, PRTY_GRP_AXI13_TIP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_196_AXI13_W_PRIORITY, PRTY_GRP_AXI13_TIP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_196_AXI13_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_197),     0x07070100, BUILD_FIELD_VAL(DENALI_CTL_197_AXI14_R_PRIORITY, PRTY_GRP_AXI14_FLM) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_197_AXI14_W_PRIORITY, PRTY_GRP_AXI14_FLM) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_197_AXI14_FIXED_PORT_PRIORITY_ENABLE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1292),    0xFFFF0000, BUILD_FIELD_VAL(DENALI_CTL_1292_TDFI_CTRLUPD_MIN, 0x37) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1293),    0x001FFFFF, BUILD_FIELD_VAL(DENALI_CTL_1293_TDFI_CTRLUPD_MAX, 0x802) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1294),    0xFFFFFFFF, 2000 },
+	{ MC_INIT_OFFSET(DENALI_CTL_1295),    0xFFFFFFFF, 50 },
+	{ MC_INIT_OFFSET(DENALI_CTL_1296),    0xFFFFFFFF, 0x200 },
+	{ MC_INIT_OFFSET(DENALI_CTL_1297),    0xFFFFFFFF, 0x200 },
+	{ MC_INIT_OFFSET(DENALI_CTL_1298),    0x007FFFFF, BUILD_FIELD_VAL(DENALI_CTL_1298_TDFI_PHYUPD_RESP, 0x30c0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1299),    0xFFFFFFFF, 0x1e780 },
+	{ MC_INIT_OFFSET(DENALI_CTL_1301),    0x0000070F, BUILD_FIELD_VAL(DENALI_CTL_1301_TDFI_DRAM_CLK_ENABLE, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1301_TDFI_PHY_WRDATA, 0x2) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1306),    0x0F000000, BUILD_FIELD_VAL(DENALI_CTL_1306_AXI0_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI0_GFX1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1307),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1307_AXI0_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI0_GFX1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1307_AXI0_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI0_GFX1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1307_AXI0_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI0_GFX1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1307_AXI0_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI0_GFX1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1308),    0x000F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1308_AXI0_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI0_GFX1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1308_AXI0_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI0_GFX1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1308_AXI0_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI0_GFX1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1309),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1309_AXI0_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1309_AXI1_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI1_BMC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1309_AXI1_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI1_BMC) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1310),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1310_AXI1_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI1_BMC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1310_AXI1_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI1_BMC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1310_AXI1_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI1_BMC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1310_AXI1_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI1_BMC) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1311),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1311_AXI1_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI1_BMC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1311_AXI1_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI1_BMC) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1312),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1312_AXI1_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1312_AXI2_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI2_GFX0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1312_AXI2_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI2_GFX0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1313),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1313_AXI2_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI2_GFX0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1313_AXI2_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI2_GFX0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1313_AXI2_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI2_GFX0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1313_AXI2_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI2_GFX0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1314),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1314_AXI2_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI2_GFX0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1314_AXI2_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI2_GFX0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1315),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1315_AXI2_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1315_AXI3_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI3_PCIERC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1315_AXI3_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI3_PCIERC) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1316),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1316_AXI3_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI3_PCIERC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1316_AXI3_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI3_PCIERC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1316_AXI3_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI3_PCIERC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1316_AXI3_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI3_PCIERC) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1317),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1317_AXI3_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI3_PCIERC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1317_AXI3_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI3_PCIERC) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1318),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1318_AXI3_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1318_AXI4_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI4_USBD_EMMC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1318_AXI4_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI4_USBD_EMMC) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1319),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1319_AXI4_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI4_USBD_EMMC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1319_AXI4_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI4_USBD_EMMC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1319_AXI4_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI4_USBD_EMMC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1319_AXI4_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI4_USBD_EMMC) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1320),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1320_AXI4_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI4_USBD_EMMC) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1320_AXI4_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI4_USBD_EMMC) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1321),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1321_AXI4_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1321_AXI5_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI5_USBH) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1321_AXI5_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI5_USBH) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1322),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1322_AXI5_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI5_USBH) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1322_AXI5_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI5_USBH) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1322_AXI5_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI5_USBH) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1322_AXI5_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI5_USBH) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1323),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1323_AXI5_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI5_USBH) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1323_AXI5_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI5_USBH) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1324),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1324_AXI5_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1324_AXI6_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI6_COP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1324_AXI6_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI6_COP) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1325),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1325_AXI6_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI6_COP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1325_AXI6_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI6_COP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1325_AXI6_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI6_COP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1325_AXI6_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI6_COP) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1326),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1326_AXI6_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI6_COP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1326_AXI6_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI6_COP) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1327),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1327_AXI6_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1327_AXI7_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI7_GMAC1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1327_AXI7_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI7_GMAC1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1328),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1328_AXI7_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI7_GMAC1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1328_AXI7_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI7_GMAC1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1328_AXI7_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI7_GMAC1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1328_AXI7_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI7_GMAC1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1329),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1329_AXI7_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI7_GMAC1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1329_AXI7_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI7_GMAC1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1330),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1330_AXI7_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1330_AXI8_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI8_GMAC2) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1330_AXI8_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI8_GMAC2) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1331),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1331_AXI8_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI8_GMAC2) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1331_AXI8_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI8_GMAC2) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1331_AXI8_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI8_GMAC2) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1331_AXI8_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI8_GMAC2) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1332),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1332_AXI8_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI8_GMAC2) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1332_AXI8_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI8_GMAC2) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1333),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1333_AXI8_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1333_AXI9_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI9_GMAC34_GDMA_VDMA) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1333_AXI9_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI9_GMAC34_GDMA_VDMA) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1334),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1334_AXI9_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI9_GMAC34_GDMA_VDMA) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1334_AXI9_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI9_GMAC34_GDMA_VDMA) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1334_AXI9_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI9_GMAC34_GDMA_VDMA) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1334_AXI9_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI9_GMAC34_GDMA_VDMA) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1335),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1335_AXI9_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI9_GMAC34_GDMA_VDMA) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1335_AXI9_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI9_GMAC34_GDMA_VDMA) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1336),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1336_AXI9_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1336_AXI10_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI10_ECE) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1336_AXI10_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI10_ECE) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1337),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1337_AXI10_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI10_ECE) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1337_AXI10_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI10_ECE) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1337_AXI10_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI10_ECE) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1337_AXI10_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI10_ECE) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1338),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1338_AXI10_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI10_ECE) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1338_AXI10_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI10_ECE) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1339),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1339_AXI10_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1339_AXI11_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI11_VCD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1339_AXI11_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI11_VCD) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1340),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1340_AXI11_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI11_VCD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1340_AXI11_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI11_VCD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1340_AXI11_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI11_VCD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1340_AXI11_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI11_VCD) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1341),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1341_AXI11_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI11_VCD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1341_AXI11_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI11_VCD) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1342),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1342_AXI11_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1342_AXI12_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI12_VCD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1342_AXI12_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI12_VCD) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1343),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1343_AXI12_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI12_VCD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1343_AXI12_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI12_VCD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1343_AXI12_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI12_VCD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1343_AXI12_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI12_VCD) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1344),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1344_AXI12_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI12_VCD) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1344_AXI12_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI12_VCD) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1345),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1345_AXI12_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1345_AXI13_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI13_TIP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1345_AXI13_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI13_TIP) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1346),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1346_AXI13_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI13_TIP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1346_AXI13_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI13_TIP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1346_AXI13_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI13_TIP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1346_AXI13_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI13_TIP) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1347),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1347_AXI13_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI13_TIP) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1347_AXI13_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI13_TIP) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1348),    0x0F0F03FF, BUILD_FIELD_VAL(DENALI_CTL_1348_AXI13_PRIORITY_RELAX, 0x64) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1348_AXI14_PRIORITY0_RELATIVE_PRIORITY, PRTY_REL_AXI14_FLM) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1348_AXI14_PRIORITY1_RELATIVE_PRIORITY, PRTY_REL_AXI14_FLM) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1349),    0x0F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_1349_AXI14_PRIORITY2_RELATIVE_PRIORITY, PRTY_REL_AXI14_FLM) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1349_AXI14_PRIORITY3_RELATIVE_PRIORITY, PRTY_REL_AXI14_FLM) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1349_AXI14_PRIORITY4_RELATIVE_PRIORITY, PRTY_REL_AXI14_FLM) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1349_AXI14_PRIORITY5_RELATIVE_PRIORITY, PRTY_REL_AXI14_FLM) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1350),    0x00000F0F, BUILD_FIELD_VAL(DENALI_CTL_1350_AXI14_PRIORITY6_RELATIVE_PRIORITY, PRTY_REL_AXI14_FLM) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_1350_AXI14_PRIORITY7_RELATIVE_PRIORITY, PRTY_REL_AXI14_FLM) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1351),    0x000003FF, BUILD_FIELD_VAL(DENALI_CTL_1351_AXI14_PRIORITY_RELAX, 0x64) },
+};
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* mc_init_1600 delta: the register writes that differ from the base tables                                */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifdef MC_CAPABILITY_CLK_TYPE_1600
+static const MC_INIT_REG_T mc_init_1600_0[] =
+{
+	{ MC_INIT_OFFSET(DENALI_CTL_25),      0x01FFFFFF, BUILD_FIELD_VAL(DENALI_CTL_25_TINIT, 0x927c0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_25_PHY_INDEP_TRAIN_MODE, 0x0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_26),      0x0000013F, BUILD_FIELD_VAL(DENALI_CTL_26_TSREF2PHYMSTR, 0x10) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_26_PHY_INDEP_INIT_MODE, 0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_27),      0xFFFFFFFF, 0x80320L },
+	{ MC_INIT_OFFSET(DENALI_CTL_28),      0xFFFFFFFF, 0x80320L },
+	{ MC_INIT_OFFSET(DENALI_CTL_29),      0x0000FFFF, BUILD_FIELD_VAL(DENALI_CTL_29_TDLL, 0x255) },
+	{ MC_INIT_OFFSET(DENALI_CTL_31),      0xFF001F07, BUILD_FIELD_VAL(DENALI_CTL_31_TBST_INT_INTERVAL, 0x4) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_31_TCCD, 0x4) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_31_TRRD, 0x5) },
+	{ MC_INIT_OFFSET(DENALI_CTL_32),      0x0001FFFF, BUILD_FIELD_VAL(DENALI_CTL_32_TRRD_L, 0x6) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_32_TRC, 0x27) },
+	{ MC_INIT_OFFSET(DENALI_CTL_33),      0x3F3F01FF, BUILD_FIELD_VAL(DENALI_CTL_33_TRAS_MIN, 0x1c) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_33_TWTR, 0x2) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_33_TWTR_L, 0x6) },
+	{ MC_INIT_OFFSET(DENALI_CTL_34),      0xFF01FFFF, BUILD_FIELD_VAL(DENALI_CTL_34_TRP, 0xb) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_34_TFAW, 0x1c) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_34_TRTP, 0x6) },
+	{ MC_INIT_OFFSET(DENALI_CTL_36),      0x0F0FFFFF, BUILD_FIELD_VAL(DENALI_CTL_36_TRAS_MAX, 0xbd60) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_36_TCKE, 0x4) },
+	{ MC_INIT_OFFSET(DENALI_CTL_37),      0x000707FF, BUILD_FIELD_VAL(DENALI_CTL_37_TCKESR, 0x9) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_37_MC_RESERVED0, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_37_MC_RESERVED1, 0x3) },
+	{ MC_INIT_OFFSET(DENALI_CTL_38),      0xFFFFFFFF, BUILD_FIELD_VAL(DENALI_CTL_38_TRCD, 0xc) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_38_TWR, 0xc) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_38_TVREF, 0x78) },
+	{ MC_INIT_OFFSET(DENALI_CTL_39),      0x000100FF, BUILD_FIELD_VAL(DENALI_CTL_39_TMRD_PDA, 0x18) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_39_CONCURRENTAP, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_40),      0x00FF07FF, BUILD_FIELD_VAL(DENALI_CTL_40_TDAL, 0x18) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_40_BSTLEN, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_40_TRP_AB, 0xc) },
+	{ MC_INIT_OFFSET(DENALI_CTL_44),      0x03FF0F07, BUILD_FIELD_VAL(DENALI_CTL_44_MC_RESERVED3, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_44_CS_COMPARISON_FOR_REFRESH_DEPTH, 0x8) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_44_TRFC, 0x1B8) },
+	{ MC_INIT_OFFSET(DENALI_CTL_45),      0x000FFFFF, BUILD_FIELD_VAL(DENALI_CTL_45_TREF, 0x1860) },
+	{ MC_INIT_OFFSET(DENALI_CTL_46),      0xFFFFFFFF, BUILD_FIELD_VAL(DENALI_CTL_46_TPDEX, 0x5) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_46_TXPDLL, 0x14) },
+	{ MC_INIT_OFFSET(DENALI_CTL_47),      0xFFFFFFFF, BUILD_FIELD_VAL(DENALI_CTL_47_TXSR, 0x360) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_47_TXSNR, 0x320) },
+	{ MC_INIT_OFFSET(DENALI_CTL_48),      0x0000FFFF, BUILD_FIELD_VAL(DENALI_CTL_48_TXPR, 0xd8) },
+	{ MC_INIT_OFFSET(DENALI_CTL_49),      0x07000001, BUILD_FIELD_VAL(DENALI_CTL_49_ENABLE_QUICK_SREFRESH, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_49_MC_RESERVED5, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_54),      0xFFFFFFFF, 0x30c00 },
+	{ MC_INIT_OFFSET(DENALI_CTL_55),      0x000FFFFF, BUILD_FIELD_VAL(DENALI_CTL_55_TDFI_PHYMSTR_RESP, 0xaaa0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_57),      0x00000100, BUILD_FIELD_VAL(DENALI_CTL_57_PHYMSTR_TRAIN_AFTER_INIT_COMPLETE, 0x0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_63),      0xFFFF0000, BUILD_FIELD_VAL(DENALI_CTL_63_CKSRE, 0xc) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_63_CKSRX, 0x8) },
+	{ MC_INIT_OFFSET(DENALI_CTL_65),      0x3F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_65_LPI_SR_LONG_MCCLK_GATE_WAKEUP, 0xA) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_65_LPI_PD_WAKEUP, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_65_LPI_TIMER_WAKEUP, 0xe) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_65_LPI_WAKEUP_EN, 0x2F) },
+	{ MC_INIT_OFFSET(DENALI_CTL_66),      0x000FFF01, BUILD_FIELD_VAL(DENALI_CTL_66_LPI_CTRL_REQ_EN, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_66_LPI_TIMER_COUNT, 0x3) },
+	{ MC_INIT_OFFSET(DENALI_CTL_123),     0x0FFF0FFF, BUILD_FIELD_VAL(DENALI_CTL_123_ZQCL, 0x400) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_123_ZQCS, 0x80) },
+	{ MC_INIT_OFFSET(DENALI_CTL_169),     0x00010FFF, BUILD_FIELD_VAL(DENALI_CTL_169_TODTL_2CMD, 0xc) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_169_TODTH_WR, 0x6) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_169_ODT_EN, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_170),     0x1F1F1F1F, BUILD_FIELD_VAL(DENALI_CTL_170_R2R_SAMECS_DLY, 0x0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_170_R2W_SAMECS_DLY, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_170_W2R_SAMECS_DLY, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_170_W2W_SAMECS_DLY, 0x0) },
+};
+
+static const MC_INIT_REG_T mc_init_1600_1[] =
+{
+	{ MC_INIT_OFFSET(DENALI_CTL_1291),    0x7F000000, BUILD_FIELD_VAL(DENALI_CTL_1291_TDFI_PHY_RDLAT, 0x14) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1300),    0x000F0000, BUILD_FIELD_VAL(DENALI_CTL_1300_TDFI_CTRL_DELAY, 0x2) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1302),    0x0000FF00, BUILD_FIELD_VAL(DENALI_CTL_1302_TDFI_WRDATA_DELAY, 0xc) },
+};
+
+static const MC_INIT_LAYER_T mc_init_1600_delta[] =
+{
+	{ mc_init_1600_0, ARRAY_SIZE(mc_init_1600_0) },
+	{ mc_init_1600_1, ARRAY_SIZE(mc_init_1600_1) },
+};
+#endif
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* mc_init_2133 delta: the register writes that differ from the base tables                                */
+/*---------------------------------------------------------------------------------------------------------*/
+static const MC_INIT_REG_T mc_init_2133_0[] =
+{
+	{ MC_INIT_OFFSET(DENALI_CTL_25),      0x01FFFFFF, BUILD_FIELD_VAL(DENALI_CTL_25_TINIT, 0xb6888) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_25_PHY_INDEP_TRAIN_MODE, 0x0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_26),      0x0000003F, BUILD_FIELD_VAL(DENALI_CTL_26_TSREF2PHYMSTR, 0x32) },
+	{ MC_INIT_OFFSET(DENALI_CTL_27),      0xFFFFFFFF, 0x35000 },
+	{ MC_INIT_OFFSET(DENALI_CTL_28),      0xFFFFFFFF, 0x8f3ab },
+	{ MC_INIT_OFFSET(DENALI_CTL_29),      0x0000FFFF, BUILD_FIELD_VAL(DENALI_CTL_29_TDLL, 0x302) },
+	{ MC_INIT_OFFSET(DENALI_CTL_31),      0xFF001F07, BUILD_FIELD_VAL(DENALI_CTL_31_TBST_INT_INTERVAL, 0x4) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_31_TCCD, 0x4) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_31_TRRD, 0x6) },
+	{ MC_INIT_OFFSET(DENALI_CTL_32),      0x0001FFFF, BUILD_FIELD_VAL(DENALI_CTL_32_TRRD_L, 0x6) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_32_TRC, 0x34) },
+	{ MC_INIT_OFFSET(DENALI_CTL_33),      0x3F3F01FF, BUILD_FIELD_VAL(DENALI_CTL_33_TRAS_MIN, 0x24) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_33_TWTR, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_33_TWTR_L, 0x8) },
+	{ MC_INIT_OFFSET(DENALI_CTL_34),      0xFF01FFFF, BUILD_FIELD_VAL(DENALI_CTL_34_TRP, 0x10) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_34_TFAW, 0x20) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_34_TRTP, 0x8) },
+	{ MC_INIT_OFFSET(DENALI_CTL_36),      0x0F0FFFFF, BUILD_FIELD_VAL(DENALI_CTL_36_TRAS_MAX, 0x11bd4) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_36_TCKE, 0x6) },
+	{ MC_INIT_OFFSET(DENALI_CTL_37),      0x000707FF, BUILD_FIELD_VAL(DENALI_CTL_37_TCKESR, 0x7) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_37_MC_RESERVED0, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_37_MC_RESERVED1, 0x3) },
+	{ MC_INIT_OFFSET(DENALI_CTL_38),      0xFFFFFFFF, BUILD_FIELD_VAL(DENALI_CTL_38_TRCD, 0x10) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_38_TWR, 0x10) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_38_TVREF, 0xa0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_39),      0x000100FF, BUILD_FIELD_VAL(DENALI_CTL_39_TMRD_PDA, 0x10) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_39_CONCURRENTAP, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_40),      0x01FF07FF, BUILD_FIELD_VAL(DENALI_CTL_40_TDAL, 0x20) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_40_BSTLEN, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_40_TRP_AB, 0x10) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_40_REG_DIMM_ENABLE, 0x0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_44),      0x03FF0F07, BUILD_FIELD_VAL(DENALI_CTL_44_MC_RESERVED3, 0x3) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_44_CS_COMPARISON_FOR_REFRESH_DEPTH, 0x8) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_44_TRFC, 0x260) },
+	{ MC_INIT_OFFSET(DENALI_CTL_45),      0x000FFFFF, BUILD_FIELD_VAL(DENALI_CTL_45_TREF, 0x1FFE) },
+	{ MC_INIT_OFFSET(DENALI_CTL_46),      0xFFFFFFFF, BUILD_FIELD_VAL(DENALI_CTL_46_TPDEX, 0x7) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_46_TXPDLL, 0x7) },
+	{ MC_INIT_OFFSET(DENALI_CTL_47),      0xFFFFFFFF, BUILD_FIELD_VAL(DENALI_CTL_47_TXSR, 0x320) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_47_TXSNR, 0x180) },
+	{ MC_INIT_OFFSET(DENALI_CTL_48),      0x0000FFFF, BUILD_FIELD_VAL(DENALI_CTL_48_TXPR, 0x180) },
+	{ MC_INIT_OFFSET(DENALI_CTL_49),      0x07000001, BUILD_FIELD_VAL(DENALI_CTL_49_ENABLE_QUICK_SREFRESH, 0x0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_49_MC_RESERVED5, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_54),      0xFFFFFFFF, 0x7d0 },
+	{ MC_INIT_OFFSET(DENALI_CTL_55),      0x000FFFFF, BUILD_FIELD_VAL(DENALI_CTL_55_TDFI_PHYMSTR_RESP, 0x7d0) },
+	{ MC_INIT_OFFSET(DENALI_CTL_57),      0x00000100, BUILD_FIELD_VAL(DENALI_CTL_57_PHYMSTR_TRAIN_AFTER_INIT_COMPLETE, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_63),      0xFFFF0000, BUILD_FIELD_VAL(DENALI_CTL_63_CKSRE, 0xb) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_63_CKSRX, 0xb) },
+	{ MC_INIT_OFFSET(DENALI_CTL_65),      0x3F0F0F0F, BUILD_FIELD_VAL(DENALI_CTL_65_LPI_SR_LONG_MCCLK_GATE_WAKEUP, 0xa) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_65_LPI_PD_WAKEUP, 0xF) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_65_LPI_TIMER_WAKEUP, 0xe) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_65_LPI_WAKEUP_EN, 0x2F) },
+	{ MC_INIT_OFFSET(DENALI_CTL_66),      0x000FFF01, BUILD_FIELD_VAL(DENALI_CTL_66_LPI_CTRL_REQ_EN, 0x0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_66_LPI_TIMER_COUNT, 0x3) },
+	{ MC_INIT_OFFSET(DENALI_CTL_71),      0x01000000, BUILD_FIELD_VAL(DENALI_CTL_71_LPC_SR_PHYUPD_EN, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_123),     0x0FFF0FFF, BUILD_FIELD_VAL(DENALI_CTL_123_ZQCL, 0x400) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_123_ZQCS, 0x200) },
+	{ MC_INIT_OFFSET(DENALI_CTL_169),     0x00010FFF, BUILD_FIELD_VAL(DENALI_CTL_169_TODTL_2CMD, 0xd) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_169_TODTH_WR, 0x7) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_169_ODT_EN, 0x1) },
+	{ MC_INIT_OFFSET(DENALI_CTL_170),     0x1F1F1F1F, BUILD_FIELD_VAL(DENALI_CTL_170_R2R_SAMECS_DLY, 0x0) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_170_R2W_SAMECS_DLY, 0x4) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_170_W2R_SAMECS_DLY, 0x1) |
+	                                                  BUILD_FIELD_VAL(DENALI_CTL_170_W2W_SAMECS_DLY, 0x0) },
+};
+
+static const MC_INIT_REG_T mc_init_2133_1[] =
+{
+	{ MC_INIT_OFFSET(DENALI_CTL_1291),    0x7F000000, BUILD_FIELD_VAL(DENALI_CTL_1291_TDFI_PHY_RDLAT, 0x20) },
+	{ MC_INIT_OFFSET(DENALI_CTL_1302),    0x0000FF00, BUILD_FIELD_VAL(DENALI_CTL_1302_TDFI_WRDATA_DELAY, 0x18) },
+};
+
+static const MC_INIT_LAYER_T mc_init_2133_delta[] =
+{
+	{ mc_init_2133_0, ARRAY_SIZE(mc_init_2133_0) },
+	{ mc_init_2133_1, ARRAY_SIZE(mc_init_2133_1) },
+};
+
+static void mc_init_grade (DDR_Setup *ddr_setup, const MC_GRADE_T *grade)
+{
+	const MC_INIT_REG_T setup_0[] =
+	{
+		{ MC_INIT_OFFSET(DENALI_CTL_29),      0x1F3F0000, BUILD_FIELD_VAL(DENALI_CTL_29_CASLAT_LIN, (ddr_setup->cas_latency << 1)) |
+		                                                  BUILD_FIELD_VAL(DENALI_CTL_29_WRLAT, ddr_setup->cas_write_latency) },
+		{ MC_INIT_OFFSET(DENALI_CTL_31),      0x001F0000, BUILD_FIELD_VAL(DENALI_CTL_31_TCCD_L, ddr_setup->phy_tCCD_L) },
+		{ MC_INIT_OFFSET(DENALI_CTL_75),      0x0001FFFF, BUILD_FIELD_VAL(DENALI_CTL_75_MR0_DATA_0, ddr_setup->MR0_DATA) },
+		{ MC_INIT_OFFSET(DENALI_CTL_76),      0x0001FFFF, BUILD_FIELD_VAL(DENALI_CTL_76_MR1_DATA_0, ddr_setup->MR1_DATA) },
+		{ MC_INIT_OFFSET(DENALI_CTL_77),      0x0001FFFF, BUILD_FIELD_VAL(DENALI_CTL_77_MR2_DATA_0, ddr_setup->MR2_DATA) },
+		{ MC_INIT_OFFSET(DENALI_CTL_82),      0x0001FFFF, BUILD_FIELD_VAL(DENALI_CTL_82_MR6_DATA_0, ddr_setup->MR6_DATA) },
+	};
+	const MC_INIT_LAYER_T layers_0[] =
+	{
+		{ mc_init_base_0, ARRAY_SIZE(mc_init_base_0) },
+		grade->delta[0],
+		{ setup_0, ARRAY_SIZE(setup_0) },
+	};
+	const MC_INIT_REG_T setup_1[] =
+	{
+		{ MC_INIT_OFFSET(DENALI_CTL_1300),    0x00007F7F, BUILD_FIELD_VAL(DENALI_CTL_1300_RDLAT_ADJ, ddr_setup->read_latency_adjust * 2) |
+		                                                  BUILD_FIELD_VAL(DENALI_CTL_1300_WRLAT_ADJ, ddr_setup->write_latency_adjust * 2) },
+		{ MC_INIT_OFFSET(DENALI_CTL_1301),    0x7F7F0000, BUILD_FIELD_VAL(DENALI_CTL_1301_TDFI_RDCSLAT, ddr_setup->cas_latency) |
+		                                                  BUILD_FIELD_VAL(DENALI_CTL_1301_TDFI_WRCSLAT, ddr_setup->cas_write_latency) },
+	};
+	const MC_INIT_LAYER_T layers_1[] =
+	{
+		{ mc_init_base_1, ARRAY_SIZE(mc_init_base_1) },
+		grade->delta[1],
+		{ setup_1, ARRAY_SIZE(setup_1) },
+	};
+
+	mc_init_apply_l(layers_0, ARRAY_SIZE(layers_0));
+	if (ddr_setup->ddr_size > _1GB_)
+	{
+		SET_REG_FIELD( DENALI_CTL_124, DENALI_CTL_124_BANK_DIFF, 0x1 );
+		SET_REG_FIELD( DENALI_CTL_124, DENALI_CTL_124_ROW_DIFF, 0x0);
+	}
+	else if (ddr_setup->ddr_size == _1GB_)
+	{
+		SET_REG_FIELD( DENALI_CTL_124, DENALI_CTL_124_BANK_DIFF, 0x1 );
+		SET_REG_FIELD( DENALI_CTL_124, DENALI_CTL_124_ROW_DIFF, 0x1);
+	}
+	else if (ddr_setup->ddr_size == _512MB_)
+	{
+		SET_REG_FIELD( DENALI_CTL_124, DENALI_CTL_124_BANK_DIFF, 0x1 );
+		SET_REG_FIELD( DENALI_CTL_124, DENALI_CTL_124_ROW_DIFF, 0x2);
+	}
+	mc_setup_AXI_ranges();
+
+	mc_init_apply_l(layers_1, ARRAY_SIZE(layers_1));
+}
@@ -44,17 +44,8 @@ static UINT32 calc_mr0_val (DDR_Setup *ddr_setup)
 	// need to clarify the trtp values
 	// reg_read_val |= ddr_setup->trtp <<9;
 
-	if (ddr_setup->dram_type_clk > DRAM_CLK_TYPE_1600)
-	{
-		reg_read_val |=  0x3 << 9;
-	}
-#ifdef MC_CAPABILITY_CLK_TYPE_1600
-	else
-	{
-		// Check the MR 0 value for 800! Why was the DLL reset set
-		reg_read_val |=  0x1 << 9;
-	}
-#endif
+	reg_read_val |= (UINT32)mc_grade_l(ddr_setup->dram_type_clk)->mr0_wr_rtp << 9;
+
 	return reg_read_val;
 }
 
@@ -163,6 +154,7 @@ static UINT32 calc_mr1_val (DDR_Setup *ddr_setup)
 /*---------------------------------------------------------------------------------------------------------*/
 DEFS_STATUS MC_Init_DDR_Setup (DDR_Setup *ddr_setup)
 {
+	const MC_GRADE_T *grade;
 
 	// only setting that work
 	// ddr_setup->dram_type_clk = DRAM_CLK_TYPE_2133;
@@ -188,31 +180,15 @@ DEFS_STATUS MC_Init_DDR_Setup (DDR_Setup *ddr_setup)
 	ddr_setup->phy_additive_latency = 0;
 	ddr_setup->phy_tRTP = 6;
 
-	if (ddr_setup->dram_type_clk > DRAM_CLK_TYPE_1600)
-	{
-		ddr_setup->cas_latency = 0xF;
-		ddr_setup->cas_write_latency = 0xE;
-		ddr_setup->phy_tCCD_L = 6;
-	}
-#ifdef MC_CAPABILITY_CLK_TYPE_1600
-	else
-	{
-		// NTIL: check if the correct value should be B or D!
-		ddr_setup->cas_latency = 0xB;
-		ddr_setup->cas_write_latency = 0xD; // TODO: or 0x0B?
-		ddr_setup->phy_tCCD_L = 5;
-	}
-
-#else
-	else
+	grade = mc_grade_l(ddr_setup->dram_type_clk);
+	if (grade->type != ddr_setup->dram_type_clk)
 	{
-		HAL_PRINT(KRED "DRAM 1600 - not supported! Reverting to 2133\n" KNRM);
-		ddr_setup->dram_type_clk = DRAM_CLK_TYPE_2133;
-		ddr_setup->cas_latency = 0xF;
-		ddr_setup->cas_write_latency = 0xE;
-		ddr_setup->phy_tCCD_L = 6;
+		HAL_PRINT_ERR(KRED "DRAM clock type %d - not supported! Reverting to %s\n" KNRM, ddr_setup->dram_type_clk, grade->name);
+		ddr_setup->dram_type_clk = grade->type;
 	}
-#endif
+	ddr_setup->cas_latency = grade->cas_latency;
+	ddr_setup->cas_write_latency = grade->cas_write_latency;
+	ddr_setup->phy_tCCD_L = grade->tCCD_L;
 
 	// Based on TE parameters, currently hard coded, for now w/o analysis and verification
 	if (CHIP_Get_Version() == 0x08)
@@ -367,7 +343,7 @@ static UINT32 MC_ohm_to_reg ( UINT32 val)
 		case 30:     return PHY_DRV_30ohm;
 		case 40:     return PHY_DRV_40ohm;
 		case 48:     return PHY_DRV_48ohm;
-		default: HAL_PRINT(KRED "MC_ohm_to_reg error \n" KNRM);
+		default: HAL_PRINT_ERR(KRED "MC_ohm_to_reg error \n" KNRM);
 	}
 
 	return PHY_DRV_48ohm;
@@ -401,6 +377,7 @@ DEFS_STATUS ddr_phy_cfg1 (DDR_Setup  *ddr_setup)
 	UINT32 driveStr;
 	UINT32 odt;
 	UINT32 reg_read_val;
+	const MC_GRADE_T *grade = mc_grade_l(ddr_setup->dram_type_clk);
 	UINT32 UNQ_IO_1_MASK = (BUILD_FIELD_VAL(UNIQUIFY_IO_1_cal_npu_offset, ddr_setup->phy_cal_npu_offset) |
 				BUILD_FIELD_VAL(UNIQUIFY_IO_1_incr_cal_npu, ddr_setup->phy_incr_cal_npu) |
 				BUILD_FIELD_VAL(UNIQUIFY_IO_1_cal_ppu_offset, ddr_setup->phy_cal_ppu_offset) |
@@ -510,18 +487,8 @@ DEFS_STATUS ddr_phy_cfg1 (DDR_Setup  *ddr_setup)
 #endif
 #ifdef STATIC_SCL_CONFIG
 
-	if (ddr_setup->dram_type_clk > DRAM_CLK_TYPE_1600)
-	{
-		REG_WRITE(SCL_CONFIG_1, 0x01000081 | 1 << 3 | 4 << 12);
-		REG_WRITE(SCL_CONFIG_2, 0x80000701 | 1 << 12);
-	}
-#ifdef MC_CAPABILITY_CLK_TYPE_1600
-	else
-	{
-		REG_WRITE(SCL_CONFIG_1, 0x01000061 | 1 << 3 | 4 << 12);
-		REG_WRITE(SCL_CONFIG_2, 0x81000601 | 1 << 12);
-	}
-#endif
+	REG_WRITE(SCL_CONFIG_1, grade->scl_config_1);
+	REG_WRITE(SCL_CONFIG_2, grade->scl_config_2);
 #else
 
 
@@ -559,19 +526,8 @@ DEFS_STATUS ddr_phy_cfg1 (DDR_Setup  *ddr_setup)
 
 	REG_WRITE( SCL_CONFIG_3	  /*0x16c*/, 0x00000000 );
 
-	if (ddr_setup->dram_type_clk > DRAM_CLK_TYPE_1600)
-	{
-		REG_WRITE(DYNAMIC_WRITE_BIT_LVL /*0x1c0*/, 0x0002e261);
-		REG_WRITE(SCL_CONFIG_4          /*0x1bc*/, 0x00000001);
-	}
-#ifdef MC_CAPABILITY_CLK_TYPE_1600
-	else
-	{
-
-		REG_WRITE(DYNAMIC_WRITE_BIT_LVL /*0x1c0*/, 0x0002b251);
-		REG_WRITE(SCL_CONFIG_4          /*0x1bc*/, 0x00000000);
-	}
-#endif
+	REG_WRITE(DYNAMIC_WRITE_BIT_LVL /*0x1c0*/, grade->dyn_wr_bit_lvl);
+	REG_WRITE(SCL_CONFIG_4          /*0x1bc*/, grade->scl_config_4);
 	REG_WRITE( SCL_GATE_TIMING		/*0x1e0*/, 0x00000190 ); /* From Ben. NTIL: 0x000000f0 ); */
 
 	REG_WRITE( WRLVL_DYN_ODT		 /*0x150*/, (ddr_setup->MR2_DATA) | (ddr_setup->MR2_DATA << 16));
@@ -582,17 +538,9 @@ DEFS_STATUS ddr_phy_cfg1 (DDR_Setup  *ddr_setup)
 	REG_WRITE( WRLVL_ON_OFF, reg_read_val ); /* changed from 0x03810301 */
 
 	//  Disable recalibration (will be init after ZQ calibration)
-	if (ddr_setup->dram_type_clk  > DRAM_CLK_TYPE_1600)
-	{
-		// NTIL: to update for 1066
-		REG_WRITE( PHY_DLL_RECALIB		, 0xac085400 );
-		//REG_WRITE( PHY_DLL_RECALIB		, 0xac001000 );
-	}
-	else
-	{
-		REG_WRITE( PHY_DLL_RECALIB		, 0xac064000 );
-		//REG_WRITE( PHY_DLL_RECALIB		, 0xac001000 );
-	}
+	// NTIL: to update for 1066
+	REG_WRITE( PHY_DLL_RECALIB		, ((0xA << 28)|(1<<27)|(1<<26)|(grade->recalib_cnt<<8)) ); /* 0xac085400 for DDR4-2133 */
+	//REG_WRITE( PHY_DLL_RECALIB		, 0xac001000 );
 
 	CLK_Delay_MicroSec( 100 );
 
@@ -670,16 +618,7 @@ DEFS_STATUS ddr_phy_cfg1 (DDR_Setup  *ddr_setup)
 
 	REG_WRITE( PHY_DLL_TRIM_CLK, ((dlls_trim_clk_incr << 7) | dlls_trim_clk) );
 	HAL_PRINT_DBG(">ddr_phy_cfg1 dlls_trim_clk	%c%d (reg=0x%x)\n", MC_SignToChar(dlls_trim_clk_incr), dlls_trim_clk, REG_READ (PHY_DLL_TRIM_CLK));
-	if (ddr_setup->dram_type_clk > DRAM_CLK_TYPE_1600)
-	{
-		REG_WRITE( PHY_DLL_RECALIB, ((0xA << 28)|(dll_recalib_trim_increment_ma<<27)|(1<<26)|(0x854<<8) | dll_recalib_trim_adrctrl_ma) ); /* replace 0x10 with 0x640 */
-	}
-#ifdef MC_CAPABILITY_CLK_TYPE_1600
-	else
-	{
-		REG_WRITE( PHY_DLL_RECALIB, ((0xA << 28)|(dll_recalib_trim_increment_ma<<27)|(1<<26)|(0x640<<8) | dll_recalib_trim_adrctrl_ma) ); /* replace 0x10 with 0x640 */
-	}
-#endif
+	REG_WRITE( PHY_DLL_RECALIB, ((0xA << 28)|(dll_recalib_trim_increment_ma<<27)|(1<<26)|(grade->recalib_cnt<<8) | dll_recalib_trim_adrctrl_ma) ); /* replace 0x10 with 0x640 */
 	HAL_PRINT_DBG(">ddr_phy_cfg1 dlls_trim_adrctrl_ma %c%d\n",
 		MC_SignToChar(READ_REG_FIELD(PHY_DLL_RECALIB, PHY_DLL_RECALIB_incr_dly_adrctrl_ma)),
 		READ_REG_FIELD(PHY_DLL_RECALIB, PHY_DLL_RECALIB_dlls_trim_adrctrl_ma));
@@ -722,7 +661,7 @@ DEFS_STATUS ddr_phy_cfg1 (DDR_Setup  *ddr_setup)
 
 		if (!timeout)
 		{
-			HAL_PRINT(KRED "\t>MC phy init ZQ calib to. UNIQUIFY_IO_1  %#010lx\n" KNRM, REG_READ(UNIQUIFY_IO_1));
+			HAL_PRINT_ERR(KRED "\t>MC phy init ZQ calib to. UNIQUIFY_IO_1  %#010lx\n" KNRM, REG_READ(UNIQUIFY_IO_1));
 			break;
 		}
 		timeout--;
@@ -749,7 +688,7 @@ DEFS_STATUS ddr_phy_cfg1 (DDR_Setup  *ddr_setup)
 
 		if (!timeout)
 		{
-			HAL_PRINT(KRED "\t>MC phy init ZQ calib to. UNIQUIFY_IO_1  %#010lx\n" KNRM, REG_READ(UNIQUIFY_IO_1));
+			HAL_PRINT_ERR(KRED "\t>MC phy init ZQ calib to. UNIQUIFY_IO_1  %#010lx\n" KNRM, REG_READ(UNIQUIFY_IO_1));
 			break;
 
 		}
@@ -847,7 +786,7 @@ DEFS_STATUS ddr_phy_cfg1 (DDR_Setup  *ddr_setup)
 
 		if (!timeout)
 		{
-			HAL_PRINT(KRED "\t>UNQ_ANALOG_DLL_2 ZQ calib to. UNQ_ANALOG_DLL_2  %#010lx\n" KNRM, REG_READ(UNQ_ANALOG_DLL_2));
+			HAL_PRINT_ERR(KRED "\t>UNQ_ANALOG_DLL_2 ZQ calib to. UNQ_ANALOG_DLL_2  %#010lx\n" KNRM, REG_READ(UNQ_ANALOG_DLL_2));
 			break;
 
 		}
@@ -434,7 +434,6 @@ void vref_dq_training_ddr4 (DDR_Setup *ddr_setup)
 	const UINT8 MAX_VREF_TRIM_PHY = 126;  // Max VREF trim value supported by PHY selected based on pull down or pull up ODT
 			                              // Because UVREF supports 2 trim ranges depending on pull down or pull up ODT
 	const UINT8 SWEEP_LIMIT = 73;		   // Total number of unique VREF trim settings supported by DDR4, including both range 0 and range 1
-	const UINT8 MAX_BEST_VREF_SAVED = 30; // Maximum number of BEST VREF settings that we need to save
 	const UINT32 VREF_TRAINING_ITERATION = 1;
 
 	// ============== SIGNAL LIST =============== //
@@ -450,13 +449,11 @@ void vref_dq_training_ddr4 (DDR_Setup *ddr_setup)
 	UINT32 window_diff; // Difference between the width of '0' and '1' windows - minimizing this difference will result
 			                     // in closest to 50% duty cycle and this is the main goal of VREF training
 	volatile UINT32 best_window_diff_so_far [MEM_STRB_WIDTH] __attribute__((aligned(16))); // Smallest window difference recorded so far at any VREF setting per byte lane
-	volatile UINT32 all_best_vref_matches [MEM_STRB_WIDTH][MAX_BEST_VREF_SAVED * VREF_TRAINING_ITERATION] __attribute__((aligned(16))); // ALL VREF settings that result in smallest window difference
-	volatile UINT32 all_common_best_vref_matches[MAX_BEST_VREF_SAVED*VREF_TRAINING_ITERATION] __attribute__((aligned(16))); // ALL VREF settings that result in smallest window difference
-	volatile UINT32 bucket_common_vref[MAX_VREF_TRIM_PHY] __attribute__((aligned(16)));
+	UINT32 highest_best_vref[MEM_STRB_WIDTH]; // Highest VREF setting that gave the smallest window difference, per byte lane
+	UINT32 lowest_best_vref[MEM_STRB_WIDTH];  // Lowest VREF setting that gave the smallest window difference, per byte lane
 
 	UINT32 highest_best_vref_val; // If multiple VREF settings gave the smallest window difference, the highest of those
 	UINT32 lowest_best_vref_val;  // If multiple VREF settings gave the smallest window difference, the lowest of those
-	volatile UINT32 num_best_vref_matches[MEM_STRB_WIDTH] __attribute__((aligned(16))); // Total number of VREF settings that give the smallest window difference
 
 	double vref_mid_level; // VREF mid level of high and low DC levels calculated based on ODT & Drive strength
 
@@ -470,26 +467,13 @@ void vref_dq_training_ddr4 (DDR_Setup *ddr_setup)
 
 	HAL_PRINT("MC Vref training\n");
 
-	for (unsigned int j = 0; j < (MAX_BEST_VREF_SAVED * VREF_TRAINING_ITERATION); j++ )
-	{
-		all_common_best_vref_matches[j] = 0xFFFFFFFF;
-		for (int i = 0; i < MEM_STRB_WIDTH; i++) 
-		{
-			all_best_vref_matches[i][j] = 0;
-		}
-	}
 	for (int i = 0; i < MEM_STRB_WIDTH; i++) 
 	{
-		num_best_vref_matches[i]= 0;
 		for (int j = 0; j < MAX_VREF_VAL; j++) 
 		{
 			bucket_save_diff_lane[i][j] = 0;
 		}
 	}
-	for (int i = 0; i < MAX_VREF_TRIM_PHY; i++) 
-	{
-		bucket_common_vref[i]= 0;
-	}
 
 	HAL_PRINT_DBG("SOC:  drive %d odt %d ; DRAM: drive %d odt %d \n",
 		ddr_setup->soc_drive, ddr_setup->soc_odt, ddr_setup->dram_drive, ddr_setup->dram_odt );
@@ -530,7 +514,8 @@ void vref_dq_training_ddr4 (DDR_Setup *ddr_setup)
 /**/
 	for (lane = 0; lane < MEM_STRB_WIDTH; lane++) {
 			best_window_diff_so_far[lane] = 255; // Set initial value prior to training
-			num_best_vref_matches[lane] = 0;
+			highest_best_vref[lane] = 0x0;
+			lowest_best_vref[lane] = 0x7F;
 			for (int j = 0; j < MAX_VREF_TRIM_PHY; j++)
 				bucket_save_diff_lane[lane][j] = 0xAA;
 	}
@@ -613,21 +598,20 @@ void vref_dq_training_ddr4 (DDR_Setup *ddr_setup)
 
 				if(current_vref > 255)
 				{
-					HAL_PRINT(KRED "Current VREF was expected to be less than 255 0x%x\n" KNRM, current_vref);
+					HAL_PRINT_ERR(KRED "Current VREF was expected to be less than 255 0x%x\n" KNRM, current_vref);
 				}
 				// Check if window_diff we got is the best so far and if so save the information for later evaluation
 				if (window_diff < best_window_diff_so_far[lane])
 				{
 					best_window_diff_so_far[lane] = window_diff;
-					all_best_vref_matches[lane][0] = (UINT8)current_vref;
-					num_best_vref_matches[lane] = 1;
+					highest_best_vref[lane] = current_vref;
+					lowest_best_vref[lane] = current_vref;
 					// HAL_PRINT_DBG("\tlane%d CURRENT BEST VREF :0x%lx \t", lane, current_vref);
 				}
-				else if ((window_diff == best_window_diff_so_far[lane]) &&
-					(num_best_vref_matches[lane] < MAX_BEST_VREF_SAVED))
+				else if (window_diff == best_window_diff_so_far[lane])
 				{
-					all_best_vref_matches[lane][num_best_vref_matches[lane]] = (UINT8)current_vref;
-					num_best_vref_matches[lane] = num_best_vref_matches[lane] + 1;
+					highest_best_vref[lane] = MAX(highest_best_vref[lane], current_vref);
+					lowest_best_vref[lane] = MIN(lowest_best_vref[lane], current_vref);
 				}
 				bucket_save_diff_lane[lane % MEM_STRB_WIDTH][current_vref % MAX_VREF_VAL] = window_diff;
 			}
@@ -640,15 +624,11 @@ void vref_dq_training_ddr4 (DDR_Setup *ddr_setup)
 	}
 	// print_full_window_diffs();
 
-	// Iterate over ALL VREF settings that gave smallest window_diff in each lane to find the highest and lowest such VREF value for each lane
+	// The highest and lowest VREF settings that gave the smallest window_diff in each lane were kept during the sweep
 	for (lane = 0; lane < MEM_STRB_WIDTH; lane++) {
 		HAL_PRINT_DBG(KCYN "> BMC VREF (read): lane%d: " KNRM, lane);
-		highest_best_vref_val = 0x0;
-		lowest_best_vref_val = 0x7F;
-		for (UINT32 i = 0; i < num_best_vref_matches[lane]; i++) {
-			highest_best_vref_val = all_best_vref_matches[lane][i] > highest_best_vref_val ? all_best_vref_matches[lane][i] : highest_best_vref_val;
-			lowest_best_vref_val  = all_best_vref_matches[lane][i] < lowest_best_vref_val  ? all_best_vref_matches[lane][i] : lowest_best_vref_val;
-		}
+		highest_best_vref_val = highest_best_vref[lane];
+		lowest_best_vref_val = lowest_best_vref[lane];
 
 		current_vref = highest_best_vref_val; // Convert from unsigned char to unsigned int to avoid overflow on following line
 		current_vref = (current_vref + lowest_best_vref_val) >> 1; // Find midpoint of highest_best_vref_val and lowest_best_vref_val
@@ -689,7 +669,7 @@ void vref_dq_training_ddr4 (DDR_Setup *ddr_setup)
 	{
 		HAL_PRINT_DBG("* Bit leveling passed on all lanes for the read side");
 	} else {
-		HAL_PRINT(KRED "* ERROR! Bit leveling failed for the read side! Lanes failed(1=fail): 0x%lx \n \n" KNRM, READ_REG_FIELD(DYNAMIC_BIT_LVL, DYNAMIC_BIT_LVL_bit_lvl_failure_status) );
+		HAL_PRINT_ERR(KRED "* ERROR! Bit leveling failed for the read side! Lanes failed(1=fail): 0x%lx \n \n" KNRM, READ_REG_FIELD(DYNAMIC_BIT_LVL, DYNAMIC_BIT_LVL_bit_lvl_failure_status) );
 	}
 
 
@@ -744,7 +724,8 @@ void vref_dq_training_ddr4 (DDR_Setup *ddr_setup)
 
 	for (lane = 0; lane < MEM_STRB_WIDTH; lane = lane + 1) {
 		best_window_diff_so_far[lane] = 255; // Set initial value prior to training
-		num_best_vref_matches[lane] = 0;
+		highest_best_vref[lane] = 0x0;
+		lowest_best_vref[lane] = 0x7F;
 		for (int j = 0; j < MAX_VREF_TRIM_PHY; j++)
 			bucket_save_diff_lane[lane][j] = 0xAA;
 	}
@@ -816,26 +797,26 @@ void vref_dq_training_ddr4 (DDR_Setup *ddr_setup)
 					// Check if window_diff we got is the best so far and if so save the information for later evaluation
 					if (current_vref > 255)
 					{
-						HAL_PRINT(KRED "Current VREF was expected to be less than 255 0x%x\n" KNRM, temp1);
+						HAL_PRINT_ERR(KRED "Current VREF was expected to be less than 255 0x%x\n" KNRM, temp1);
 					}
 
 #if 1 // TEST_METHOD
 					if (window_diff <= 2)
 					{
-						all_best_vref_matches[lane][num_best_vref_matches[lane]] = (UINT8)current_vref;
-						num_best_vref_matches[lane]++;
+						highest_best_vref[lane] = MAX(highest_best_vref[lane], current_vref);
+						lowest_best_vref[lane] = MIN(lowest_best_vref[lane], current_vref);
 					}
 #else
 
 					if (window_diff < best_window_diff_so_far[lane]) {
 						best_window_diff_so_far[lane] = window_diff;
-						all_best_vref_matches[lane][0] = (UINT8)current_vref;
-						num_best_vref_matches[lane] = 1;
+						highest_best_vref[lane] = current_vref;
+						lowest_best_vref[lane] = current_vref;
 						HAL_PRINT_DBG("CURRENT BEST VREF write side :%d Lane %d\n", current_vref, lane);
 					}
-					else if ((window_diff == best_window_diff_so_far[lane]) && (num_best_vref_matches[lane] < MAX_BEST_VREF_SAVED)) {
-						all_best_vref_matches[lane][num_best_vref_matches[lane]] = (UINT8)current_vref;
-						num_best_vref_matches[lane] = num_best_vref_matches[lane] + 1;
+					else if (window_diff == best_window_diff_so_far[lane]) {
+						highest_best_vref[lane] = MAX(highest_best_vref[lane], current_vref);
+						lowest_best_vref[lane] = MIN(lowest_best_vref[lane], current_vref);
 					}
 #endif
 					bucket_save_diff_lane[lane][current_vref % MAX_VREF_VAL] = window_diff;
@@ -855,55 +836,16 @@ void vref_dq_training_ddr4 (DDR_Setup *ddr_setup)
 	highest_best_vref_val = 0x0;
 	lowest_best_vref_val = 0x7F;
 	// print_full_window_diffs();
-#ifdef TEST_METHOD
-	for (int i = 0; i < MAX_VREF_TRIM_PHY; i++) 
-	{
-		bucket_common_vref[i] = 0;
-	}
-
-	int num_common_vref_best = 0;
-	for (int i = 0; i < num_best_vref_matches[0]; i++)
-	{
-		for (int j = 0; j < num_best_vref_matches[1]; j++)
-		{
-			if (all_best_vref_matches[1][j] == all_best_vref_matches[0][i])
-			{
-				// Common Value!
-				bucket_common_vref[all_best_vref_matches[0][i]] = 1;
-
-				// Start at next position next time
 
-				// We'll break at next  loop
-			}
-
-		}
-
-	}
-	HAL_PRINT_DBG("Best VREF Values:\t");
-	for (int i = 0; i < MAX_VREF_TRIM_PHY; i++)
-	{
-		if (bucket_common_vref[i] == 1)
-		{
-			all_common_best_vref_matches[num_common_vref_best++] = i;
-			HAL_PRINT_DBG("%d,\t",i );
-		}
-	}
-	num_common_vref_best = (num_common_vref_best % 2) + (num_common_vref_best >> 1) -1;
-	HAL_PRINT_DBG("\nCurrent VREF %d\n", all_common_best_vref_matches[num_common_vref_best]);
-	current_vref = all_common_best_vref_matches[num_common_vref_best];
-#else
-	// Iterate over ALL VREF settings that gave smallest window_diff in each lane to find the highest and lowest such VREF value across all lanes
+	// The highest and lowest VREF settings that gave a small window_diff, across all lanes
 	for (lane = 0; lane < MEM_STRB_WIDTH; lane = lane + 1) {
-		for (UINT32 i = 0; i < num_best_vref_matches[lane]; i = i + 1) {
-			highest_best_vref_val = all_best_vref_matches[lane][i] > highest_best_vref_val ? all_best_vref_matches[lane][i] : highest_best_vref_val;
-			lowest_best_vref_val  = all_best_vref_matches[lane][i] < lowest_best_vref_val  ? all_best_vref_matches[lane][i] : lowest_best_vref_val;
-		}
+		highest_best_vref_val = MAX(highest_best_vref_val, highest_best_vref[lane]);
+		lowest_best_vref_val  = MIN(lowest_best_vref_val, lowest_best_vref[lane]);
 	}
 
 	// Convert from unsigned char to unsigned int to avoid overflow on following line
 	current_vref = highest_best_vref_val;
 	current_vref = (current_vref + lowest_best_vref_val) >> 1;
-#endif
 
 
 
@@ -913,7 +855,7 @@ void vref_dq_training_ddr4 (DDR_Setup *ddr_setup)
 	// Debug - add error in case VREF is hiher than 65 - becuase it is most likely didnt pass any VREF value
 	if (current_vref >= 65)
 	{
-		HAL_PRINT(KRED "Note: VREF value set to %d (0x%x) which is too high!\n" KNRM, current_vref, current_vref);
+		HAL_PRINT_ERR(KRED "Note: VREF value set to %d (0x%x) which is too high!\n" KNRM, current_vref, current_vref);
 	}
 	setup_vref_training_registers_(ddr_setup, current_vref);
 
@@ -1102,7 +1044,7 @@ void run_bit_leveling (void)
 	}
 	else
 	{
-		 HAL_PRINT(KRED "##### Bit leveling failed for the read side! Lanes failed(1=fail) status: 0x%lx \n \n",
+		 HAL_PRINT_ERR(KRED "##### Bit leveling failed for the read side! Lanes failed(1=fail) status: 0x%lx \n \n" KNRM,
 		 	READ_REG_FIELD( DYNAMIC_BIT_LVL, DYNAMIC_BIT_LVL_bit_lvl_failure_status));
 		 HAL_PRINT_DBG( "\n\n##### Error in ddr_phy_cfg2 @ Read bit leveling \n" KNRM);
 		 // REG_WRITE( ERROR_DB_BASE_ADDR + 2*0x4, (1<<16) | (0xDEAD) );
@@ -1146,7 +1088,7 @@ void run_bit_leveling (void)
 		    HAL_PRINT_DBG( "##### Bit leveling passed on all lanes for the write side \n" );
 		    // REG_WRITE( ERROR_DB_BASE_ADDR + 3*0x4, (3<<16) | (0xCAFE) );
 		 } else {
-		    HAL_PRINT(KRED "##### Bit leveling failed for the write side! Lanes failed(1=fail): DYNAMIC_WRITE_BIT_LVL_bit_lvl_wr_failure_status =  0x%lx \n \n" KNRM,
+		    HAL_PRINT_ERR(KRED "##### Bit leveling failed for the write side! Lanes failed(1=fail): DYNAMIC_WRITE_BIT_LVL_bit_lvl_wr_failure_status =  0x%lx \n \n" KNRM,
 		    	READ_REG_FIELD(DYNAMIC_WRITE_BIT_LVL, DYNAMIC_WRITE_BIT_LVL_bit_lvl_wr_failure_status) );
 		    //   dut_error( "##### Error in ddr_phy_cfg2 @ Write bit leveling!!" );
 		 }
@@ -1214,6 +1156,11 @@ DEFS_STATUS ddr_phy_cfg2 (DDR_Setup *ddr_setup)
 #endif
 
 	// Call VREF training
+#ifdef BOOTBLOCK_DDR_TRAINING_CACHE
+	if (mc_training_restore != NULL)
+		MC_RestoreVref_l(ddr_setup, mc_training_restore);
+	else
+#endif
 	vref_dq_training_ddr4(ddr_setup);
 
 
@@ -1255,7 +1202,7 @@ DEFS_STATUS ddr_phy_cfg2 (DDR_Setup *ddr_setup)
 		HAL_PRINT_DBG( "##### SCL passed for all lanes \n" );
 
 	} else {
-		HAL_PRINT(KRED  "##### ERROR! SCL failed \n" );
+		HAL_PRINT_ERR(KRED  "##### ERROR! SCL failed \n" KNRM);
 		HAL_PRINT_DBG( "(0=fail): SCL_START_cuml_scl_rslt : 0x%lx\n \n" KNRM,
 			READ_REG_FIELD(SCL_START, SCL_START_cuml_scl_rslt) );
 		status = DEFS_STATUS_FAIL;
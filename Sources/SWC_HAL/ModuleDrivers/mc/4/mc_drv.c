@@ -25,38 +25,22 @@
 #include <stdlib.h>
 #include <string.h>
 
-#if (defined(DEBUG_LOG) || defined(DEV_LOG))
-#define HAL_PRINT_DBG(...)          \
-	{                               \
-		if (bPrint)                 \
-		{                           \
-			HAL_PRINT(__VA_ARGS__); \
-		}                           \
-	}
-#else
-#define HAL_PRINT(x, ...) (void)0
-#define HAL_PRINT_DBG(x, ...) (void)0
+/*---------------------------------------------------------------------------------------------------------*/
+/* Prints of this driver are logged as the MC module, the PHY training as the PHY module (HAL_LOG in       */
+/* hal_cfg.h). HAL_PRINT_DBG prints only when print_enable is set in the header                            */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          MC
 #endif
 
-void *
-memset(void *dest, int val, size_t len)
-{
-	volatile unsigned char *ptr = dest;
-	while (len-- > 0)
-		*ptr++ = val;
-	return dest;
-}
-
-void *
-memcpy(void *dest, const void *src, size_t len)
-{
-	volatile char *d = dest;
-	const char *s = src;
-	while (len--)
-		*d++ = *s++;
-	return dest;
-}
-
+#ifdef BOOTBLOCK_LOG_BINARY
+/*---------------------------------------------------------------------------------------------------------*/
+/* Training prints (sweep tables, register dumps) are logged as binary records, also in production         */
+/*---------------------------------------------------------------------------------------------------------*/
+#undef  HAL_LOG_OUT
+#define HAL_LOG_OUT             serial_log_bin
+#endif
 
 #define BOOTBLOCK_IMAGE_START __bootblock_start
 #define BOOTBLOCK_IMAGE_END __bootblock_end
@@ -64,7 +48,6 @@ memcpy(void *dest, const void *src, size_t len)
 #define NUM_OF_LANES_MAX 2
 
 static unsigned int NUM_OF_LANES = 2;
-BOOLEAN bPrint;
 
 // Note:
 // PHY is set to VREF_STARTPOINT value. This is a tyical value for DDR_DRV_DQ_48R with PHY_ODT_DQ_120R. VREF training will later-on look for the optimal value.
@@ -75,7 +58,6 @@ BOOLEAN bPrint;
 #define VREF_STARTPOINT (0x7 | (1)) // @ range 1 it value is 65% of DRAM Voltage.
 
 static void                 Run_Memory_SI_Test        (DDR_Setup *ddr_setup);
-static void                 FindMidBiggestEyeBitwise_l(const UINT16 *SweepDataBuff, const int BuffSize, volatile int *pEyeCenter, volatile int *pEyeSize, int bits);
 static DEFS_STATUS          MC_ConfigureDDR_l         (DDR_Setup *ddr_setup, unsigned int try );
 static void                 MC_PrintLeveling          (BOOLEAN bIn, BOOLEAN bOut);
 static void                 MC_write_mr_regs_all      (void);
@@ -91,6 +73,17 @@ static void                 MC_PrintTrim              (BOOLEAN bIn, BOOLEAN bOut
 static void                 MC_BIST_Init_DRAM_mem     (UINT32 start_address, UINT64 size, UINT32 dataPattern);
 static void                 setup_registers_MRS       (UINT32 index, UINT32 data, DDR_Setup *ddr_setup );
 static char                 MC_SignToChar             (UINT32 val);
+#ifdef BOOTBLOCK_DDR_TRAINING_CACHE
+static void                 MC_SaveTraining_l         (DDR_Setup *ddr_setup, MC_TRAINING_DATA_T *data);
+static void                 MC_RestoreVref_l          (DDR_Setup *ddr_setup, const MC_TRAINING_DATA_T *data);
+static void                 MC_RestoreTrim_l          (const MC_TRAINING_DATA_T *data);
+static BOOLEAN              MC_RejectTraining_l       (void);
+
+static const MC_TRAINING_DATA_T *mc_training_restore = NULL;   // state to restore instead of training
+static MC_TRAINING_DATA_T        mc_training_data;             // state of the last full training
+static BOOLEAN                   mc_training_valid = FALSE;
+static BOOLEAN                   mc_training_rejected = FALSE; // the restored state failed a DDR test
+#endif
 
 static UINT32 volatile g_fail_rate_0;
 static UINT32 volatile g_fail_rate_1;
@@ -110,10 +103,25 @@ static UINT32 volatile g_fail_rate_1;
 #define TWOS_COMP_7BIT_VALUE_TO_REG(x) (((UINT32)(((x) >= 0) ? (0x40 | (x)) : (-(x))) & 0x7F))
 
 #include "arbel_mc_init.c"
+
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          PHY
+#endif
+#include "mc_drv_eye.c"
+#include "mc_drv_ptrn.c"
+#include "mc_drv_sweep_run.c"
 #include "mc_drv_sweeps.c"
 #include "ddr_phy_cfg1.c"
 #include "ddr_phy_cfg2.c"
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          MC
+#endif
+
 #include "mc_drv_mem_test.c"
+#include "mc_drv_size.c"
+#include "mc_drv_train_cache.c"
 
 /*---------------------------------------------------------------------------------------------------------*/
 /* Function:        MC_ClearInterrupts                                                                     */
@@ -201,7 +209,8 @@ DEFS_STATUS MC_ConfigureDDR(DDR_Setup *ddr_setup)
 
 	ddr_setup->cpu_clk = CLK_GetCPUFreq();
 
-	bPrint = (BOOLEAN)(ddr_setup->print_enable > 0);
+	HAL_LOG_SetLevel(MC, (ddr_setup->print_enable > 0) ? HAL_LOG_DBG : HAL_LOG_INFO);
+	HAL_LOG_SetLevel(PHY, (ddr_setup->print_enable > 0) ? HAL_LOG_DBG : HAL_LOG_INFO);
 
 	HAL_PRINT(KGRN "MC init\n" KNRM);
 
@@ -245,12 +254,33 @@ DEFS_STATUS MC_ConfigureDDR(DDR_Setup *ddr_setup)
 
 	HAL_PRINT("\n\n ****** DDR4 Init mc_config = %#010lx \n", ddr_setup->mc_config);
 
+#ifdef BOOTBLOCK_DDR_TRAINING_CACHE
+	// characterization sweeps need the full training
+	mc_training_valid = FALSE;
+	mc_training_rejected = FALSE;
+	if ((ddr_setup->mc_config & MC_CAPABILITY_SWEEP_ENABLE) || (ddr_setup->sweep_debug != 0))
+		mc_training_restore = NULL;
+
+	// a restored training that fails any of the DDR tests below is rejected and the DDR is trained again
+retrain:
+#endif
+
 	status = MC_ConfigureDDR_l(ddr_setup, try);
 
+#ifdef BOOTBLOCK_DDR_TRAINING_CACHE
+	if ((status != DEFS_STATUS_OK) && MC_RejectTraining_l())
+	{
+		try++;
+		goto retrain;
+	}
+#endif
+
 	// TODO: SDRAM_PrintRegs(); // Only when MC was init. When MC was not init, can't read/write MR registers.
 	HAL_PRINT_DBG("\n\n");
 
+	BOOT_TRACE_Begin(BOOT_TRACE_DDR_SIZE, 0);
 	ddr_setup->ddr_size = MC_CheckDramSize(ddr_setup);
+	BOOT_TRACE_End(BOOT_TRACE_DDR_SIZE, 0);
 	MC_UpdateDramSize(ddr_setup, ddr_setup->ddr_size);
 
 	if (status == DEFS_STATUS_OK) // ddr_setup->ddr_size != 0)
@@ -258,9 +288,19 @@ DEFS_STATUS MC_ConfigureDDR(DDR_Setup *ddr_setup)
 		HAL_PRINT("size detected OK\n");
 
 
-		error = MC_mem_test_long(1, 0, _128KB_, TRUE);	
+		BOOT_TRACE_Begin(BOOT_TRACE_DDR_MEM_TEST, 1);
+		error = MC_mem_test_long(ddr_setup, _128KB_, MC_MEM_TEST_FULL);
+		BOOT_TRACE_End(BOOT_TRACE_DDR_MEM_TEST, 1);
 		HAL_PRINT("mem_test1=0x%x\n", error);
 
+#ifdef BOOTBLOCK_DDR_TRAINING_CACHE
+		if ((error != 0) && MC_RejectTraining_l())
+		{
+			try++;
+			goto retrain;
+		}
+#endif
+
 		if (error == 0)
 		{
 			status = DEFS_STATUS_OK;
@@ -269,7 +309,7 @@ DEFS_STATUS MC_ConfigureDDR(DDR_Setup *ddr_setup)
 	}
 	else
 	{
-		HAL_PRINT(KRED "training fail\n" KNRM);
+		HAL_PRINT_ERR(KRED "training fail\n" KNRM);
 		MC_PrintRegs();
 		MC_PrintPhy();
 		return status;
@@ -279,7 +319,9 @@ done:
 
 	if (ddr_setup->ECC_enable)
 	{
+		BOOT_TRACE_Begin(BOOT_TRACE_DDR_BIST_INIT, 0);
 		MC_ECC_Init_l(ddr_setup);
+		BOOT_TRACE_End(BOOT_TRACE_DDR_BIST_INIT, 0);
 	}
 
 	MC_ClearInterrupts();
@@ -291,9 +333,33 @@ done:
 				  ddr_setup->ECC_enable ? "Enable" : "Disable",
 				  ddr_setup->ddr_ddp ? "DDP" : "SDP");
 
-		error = MC_mem_test_long(2, 0, _128KB_, TRUE);
+		// The whole DRAM is tested only on request (header mc_config): the quick test costs
+		// MC_MEM_TEST_QUICK_US of boot time, the full one seconds
+		BOOT_TRACE_Begin(BOOT_TRACE_DDR_MEM_TEST, 2);
+		if (ddr_setup->mc_config & MC_CAPABILITY_MEM_TEST_FULL)
+		{
+			error = MC_mem_test_long(ddr_setup, ddr_setup->ddr_size, MC_MEM_TEST_FULL);
+		}
+		else if (ddr_setup->mc_config & MC_CAPABILITY_MEM_TEST_QUICK)
+		{
+			error = MC_mem_test_long(ddr_setup, ddr_setup->ddr_size, MC_MEM_TEST_QUICK);
+		}
+		else
+		{
+			error = MC_mem_test_long(ddr_setup, _128KB_, MC_MEM_TEST_FULL);
+		}
+		BOOT_TRACE_End(BOOT_TRACE_DDR_MEM_TEST, 2);
 
 		HAL_PRINT("mem_test2=0x%x\n", error);
+
+#ifdef BOOTBLOCK_DDR_TRAINING_CACHE
+		if ((error != 0) && MC_RejectTraining_l())
+		{
+			try++;
+			goto retrain;
+		}
+#endif
+
 		if ((error == 0) && ddr_setup->b_gpio_test_pass)
 		{
 			GPIO_Write(ddr_setup->mc_gpio_test_pass, ddr_setup->mc_gpio_test_pass_active_low);
@@ -308,16 +374,18 @@ done:
 
 		if (ddr_setup->ECC_enable == FALSE)
 		{
+			BOOT_TRACE_Begin(BOOT_TRACE_DDR_BIST_INIT, 0);
 			MC_BIST_Init_DRAM_mem(0x0, ddr_setup->ddr_size, 0x14000000);
+			BOOT_TRACE_End(BOOT_TRACE_DDR_BIST_INIT, 0);
 		}
 	}
 	else
 	{
 		MC_PrintRegs();
 		MC_PrintPhy();
-		HAL_PRINT(KRED "\n****************************\n" KNRM);
-		HAL_PRINT(KRED "*** Your SDRAM is Faulty ***\n" KNRM);
-		HAL_PRINT(KRED "****************************\n" KNRM);
+		HAL_PRINT_ERR(KRED "\n****************************\n" KNRM);
+		HAL_PRINT_ERR(KRED "*** Your SDRAM is Faulty ***\n" KNRM);
+		HAL_PRINT_ERR(KRED "****************************\n" KNRM);
 	}
 
 	MC_ClearInterrupts();
@@ -336,6 +404,10 @@ done:
 	REG_WRITE(DENALI_CTL_157, 0);
 	REG_WRITE(DENALI_CTL_1305, 0);
 
+#ifdef BOOTBLOCK_DDR_TRAINING_CACHE
+	mc_training_restore = NULL;
+#endif
+
 	HAL_PRINT_DBG(KNRM "\nmc_init done\n");
 	SET_REG_FIELD(INTCR2, INTCR2_MC_INIT, 1);
 
@@ -387,109 +459,6 @@ static void MC_ClearOutOfRangeInt(void)
 	tmp = REG_READ(DENALI_CTL_160);
 }
 
-#define MC_SIZE_FAIL 0xFFFFFFFFLL
-/*---------------------------------------------------------------------------------------------------------*/
-/* Function:        MC_CheckWrapAround                                                                     */
-/*                                                                                                         */
-/* Parameters:                                                                                             */
-/*                  bank_diff -                                                                            */
-/*                  col_diff -                                                                             */
-/*                  ddr_setup -                                                                            */
-/*                  row_diff -                                                                             */
-/*                                                                                                         */
-/* Returns:         size of DRAM or MC_SIZE_FAIL - if there is a wraparound at 0x1000                      */
-/* Side effects:                                                                                           */
-/* Description:                                                                                            */
-/*                  This routine checks for wrap around to detect size of DRAM                             */
-/*---------------------------------------------------------------------------------------------------------*/
-UINT64 MC_CheckWrapAround(DDR_Setup *ddr_setup, int bank_diff, int row_diff, int col_diff)
-{
-	UINT64 shift = 0;		// 1GB value.
-	UINT64 shift_limit = 0; // 1K ==> 2GB value.
-	const UINT64 MEM_CHECK_DATA = 0xFEDCBA987654321LL;
-	const UINT64 MEM_CHECK_ADDR = 0x8000LL;
-
-	volatile UINT64 address = 0;
-	UINT64 orig_data = MEMR64(MEM_CHECK_ADDR);
-	BOOLEAN bFoundWrap = FALSE;
-
-	MC_ClearInterrupts();
-
-	// Set BANK Diff before testing
-	MC_SetBankRowCol(bank_diff, row_diff, col_diff);
-
-	shift_limit = LOG(ddr_setup->max_ddr_size / _128MB_);
-
-	HAL_PRINT_DBG("\n\n>MC: check DRAM size for configuration: BANK diff %d, ROW diff %d, COL diff %d, max_shift %d, max_size %#010lx\n",
-				  bank_diff, row_diff, col_diff, shift_limit, ddr_setup->max_ddr_size);
-
-	// Special case for DDP because the pseudo-wrap is at 4K
-	address = 0x1010;
-	MEMW64(0x10, MEM_CHECK_DATA); // write data
-	HAL_PRINT_DBG("Check if data is mirrored at address %#010lx\n", address);
-
-	// check if the data is mirrored at address
-	if (MEMR64(address) == MEM_CHECK_DATA)
-	{
-		HAL_PRINT_DBG("data is mirrored at address %#010lx\n", address);
-		MEMW64(0x10, ~MEM_CHECK_DATA); // write the reversed data
-
-		// check if the reversed data is mirrored at address
-		if (MEMR64(address) == ~MEM_CHECK_DATA)
-		{
-			HAL_PRINT_DBG("DDP Wrap around shift %u BANK %d, ROW %d, COL %d address %#010lx\n",
-					  shift, bank_diff, row_diff, col_diff, address);
-			MC_ClearOutOfRangeInt();
-			ddr_setup->ddr_ddp = TRUE;
-			return MC_SIZE_FAIL;
-		}
-	}
-
-	for (shift = 0; shift < shift_limit; shift++)
-	{
-		if (shift < 4)
-		{
-			address = (_128MB_ << shift) + MEM_CHECK_ADDR;
-		}
-		else
-		{
-			// Mapping of address 2G-4G is done thorugh 4G-6G
-			address = 0x100000000ULL + MEM_CHECK_ADDR;
-		}
-
-		MEMW64(MEM_CHECK_ADDR, MEM_CHECK_DATA); // write test data
-
-		HAL_PRINT_DBG("Check if data is mirrored at address %#010lx\n", address);
-
-		// check if the data is mirrored at address
-		if (MEMR64(address) == MEM_CHECK_DATA)
-		{
-			MEMW64(MEM_CHECK_ADDR, ~MEM_CHECK_DATA); // write the reversed data
-
-			// check if the reversed data is mirrored at address
-			if (MEMR64(address) == ~MEM_CHECK_DATA)
-			{
-				HAL_PRINT_DBG("Wrap around shift %u BANK %d, ROW %d, COL %d data is mirrored at address %#010lx\n",
-						  shift, bank_diff, row_diff, col_diff, address);
-				bFoundWrap = TRUE;
-				MC_ClearOutOfRangeInt();
-				break;
-			}
-		}
-	}
-
-	// restore original data
-	MEMW64(MEM_CHECK_ADDR, orig_data);
-	MC_ClearInterrupts();
-	if (bFoundWrap == TRUE)
-	{
-		HAL_PRINT_DBG("wrap found size is  %#010lx BANK %d, ROW %d, COL %d:\n", (_128MB_ << shift), bank_diff, row_diff, col_diff);
-		return (_128MB_ << shift);
-	}
-	HAL_PRINT(KRED "Size is greater then %#010lx  BANK %d, ROW %d, COL %d: \n" KNRM, (_128MB_ << shift_limit), bank_diff, row_diff, col_diff);
-	return (_128MB_ << shift);
-}
-
 /*---------------------------------------------------------------------------------------------------------*/
 /* Function:        MC_CheckDramSize                                                                       */
 /*                                                                                                         */
@@ -502,53 +471,13 @@ UINT64 MC_CheckWrapAround(DDR_Setup *ddr_setup, int bank_diff, int row_diff, int
 UINT64 MC_CheckDramSize(DDR_Setup *ddr_setup)
 {
 	UINT64 ddr_size;
-	UINT64 ddr_size_00;
-	UINT64 ddr_size_11;
-	UINT64 ddr_size_01;
-	UINT64 ddr_size_10;
 	UINT32 gmmap = 0;
 
 	MC_ClearInterrupts();
 
-	HAL_PRINT_DBG("\n\n>MC: check DRAM size:\n");
+	HAL_PRINT_DBG("\n\n>MC: check DRAM size, max size %#010lx:\n", ddr_setup->max_ddr_size);
 
-	/* try all bank options*/
-	ddr_size_01 = MC_CheckWrapAround(ddr_setup, 0, 1, 2);
-	ddr_size_10 = MC_CheckWrapAround(ddr_setup, 1, 0, 2);
-	ddr_size_00 = MC_CheckWrapAround(ddr_setup, 0, 0, 2);
-	ddr_size_11 = MC_CheckWrapAround(ddr_setup, 1, 1, 2);
-
-	HAL_PRINT_DBG(KMAG "\n\n[bank,row,size] 10 %#010lx; 01 %#010lx; 00 %#010lx; 11 %#010lx\n" KNRM, ddr_size_10, ddr_size_01, ddr_size_00, ddr_size_11);
-
-	if (ddr_size_00 == _4GB_)
-	{
-		ddr_size = ddr_size_00;
-		MC_SetBankRowCol(0, 0, 2);
-		ddr_setup->ddr_ddp = TRUE;
-	}
-	else
-	{
-		ddr_size = MIN(ddr_size_11, ddr_size_00);
-
-		if ((ddr_size_10 != MC_SIZE_FAIL) && (ddr_size_10 >= ddr_size))
-		{
-			ddr_size = MAX(ddr_size_10, ddr_size);
-			MC_SetBankRowCol(1, 0, 2);
-			ddr_setup->ddr_ddp = FALSE;
-		}
-		if ((ddr_size_01 != MC_SIZE_FAIL) && (ddr_size_01 >= ddr_size))
-		{
-			ddr_size = MAX(ddr_size_01, ddr_size);
-			MC_SetBankRowCol(0, 1, 2);
-			ddr_setup->ddr_ddp = FALSE;
-		}
-		if ((ddr_size_11 != MC_SIZE_FAIL) && (ddr_size_11 >= ddr_size))
-		{
-			ddr_size = ddr_size_11;
-			MC_SetBankRowCol(1, 1, 2);
-			ddr_setup->ddr_ddp = FALSE;
-		}
-	}
+	ddr_size = MC_SizeSearch_l(ddr_setup);
 
 	HAL_PRINT(KGRN ">DRAM measured size is: %#010lx. max size from header %#010lx\n" KNRM,
 			  ddr_size, ddr_setup->max_ddr_size);
@@ -639,455 +568,25 @@ static void Set_DQS_out_val(int ilane, UINT32 output_val, BOOLEAN bOverride, BOO
 	REG_WRITE(PHY_LANE_SEL, (ilane * DQS_DLY_WIDTH) + 0x900);
 	REG_WRITE(OP_DQ_DM_DQS_BITWISE_TRIM, overide | (0x7F & output_val));
 
-	REG_WRITE(PHY_LANE_SEL, 0);
-
-	// dummy wr\rd ? IOW32(0x1000, IOR32(0x1000));
-}
-
-
-/*---------------------------------------------------------------------------------------------------------*/
-/* Function:    MC_MemStressTest                                                                           */
-/*                                                                                                         */
-/* Parameters:             bECC : if true, mem test is for ECC lane. Can't sweep it directly, must check ber bit*/
-/* Returns:                bitwise error in UINT16 (one UINT8 for each lane)                               */
-/* Side effects:                                                                                           */
-/* Description:                                                                                            */
-/*                        This routine does memory test with a list of patterns. Used for sweep.           */
-/*---------------------------------------------------------------------------------------------------------*/
-UINT16 MC_MemStressTest(BOOLEAN bECC, BOOLEAN bQuick)
-{
-	UINT16 ber = 0;
-
-	const UINT32 aPtrn[6] = {0xFFFFFFFF, 0x00000000, 0x55555555, 0xAAAAAAAA, 0x33333333, 0x99999999};
-	const UINT32 iPtrnSize = 0x100;
-	const UINT iWalkers = 0x10; // NTIL - there is no point to shift 0x0001 more then 16 steps ;
-
-	UINT32 iCnt1 = 0;
-	UINT32 iCnt2 = 0;
-
-	extern UINT32 BOOTBLOCK_IMAGE_START;
-	extern UINT32 BOOTBLOCK_IMAGE_END;
-
-	volatile UINT16 *dstAddrStart = (UINT16 *)0x1000;
-
-	volatile UINT32 *dstAddrStartLong = (UINT32 *)0x1000;
-
-	// dummy access to DRAM:
-	IOW32(0x1000, IOR32(0x1000));
-	REG_WRITE(PHY_LANE_SEL, 0);
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*                    Fixed pattern test                                                               */
-	/*-----------------------------------------------------------------------------------------------------*/
-	for (iCnt1 = 0; iCnt1 < ARRAY_SIZE(aPtrn); iCnt1++)
-	{
-		dstAddrStart = (UINT16 *)0x1000;
-		dstAddrStartLong = (UINT32 *)0x1000;
-		REG_WRITE(DENALI_CTL_145, 0xFFFFFFFF);
-		REG_WRITE(DENALI_CTL_145, 0);
-
-		/*-----------------------------------------------------------------------------------------------------*/
-		/*  Write pattern                                                                                      */
-		/*-----------------------------------------------------------------------------------------------------*/
-		// memset((void *)dstAddrStart, (UINT8)aPtrn[iCnt1], iPtrnSize);
-		for (iCnt2 = 0; iCnt2 < iPtrnSize; iCnt2 += 4)
-		{
-			*dstAddrStartLong = (UINT32)aPtrn[iCnt1];
-
-			// clear all interrupt status bits:
-			REG_WRITE(DENALI_CTL_145, 0xFFFFFFFF);
-			REG_WRITE(DENALI_CTL_145, 0);
-
-			dstAddrStartLong++;
-		}
-
-		dstAddrStart = (UINT16 *)0x1000;
-		dstAddrStartLong = (UINT32 *)0x1000;
-		/*-----------------------------------------------------------------------------------------------------*/
-		/* Verify pattern                                                                                      */
-		/*-----------------------------------------------------------------------------------------------------*/
-		for (iCnt2 = 0; iCnt2 < iPtrnSize; iCnt2 += 2)
-		{
-			if (bECC == TRUE)
-			{
-				ber |= GetECCSyndrom(*dstAddrStart);
-			}
-			else
-			{
-				ber |= *dstAddrStart ^ aPtrn[iCnt1];
-			}
-			dstAddrStart++;
-		}
-
-		if ((iCnt1 == 1) && (bQuick == TRUE))
-		{
-			return ber;
-		}
-
-		if (ber == 0xFFFF)
-		{
-			return ber;
-		}
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Walking-1 pattern test                                                                              */
-	/*-----------------------------------------------------------------------------------------------------*/
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*  Write pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		*dstAddrStart = (0x0001 << (iCnt2));
-		dstAddrStart++;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Verify pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		if (bECC == TRUE)
-		{
-			ber |= GetECCSyndrom(*dstAddrStart);
-		}
-		else
-		{
-			ber |= *dstAddrStart ^ (0x0001 << (iCnt2));
-		}
-		dstAddrStart++;
-	}
-	if (ber == 0xFFFF)
-	{
-		return ber;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Walking-0 pattern test                                                                              */
-	/*-----------------------------------------------------------------------------------------------------*/
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*  Write pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		*dstAddrStart = 0xFFFF - (0x0001 << (iCnt2));
-		dstAddrStart++;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Verify pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		if (bECC == TRUE)
-		{
-			ber |= GetECCSyndrom(*dstAddrStart);
-		}
-		else
-		{
-			ber |= *dstAddrStart ^ (0xFFFF - (0x0001 << (iCnt2)));
-		}
-		dstAddrStart++;
-	}
-	if (ber == 0xFFFF)
-	{
-		return ber;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*                   Walking dead pattern test                                                         */
-	/*-----------------------------------------------------------------------------------------------------*/
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*  Write pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		if ((iCnt2 % 2) == 0)
-		{
-			*dstAddrStart = 0xFFFF - (0x0001 << (iCnt2 / 2));
-		}
-		else
-		{
-			*dstAddrStart = (0x0001 << (iCnt2 / 2));
-		}
-		dstAddrStart++;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Verify pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		if (bECC == TRUE)
-		{
-			ber |= GetECCSyndrom(*dstAddrStart);
-		}
-		else
-		{
-			if ((iCnt2 % 2) == 0)
-			{
-				ber |= *dstAddrStart ^ (0xFFFF - (0x0001 << (iCnt2 / 2)));
-			}
-			else
-			{
-				ber |= *dstAddrStart ^ (0x0001 << (iCnt2 / 2));
-			}
-		}
-		dstAddrStart++;
-	}
-	if (ber == 0xFFFF)
-	{
-		return ber;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*                    Walking dead1 pattern test                                                       */
-	/*-----------------------------------------------------------------------------------------------------*/
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*  Write pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		if ((iCnt2 % 2) == 0)
-		{
-			*dstAddrStart = 0xFFFF;
-		}
-		else
-		{
-			*dstAddrStart = (0x0001 << (iCnt2 / 2));
-		}
-		dstAddrStart++;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Verify pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		if (bECC == TRUE)
-		{
-			ber |= GetECCSyndrom(*dstAddrStart);
-		}
-		else
-		{
-			if ((iCnt2 % 2) == 0)
-			{
-				ber |= *dstAddrStart ^ 0xFFFF;
-			}
-			else
-			{
-				ber |= *dstAddrStart ^ (0x0001 << (iCnt2 / 2));
-			}
-		}
-
-		dstAddrStart++;
-	}
-	if (ber == 0xFFFF)
-	{
-		return ber;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*                     Walking dead2 pattern test                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*  Write pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		if ((iCnt2 % 2) == 0)
-		{
-			*dstAddrStart = 0xFFFF - (0x0001 << (iCnt2 / 2));
-		}
-		else
-		{
-			*dstAddrStart = 0;
-		}
-		dstAddrStart++;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Verify pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		if (bECC == TRUE)
-		{
-			ber |= GetECCSyndrom(*dstAddrStart);
-		}
-		else
-		{
-			if ((iCnt2 % 2) == 0)
-			{
-				ber |= *dstAddrStart ^ (0xFFFF - (0x0001 << (iCnt2 / 2)));
-			}
-			else
-			{
-				ber |= *dstAddrStart ^ 0;
-			}
-		}
-		dstAddrStart++;
-	}
-	if (ber == 0xFFFF)
-	{
-		return ber;
-	}
-
-	// NTIL: move bootblock test to last test since this test take too much time (first it copy then it check)
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*  Use RAM2 as a pseudo random pattern to test the DDR                                                */
-	/*  Copy BB code segment to the DDR                                                                    */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart = (UINT16 *)0x1000;
-
-	for (iCnt2 = 0; iCnt2 < 0x10000 /* (&(UINT32)BOOTBLOCK_IMAGE_END - RAM2_MEMORY_SIZE)*/; iCnt2 += sizeof(UINT16))
-	{
-		*dstAddrStart = *(UINT16 *)(UINT64)(RAM2_BASE_ADDR + iCnt2);
-		dstAddrStart++;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Compare BB code segment to the DDR                                                                  */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart = (UINT16 *)0x1000;
-
-	for (iCnt2 = 0; iCnt2 < 0x10000 /* (&(UINT32)BOOTBLOCK_IMAGE_END - RAM2_MEMORY_SIZE)  */; iCnt2 += sizeof(UINT16))
-	{
-		if (bECC == TRUE)
-		{
-			ber |= GetECCSyndrom(*(UINT16 *)(UINT64)(RAM2_BASE_ADDR + iCnt2));
-		}
-		else
-		{
-			ber |= *dstAddrStart ^ *(UINT16 *)(UINT64)(RAM2_BASE_ADDR + iCnt2);
-		}
-
-		// NTIL: save time and return as soos as posiable when there is total bits error (don't wait to verify to complete)
-		if (ber == 0xFFFF)
-			return ber;
-
-		dstAddrStart++;
-	}
+	REG_WRITE(PHY_LANE_SEL, 0);
 
-	return ber;
+	// dummy wr\rd ? IOW32(0x1000, IOR32(0x1000));
 }
 
 /*---------------------------------------------------------------------------------------------------------*/
-/* Function:        FindMidBiggestEyeBitwise_l                                                             */
+/* Function:    MC_MemStressTest                                                                           */
 /*                                                                                                         */
-/* Parameters:      none                                                                                   */
-/* Returns:                                                                                                */
+/* Parameters:             bECC : if true, mem test is for ECC lane. Can't sweep it directly, must check ber bit*/
+/* Returns:                bitwise error in UINT16 (one UINT8 for each lane)                               */
 /* Side effects:                                                                                           */
 /* Description:                                                                                            */
-/*          This routine finds the middle of the eye on the array received from MC_MemStressTest           */
+/*                        This routine does memory test with a list of patterns (mc_drv_ptrn.c)            */
 /*---------------------------------------------------------------------------------------------------------*/
-
-// TBD: there was a bug in center calculation when there are several eyes !!!.
-static void FindMidBiggestEyeBitwise_l(const UINT16 *SweepDataBuff, const int BuffSize, volatile int *pEyeCenter, volatile int *pEyeSize, int bits)
+UINT16 MC_MemStressTest(BOOLEAN bECC, BOOLEAN bQuick)
 {
-	int start = -1;
-	int stop = -1;
-	int eyeSize = -1;
-
-	int bufInd = 0;
-	int bitInd = 0;
-	int bitStep = 1; // in bitwise sweep find the biggest eye size on every bit.
-	// when sweeping a value that is common to entire lane , like DQS,
-	// use bit zero and bit 8 value of the UINT16 of data buf.
-
-	for (bitInd = 0; bitInd < bits; bitInd += bitStep)
-	{
-		start = -1;
-		stop = -1;
-		eyeSize = -1;
-
-		for (bufInd = 0; bufInd < BuffSize; bufInd++)
-		{
-			if ((SweepDataBuff[bufInd] & ((UINT16)0x0001 << bitInd)) == 0)
-			{ // pass point
-				if (start == (-1))
-				{ // found a good start point
-					start = bufInd;
-					// HAL_PRINT_DBG("[%u",bufInd);
-				}
-			}
-			else
-			{ // fail point
-				if (start != (-1))
-				{ // found fail point (after found a good start point);
-					// HAL_PRINT_DBG("...%u]",bufInd);
-					if ((bufInd - start) > eyeSize)
-					{
-						// new eye size is bigger then last found eye
-						stop = bufInd - 1; // last good point
-						eyeSize = bufInd - start;
-						// HAL_PRINT_DBG("*");
-					}
-					start = -1;
-				}
-			}
-		}
-
-		/*----------------------------------------------------------------------------------------------*/
-		/*      Close an unclosed eyes                                                                  */
-		/*----------------------------------------------------------------------------------------------*/
-		if (start != -1)
-		{
-			// need to close at the end after found a good start point;
-			// HAL_PRINT_DBG("Close the unclosed eyes : bit %u bufInd=%u start=%u\n",bitInd, bufInd, start );
-			if (((BuffSize - 1) - start) > eyeSize)
-			{
-				// new eye size is bigger then last found eye
-				stop = (BuffSize - 1) - 1;
-				eyeSize = (BuffSize - 1) - start;
-				// HAL_PRINT_DBG("*");
-			}
-			start = -1;
-		}
-
-		/*---------------------------------------------------------------------------------------------------------*/
-		/*  write results to pEyeCenter and pEyeSize                                                               */
-		/*---------------------------------------------------------------------------------------------------------*/
-
-		if (eyeSize == (-1))
-		{
-			/*------------------------------------------------------------------------------------------------*/
-			/* No eye                                                                                         */
-			/*------------------------------------------------------------------------------------------------*/
-			// HAL_PRINT(KRED ">lane%u, bit%u: No eye !\n" KNRM , ((bitInd>7)?1:0), (bitInd %8));
-
-			// Clear pEyeCenter and pEyeSize
-			pEyeCenter[bitInd] = -1;
-			pEyeSize[bitInd] = 0;
-		}
-		else
-		{
-			// calculate eye center
-			pEyeSize[bitInd] = eyeSize;
-			pEyeCenter[bitInd] = stop - DIV_CEILING(eyeSize, 2) + 1;
-		}
-		// HAL_PRINT_DBG("\n>lane%u, bit%u: eye=%u center=%u\n", ((bitInd>7)?1:0), (bitInd %8),  pEyeSize[bitInd] , pEyeCenter[bitInd] );
-	}
-
-	return;
+	return MC_PTRN_Run_l((bQuick == TRUE) ? &mc_ptrn_set_short_quick : &mc_ptrn_set_short, bECC, 0);
 }
 
-
 /*---------------------------------------------------------------------------------------------------------*/
 /* Function:        MC_Init_l                                                                              */
 /*                                                                                                         */
@@ -1129,7 +628,7 @@ static DEFS_STATUS MC_Init_l(DDR_Setup *ddr_setup)
 	{
 		if (TimeOut == 0)
 		{
-			HAL_PRINT(KRED ">LOG_ERROR_MC_INIT_TIMEOUT\n" KNRM);
+			HAL_PRINT_ERR(KRED ">LOG_ERROR_MC_INIT_TIMEOUT\n" KNRM);
 			return DEFS_STATUS_FAIL;
 		}
 		TimeOut--;
@@ -1166,53 +665,68 @@ static BOOLEAN MC_IsDDRConfigured_l(void)
 }
 
 /*---------------------------------------------------------------------------------------------------------*/
-/* Function:        MC_BIST_Init_DRAM_mem                                                                  */
+/* DRAM init engine: BIST runs on power of 2 regions from the bottom of the device while the cores fill    */
+/* slices from the top, until they meet. A BIST region is the biggest power of 2 up to MC_BIST_CHUNK_SIZE, */
+/* aligned on its size, that fits in the gap still free; it always has ADDR_SPACE = log2(region size).     */
+/* BIST does not start a region under MC_BIST_MIN_REGION: a device of up to MC_BIST_CHUNK_SIZE is one      */
+/* BIST region with no CPU store, and the CPU fills MC_CPU_INIT_SLICE at a time, so that it is never more  */
+/* than one slice behind BIST. With BOOTBLOCK_MULTICORE_DDR_INIT cores 1-3 fill MC_CORE_INIT_JOB jobs from */
+/* the el3_secondary wait loop; a core that does not take its job has it filled by the primary.            */
+/* MC addresses above 2GB are seen by the CPU at 4GB (upper DRAM window)                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+#define MC_BIST_CHUNK_SIZE          _256MB_
+#define MC_BIST_MIN_REGION          _8MB_
+#define MC_CPU_INIT_SLICE           _1MB_
+#define MC_BIST_POLL_US             10
+#define MC_BIST_TIMEOUT_US          (2 * 1000 * 1000)
+#define MC_DDR_HIGH_BASE_ADDR       0x100000000ULL
+#ifdef BOOTBLOCK_MULTICORE_DDR_INIT
+#define MC_INIT_CORES               CORE_JOB_CORES
+#else
+#define MC_INIT_CORES               1
+#endif
+#define MC_CORE_INIT_JOB            _16MB_      // aligned on its size, never crosses 2GB
+#define MC_CORE_INIT_TIMEOUT_US     (2 * 1000 * 1000)
+
+typedef struct
+{
+	UINT32  dataPattern;
+	UINT64  bist_end;                   /* MC address, BIST regions are below it                            */
+	UINT64  cpu_top;                    /* MC address, the cores filled or are filling from here up          */
+	BOOLEAN bist_busy;
+	UINT32  bist_wait_us;
+	UINT32  bist_regions;
+	UINT32  cpu_slices;                 /* filled by the primary core                                        */
+	UINT32  core_jobs;                  /* filled by cores 1-3                                               */
+	UINT32  core_busy;                  /* cores with a job, bitwise                                         */
+	UINT32  core_absent;                /* cores that did not take their job, bitwise                        */
+	UINT32  core_job[MC_INIT_CORES];    /* job argument: first slice, slices << 16                           */
+	UINT32  core_wait_us[MC_INIT_CORES];
+} MC_INIT_ENGINE_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_BIST_Start_l                                                                        */
 /*                                                                                                         */
 /* Parameters:                                                                                             */
-/*                  DataPattern -   const to write to mem                                                  */
-/*                  Size -                                                                                 */
-/*                  start_address -                                                                        */
+/*                  start_address -  MC address (34 bits), aligned on the region size                      */
+/*                  addrSpace     -  log2 of the region size                                               */
+/*                  dataPattern   -  const to write to mem                                                 */
 /*                                                                                                         */
 /* Returns:         none                                                                                   */
 /* Side effects:                                                                                           */
 /* Description:                                                                                            */
-/*                  This routine init memory regions using BIST                                            */
+/*                  This routine starts BIST memory initialization of one region                           */
 /*---------------------------------------------------------------------------------------------------------*/
-static void MC_BIST_Init_DRAM_mem(UINT32 start_address, UINT64 size, UINT32 dataPattern)
+static void MC_BIST_Start_l(UINT64 start_address, UINT32 addrSpace, UINT32 dataPattern)
 {
-
-	UINT32 ReadData, WriteData;
-
-	UINT32 AddressSpace = LOG(size) + 1;
-
-	volatile UINT32 read, err = 0;
-
-	/* BIST only first 2GB */
-	if (size > _2GB_)
-		AddressSpace = LOG(_2GB_);
-
-	if (size > _2GB_)
-	{
-		HAL_PRINT(KNRM "\nzero upper 2GB\n");
-		for (UINT64 i = 0x100000000; i < 0x100000000 + (size - _2GB_); i += 8)
-		{
-			if ((i % 0x02000000) == 0)
-				HAL_PRINT(".");
-			*(UINT64 *)i = 0;
-		}
-	}
-
-	HAL_PRINT("\nMC: BIST init start=%#010lx size=%#010lx pattern=%#010lx\n",
-			  start_address, size, dataPattern);
-
 	// Clear status register to verify no BIST interrup is pending
 	SET_REG_FIELD(DENALI_CTL_148, DENALI_CTL_148_INT_ACK_BIST, 0xFF);
 
-	// Init BIST address range - in our case - 85 is constant 0
-	REG_WRITE(DENALI_CTL_84, start_address);
-	REG_WRITE(DENALI_CTL_85, 0);
+	// Init BIST address range
+	REG_WRITE(DENALI_CTL_84, (UINT32)start_address);
+	REG_WRITE(DENALI_CTL_85, (UINT32)(start_address >> 32));
 
-	SET_REG_FIELD(DENALI_CTL_83, DENALI_CTL_83_ADDR_SPACE, AddressSpace);
+	SET_REG_FIELD(DENALI_CTL_83, DENALI_CTL_83_ADDR_SPACE, addrSpace);
 	SET_REG_FIELD(DENALI_CTL_83, DENALI_CTL_83_BIST_DATA_CHECK, 1);
 
 	// set BIST_TEST_MODE to memory initialization mode
@@ -1224,21 +738,349 @@ static void MC_BIST_Init_DRAM_mem(UINT32 start_address, UINT64 size, UINT32 data
 
 	// BIST GO
 	SET_REG_FIELD(DENALI_CTL_82, DENALI_CTL_82_BIST_GO, 1);
+}
 
-	// Read status register till interrupt is pending
-	while (READ_REG_FIELD(DENALI_CTL_141, DENALI_CTL_141_INT_STATUS_BIST) == 0)
-	{
-		HAL_PRINT(".");
-		CLK_Delay_MicroSec(10000);
-	}
-	HAL_PRINT("\n");
-	HAL_PRINT_DBG("MC: BIST Completed, status = %#010lx\n\n", READ_REG_FIELD(DENALI_CTL_141, DENALI_CTL_141_INT_STATUS_BIST));
-
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_BIST_Stop_l                                                                         */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine clears BIST GO and the BIST interrupt after a region is done              */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_BIST_Stop_l(void)
+{
 	// BIST GO clear
 	SET_REG_FIELD(DENALI_CTL_82, DENALI_CTL_82_BIST_GO, 0);
 
 	// Clear BIST interrupt
 	SET_REG_FIELD(DENALI_CTL_148, DENALI_CTL_148_INT_ACK_BIST, 0xFF);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_CPU_Init_DRAM_l                                                                     */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  mc_address -  MC address (the range does not cross 2GB)                                */
+/*                  size       -  bytes, multiple of 8                                                     */
+/*                  pattern    -  64 bit pattern                                                           */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine fills a region with 8 bytes aligned stores (full ECC words)               */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_CPU_Init_DRAM_l(UINT64 mc_address, UINT64 size, UINT64 pattern)
+{
+	UINT64 cpu_address = mc_address;
+	UINT64 *p;
+	UINT64 *end;
+
+	if (mc_address >= _2GB_)
+	{
+		cpu_address = MC_DDR_HIGH_BASE_ADDR + (mc_address - _2GB_);
+	}
+
+	p = (UINT64 *)cpu_address;
+	end = (UINT64 *)(cpu_address + size);
+	while (p < end)
+	{
+		*p++ = pattern;
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_Init_Engine_Take_l                                                                  */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  engine -  init engine state                                                            */
+/*                  unit   -  power of 2, MC_CPU_INIT_SLICE or MC_CORE_INIT_JOB                            */
+/*                                                                                                         */
+/* Returns:         MC address of the region taken, it ends at the previous cpu_top                        */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Takes the top of the free gap for a core, down to an unit boundary, not below BIST     */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 MC_Init_Engine_Take_l(MC_INIT_ENGINE_T *engine, UINT32 unit)
+{
+	engine->cpu_top = MAX(engine->bist_end, (engine->cpu_top - 1) & ~(UINT64)(unit - 1));
+
+	return engine->cpu_top;
+}
+
+#ifdef BOOTBLOCK_MULTICORE_DDR_INIT
+extern unsigned int GetCPUID (void);
+#ifdef BOOTBLOCK_CACHED_BOOT
+extern void CleanInvalidateUDCaches (void);
+#define MC_INIT_SYNC()              CleanInvalidateUDCaches()   // cores 1-3 run with the MMU off
+#else
+#define MC_INIT_SYNC()
+#endif
+
+static UINT64 mc_init_pattern;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_Init_Core_Worker_l                                                                  */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Runs on cores 1-3, called from the el3_secondary wait loop. The job argument is the    */
+/*                  first slice and the number of slices << 16                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_Init_Core_Worker_l(void)
+{
+	UINT32 cpu = GetCPUID();
+	UINT32 job = CORE_JOB_Ack(cpu);
+
+	MC_CPU_Init_DRAM_l((UINT64)(job & 0xFFFF) * MC_CPU_INIT_SLICE, (UINT64)(job >> 16) * MC_CPU_INIT_SLICE,
+					   mc_init_pattern);
+
+	CORE_JOB_Done(cpu);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_Init_Core_Fill_l                                                                    */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  engine -  init engine state                                                            */
+/*                  cpu    -  core 1-3 that did not do its job                                             */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  The primary fills the job of the core and does not use the core again. The fill is     */
+/*                  idempotent: a late core stores the same pattern                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_Init_Core_Fill_l(MC_INIT_ENGINE_T *engine, UINT32 cpu)
+{
+	UINT32 job = engine->core_job[cpu];
+
+	engine->core_busy &= ~MASK_BIT(cpu);
+	engine->core_absent |= MASK_BIT(cpu);
+	MC_CPU_Init_DRAM_l((UINT64)(job & 0xFFFF) * MC_CPU_INIT_SLICE, (UINT64)(job >> 16) * MC_CPU_INIT_SLICE,
+					   mc_init_pattern);
+	engine->cpu_slices += job >> 16;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_Init_Core_Service_l                                                                 */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  engine -  init engine state                                                            */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Retire the jobs of cores 1-3 that are done and give a new one to the idle cores        */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_Init_Core_Service_l(MC_INIT_ENGINE_T *engine)
+{
+	UINT32 cpu;
+	UINT64 top;
+	UINT64 bottom;
+
+	for (cpu = 1; cpu < MC_INIT_CORES; cpu++)
+	{
+		if ((engine->core_busy & MASK_BIT(cpu)) && CORE_JOB_IsDone(cpu))
+		{
+			engine->core_busy &= ~MASK_BIT(cpu);
+			engine->core_jobs++;
+		}
+
+		if (((engine->core_busy | engine->core_absent) & MASK_BIT(cpu)) || (engine->cpu_top <= engine->bist_end))
+		{
+			continue;
+		}
+
+		top = engine->cpu_top;
+		bottom = MC_Init_Engine_Take_l(engine, MC_CORE_INIT_JOB);
+		engine->core_job[cpu] = (UINT32)(bottom / MC_CPU_INIT_SLICE) | (UINT32)(((top - bottom) / MC_CPU_INIT_SLICE) << 16);
+		engine->core_wait_us[cpu] = 0;
+		engine->core_busy |= MASK_BIT(cpu);
+
+		CORE_JOB_Dispatch(cpu, MC_Init_Core_Worker_l, engine->core_job[cpu]);
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_Init_Core_Wait_l                                                                    */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  engine -  init engine state                                                            */
+/*                  us     -  time waited since the last call                                              */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Called when the primary has nothing left to fill. A core that does not take its job in */
+/*                  CORE_JOB_ACK_US, or does not finish it in MC_CORE_INIT_TIMEOUT_US, has it filled by    */
+/*                  the primary                                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_Init_Core_Wait_l(MC_INIT_ENGINE_T *engine, UINT32 us)
+{
+	UINT32 cpu;
+
+	for (cpu = 1; cpu < MC_INIT_CORES; cpu++)
+	{
+		if ((engine->core_busy & MASK_BIT(cpu)) == 0)
+		{
+			continue;
+		}
+
+		engine->core_wait_us[cpu] += us;
+		if (!CORE_JOB_IsTaken(cpu))
+		{
+			// take the job back, unless the core took it meanwhile
+			if ((engine->core_wait_us[cpu] < CORE_JOB_ACK_US) || !CORE_JOB_TakeBack(cpu))
+			{
+				continue;
+			}
+
+			HAL_PRINT(KYEL "\nMC: core %d does not answer, DRAM init on core 0\n" KNRM, cpu);
+			MC_Init_Core_Fill_l(engine, cpu);
+		}
+		else if (engine->core_wait_us[cpu] >= MC_CORE_INIT_TIMEOUT_US)
+		{
+			HAL_PRINT_ERR(KRED "\nMC: core %d did not finish its DRAM init\n" KNRM, cpu);
+			CORE_JOB_TakeBack(cpu);
+			MC_Init_Core_Fill_l(engine, cpu);
+		}
+	}
+}
+#endif // BOOTBLOCK_MULTICORE_DDR_INIT
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_Init_Engine_Service_l                                                               */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  engine -  init engine state                                                            */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Retire a finished BIST region and start BIST on the biggest region left in the gap,    */
+/*                  then service cores 1-3                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_Init_Engine_Service_l(MC_INIT_ENGINE_T *engine)
+{
+	UINT64 region;
+
+	if (engine->bist_busy && (READ_REG_FIELD(DENALI_CTL_141, DENALI_CTL_141_INT_STATUS_BIST) != 0))
+	{
+		MC_BIST_Stop_l();
+		engine->bist_busy = FALSE;
+		HAL_PRINT(".");
+	}
+
+	if (!engine->bist_busy)
+	{
+		region = MC_BIST_CHUNK_SIZE;
+		while ((region >= MC_BIST_MIN_REGION) &&
+			   ((region > (engine->cpu_top - engine->bist_end)) || ((engine->bist_end & (region - 1)) != 0)))
+		{
+			region >>= 1;
+		}
+
+		if (region >= MC_BIST_MIN_REGION)
+		{
+			MC_BIST_Start_l(engine->bist_end, LOG((UINT32)region), engine->dataPattern);
+			engine->bist_end += region;
+			engine->bist_regions++;
+			engine->bist_busy = TRUE;
+			engine->bist_wait_us = 0;
+		}
+	}
+
+#ifdef BOOTBLOCK_MULTICORE_DDR_INIT
+	MC_Init_Core_Service_l(engine);
+#endif
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_BIST_Init_DRAM_mem                                                                  */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  start_address - MC address, aligned on MC_CPU_INIT_SLICE                               */
+/*                  size -          bytes, multiple of 8                                                   */
+/*                  dataPattern -   const to write to mem                                                  */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine init the whole memory (including above 2GB) with the DRAM init engine.    */
+/*                  Completion is polled every MC_BIST_POLL_US.                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_BIST_Init_DRAM_mem(UINT32 start_address, UINT64 size, UINT32 dataPattern)
+{
+	MC_INIT_ENGINE_T engine;
+	UINT64 pattern = ((UINT64)dataPattern << 32) | dataPattern;
+	UINT64 top;
+	UINT64 bottom;
+
+	HAL_PRINT("\nMC: BIST init start=%#010lx size=%#010lx pattern=%#010lx\n",
+			  start_address, size, dataPattern);
+
+	memset(&engine, 0, sizeof(engine));
+	engine.dataPattern = dataPattern;
+	engine.bist_end = start_address;
+	engine.cpu_top = start_address + size;
+
+#ifdef BOOTBLOCK_MULTICORE_DDR_INIT
+	mc_init_pattern = pattern;
+	MC_INIT_SYNC();
+#endif
+
+	// a partial slice at the top first: the jobs of the cores are whole slices
+	if ((size % MC_CPU_INIT_SLICE) != 0)
+	{
+		top = engine.cpu_top;
+		bottom = MAX(engine.bist_end, top & ~(UINT64)(MC_CPU_INIT_SLICE - 1));
+		MC_CPU_Init_DRAM_l(bottom, top - bottom, pattern);
+		engine.cpu_top = bottom;
+	}
+
+	while (TRUE)
+	{
+		MC_Init_Engine_Service_l(&engine);
+
+		if (engine.cpu_top > engine.bist_end)
+		{
+			// the primary fills a slice, BIST and the other cores are serviced between slices
+			top = engine.cpu_top;
+			bottom = MC_Init_Engine_Take_l(&engine, MC_CPU_INIT_SLICE);
+			MC_CPU_Init_DRAM_l(bottom, top - bottom, pattern);
+			engine.cpu_slices++;
+			continue;
+		}
+
+		if (!engine.bist_busy && (engine.core_busy == 0))
+		{
+			break;
+		}
+
+		CLK_Delay_MicroSec(MC_BIST_POLL_US);
+
+#ifdef BOOTBLOCK_MULTICORE_DDR_INIT
+		MC_Init_Core_Wait_l(&engine, MC_BIST_POLL_US);
+#endif
+
+		if (engine.bist_busy)
+		{
+			engine.bist_wait_us += MC_BIST_POLL_US;
+			if (engine.bist_wait_us >= MC_BIST_TIMEOUT_US)
+			{
+				HAL_PRINT_ERR(KRED "\nMC: BIST init timeout\n" KNRM);
+				MC_BIST_Stop_l();
+				engine.bist_busy = FALSE;
+			}
+		}
+	}
+	HAL_PRINT("\n");
+	HAL_PRINT_DBG("MC: BIST Completed, %d regions by BIST, %d slices by core 0, %d jobs by cores 1-3\n\n",
+				  engine.bist_regions, engine.cpu_slices, engine.core_jobs);
 
 	CLK_Delay_MicroSec(30);
 
@@ -1442,14 +1284,19 @@ static DEFS_STATUS MC_ConfigureDDR_l (DDR_Setup *ddr_setup, unsigned int try)
 
 	CLK_Delay_Cycles(0x100);
 
+	BOOT_TRACE_Begin(BOOT_TRACE_DDR_PHY_CFG1, try);
 	status = ddr_phy_cfg1(ddr_setup);
+	BOOT_TRACE_End(BOOT_TRACE_DDR_PHY_CFG1, try);
 	if (status != DEFS_STATUS_OK)
-		HAL_PRINT(KRED "\nddr_phy_cfg1\n" KNRM);
+		HAL_PRINT_ERR(KRED "\nddr_phy_cfg1\n" KNRM);
 
+	BOOT_TRACE_Begin(BOOT_TRACE_DDR_MC_INIT, try);
 	status = MC_Init_l(ddr_setup);
+	BOOT_TRACE_End(BOOT_TRACE_DDR_MC_INIT, try);
 	if (status != DEFS_STATUS_OK)
-		HAL_PRINT(KRED "\nMC_Init_l\n" KNRM);
+		HAL_PRINT_ERR(KRED "\nMC_Init_l\n" KNRM);
 
+	BOOT_TRACE_Begin(BOOT_TRACE_DDR_MR, try);
 #if 1 // WORKAROUND for UNQ issue
 	// set_odt_in_dram();
 	MC_write_mr_regs_all();
@@ -1470,12 +1317,15 @@ static DEFS_STATUS MC_ConfigureDDR_l (DDR_Setup *ddr_setup, unsigned int try)
 	MC_manual_issue_DRAM_ZQ();
 	// set_odt_in_dram(ddr_setup);
 #endif
+	BOOT_TRACE_End(BOOT_TRACE_DDR_MR, try);
 
 	// disable refresh before doing Vref training to workaround MC Errata issue:
 	SET_REG_FIELD(DENALI_CTL_43, DENALI_CTL_43_TREF_ENABLE, 0);
 	CLK_Delay_MicroSec(100);
 
+	BOOT_TRACE_Begin(BOOT_TRACE_DDR_PHY_CFG2, try);
 	status = ddr_phy_cfg2(ddr_setup);
+	BOOT_TRACE_End(BOOT_TRACE_DDR_PHY_CFG2, try);
 
 	// disable refresh before doing Vref training to workaround MC Errata issue:
 	SET_REG_FIELD(DENALI_CTL_43, DENALI_CTL_43_TREF_ENABLE, 1);
@@ -1491,7 +1341,7 @@ static DEFS_STATUS MC_ConfigureDDR_l (DDR_Setup *ddr_setup, unsigned int try)
 	CLK_Delay_MicroSec(100);
 
 	if (status != DEFS_STATUS_OK)
-		HAL_PRINT(KRED "\nddr_phy_cfg2 fail\n" KNRM); // return DEFS_STATUS_FAIL;
+		HAL_PRINT_ERR(KRED "\nddr_phy_cfg2 fail\n" KNRM); // return DEFS_STATUS_FAIL;
 
 #ifdef ENHANCED_SWEEPING_AND_LEVELING
 	if (status != DEFS_STATUS_OK)
@@ -1520,6 +1370,29 @@ static DEFS_STATUS MC_ConfigureDDR_l (DDR_Setup *ddr_setup, unsigned int try)
 	if (status != DEFS_STATUS_OK)
 		return status;
 
+#ifdef BOOTBLOCK_DDR_TRAINING_CACHE
+	/*--------------------------------------------------------------------*/
+	/* Saved training: restore the sweeps result and check it             */
+	/*--------------------------------------------------------------------*/
+	if (mc_training_restore != NULL)
+	{
+		UINT16 ber;
+
+		MC_RestoreTrim_l(mc_training_restore);
+
+		ber = MC_MemStressTest(FALSE, FALSE);
+		if (ber != 0)
+		{
+			HAL_PRINT_ERR(KRED "saved training check fail ber=%04X\n" KNRM, ber);
+			return DEFS_STATUS_FAIL;
+		}
+
+		HAL_PRINT(KGRN "saved training restored\n" KNRM);
+		MC_PrintTrim(TRUE, TRUE);
+		return DEFS_STATUS_OK;
+	}
+#endif
+
 	/*--------------------------------------------------------------------*/
 	/* Main flow sweeps, accroding to header flag SWEEP_MAIN_FLOW.        */
 	/*--------------------------------------------------------------------*/
@@ -1606,11 +1479,16 @@ static DEFS_STATUS MC_ConfigureDDR_l (DDR_Setup *ddr_setup, unsigned int try)
 	MC_PrintPhy();
 	if ((status != DEFS_STATUS_OK) || (status_out_sweep != DEFS_STATUS_OK))
 	{
-		HAL_PRINT(KRED "\n\nTraining failed, retry\n" KNRM);
+		HAL_PRINT_ERR(KRED "\n\nTraining failed, retry\n" KNRM);
 
 		return DEFS_STATUS_FAIL;
 	}
 
+#ifdef BOOTBLOCK_DDR_TRAINING_CACHE
+	MC_SaveTraining_l(ddr_setup, &mc_training_data);
+	mc_training_valid = TRUE;
+#endif
+
 	return status;
 }
 
@@ -1627,7 +1505,7 @@ void MC_UpdateDramSize(DDR_Setup *ddr_setup, UINT64 iDramSize)
 {
 	if (iDramSize == 0)
 	{
-		HAL_PRINT(KRED "\n\n>ERROR: Can't detect SDRAM size.\n>SDRAM device is faulty\n" KNRM);
+		HAL_PRINT_ERR(KRED "\n\n>ERROR: Can't detect SDRAM size.\n>SDRAM device is faulty\n" KNRM);
 		return;
 	}
 
@@ -1961,7 +1839,7 @@ static void MC_PrintPassFail (UINT32 val, UINT32 full_reg_val)
 /* Returns:         none                                                                                   */
 /* Side effects:                                                                                           */
 /* Description:                                                                                            */
-/*          This routine prints the module registers                                                       */
+/*          This routine prints the module registers. The log ring waits for room: the dump is not cut     */
 /*---------------------------------------------------------------------------------------------------------*/
 void MC_PrintRegs (void)
 {
@@ -1969,6 +1847,8 @@ void MC_PrintRegs (void)
 	UINT32 ilane = 0;
 	char sign;
 
+	serial_printf_sync(TRUE);
+
 	HAL_PRINT_DBG("\n************\n");
 	HAL_PRINT_DBG("* MC	 Info *\n");
 	HAL_PRINT_DBG("************\n\n");
@@ -2113,6 +1993,8 @@ void MC_PrintRegs (void)
 	HAL_PRINT_DBG("%s  = %#010lx\t", "DENALI_CTL_141", REG_READ(DENALI_CTL_141));
 	HAL_PRINT_DBG("%s  = %#010lx\t", "DENALI_CTL_142", REG_READ(DENALI_CTL_142));
 	HAL_PRINT_DBG("%s  = %#010lx\n", "DENALI_CTL_1304" KNRM, REG_READ(DENALI_CTL_1304));
+
+	serial_printf_sync(FALSE);
 }
 
 
@@ -2270,10 +2152,11 @@ static UINT16 GetECCSyndrom(UINT32 readVal)
 /* Returns:         none                                                                                   */
 /* Side effects:                                                                                           */
 /* Description:                                                                                            */
-/*                  Print PHY regs                                                                         */
+/*                  Print PHY regs. The log ring waits for room: the dump is not cut                       */
 /*---------------------------------------------------------------------------------------------------------*/
 static void MC_PrintPhy(void)
 {
+	serial_printf_sync(TRUE);
 
 	REG_WRITE(PHY_LANE_SEL /*0x12c*/, MAS_DLY_WIDTH * 0);
 	HAL_PRINT_DBG(KNRM "Lane:                     %#010lx  \n", REG_READ(PHY_LANE_SEL));
@@ -2409,5 +2292,17 @@ static void MC_PrintPhy(void)
 	HAL_PRINT_DBG("BIT_LVL_MASK                   %#010lx  \n", REG_READ(BIT_LVL_MASK));
 	HAL_PRINT_DBG("DYNAMIC_IE_TIMER               %#010lx  \n", REG_READ(DYNAMIC_IE_TIMER));
 
+	serial_printf_sync(FALSE);
+
 	return;
 }
+
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          HAL
+#endif
+
+#ifdef BOOTBLOCK_LOG_BINARY
+#undef  HAL_LOG_OUT
+#define HAL_LOG_OUT             serial_printf
+#endif
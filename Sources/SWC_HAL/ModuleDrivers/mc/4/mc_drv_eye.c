@@ -0,0 +1,244 @@
+/*----------------------------------------------------------------------------*/
+/* SPDX-License-Identifier: GPL-2.0                                           */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mc_drv_eye.c                                                             */
+/*        This file contains the eye analysis of the sweeps                   */
+/*        (included from mc_drv.c)                                            */
+/* Project:                                                                   */
+/*        SWC HAL                                                             */
+/*----------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* A sweep status has one UINT16 per point, one bit per DQ (1 = fail). It is transposed 8 points x 8 DQs   */
+/* at a time into one pass bitmap per DQ, then the eyes (pass runs) of a DQ are found with count trailing  */
+/* zeros, one step per edge instead of one per point. The biggest eye of a DQ is kept (the first one on a  */
+/* tie), with the same center as before: first pass point + size / 2. It is rated by the width of its      */
+/* edges (the farthest pass point within MC_EYE_EDGE_WINDOW points outside the eye, 0 for a sharp edge),   */
+/* the size of the second biggest eye and whether the sweep range clips it                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+#define MC_EYE_POINTS               128         // sweep points, up to MC_DQ_DQS_BITWISE_TRIM_SAMPLING_POINTS_TEST
+#define MC_EYE_WORDS                (MC_EYE_POINTS / 64)
+#define MC_EYE_BITS                 16
+#define MC_EYE_EDGE_WINDOW          4           // points rated outside each edge
+#define MC_EYE_SECONDARY_MIN        4           // smaller eyes are edge noise
+
+#define MC_EYE_NONE                 MASK_BIT(0) // no pass point
+#define MC_EYE_CLIPPED              MASK_BIT(1) // the eye reaches the first or the last point
+#define MC_EYE_SOFT_EDGE            MASK_BIT(2) // pass points close to an edge
+#define MC_EYE_SECONDARY            MASK_BIT(3) // another eye of MC_EYE_SECONDARY_MIN points or more
+
+typedef struct
+{
+	int     center;                 /* -1 if no eye                                                        */
+	int     size;                   /* pass points, 0 if no eye                                            */
+	int     left;                   /* first pass point, -1 if no eye                                      */
+	int     right;                  /* last pass point, -1 if no eye                                       */
+	UINT8   edge[2];                /* left and right edge width, 0 = sharp                                */
+	UINT8   eyes;                   /* pass runs                                                           */
+	UINT8   second;                 /* size of the second biggest pass run                                 */
+	UINT8   flags;                  /* MC_EYE_*                                                            */
+} MC_EYE_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_EYE_Transpose8_l                                                                    */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  x -             8 x 8 bits matrix, byte i is row i                                     */
+/*                                                                                                         */
+/* Returns:         transposed matrix, byte j holds bit j of the 8 rows                                    */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine transposes a bit matrix in three swap steps (2x2, 4x4 then 8x8 blocks)    */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 MC_EYE_Transpose8_l (UINT64 x)
+{
+	UINT64 t;
+
+	t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+	x = x ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x = x ^ t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	x = x ^ t ^ (t << 28);
+
+	return x;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_EYE_Bitmap_l                                                                        */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  SweepDataBuff - bitwise ber per point (1 = fail)                                       */
+/*                  BuffSize -      points, up to MC_EYE_POINTS                                            */
+/*                  pass -          bitmap per DQ, bit n of word n / 64 is set if the DQ passes on point n */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine turns the sweep status into pass bitmaps, in one pass over the status     */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_EYE_Bitmap_l (const UINT16 *SweepDataBuff, int BuffSize, UINT64 pass[MC_EYE_BITS][MC_EYE_WORDS])
+{
+	UINT64 lane0;
+	UINT64 lane1;
+	UINT64 ber;
+	int    point;
+	int    i;
+
+	for (i = 0; i < MC_EYE_BITS; i++)
+	{
+		pass[i][0] = 0;
+		pass[i][1] = 0;
+	}
+
+	for (point = 0; point < BuffSize; point += 8)
+	{
+		lane0 = 0;
+		lane1 = 0;
+		for (i = 0; i < 8; i++)
+		{
+			ber = (point + i < BuffSize) ? SweepDataBuff[point + i] : 0xFFFF;
+			lane0 |= (ber & 0xFF) << (8 * i);
+			lane1 |= (ber >> 8) << (8 * i);
+		}
+
+		lane0 = ~MC_EYE_Transpose8_l(lane0);
+		lane1 = ~MC_EYE_Transpose8_l(lane1);
+
+		for (i = 0; i < 8; i++)
+		{
+			pass[i][point / 64]     |= ((lane0 >> (8 * i)) & 0xFF) << (point % 64);
+			pass[i + 8][point / 64] |= ((lane1 >> (8 * i)) & 0xFF) << (point % 64);
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_EYE_Next_l                                                                          */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  pass -          bitmap of a DQ                                                         */
+/*                  from -          first point searched                                                   */
+/*                  fail -          0 to search a pass point, ~0 to search a fail point                    */
+/*                  points -        end of the search                                                      */
+/*                                                                                                         */
+/* Returns:         first point from 'from' that matches, 'points' if none                                 */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine searches the bitmap a word at a time (count trailing zeros)               */
+/*---------------------------------------------------------------------------------------------------------*/
+static int MC_EYE_Next_l (const UINT64 *pass, int from, UINT64 fail, int points)
+{
+	UINT64 word;
+	int    w = from / 64;
+
+	if (from >= points)
+		return points;
+
+	word = (pass[w] ^ fail) & (~0ULL << (from % 64));
+	while (word == 0)
+	{
+		if (++w >= MC_EYE_WORDS)
+			return points;
+		word = pass[w] ^ fail;
+	}
+
+	return MIN((w * 64) + __builtin_ctzll(word), points);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_EYE_Find_l                                                                          */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  SweepDataBuff - bitwise ber per point (1 = fail), from point 0 of the sweep            */
+/*                  BuffSize -      points, up to MC_EYE_POINTS                                            */
+/*                  eye -           MC_EYE_BITS results                                                    */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine finds the biggest eye of each DQ and rates it                             */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_EYE_Find_l (const UINT16 *SweepDataBuff, int BuffSize, MC_EYE_T *eye)
+{
+	UINT64   pass[MC_EYE_BITS][MC_EYE_WORDS];
+	MC_EYE_T *e;
+	int      bit;
+	int      start;
+	int      stop;
+	int      end;
+	int      point;
+
+	BuffSize = MIN(BuffSize, MC_EYE_POINTS);
+	MC_EYE_Bitmap_l(SweepDataBuff, BuffSize, pass);
+
+	for (bit = 0; bit < MC_EYE_BITS; bit++)
+	{
+		e = &eye[bit];
+		e->size    = 0;
+		e->left    = -1;
+		e->edge[0] = 0;
+		e->edge[1] = 0;
+		e->eyes    = 0;
+		e->second  = 0;
+		e->flags   = 0;
+
+		/*-------------------------------------------------------------------------------------------------*/
+		/* Pass runs                                                                                       */
+		/*-------------------------------------------------------------------------------------------------*/
+		for (start = MC_EYE_Next_l(pass[bit], 0, 0, BuffSize); start < BuffSize;
+		     start = MC_EYE_Next_l(pass[bit], stop, 0, BuffSize))
+		{
+			stop = MC_EYE_Next_l(pass[bit], start, ~0ULL, BuffSize);
+			e->eyes++;
+
+			if ((stop - start) > e->size)
+			{
+				e->second = (UINT8)e->size;
+				e->size   = stop - start;
+				e->left   = start;
+			}
+			else if ((stop - start) > e->second)
+			{
+				e->second = (UINT8)(stop - start);
+			}
+		}
+
+		if (e->size == 0)
+		{
+			e->center = -1;
+			e->right  = -1;
+			e->flags  = MC_EYE_NONE;
+			continue;
+		}
+
+		e->right  = e->left + e->size - 1;
+		e->center = e->left + (e->size / 2);
+
+		/*-------------------------------------------------------------------------------------------------*/
+		/* Edges: the farthest pass point in the window (the point next to the eye fails)                  */
+		/*-------------------------------------------------------------------------------------------------*/
+		point = MC_EYE_Next_l(pass[bit], MAX(e->left - MC_EYE_EDGE_WINDOW, 0), 0, e->left);
+		if (point < e->left)
+			e->edge[0] = (UINT8)(e->left - point);
+
+		end = MIN(e->right + 1 + MC_EYE_EDGE_WINDOW, BuffSize);
+		for (point = MC_EYE_Next_l(pass[bit], e->right + 1, 0, end); point < end;
+		     point = MC_EYE_Next_l(pass[bit], point + 1, 0, end))
+		{
+			e->edge[1] = (UINT8)(point - e->right);
+		}
+
+		if ((e->left == 0) || (e->right == (BuffSize - 1)))
+			e->flags |= MC_EYE_CLIPPED;
+		if ((e->edge[0] != 0) || (e->edge[1] != 0))
+			e->flags |= MC_EYE_SOFT_EDGE;
+		if (e->second >= MC_EYE_SECONDARY_MIN)
+			e->flags |= MC_EYE_SECONDARY;
+	}
+}
@@ -6,8 +6,9 @@
 /*                                                                            */
 /*----------------------------------------------------------------------------*/
 /* File Contents:                                                             */
-/*   mc_drv.c                                                                 */
-/*        This file contains configuration routines for Memory Controller     */
+/*   mc_drv_mem_test.c                                                        */
+/*        This file contains the DRAM tests run after the training            */
+/*        (included from mc_drv.c)                                            */
 /* Project:                                                                   */
 /*        SWC HAL                                                             */
 /*----------------------------------------------------------------------------*/
@@ -27,16 +28,11 @@
 #endif
 
 
-//#define (mem_stop - mem_start) mem_start0
-//#define mem_stop ((UINT32)1<<22) // 4M
-#define MEM_TEST_MASK ((UINT32)(mem_stop-1))
-extern BOOLEAN   bPrint;
-
 //------------------------------------------------------------------------------------------
 // -------   Golden Numbers   ----------
 // 23/12/2015: changed Golden_Numbers buffer size to aline 0xFF for simplicity
 
-const UINT32 Golden_Numbers[256] =
+const UINT32 Golden_Numbers[256] __attribute__((aligned(16))) =
 {
 	// Keep 0         Keep 1
 	0x007F00FFU,		~0x007F00FFU,  // lane-1 fixed to 0, lane-0 MSB bit 7 toggle while others are const 1
@@ -184,154 +180,520 @@ const UINT32 Golden_Numbers[256] =
 
 
 /*---------------------------------------------------------------------------------------------------------*/
-/* Function:        MC_mem_test_long                                                                       */
+/* DRAM test (MC_mem_test_long). Every test is a march: a list of elements, each one a pass over the       */
+/* tested memory, upwards or downwards, that reads and / or writes a 64 bit data background or its         */
+/* complement. With MC_MARCH_ADDR the data is also XORed with the address of the word (address in address, */
+/* for the address decoder faults). MarchBlock64 (v8_utils.S) runs an element on a block with NEON         */
+/* q-registers and stops on the first 64 bytes that fail: those are checked and written word by word here, */
+/* to report the address and the bits.                                                                     */
+/* The memory is split in one stripe per core. With BOOTBLOCK_MULTICORE_MEM_TEST cores 1-3 run their       */
+/* stripe from the el3_secondary wait loop (CORE_JOB_Dispatch of core_job.c, as the image copy); a core    */
+/* that does not answer has its stripe run by the primary.                                                 */
+/*  - MC_MEM_TEST_QUICK: the address lines over the whole capacity, then the quick march window by window, */
+/*    the windows spread over the stripe (bit reversed order), until MC_MEM_TEST_QUICK_US. 3 passes per    */
+/*    window instead of the 13 of all the tests: about 4 times the coverage in the same time. Selected by  */
+/*    mc_config bit 1 (MC_CAPABILITY_MEM_TEST_QUICK): it adds MC_MEM_TEST_QUICK_US to every boot           */
+/*  - MC_MEM_TEST_FULL: every element of every test over all the memory, the cores are synchronized        */
+/*    between the elements                                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef MC_MEM_TEST_QUICK_US
+#define MC_MEM_TEST_QUICK_US        50000
+#endif
+#define MC_MEM_TEST_WINDOW          _64KB_      // quick mode
+#define MC_MEM_TEST_CHUNK           _1MB_       // full mode: an element runs on a stripe by chunks
+#define MC_MEM_TEST_MAX_ERRORS      100         // per core, the test of the core stops
+#ifdef BOOTBLOCK_MULTICORE_MEM_TEST
+#define MC_MEM_TEST_CORES           CORE_JOB_CORES
+#else
+#define MC_MEM_TEST_CORES           1
+#endif
+#define MC_MEM_TEST_TIMEOUT_US      (120 * 1000 * 1000)
+
+#define MC_MARCH_READ               MASK_BIT(0) // MarchBlock64 flags
+#define MC_MARCH_WRITE              MASK_BIT(1)
+#define MC_MARCH_DOWN               MASK_BIT(2)
+#define MC_MARCH_ADDR               MASK_BIT(3)
+#define MC_MARCH_RD_INV             MASK_BIT(4) // read the complement of the background
+#define MC_MARCH_WR_INV             MASK_BIT(5) // write the complement of the background
+#define MC_MARCH_FLAGS              (MC_MARCH_READ | MC_MARCH_WRITE | MC_MARCH_DOWN | MC_MARCH_ADDR)
+
+#define MC_MARCH_W                  (MC_MARCH_WRITE)
+#define MC_MARCH_R0_W1              (MC_MARCH_READ | MC_MARCH_WRITE | MC_MARCH_WR_INV)
+#define MC_MARCH_R1_W0              (MC_MARCH_READ | MC_MARCH_RD_INV | MC_MARCH_WRITE)
+#define MC_MARCH_R0                 (MC_MARCH_READ)
+#define MC_MARCH_R1                 (MC_MARCH_READ | MC_MARCH_RD_INV)
+
+typedef enum
+{
+	MC_MEM_TEST_QUICK,
+	MC_MEM_TEST_FULL,
+} MC_MEM_TEST_MODE_T;
+
+typedef struct
+{
+	const char          *name;
+	const UINT8         *element;
+	UINT32              elements;
+	const UINT64        *background;        // full mode: all of them, quick mode: one per window, in turn
+	UINT32              backgrounds;
+} MC_MEM_TEST_T;
+
+typedef struct
+{
+	UINT32              errors;             // failing 64 bit words
+	UINT64              bits;               // OR of the failing bits
+	UINT64              addr;               // first failing word
+	UINT64              expected;
+	UINT64              actual;
+	UINT64              tested;             // bytes, all the tests
+} MC_MEM_TEST_RESULT_T;
+
+typedef struct
+{
+	MC_MEM_TEST_MODE_T  mode;
+	UINT64              offset;             // stripe, DRAM offset
+	UINT64              size;
+	UINT32              test;               // full mode: element to run
+	UINT32              background;
+	UINT32              element;
+	UINT64              deadline;           // quick mode: time stamp, usec
+	MC_MEM_TEST_RESULT_T result;
+} MC_MEM_TEST_JOB_T;
+
+extern unsigned long MarchBlock64 (void *addr, unsigned long nBytes, unsigned long rdData, unsigned long wrData,
+				   unsigned long flags);
+
+// address in address: (w a) up(r a, w ~a) down(r ~a)
+static const UINT8 mc_march_addr[] = {MC_MARCH_ADDR | MC_MARCH_W, MC_MARCH_ADDR | MC_MARCH_R0_W1,
+				      MC_MARCH_ADDR | MC_MARCH_DOWN | MC_MARCH_R1};
+
+// march C-: (w0) up(r0, w1) up(r1, w0) down(r0, w1) down(r1, w0) (r0)
+static const UINT8 mc_march_c[] = {MC_MARCH_W, MC_MARCH_R0_W1, MC_MARCH_R1_W0, MC_MARCH_DOWN | MC_MARCH_R0_W1,
+				   MC_MARCH_DOWN | MC_MARCH_R1_W0, MC_MARCH_R0};
+
+// moving inversions: up(w p) up(r p, w ~p) down(r ~p, w p) (r p)
+static const UINT8 mc_march_mi[] = {MC_MARCH_W, MC_MARCH_R0_W1, MC_MARCH_DOWN | MC_MARCH_R1_W0, MC_MARCH_R0};
+
+static const UINT64 mc_march_zero[] = {0};
+static const UINT64 mc_march_bg[]   = {0, 0x5555555555555555ULL, 0x3333333333333333ULL, 0x00FF00FF00FF00FFULL};
+
+// one DQ at 1, on the 4 beats of a word
+static const UINT64 mc_march_walk[] =
+{
+	0x0001000100010001ULL, 0x0002000200020002ULL, 0x0004000400040004ULL, 0x0008000800080008ULL,
+	0x0010001000100010ULL, 0x0020002000200020ULL, 0x0040004000400040ULL, 0x0080008000800080ULL,
+	0x0100010001000100ULL, 0x0200020002000200ULL, 0x0400040004000400ULL, 0x0800080008000800ULL,
+	0x1000100010001000ULL, 0x2000200020002000ULL, 0x4000400040004000ULL, 0x8000800080008000ULL,
+};
+
+static const MC_MEM_TEST_T mc_mem_tests[] =
+{
+	{"address",           mc_march_addr, ARRAY_SIZE(mc_march_addr), mc_march_zero, ARRAY_SIZE(mc_march_zero)},
+	{"march C-",          mc_march_c,    ARRAY_SIZE(mc_march_c),    mc_march_bg,   ARRAY_SIZE(mc_march_bg)},
+	{"moving inversions", mc_march_mi,   ARRAY_SIZE(mc_march_mi),   mc_march_walk, ARRAY_SIZE(mc_march_walk)},
+};
+
+// quick mode windows: address in address XOR one DQ at 1, both polarities, the DQ changes from a window to the next
+static const MC_MEM_TEST_T mc_mem_test_quick =
+	{"quick",             mc_march_addr, ARRAY_SIZE(mc_march_addr), mc_march_walk, ARRAY_SIZE(mc_march_walk)};
+
+static MC_MEM_TEST_JOB_T mc_mem_test_jobs[MC_MEM_TEST_CORES];
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_MemTestAddr_l                                                                       */
+/*                                                                                                         */
+/* Parameters:      offset - DRAM offset                                                                   */
+/* Returns:         address of the offset: DRAM 2GB-4GB is mapped at 4GB-6GB                               */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 MC_MemTestAddr_l (UINT64 offset)
+{
+	return (offset < _2GB_) ? offset : (offset + _2GB_);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_MemTestRank_l                                                                       */
 /*                                                                                                         */
 /* Parameters:                                                                                             */
-/*                  itr -                                                                                  */
-/*                  mem_start -                                                                            */
-/*                  mem_stop -                                                                             */
-/*                  print -                                                                                */
+/*                  ddr_setup -                                                                            */
+/*                  addr -      failing address                                                            */
 /*                                                                                                         */
-/* Returns:                                                                                                */
-/* Side effects:                                                                                           */
-/* Description:                                                                                            */
-/*                  This routine performs...                                                               */
+/* Returns:         rank (die of a DDP device) of the address: the chip select is the top DRAM address bit */
 /*---------------------------------------------------------------------------------------------------------*/
-static int MC_mem_test_long (UINT32 itr, UINT32 mem_start, UINT32 mem_stop, BOOLEAN print)
+static UINT32 MC_MemTestRank_l (const DDR_Setup *ddr_setup, UINT64 addr)
 {
-	UINT32 counter = 0;
-	UINT32 golden_cnt=0;
-	UINT32 index = 0;
-	UINT32 TmpAddr, TmpDataRd, TmpDataWr;
-
-	UINT32 g_CPU0_MemTest_Fail = 0; //complete with failure
-	UINT32 g_CPU0_MemTest_Loop = 0;
-	UINT32 g_CPU0_MemTest_Addr = 0;
-	UINT32 g_CPU0_MemTest_Data_Expected = 0;
-	UINT32 g_CPU0_MemTest_Data_Read = 0;
-	UINT32 g_CPU0_MemTest_Completed = 0;
-	UINT32 error = 0;
+	UINT64 offset = (addr < _4GB_) ? addr : (addr - _2GB_);
 
-	HAL_PRINT("\n");
-	
-	while (counter++ < itr)
-	{
-		TmpAddr = 0;
-		if (print)
-			HAL_PRINT_DBG("Start Mem test %d", counter);
+	if ((ddr_setup->ddr_ddp == FALSE) || (ddr_setup->ddr_size == 0))
+		return 0;
 
+	return (offset >= (ddr_setup->ddr_size / 2)) ? 1 : 0;
+}
 
-		//--------------------------------------
-		// write pattern
-		//--------------------------------------
-		golden_cnt = 0;
-		for (index = mem_start ; index < mem_stop; index += 4)
-		{
-			*(volatile UINT32*)(UINT64)index = Golden_Numbers[golden_cnt++ & 0xFF];
-			/*if (index == 0x100)
-			{
-				*((volatile UINT32*)(TmpAddr+ mem_stop)) = 0xAABBCCDD;
-			}*/
-			//TmpAddr += index + (4 * 8);
-		}
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_MemTestTime_l                                                                       */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         time stamp in usec, can be read by all the cores                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 MC_MemTestTime_l (void)
+{
+	UINT32 time_quad[2] __attribute__((aligned(8)));
 
-		//---------------------------------------------------
-		// read and verify, write anti-pattern (for noise only)
-		//----------------------------------------------------
-		TmpAddr = 0;
+	CLK_GetTimeStamp(time_quad);
 
-		golden_cnt = 0;
+	return ((UINT64)time_quad[1] * 1000000) + (time_quad[0] / 25);
+}
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_MemTestBlock_l                                                                      */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  result -        errors                                                                 */
+/*                  addr -          64 bytes aligned                                                       */
+/*                  size -          multiple of 64 bytes                                                   */
+/*                  background -                                                                           */
+/*                  element -       MC_MARCH_xxx flags                                                     */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine runs one march element on a block. The 64 bytes that fail are checked     */
+/*                  word by word, written, and the element goes on after them                              */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_MemTestBlock_l (MC_MEM_TEST_RESULT_T *result, UINT64 addr, UINT64 size, UINT64 background, UINT8 element)
+{
+	UINT64 rd = (element & MC_MARCH_RD_INV) ? ~background : background;
+	UINT64 wr = (element & MC_MARCH_WR_INV) ? ~background : background;
+	UINT64 left;
+	UINT64 fail;
+	UINT64 data;
+	UINT64 expected;
+	UINT64 mask;
+	UINT32 i;
+
+	left = MarchBlock64((void *)addr, size, rd, wr, element & MC_MARCH_FLAGS);
+
+	while ((left > 0) && (result->errors <= MC_MEM_TEST_MAX_ERRORS))
+	{
+		fail = (element & MC_MARCH_DOWN) ? (addr + left - 64) : (addr + size - left);
 
-		for (index = mem_start ; index < mem_stop; index += 4)
+		for (i = 0; i < 8; i++)
 		{
-			TmpDataWr = Golden_Numbers[golden_cnt++ & 0xFF];
-			TmpDataRd = *(volatile UINT32*)(UINT64)index;
-			if (TmpDataWr != TmpDataRd)
+			mask = (element & MC_MARCH_ADDR) ? (fail + (i * 8)) : 0;
+			expected = rd ^ mask;
+			data = *(volatile UINT64 *)(fail + (i * 8));
+
+			if (data != expected)
 			{
-				g_CPU0_MemTest_Fail = TRUE; //complete with failure
-				g_CPU0_MemTest_Loop = index;
-				g_CPU0_MemTest_Addr = TmpAddr + mem_stop;
-				g_CPU0_MemTest_Data_Expected = TmpDataWr;
-				g_CPU0_MemTest_Data_Read = TmpDataRd;
-
-				if (print)
-					HAL_PRINT("Memtest failed index %d address %#010lx Expected %#010lx read %#010lx ", g_CPU0_MemTest_Loop, index, TmpDataWr, TmpDataRd);
-				error++;
-				if (error > 100)	return error;
-
-				//while (TRUE);
+				if (result->errors == 0)
+				{
+					result->addr = fail + (i * 8);
+					result->expected = expected;
+					result->actual = data;
+				}
+				result->errors++;
+				result->bits |= data ^ expected;
 			}
-			//*((volatile UINT32*)(TmpAddr+ mem_stop)) = ~TmpDataWr;
-			//TmpAddr += mem_start + (4 * 8) + 4;
-			//TmpAddr &= MEM_TEST_MASK;
+
+			if (element & MC_MARCH_WRITE)
+				*(volatile UINT64 *)(fail + (i * 8)) = wr ^ mask;
 		}
 
-		// UINT8 a line test
-#if 1
-		//--------------------------------------
-		// write pattern
-		//--------------------------------------
-		TmpAddr = mem_start;
-		golden_cnt = 0;
-		for (index = mem_start ; index < mem_stop; index++)
-		{
-			TmpDataWr = Golden_Numbers[golden_cnt++ & 0xFF];
-			*(volatile UINT8*)(UINT64)TmpAddr = (UINT8)TmpDataWr;
+		if (element & MC_MARCH_DOWN)
+			left = MarchBlock64((void *)addr, left - 64, rd, wr, element & MC_MARCH_FLAGS);
+		else
+			left = MarchBlock64((void *)(fail + 64), left - 64, rd, wr, element & MC_MARCH_FLAGS);
+	}
+}
 
-			TmpAddr += (4 * 8) + sizeof(UINT8);
-			TmpAddr &= MEM_TEST_MASK;
-		}
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_MemTestWindows_l                                                                    */
+/*                                                                                                         */
+/* Parameters:      job -   quick mode job                                                                 */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine runs the quick march on MC_MEM_TEST_WINDOW windows of the stripe, in bit  */
+/*                  reversed order (spread over the stripe first), until the deadline. The background      */
+/*                  changes from a window to the next                                                      */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_MemTestWindows_l (MC_MEM_TEST_JOB_T *job)
+{
+	const MC_MEM_TEST_T *t = &mc_mem_test_quick;
+	UINT64 window = MIN(job->size, MC_MEM_TEST_WINDOW);
+	UINT32 windows = (UINT32)(job->size / window);
+	UINT32 bits = LOG(windows);
+	UINT32 i, w, b;
+	UINT32 element;
+	UINT64 addr;
+
+	for (i = 0; i < windows; i++)
+	{
+		for (w = 0, b = 0; b < bits; b++)
+			w |= ((i >> b) & 0x1) << (bits - 1 - b);
 
-		//---------------------------------------------------
-		// read and verify
-		//----------------------------------------------------
-		TmpAddr = mem_start;
-		golden_cnt = 0;
-		for (index = mem_start ; index < mem_stop; index += 1)
-		{
-			TmpDataWr = Golden_Numbers[golden_cnt++ & 0xFF];
-			TmpDataRd = *(volatile UINT8*)(UINT64)TmpAddr;
-			if ((UINT8)TmpDataWr != (UINT8)TmpDataRd)
-			{
-				g_CPU0_MemTest_Fail = TRUE; //complete with failure
-				g_CPU0_MemTest_Loop = index;
-				g_CPU0_MemTest_Addr = TmpAddr + mem_stop;
-				g_CPU0_MemTest_Data_Expected = TmpDataWr;
-				g_CPU0_MemTest_Data_Read = TmpDataRd;
+		addr = MC_MemTestAddr_l(job->offset + ((UINT64)w * window));
 
-				if (print)
-					HAL_PRINT("Memtest failed index %d address %#010lx Expected %#010lx read %#010lx ", g_CPU0_MemTest_Loop, index, TmpDataRd, TmpDataWr);
-				error++;
+		for (element = 0; element < t->elements; element++)
+			MC_MemTestBlock_l(&job->result, addr, window, t->background[i % t->backgrounds], t->element[element]);
 
-				if (error > 100)	return error;
-			}
-			TmpAddr += (4 * 8) + sizeof(UINT8);
-			TmpAddr &= MEM_TEST_MASK;
-		}
+		job->result.tested += window;
+
+		if ((job->result.errors > MC_MEM_TEST_MAX_ERRORS) || (MC_MemTestTime_l() >= job->deadline))
+			break;
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_MemTestJob_l                                                                        */
+/*                                                                                                         */
+/* Parameters:      job -                                                                                  */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine runs the job of a core: quick mode windows, or one element of a test on   */
+/*                  the whole stripe (by chunks, in the direction of the element)                          */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_MemTestJob_l (MC_MEM_TEST_JOB_T *job)
+{
+	const MC_MEM_TEST_T *t = &mc_mem_tests[job->test];
+	UINT8 element = t->element[job->element];
+	UINT64 chunk = MIN(job->size, MC_MEM_TEST_CHUNK);
+	UINT64 chunks = job->size / chunk;
+	UINT64 i, c;
+
+	if (job->mode == MC_MEM_TEST_QUICK)
+	{
+		MC_MemTestWindows_l(job);
+		return;
+	}
+
+	for (i = 0; (i < chunks) && (job->result.errors <= MC_MEM_TEST_MAX_ERRORS); i++)
+	{
+		c = (element & MC_MARCH_DOWN) ? (chunks - 1 - i) : i;
+		MC_MemTestBlock_l(&job->result, MC_MemTestAddr_l(job->offset + (c * chunk)), chunk,
+				  t->background[job->background], element);
+	}
+}
+
+#ifdef BOOTBLOCK_MULTICORE_MEM_TEST
+extern unsigned int GetCPUID (void);
+#ifdef BOOTBLOCK_CACHED_BOOT
+extern void CleanInvalidateUDCaches (void);
+#define MC_MEM_TEST_SYNC()          CleanInvalidateUDCaches()   // cores 1-3 run with the MMU off
+#else
+#define MC_MEM_TEST_SYNC()
 #endif
+
+static UINT32 mc_mem_test_absent;       // cores that did not answer, bitwise
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_MemTestWorker_l                                                                     */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Runs on cores 1-3, called from the el3_secondary wait loop. Returns the core to the    */
+/*                  wait loop                                                                              */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_MemTestWorker_l (void)
+{
+	UINT32 cpu = GetCPUID();
+
+	CORE_JOB_Ack(cpu);
+
+	MC_MemTestJob_l(&mc_mem_test_jobs[cpu]);
+
+	CORE_JOB_Done(cpu);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_MemTestWait_l                                                                       */
+/*                                                                                                         */
+/* Parameters:      cpu -   core 1-3, its job was dispatched                                               */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine waits for the job of a core. If the core does not take it, the job is     */
+/*                  taken back and run here (the core is not used again)                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_MemTestWait_l (UINT32 cpu)
+{
+	DEFS_STATUS status = CORE_JOB_Wait(cpu, CORE_JOB_ACK_US, MC_MEM_TEST_TIMEOUT_US);
+
+	if (status == DEFS_STATUS_NO_CONNECTION)
+	{
+		HAL_PRINT(KYEL "mem test: core %d does not answer, run on core 0\n" KNRM, cpu);
+		mc_mem_test_absent |= MASK_BIT(cpu);
+		MC_MemTestJob_l(&mc_mem_test_jobs[cpu]);
+		return;
 	}
-	//----------------------------------------
-//#ifdef CACHE_ENABLE
-//	dcache_disable();
-//#endif
-	g_CPU0_MemTest_Completed = TRUE;
 
-	if (g_CPU0_MemTest_Completed == TRUE)
+	if (status != DEFS_STATUS_OK)
 	{
-		g_CPU0_MemTest_Data_Read = (mem_stop - mem_start);
-		HAL_PRINT_DBG("Memtest completed 0x%X bytes\n", g_CPU0_MemTest_Data_Read);
-		if (print)
-			HAL_PRINT("Test pass\n");
+		HAL_PRINT(KRED "mem test: core %d did not finish\n" KNRM, cpu);
+		mc_mem_test_absent |= MASK_BIT(cpu);
+		mc_mem_test_jobs[cpu].result.errors++;
+		return;
+	}
+
+	MC_MEM_TEST_SYNC();
+}
+#endif // BOOTBLOCK_MULTICORE_MEM_TEST
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_MemTestRun_l                                                                        */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine runs the jobs of mc_mem_test_jobs, one per core, and waits for them       */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_MemTestRun_l (void)
+{
+#ifdef BOOTBLOCK_MULTICORE_MEM_TEST
+	UINT32 cpu;
+
+	MC_MEM_TEST_SYNC();
+
+	for (cpu = 1; cpu < MC_MEM_TEST_CORES; cpu++)
+	{
+		if (mc_mem_test_absent & MASK_BIT(cpu))
+			continue;
+
+		CORE_JOB_Dispatch(cpu, MC_MemTestWorker_l, 0);
+	}
+#endif
+
+	MC_MemTestJob_l(&mc_mem_test_jobs[0]);
+
+#ifdef BOOTBLOCK_MULTICORE_MEM_TEST
+	for (cpu = 1; cpu < MC_MEM_TEST_CORES; cpu++)
+	{
+		if (mc_mem_test_absent & MASK_BIT(cpu))
+			MC_MemTestJob_l(&mc_mem_test_jobs[cpu]);
+		else
+			MC_MemTestWait_l(cpu);
+	}
+#endif
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_MemTestAddrLines_l                                                                  */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  result -                                                                               */
+/*                  size -      DRAM size                                                                  */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine runs the address in address test on 64 bytes at offset 0 and at each      */
+/*                  power of 2 offset: a stuck or shorted address line makes two of them alias             */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_MemTestAddrLines_l (MC_MEM_TEST_RESULT_T *result, UINT64 size)
+{
+	const MC_MEM_TEST_T *t = &mc_mem_tests[0];
+	UINT32 lines = LOG(size / 64);
+	UINT32 element, i, line;
+	UINT64 offset;
+
+	for (element = 0; element < t->elements; element++)
+	{
+		for (i = 0; i <= lines; i++)
+		{
+			line = (t->element[element] & MC_MARCH_DOWN) ? (lines - i) : i;
+			offset = (line == 0) ? 0 : ((UINT64)64 << (line - 1));
+			MC_MemTestBlock_l(result, MC_MemTestAddr_l(offset), 64, t->background[0], t->element[element]);
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_mem_test_long                                                                       */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  ddr_setup -                                                                            */
+/*                  size -      bytes from DRAM offset 0, power of 2, at least 64KB                        */
+/*                  mode -      MC_MEM_TEST_QUICK / MC_MEM_TEST_FULL                                       */
+/*                                                                                                         */
+/* Returns:         number of failing 64 bit words (tests of a core stop after MC_MEM_TEST_MAX_ERRORS)     */
+/* Side effects:    the tested memory is overwritten                                                       */
+/* Description:                                                                                            */
+/*                  This routine tests the DRAM, on all the cores, and prints the first failing address,   */
+/*                  bits and rank of each core                                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 MC_mem_test_long (DDR_Setup *ddr_setup, UINT64 size, MC_MEM_TEST_MODE_T mode)
+{
+	MC_MEM_TEST_RESULT_T *result;
+	MC_MEM_TEST_JOB_T *job;
+	UINT64 start = MC_MemTestTime_l();
+	UINT64 tested = 0;
+	UINT32 error = 0;
+	UINT32 cpu, test, bg, element;
+	UINT16 dq;
+
+	memset(mc_mem_test_jobs, 0, sizeof(mc_mem_test_jobs));
+
+	for (cpu = 0; cpu < MC_MEM_TEST_CORES; cpu++)
+	{
+		job = &mc_mem_test_jobs[cpu];
+		job->mode = mode;
+		job->size = size / MC_MEM_TEST_CORES;
+		job->offset = cpu * job->size;
+		job->deadline = start + MC_MEM_TEST_QUICK_US;
+	}
+
+	if (mode == MC_MEM_TEST_QUICK)
+	{
+		MC_MemTestAddrLines_l(&mc_mem_test_jobs[0].result, size);
+		MC_MemTestRun_l();
 	}
 	else
 	{
-		if (print)
-			HAL_PRINT("Test fail\n");
+		for (test = 0; test < ARRAY_SIZE(mc_mem_tests); test++)
+		{
+			HAL_PRINT_DBG("mem test %s\n", mc_mem_tests[test].name);
+			for (bg = 0; bg < mc_mem_tests[test].backgrounds; bg++)
+			{
+				for (element = 0; element < mc_mem_tests[test].elements; element++)
+				{
+					for (cpu = 0; cpu < MC_MEM_TEST_CORES; cpu++)
+					{
+						mc_mem_test_jobs[cpu].test = test;
+						mc_mem_test_jobs[cpu].background = bg;
+						mc_mem_test_jobs[cpu].element = element;
+					}
+					MC_MemTestRun_l();
+				}
+			}
+		}
 
+		for (cpu = 0; cpu < MC_MEM_TEST_CORES; cpu++)
+			mc_mem_test_jobs[cpu].result.tested = mc_mem_test_jobs[cpu].size;
 	}
 
-	return error;
+	for (cpu = 0; cpu < MC_MEM_TEST_CORES; cpu++)
+	{
+		result = &mc_mem_test_jobs[cpu].result;
+		tested += result->tested;
+		error += result->errors;
 
+		if (result->errors == 0)
+			continue;
 
-}
\ No newline at end of file
+		dq = (UINT16)(result->bits | (result->bits >> 16) | (result->bits >> 32) | (result->bits >> 48));
+		HAL_PRINT(KRED "mem test core %u: %u errors, first at %#010lx rank %u expected %#018lx read %#018lx DQ %#06x\n" KNRM,
+			  cpu, result->errors, result->addr, MC_MemTestRank_l(ddr_setup, result->addr), result->expected,
+			  result->actual, dq);
+	}
+
+	HAL_PRINT("mem test %s: %u cores, tested %#010lx of %#010lx bytes (%u.%u%%) in %u ms, %u errors\n",
+		  (mode == MC_MEM_TEST_QUICK) ? "quick" : "full", MC_MEM_TEST_CORES, tested, size,
+		  (UINT32)((tested * 100) / size), (UINT32)(((tested * 1000) / size) % 10),
+		  (UINT32)((MC_MemTestTime_l() - start) / 1000), error);
+
+	return error;
+}
@@ -0,0 +1,388 @@
+/*----------------------------------------------------------------------------*/
+/* SPDX-License-Identifier: GPL-2.0                                           */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mc_drv_ptrn.c                                                            */
+/*        This file contains the DRAM pattern test kernels of the training    */
+/*        and the sweeps (included from mc_drv.c)                             */
+/* Project:                                                                   */
+/*        SWC HAL                                                             */
+/*----------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* A kernel writes its pattern to DRAM at MC_PTRN_ADDR and reads it back. The bitwise ber has one bit per  */
+/* DQ (bit 0-7 lane 0, bit 8-15 lane 1), so the 64 bit words of (read XOR pattern) are ORed and folded to  */
+/* 16 bits. Patterns are built in SRAM and written / compared in 64 bytes NEON blocks (CopyBlock64,        */
+/* XorOrBlock64 in v8_utils.S). Only MC_PTRN_BYTE_LANE writes bytes: it is the one that exercises DM.      */
+/* A test runs a set of kernels and stops once all the bits fail                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+#define MC_PTRN_ADDR                0x1000
+#define MC_PTRN_SIZE                0x100       // bytes per kernel
+#define MC_PTRN_BYTE_LANE_SIZE      0x400
+#define MC_PTRN_RAM2_SIZE           0x10000     // bootblock code as a pseudo random pattern
+#define MC_PTRN_RAM2_CHUNK          0x1000      // compare chunk, to stop early
+#define MC_PTRN_PRBS_SHIFT          17          // PRBS phase between two DQs
+
+typedef enum
+{
+	MC_PTRN_BYTE_LANE,          // byte stores FF 00 00 FF, counts the failing words per lane (g_fail_rate_n)
+
+	MC_PTRN_00FFFF00,           // fixed words, lane aware
+	MC_PTRN_FF0000FF,
+	MC_PTRN_FFFF0000,
+	MC_PTRN_0000FFFF,
+	MC_PTRN_FFFFFFFF,
+	MC_PTRN_00000000,
+	MC_PTRN_55555555,
+	MC_PTRN_AAAAAAAA,
+	MC_PTRN_33333333,
+	MC_PTRN_99999999,
+
+	MC_PTRN_WALK_1,             // one DQ at 1
+	MC_PTRN_WALK_0,             // one DQ at 0
+	MC_PTRN_WALK_DEAD,          // walking 0 / walking 1 interleaved
+	MC_PTRN_WALK_DEAD1,         // all 1 / walking 1 interleaved
+	MC_PTRN_WALK_DEAD2,         // walking 0 / all 0 interleaved
+
+	MC_PTRN_PRBS7,              // x^7 + x^6 + 1 on every DQ, MC_PTRN_PRBS_SHIFT bits apart
+	MC_PTRN_PRBS15,             // x^15 + x^14 + 1
+	MC_PTRN_SSO,                // all DQs toggle together, every 1, 2 and 4 beats
+	MC_PTRN_XTALK,              // per victim DQ: the other DQs toggle against it
+	MC_PTRN_GOLDEN,             // Golden_Numbers (mc_drv_mem_test.c)
+	MC_PTRN_RAM2,               // bootblock code, MC_PTRN_RAM2_SIZE bytes
+} MC_PTRN_KERNEL_T;
+
+typedef struct
+{
+	const UINT8     *kernel;
+	UINT32          count;
+} MC_PTRN_SET_T;
+
+#define MC_PTRN_SET(list)           { list, ARRAY_SIZE(list) }
+
+extern void *CopyBlock64 (void *dstPtr, const void *srcPtr, unsigned long nBytes);
+extern unsigned long XorOrBlock64 (const void *dataPtr, const void *ptrnPtr, unsigned long nBytes);
+extern const UINT32 Golden_Numbers[256];
+
+static const UINT32 mc_ptrn_fixed[] = {0x00FFFF00, 0xFF0000FF, 0xFFFF0000, 0x0000FFFF, 0xFFFFFFFF,
+				       0x00000000, 0x55555555, 0xAAAAAAAA, 0x33333333, 0x99999999};
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Kernel sets. MC_MemStressTestLong and MC_MemStressTest keep their kernels and order, bQuick stops after */
+/* the second fixed pattern. The sweeps add kernels for what they move: PRBS, crosstalk and the golden     */
+/* numbers for the bitwise DQ trims, SSO and PRBS7 for DM and the lane (DQS, TRIM_2) delays. The slow      */
+/* RAM2 kernel stays last                                                                                  */
+/*---------------------------------------------------------------------------------------------------------*/
+static const UINT8 mc_ptrn_long[] = {MC_PTRN_BYTE_LANE, MC_PTRN_00FFFF00, MC_PTRN_FF0000FF, MC_PTRN_FFFF0000, MC_PTRN_0000FFFF,
+				     MC_PTRN_WALK_1, MC_PTRN_WALK_0, MC_PTRN_WALK_DEAD, MC_PTRN_WALK_DEAD1, MC_PTRN_WALK_DEAD2,
+				     MC_PTRN_RAM2};
+
+static const UINT8 mc_ptrn_short[] = {MC_PTRN_FFFFFFFF, MC_PTRN_00000000, MC_PTRN_55555555, MC_PTRN_AAAAAAAA, MC_PTRN_33333333,
+				      MC_PTRN_99999999, MC_PTRN_WALK_1, MC_PTRN_WALK_0, MC_PTRN_WALK_DEAD, MC_PTRN_WALK_DEAD1,
+				      MC_PTRN_WALK_DEAD2, MC_PTRN_RAM2};
+
+static const UINT8 mc_ptrn_dq[] = {MC_PTRN_BYTE_LANE, MC_PTRN_00FFFF00, MC_PTRN_FF0000FF, MC_PTRN_FFFF0000, MC_PTRN_0000FFFF,
+				   MC_PTRN_WALK_1, MC_PTRN_WALK_0, MC_PTRN_WALK_DEAD, MC_PTRN_WALK_DEAD1, MC_PTRN_WALK_DEAD2,
+				   MC_PTRN_PRBS15, MC_PTRN_XTALK, MC_PTRN_GOLDEN, MC_PTRN_RAM2};
+
+static const UINT8 mc_ptrn_lane[] = {MC_PTRN_BYTE_LANE, MC_PTRN_00FFFF00, MC_PTRN_FF0000FF, MC_PTRN_FFFF0000, MC_PTRN_0000FFFF,
+				     MC_PTRN_WALK_1, MC_PTRN_WALK_0, MC_PTRN_WALK_DEAD, MC_PTRN_WALK_DEAD1, MC_PTRN_WALK_DEAD2,
+				     MC_PTRN_SSO, MC_PTRN_PRBS7, MC_PTRN_RAM2};
+
+static const MC_PTRN_SET_T mc_ptrn_set_long        = MC_PTRN_SET(mc_ptrn_long);
+static const MC_PTRN_SET_T mc_ptrn_set_long_quick  = {mc_ptrn_long, 3};
+static const MC_PTRN_SET_T mc_ptrn_set_short       = MC_PTRN_SET(mc_ptrn_short);
+static const MC_PTRN_SET_T mc_ptrn_set_short_quick = {mc_ptrn_short, 2};
+
+static const MC_PTRN_SET_T mc_ptrn_set_sweep[] =
+{
+	MC_PTRN_SET(mc_ptrn_dq),        // SWEEP_OUT_DQ
+	MC_PTRN_SET(mc_ptrn_dq),        // SWEEP_IN_DQ
+	MC_PTRN_SET(mc_ptrn_lane),      // SWEEP_OUT_DM
+	MC_PTRN_SET(mc_ptrn_lane),      // SWEEP_OUT_DQS
+	MC_PTRN_SET(mc_ptrn_lane),      // SWEEP_IN_DQS
+	MC_PTRN_SET(mc_ptrn_lane),      // SWEEP_OUT_LANE
+};
+
+static UINT32  mc_ptrn_buf[MC_PTRN_SIZE / sizeof(UINT32)]        __attribute__((aligned(16)));
+static UINT32  mc_ptrn_prbs[2][MC_PTRN_SIZE / sizeof(UINT32)]    __attribute__((aligned(16)));
+static BOOLEAN mc_ptrn_prbs_ready = FALSE;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_PTRN_Prbs_l                                                                         */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  buf -           MC_PTRN_SIZE bytes pattern                                             */
+/*                  order -         PRBS order n, polynomial x^n + x^(n-1) + 1                             */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine builds a PRBS pattern: DQ b of beat k is bit k + b * MC_PTRN_PRBS_SHIFT   */
+/*                  of the sequence                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_PTRN_Prbs_l (UINT32 *buf, UINT32 order)
+{
+	UINT8 seq[(MC_PTRN_SIZE / sizeof(UINT16)) + (15 * MC_PTRN_PRBS_SHIFT)];
+	UINT16 *beat = (UINT16 *)buf;
+	UINT32 lfsr = (1 << order) - 1;
+	UINT32 i, ibit;
+
+	for (i = 0; i < ARRAY_SIZE(seq); i++)
+	{
+		seq[i] = (UINT8)(((lfsr >> (order - 1)) ^ (lfsr >> (order - 2))) & 0x1);
+		lfsr = ((lfsr << 1) | seq[i]) & ((1 << order) - 1);
+	}
+
+	for (i = 0; i < MC_PTRN_SIZE / sizeof(UINT16); i++)
+	{
+		beat[i] = 0;
+		for (ibit = 0; ibit < 16; ibit++)
+			beat[i] |= (UINT16)(seq[i + (ibit * MC_PTRN_PRBS_SHIFT)] << ibit);
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_PTRN_Build_l                                                                        */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  kernel -        MC_PTRN_KERNEL_T, not BYTE_LANE / GOLDEN / RAM2                        */
+/*                                                                                                         */
+/* Returns:         MC_PTRN_SIZE bytes pattern                                                             */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine returns the pattern of a kernel. The walking patterns repeat to fill      */
+/*                  MC_PTRN_SIZE                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+static const UINT32 *MC_PTRN_Build_l (UINT8 kernel)
+{
+	UINT16 *beat = (UINT16 *)mc_ptrn_buf;
+	UINT32 i, k;
+
+	if ((kernel == MC_PTRN_PRBS7) || (kernel == MC_PTRN_PRBS15))
+	{
+		if (!mc_ptrn_prbs_ready)
+		{
+			MC_PTRN_Prbs_l(mc_ptrn_prbs[0], 7);
+			MC_PTRN_Prbs_l(mc_ptrn_prbs[1], 15);
+			mc_ptrn_prbs_ready = TRUE;
+		}
+		return mc_ptrn_prbs[kernel - MC_PTRN_PRBS7];
+	}
+
+	for (i = 0; i < MC_PTRN_SIZE / sizeof(UINT16); i++)
+	{
+		k = i % 32;
+
+		switch (kernel)
+		{
+		case MC_PTRN_WALK_1:
+			beat[i] = (UINT16)(0x0001 << (k % 16));
+			break;
+
+		case MC_PTRN_WALK_0:
+			beat[i] = (UINT16)(0xFFFF - (0x0001 << (k % 16)));
+			break;
+
+		case MC_PTRN_WALK_DEAD:
+			beat[i] = ((k % 2) == 0) ? (UINT16)(0xFFFF - (0x0001 << (k / 2))) : (UINT16)(0x0001 << (k / 2));
+			break;
+
+		case MC_PTRN_WALK_DEAD1:
+			beat[i] = ((k % 2) == 0) ? (UINT16)0xFFFF : (UINT16)(0x0001 << (k / 2));
+			break;
+
+		case MC_PTRN_WALK_DEAD2:
+			beat[i] = ((k % 2) == 0) ? (UINT16)(0xFFFF - (0x0001 << (k / 2))) : (UINT16)0;
+			break;
+
+		case MC_PTRN_SSO:
+			// toggle every beat, then every 2 and every 4 beats
+			if (i < 64)
+				beat[i] = (i & 0x1) ? 0xFFFF : 0;
+			else if (i < 96)
+				beat[i] = (i & 0x2) ? 0xFFFF : 0;
+			else
+				beat[i] = (i & 0x4) ? 0xFFFF : 0;
+			break;
+
+		case MC_PTRN_XTALK:
+			// 16 beats per victim (same DQ in both lanes)
+			beat[i] = (UINT16)(0x0101 << ((i / 16) % 8));
+			if (i & 0x1)
+				beat[i] = (UINT16)~beat[i];
+			break;
+
+		default:
+			((UINT32 *)beat)[i / 2] = mc_ptrn_fixed[kernel - MC_PTRN_00FFFF00];
+			break;
+		}
+	}
+
+	return mc_ptrn_buf;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_PTRN_Block_l                                                                        */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  ptrn -          pattern, 16 bytes aligned                                              */
+/*                  size -          multiple of 64 bytes                                                   */
+/*                  bECC -          check the ECC status instead of the data                               */
+/*                  ber -           bits that already fail                                                 */
+/*                                                                                                         */
+/* Returns:         bitwise ber (1 = fail)                                                                 */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine writes a pattern to DRAM and compares it                                  */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT16 MC_PTRN_Block_l (const UINT32 *ptrn, UINT32 size, BOOLEAN bECC, UINT16 ber)
+{
+	UINT64 diff;
+	UINT32 offset, chunk, i;
+
+	CopyBlock64((void *)MC_PTRN_ADDR, ptrn, size);
+
+	if (bECC == TRUE)
+	{
+		// full bursts: no read-modify-write, nothing of the write is left in the status
+		REG_WRITE(DENALI_CTL_145, 0xFFFFFFFF);
+		REG_WRITE(DENALI_CTL_145, 0);
+	}
+
+	for (offset = 0; offset < size; offset += chunk)
+	{
+		chunk = MIN(size - offset, MC_PTRN_RAM2_CHUNK);
+
+		if (bECC == TRUE)
+		{
+			for (i = 0; i < chunk; i += sizeof(UINT16))
+			{
+				ber |= GetECCSyndrom(MEMR16(MC_PTRN_ADDR + offset + i));
+			}
+		}
+		else
+		{
+			diff = XorOrBlock64((const void *)(UINT64)(MC_PTRN_ADDR + offset), (const UINT8 *)ptrn + offset, chunk);
+			diff |= diff >> 32;
+			ber |= (UINT16)(diff | (diff >> 16));
+		}
+
+		if (ber == 0xFFFF)
+			break;
+	}
+
+	return ber;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_PTRN_ByteLane_l                                                                     */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  ber -           bits that already fail                                                 */
+/*                                                                                                         */
+/* Returns:         bitwise ber (1 = fail)                                                                 */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine writes FF 00 00 FF by bytes, reads the words back and counts the failing  */
+/*                  words per lane in g_fail_rate_0 / g_fail_rate_1                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT16 MC_PTRN_ByteLane_l (UINT16 ber)
+{
+	UINT64 tmp_ber;
+	UINT32 iCnt2;
+
+	for (iCnt2 = 0; iCnt2 < MC_PTRN_BYTE_LANE_SIZE; iCnt2 += 4)
+	{
+		MEMW8(MC_PTRN_ADDR + iCnt2 + 0, 0xFF);
+		MEMW8(MC_PTRN_ADDR + iCnt2 + 1, 0x00);
+		MEMW8(MC_PTRN_ADDR + iCnt2 + 2, 0x00);
+		MEMW8(MC_PTRN_ADDR + iCnt2 + 3, 0xFF);
+	}
+
+	for (iCnt2 = 0; iCnt2 < MC_PTRN_BYTE_LANE_SIZE; iCnt2 += 8)
+	{
+		tmp_ber = MEMR64(MC_PTRN_ADDR + iCnt2) ^ 0xFF0000FFFF0000FFULL;
+		ber |= (UINT16)(tmp_ber | (tmp_ber >> 16) | (tmp_ber >> 32) | (tmp_ber >> 48));
+
+		// counters are 256 if it fail all the time
+		g_fail_rate_0 += ((tmp_ber & 0x000000FF) != 0) + ((tmp_ber & 0x000000FF00000000ULL) != 0);
+		g_fail_rate_1 += ((tmp_ber & 0x0000FF00) != 0) + ((tmp_ber & 0x0000FF0000000000ULL) != 0);
+	}
+
+	return ber;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_PTRN_Run_l                                                                          */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  set -           kernels to run, in order                                               */
+/*                  bECC -          check the ECC status instead of the data (not BYTE_LANE)               */
+/*                  ber -           bits that already fail (not swept)                                     */
+/*                                                                                                         */
+/* Returns:         bitwise ber (1 = fail)                                                                 */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine runs a set of kernels, until all the bits fail                            */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT16 MC_PTRN_Run_l (const MC_PTRN_SET_T *set, BOOLEAN bECC, UINT16 ber)
+{
+	UINT32 i;
+
+	// dummy access to DRAM:
+	IOW32(0x1000, IOR32(0x1000));
+	REG_WRITE(PHY_LANE_SEL, 0);
+
+	// clear all interrupt status bits:
+	REG_WRITE(DENALI_CTL_145, 0xFFFFFFFF);
+	REG_WRITE(DENALI_CTL_145, 0);
+
+	for (i = 0; (i < set->count) && (ber != 0xFFFF); i++)
+	{
+		switch (set->kernel[i])
+		{
+		case MC_PTRN_BYTE_LANE:
+			ber = MC_PTRN_ByteLane_l(ber);
+			break;
+
+		case MC_PTRN_GOLDEN:
+			ber = MC_PTRN_Block_l(Golden_Numbers, sizeof(Golden_Numbers), bECC, ber);
+			break;
+
+		case MC_PTRN_RAM2:
+			ber = MC_PTRN_Block_l((const UINT32 *)(UINT64)RAM2_BASE_ADDR, MC_PTRN_RAM2_SIZE, bECC, ber);
+			break;
+
+		default:
+			ber = MC_PTRN_Block_l(MC_PTRN_Build_l(set->kernel[i]), MC_PTRN_SIZE, bECC, ber);
+			break;
+		}
+	}
+
+	return ber;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_PTRN_Sweep_l                                                                        */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  SweepType -                                                                            */
+/*                  SweepBitMask -  bits that are not swept, reported as fail                              */
+/*                                                                                                         */
+/* Returns:         bitwise ber (1 = fail)                                                                 */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine runs the kernels of a sweep type on one sample point                      */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT16 MC_PTRN_Sweep_l (int SweepType, UINT16 SweepBitMask)
+{
+	if ((SweepType < 0) || (SweepType >= (int)ARRAY_SIZE(mc_ptrn_set_sweep)))
+		return MC_PTRN_Run_l(&mc_ptrn_set_long, FALSE, SweepBitMask);
+
+	return MC_PTRN_Run_l(&mc_ptrn_set_sweep[SweepType], FALSE, SweepBitMask);
+}
@@ -0,0 +1,196 @@
+/*----------------------------------------------------------------------------*/
+/* SPDX-License-Identifier: GPL-2.0                                           */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mc_drv_size.c                                                            */
+/*        This file contains the DRAM size and geometry probe (included from  */
+/*        mc_drv.c, built on the host by tools/mc_size_model.c)               */
+/* Project:                                                                   */
+/*        SWC HAL                                                             */
+/*----------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* DRAM size and geometry. A geometry (bank and row diff) that does not match the device aliases the DRAM  */
+/* below its size, so each candidate is probed for its wrap around: a signature is written at every alias  */
+/* first (the base address last) and all of them are read back once, then again with the inverted data. An */
+/* alias reads the base signature on both passes. The candidates come in order of preference, the header   */
+/* maximum (dram_max_size) bounds the aliases and ends the search once a geometry reaches it. The DDP      */
+/* geometry is both dies with all the address bits (4GB); a DDP device in any other geometry mirrors 0x10  */
+/* at 0x1010, which fails the geometry. A probe that reads neither its own signature nor the base one is a */
+/* DRAM failure, not an alias: it is reported and the geometry fails if it is the base                     */
+/*---------------------------------------------------------------------------------------------------------*/
+#define MC_SIZE_FAIL                0xFFFFFFFFLL
+#define MC_SIZE_DATA                0xFEDCBA987654321LL
+#define MC_SIZE_BASE                0x8000LL
+#define MC_SIZE_DDP_BASE            0x10LL
+#define MC_SIZE_DDP_MIRROR          0x1010LL
+#define MC_SIZE_PROBES              5           // aliases at 128MB to 2GB, DRAM 2GB-4GB is mapped at 4GB-6GB
+#define MC_SIZE_SIGNATURE(i)        (MC_SIZE_DATA ^ (0x0101010101010101ULL * (UINT64)((i) + 1)))
+
+static void   MC_SetBankRowCol (int bank_diff, int row_diff, int col_diff);      // mc_drv.c
+static void   MC_ClearOutOfRangeInt (void);                                      // mc_drv.c
+static UINT64 MC_MemTestAddr_l (UINT64 offset);                                  // mc_drv_mem_test.c
+
+typedef struct
+{
+	int         bank_diff;
+	int         row_diff;
+	BOOLEAN     ddp;                /* accepted at 4GB only (header maximum 4GB or more)                   */
+} MC_SIZE_GEOMETRY_T;
+
+static const MC_SIZE_GEOMETRY_T mc_size_geometry[] =
+{
+	{0, 0, TRUE},                   // probed if the header allows 4GB
+	{1, 1, FALSE},
+	{0, 1, FALSE},
+	{1, 0, FALSE},
+};
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_SizeProbe_l                                                                         */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  ddr_setup -                                                                            */
+/*                  geometry -      bank and row diff to probe                                             */
+/*                                                                                                         */
+/* Returns:         size of DRAM in this geometry or MC_SIZE_FAIL                                          */
+/* Side effects:    sets the geometry in the MC                                                            */
+/* Description:                                                                                            */
+/*                  This routine checks for the wrap around of a geometry, in one write and one read pass  */
+/*                  of signatures (twice, the second time inverted)                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 MC_SizeProbe_l (DDR_Setup *ddr_setup, const MC_SIZE_GEOMETRY_T *geometry)
+{
+	UINT64  addr[MC_SIZE_PROBES + 1];
+	UINT64  orig_data = MEMR64(MC_SIZE_BASE);
+	UINT64  inv;
+	UINT64  data;
+	UINT32  probes;
+	UINT32  alias[2] = {0, 0};
+	UINT32  mirror = 0;
+	UINT32  fail = 0;
+	UINT32  pass;
+	UINT32  i;
+
+	MC_ClearInterrupts();
+	MC_SetBankRowCol(geometry->bank_diff, geometry->row_diff, 2);
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Probe i (1 and up) is at 128MB << (i - 1), probe 0 is the base                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	probes = MIN(LOG(ddr_setup->max_ddr_size / _128MB_), MC_SIZE_PROBES);
+	addr[0] = MC_SIZE_BASE;
+	for (i = 1; i <= probes; i++)
+		addr[i] = MC_MemTestAddr_l(_128MB_ << (i - 1)) + MC_SIZE_BASE;
+
+	for (pass = 0; pass < 2; pass++)
+	{
+		inv = (pass == 0) ? 0 : ~0ULL;
+
+		MEMW64(MC_SIZE_DDP_MIRROR, MC_SIZE_SIGNATURE(MC_SIZE_PROBES + 1) ^ inv);
+		for (i = probes; i > 0; i--)
+			MEMW64(addr[i], MC_SIZE_SIGNATURE(i) ^ inv);
+		MEMW64(MC_SIZE_DDP_BASE, MC_SIZE_SIGNATURE(MC_SIZE_PROBES + 2) ^ inv);
+		MEMW64(addr[0], MC_SIZE_SIGNATURE(0) ^ inv);
+
+		if (MEMR64(MC_SIZE_DDP_MIRROR) == (MC_SIZE_SIGNATURE(MC_SIZE_PROBES + 2) ^ inv))
+			mirror++;
+
+		for (i = 0; i <= probes; i++)
+		{
+			data = MEMR64(addr[i]);
+			if ((i > 0) && (data == (MC_SIZE_SIGNATURE(0) ^ inv)))
+			{
+				alias[pass] |= MASK_BIT(i);
+			}
+			else if (data != (MC_SIZE_SIGNATURE(i) ^ inv))
+			{
+				HAL_PRINT_DBG(KYEL "size probe %#010lx read %#018lx expected %#018lx\n" KNRM, addr[i], data,
+					      MC_SIZE_SIGNATURE(i) ^ inv);
+				fail |= MASK_BIT(i);
+			}
+		}
+	}
+
+	// restore original data
+	MEMW64(MC_SIZE_BASE, orig_data);
+	MC_ClearOutOfRangeInt();
+	MC_ClearInterrupts();
+
+	alias[0] &= alias[1];
+	HAL_PRINT_DBG("bank%d row%d: %u probes, alias %#x, mirror %u, fail %#x\n", geometry->bank_diff,
+		      geometry->row_diff, probes, alias[0], mirror, fail);
+
+	// Special case for DDP because the pseudo-wrap is at 4K
+	if (mirror == 2)
+	{
+		ddr_setup->ddr_ddp = TRUE;
+		return MC_SIZE_FAIL;
+	}
+
+	if (fail & MASK_BIT(0))
+	{
+		HAL_PRINT_ERR(KRED "size probe %#010lx fails, bank%d row%d\n" KNRM, addr[0], geometry->bank_diff, geometry->row_diff);
+		return MC_SIZE_FAIL;
+	}
+
+	if (alias[0] == 0)
+		return (_128MB_ << LOG(ddr_setup->max_ddr_size / _128MB_));
+
+	return (_128MB_ << (LOG(alias[0] & ~(alias[0] - 1)) - 1));
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_SizeSearch_l                                                                        */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  ddr_setup -                                                                            */
+/*                                                                                                         */
+/* Returns:         size of DRAM, the header maximum if no geometry passed                                 */
+/* Side effects:    sets the geometry of the biggest size in the MC, and ddr_setup->ddr_ddp                */
+/* Description:                                                                                            */
+/*                  This routine probes the geometries in order of preference, up to the header maximum    */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 MC_SizeSearch_l (DDR_Setup *ddr_setup)
+{
+	const MC_SIZE_GEOMETRY_T *best = NULL;
+	UINT64 ddr_size = 0;
+	UINT64 size;
+	UINT32 i;
+
+	for (i = 0; i < ARRAY_SIZE(mc_size_geometry); i++)
+	{
+		if (mc_size_geometry[i].ddp && (ddr_setup->max_ddr_size < _4GB_))
+			continue;
+
+		size = MC_SizeProbe_l(ddr_setup, &mc_size_geometry[i]);
+		if (mc_size_geometry[i].ddp)
+			size = (size >= _4GB_) ? _4GB_ : MC_SIZE_FAIL;   // no alias up to 2GB, the probes see no further
+		if (size == MC_SIZE_FAIL)
+			continue;
+
+		if (size > ddr_size)
+		{
+			ddr_size = size;
+			best = &mc_size_geometry[i];
+		}
+
+		if (ddr_size >= ddr_setup->max_ddr_size)
+			break;
+	}
+
+	if (best == NULL)
+	{
+		HAL_PRINT_ERR(KRED ">DRAM size: no geometry passed\n" KNRM);
+		return ddr_setup->max_ddr_size;
+	}
+
+	MC_SetBankRowCol(best->bank_diff, best->row_diff, 2);
+	ddr_setup->ddr_ddp = best->ddp;
+
+	return ddr_size;
+}
@@ -0,0 +1,397 @@
+/*----------------------------------------------------------------------------*/
+/* SPDX-License-Identifier: GPL-2.0                                           */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mc_drv_sweep_run.c                                                       */
+/*        This file contains the sweep engines: coarse to fine sweep and eye  */
+/*        tracking of the VREF sweeps (included from mc_drv.c, built on the   */
+/*        host by tools/mc_sweep_model.c)                                     */
+/* Project:                                                                   */
+/*        SWC HAL                                                             */
+/*----------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Sweep engine: coarse pass every MC_SWEEP_COARSE_STEP points, then a fine pass that samples every point  */
+/* of an interval between two coarse samples if:                                                           */
+/*  - the two samples differ bitwise (an eye edge), or a neighbour interval has an edge: an eye or a       */
+/*    glitch narrower than the step next to an edge changes the edge rating                                */
+/*  - a swept bit passes on both samples: a glitch inside an eye splits it                                 */
+/*  - a swept bit never passed on a coarse sample: its eye, if any, is narrower than the step              */
+/* The other intervals fail on both samples for all the swept bits and take their status: a pass run of    */
+/* less than MC_SWEEP_COARSE_STEP points there is not seen, it is too small to be the eye of the bit or to */
+/* be rated as a second eye (MC_EYE_SECONDARY_MIN). The coarse pass ends MC_SWEEP_EXIT_MARGIN all-fail     */
+/* samples after every swept bit closed an eye of at least MC_SWEEP_MIN_EYE points. All lanes and bits are */
+/* tested in the same pass                                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+#define MC_SWEEP_COARSE_STEP        4
+#define MC_SWEEP_EXIT_MARGIN        2
+#define MC_SWEEP_MIN_EYE            8
+
+typedef void (*MC_SWEEP_SET_T) (int SweepType, int samplePoint, UINT16 SweepBitMask);
+
+static UINT16 Sweep_Sample_l (MC_SWEEP_SET_T set, int SweepType, int samplePoint, UINT16 SweepBitMask);   // mc_drv_sweeps.c
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        Sweep_Run_l                                                                            */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  set -           routine that writes the trim of the swept lanes/bits                   */
+/*                  SweepType -                                                                            */
+/*                  startScan -                                                                            */
+/*                  stopScan -                                                                             */
+/*                  SweepBitMask -                                                                         */
+/*                  BitStatus -     result, one entry per point from startScan to stopScan                 */
+/*                                                                                                         */
+/* Returns:         number of memory tests                                                                 */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine runs a coarse to fine sweep with early exit                               */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 Sweep_Run_l (MC_SWEEP_SET_T set, int SweepType, int startScan, int stopScan, UINT16 SweepBitMask, UINT16 *BitStatus)
+{
+	int points = stopScan - startScan + 1;
+	int eyeStart[16];
+	UINT16 closed = 0;
+	UINT16 opened = 0;
+	UINT16 pass;
+	UINT64 edges = 0;           // intervals between coarse samples, up to 64 (256 points)
+	UINT64 inside = 0;
+	UINT64 refine;
+	int failRun = 0;
+	int last = points - 1;
+	int i, j, k, prev, ibit;
+	UINT32 tests = 0;
+
+	for (ibit = 0; ibit < 16; ibit++)
+		eyeStart[ibit] = -1;
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Coarse pass                                                                                         */
+	/*-----------------------------------------------------------------------------------------------------*/
+	for (i = 0; i < points; i = ((i < points - 1) && (i + MC_SWEEP_COARSE_STEP > points - 1)) ? points - 1 : i + MC_SWEEP_COARSE_STEP)
+	{
+		BitStatus[i] = Sweep_Sample_l(set, SweepType, startScan + i, SweepBitMask);
+		tests++;
+
+		pass = (UINT16)~BitStatus[i];
+		opened |= pass;
+		for (ibit = 0; ibit < 16; ibit++)
+		{
+			if (READ_VAR_BIT(pass, ibit))
+			{
+				if (eyeStart[ibit] < 0)
+					eyeStart[ibit] = i;
+			}
+			else if (eyeStart[ibit] >= 0)
+			{
+				if (i - eyeStart[ibit] >= MC_SWEEP_MIN_EYE)
+					closed |= (UINT16)(1 << ibit);
+				eyeStart[ibit] = -1;
+			}
+		}
+
+		failRun = (BitStatus[i] == 0xFFFF) ? failRun + 1 : 0;
+		if (((closed | SweepBitMask) == 0xFFFF) && (failRun >= MC_SWEEP_EXIT_MARGIN))
+		{
+			last = i;
+			break;
+		}
+	}
+
+	for (i = last + 1; i < points; i++)
+		BitStatus[i] = 0xFFFF;
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Fine pass: refine the edges and their neighbour intervals, fill the others                          */
+	/*-----------------------------------------------------------------------------------------------------*/
+	for (k = 0, prev = 0; prev < last; k++, prev += MC_SWEEP_COARSE_STEP)
+	{
+		if (BitStatus[prev] != BitStatus[MIN(prev + MC_SWEEP_COARSE_STEP, last)])
+			edges |= 1ULL << k;
+		else if ((BitStatus[prev] | SweepBitMask) != 0xFFFF)
+			inside |= 1ULL << k;
+	}
+
+	refine = edges | (edges << 1) | (edges >> 1) | inside;
+	if ((opened | SweepBitMask) != 0xFFFF)
+		refine = ~0ULL;
+
+	for (k = 0, prev = 0, i = MIN(MC_SWEEP_COARSE_STEP, last); prev < last; k++, prev = i, i = MIN(i + MC_SWEEP_COARSE_STEP, last))
+	{
+		for (j = prev + 1; j < i; j++)
+		{
+			if (!READ_VAR_BIT(refine, k))
+			{
+				BitStatus[j] = BitStatus[prev];
+			}
+			else
+			{
+				BitStatus[j] = Sweep_Sample_l(set, SweepType, startScan + j, SweepBitMask);
+				tests++;
+			}
+		}
+	}
+
+	return tests;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Eye tracking for the VREF sweeps: the eye of a bit moves little between two VREF steps. A tracked sweep */
+/* takes the eye of the previous step as a guess and only searches the edges: it probes the guess, walks   */
+/* out from it in steps of 1, 2, 4... and bisects the last step. The memory test checks all bits at once,  */
+/* so bits with close edges share their probes. Each bit is assumed to have one eye per step (the sweep    */
+/* reports the biggest one anyway), and a bit that has no eye stays closed unless a probe of the other     */
+/* bits passes on it. A step with no open eye is not tested                                                */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct
+{
+	BOOLEAN track;                  /* next Sweep_DQn_Trim_l of this type searches around left/right       */
+	int     left[16];               /* first pass point of the eye of the last sweep, -1 if no eye         */
+	int     right[16];              /* last pass point                                                     */
+} MC_SWEEP_EYE_T;
+
+typedef struct
+{
+	MC_SWEEP_SET_T  set;
+	int             SweepType;
+	int             startScan;
+	UINT16          SweepBitMask;
+	UINT16          *BitStatus;
+	UINT8           tested[MC_EYE_POINTS];
+	UINT32          tests;
+} MC_SWEEP_PROBE_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        Sweep_Probe_l                                                                          */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  probe -         sweep point status, tested once                                        */
+/*                  i -             point (from startScan)                                                 */
+/*                  ibit -                                                                                 */
+/*                                                                                                         */
+/* Returns:         TRUE if bit ibit passes on point i                                                     */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine tests a point of a tracked sweep, unless it is already tested             */
+/*---------------------------------------------------------------------------------------------------------*/
+static BOOLEAN Sweep_Probe_l (MC_SWEEP_PROBE_T *probe, int i, int ibit)
+{
+	if (!probe->tested[i])
+	{
+		probe->BitStatus[i] = Sweep_Sample_l(probe->set, probe->SweepType, probe->startScan + i, probe->SweepBitMask);
+		probe->tested[i] = 1;
+		probe->tests++;
+	}
+
+	return (BOOLEAN)(READ_VAR_BIT(probe->BitStatus[i], ibit) == 0);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        Sweep_Edge_l                                                                           */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  probe -                                                                                */
+/*                  ibit -                                                                                 */
+/*                  pass -          a pass point of the eye                                                */
+/*                  guess -         the edge of the previous step                                          */
+/*                  dir -           -1 for the left edge, 1 for the right edge                             */
+/*                  points -        number of points                                                       */
+/*                                                                                                         */
+/* Returns:         last pass point from pass in direction dir                                             */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine searches an eye edge of one bit from a guess                              */
+/*---------------------------------------------------------------------------------------------------------*/
+static int Sweep_Edge_l (MC_SWEEP_PROBE_T *probe, int ibit, int pass, int guess, int dir, int points)
+{
+	int fail = (dir < 0) ? -1 : points;     // out of the sweep range: fail
+	int step, i;
+
+	if (((guess - pass) * dir > 0) && !Sweep_Probe_l(probe, guess, ibit))
+	{
+		/*-------------------------------------------------------------------------------------------------*/
+		/* Eye narrower than before: walk in from the guess                                                */
+		/*-------------------------------------------------------------------------------------------------*/
+		fail = guess;
+		for (step = 1; ((fail - dir * step) - pass) * dir > 0; step <<= 1)
+		{
+			i = fail - dir * step;
+			if (Sweep_Probe_l(probe, i, ibit))
+			{
+				pass = i;
+				break;
+			}
+			fail = i;
+		}
+	}
+	else
+	{
+		/*-------------------------------------------------------------------------------------------------*/
+		/* Eye as wide as before (or moved past the guess): walk out                                       */
+		/*-------------------------------------------------------------------------------------------------*/
+		if ((guess - pass) * dir > 0)
+			pass = guess;
+		for (step = 1; (fail - (pass + dir * step)) * dir > 0; step <<= 1)
+		{
+			i = pass + dir * step;
+			if (!Sweep_Probe_l(probe, i, ibit))
+			{
+				fail = i;
+				break;
+			}
+			pass = i;
+		}
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Bisect the last step                                                                                */
+	/*-----------------------------------------------------------------------------------------------------*/
+	while ((fail - pass) * dir > 1)
+	{
+		i = pass + (fail - pass) / 2;
+		if (Sweep_Probe_l(probe, i, ibit))
+			pass = i;
+		else
+			fail = i;
+	}
+
+	return pass;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        Sweep_Track_l                                                                          */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  set -           routine that writes the trim of the swept lanes/bits                   */
+/*                  SweepType -                                                                            */
+/*                  startScan -                                                                            */
+/*                  stopScan -                                                                             */
+/*                  SweepBitMask -                                                                         */
+/*                  BitStatus -     result, one entry per point from startScan to stopScan                 */
+/*                  eye -           eyes of the previous step                                              */
+/*                                                                                                         */
+/* Returns:         number of memory tests                                                                 */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine runs a sweep that searches the eye edges near the previous step. The      */
+/*                  result has one eye per bit: pass inside the edges, fail outside                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 Sweep_Track_l (MC_SWEEP_SET_T set, int SweepType, int startScan, int stopScan, UINT16 SweepBitMask, UINT16 *BitStatus,
+				const MC_SWEEP_EYE_T *eye)
+{
+	MC_SWEEP_PROBE_T probe;
+	int points = stopScan - startScan + 1;
+	int left[16], right[16];
+	int i, ibit, pass;
+	BOOLEAN open = FALSE;
+
+	probe.set = set;
+	probe.SweepType = SweepType;
+	probe.startScan = startScan;
+	probe.SweepBitMask = SweepBitMask;
+	probe.BitStatus = BitStatus;
+	probe.tests = 0;
+	for (i = 0; i < points; i++)
+		probe.tested[i] = 0;
+
+	for (ibit = 0; ibit < 16; ibit++)
+	{
+		left[ibit] = -1;
+		right[ibit] = -1;
+		if (!READ_VAR_BIT(SweepBitMask, ibit) && (eye->left[ibit] >= 0))
+			open = TRUE;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Open eyes: find a pass point (a tested one, the center or the edges), then the edges                */
+	/*-----------------------------------------------------------------------------------------------------*/
+	for (ibit = 0; open && (ibit < 16); ibit++)
+	{
+		if (READ_VAR_BIT(SweepBitMask, ibit) || (eye->left[ibit] < 0))
+			continue;
+
+		for (pass = eye->left[ibit]; pass <= eye->right[ibit]; pass++)
+		{
+			if (probe.tested[pass] && !READ_VAR_BIT(BitStatus[pass], ibit))
+				break;
+		}
+
+		if (pass > eye->right[ibit])
+		{
+			pass = (eye->left[ibit] + eye->right[ibit]) / 2;
+			if (!Sweep_Probe_l(&probe, pass, ibit))
+			{
+				pass = eye->left[ibit];
+				if (!Sweep_Probe_l(&probe, pass, ibit))
+				{
+					pass = eye->right[ibit];
+					if (!Sweep_Probe_l(&probe, pass, ibit))
+						continue;
+				}
+			}
+		}
+
+		left[ibit] = Sweep_Edge_l(&probe, ibit, pass, eye->left[ibit], -1, points);
+		right[ibit] = Sweep_Edge_l(&probe, ibit, pass, eye->right[ibit], 1, points);
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Closed eyes: open again only on a pass point tested for the other bits                              */
+	/*-----------------------------------------------------------------------------------------------------*/
+	for (ibit = 0; open && (ibit < 16); ibit++)
+	{
+		if (READ_VAR_BIT(SweepBitMask, ibit) || (eye->left[ibit] >= 0))
+			continue;
+
+		for (pass = 0; pass < points; pass++)
+		{
+			if (probe.tested[pass] && !READ_VAR_BIT(BitStatus[pass], ibit))
+			{
+				left[ibit] = Sweep_Edge_l(&probe, ibit, pass, pass, -1, points);
+				right[ibit] = Sweep_Edge_l(&probe, ibit, pass, pass, 1, points);
+				break;
+			}
+		}
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Result                                                                                              */
+	/*-----------------------------------------------------------------------------------------------------*/
+	for (i = 0; i < points; i++)
+	{
+		BitStatus[i] = 0xFFFF;
+		for (ibit = 0; ibit < 16; ibit++)
+		{
+			if ((left[ibit] <= i) && (i <= right[ibit]))
+				BitStatus[i] &= (UINT16)~(1 << ibit);
+		}
+	}
+
+	return probe.tests;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        Sweep_Walk_l                                                                           */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  step -                                                                                 */
+/*                  last -          last VREF of the sweep                                                 */
+/*                  start -         trained VREF                                                           */
+/*                                                                                                         */
+/* Returns:         VREF of step                                                                           */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine orders a tracked VREF sweep: from start up to last, then from start - 1   */
+/*                  down to the first VREF, so every step follows a step with a close eye                  */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 Sweep_Walk_l (UINT32 step, UINT32 last, UINT32 start)
+{
+	if (step <= last - start)
+		return start + step;
+
+	return start - 1 - (step - (last - start + 1));
+}
@@ -19,7 +19,6 @@
 #define MC_DQ_DQS_BITWISE_TRIM_SAMPLING_POINTS_TEST  ((UINT32)128)
 #define NUM_OF_LANES_TEST_SWEEP                      ((UINT32)2)
 
-extern BOOLEAN   bPrint;
 
 // move to global to use them outside of this funtion.
 UINT16            g_Table_Y_BitStatus[MC_DQ_DQS_BITWISE_TRIM_SAMPLING_POINTS_TEST] __attribute__((aligned(16))); // 16bit for 16 bit of data. each bit is 0 for pass or 1 for fail.
@@ -29,6 +28,7 @@ UINT32            g_PresetTrim[NUM_OF_LANES_TEST_SWEEP][8] __attribute__((aligne
 
 static volatile int               g_Table_Y_BestTrim_EyeCenter[16]    __attribute__((aligned(16)));
 static volatile int               g_Table_Y_BestTrim_EyeSize[16]      __attribute__((aligned(16)));
+static MC_EYE_T                   g_Table_Y_Eye[16];
 static volatile UINT16            g_Table_Z_BitStatus  [40][74] __attribute__((aligned(16)));
 static volatile UINT16            g_Table_Z2_BitStatus [40][74] __attribute__((aligned(16)));
 static volatile int               g_Table_MinEyeSize[74][2]          __attribute__((aligned(16)));
@@ -75,6 +75,158 @@ static void mc_init_sweep_arrays (void)
 	}
 }
 
+static MC_SWEEP_EYE_T g_SweepEye[SWEEP_OUT_DM + 1];     // per DQn sweep type
+static UINT32         g_SweepTests;                     // memory tests of the DQn sweeps
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        Sweep_Sample_l                                                                         */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  set -           routine that writes the trim of the swept lanes/bits                   */
+/*                  SweepType -                                                                            */
+/*                  samplePoint -                                                                          */
+/*                  SweepBitMask -                                                                         */
+/*                                                                                                         */
+/* Returns:         bitwise ber (1 = fail)                                                                 */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine sets one sample point and runs the memory test                            */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT16 Sweep_Sample_l (MC_SWEEP_SET_T set, int SweepType, int samplePoint, UINT16 SweepBitMask)
+{
+	set(SweepType, samplePoint, SweepBitMask);
+
+	g_fail_rate_0 = 0;
+	g_fail_rate_1 = 0;
+	return MC_PTRN_Sweep_l(SweepType, SweepBitMask);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        Sweep_DQn_Set_l                                                                        */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  SweepType -                                                                            */
+/*                  samplePoint -                                                                          */
+/*                  SweepBitMask -                                                                         */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine writes the DQn (or DM) trim of all swept bits                             */
+/*---------------------------------------------------------------------------------------------------------*/
+static void Sweep_DQn_Set_l (int SweepType, int samplePoint, UINT16 SweepBitMask)
+{
+	UINT32 ilane, ibit;
+	UINT32 NewTrimReg = TWOS_COMP_7BIT_VALUE_TO_REG(samplePoint);
+
+	// Update trim value into DQn and DM as needed
+	for (ilane = 0; ilane < NUM_OF_LANES_TEST_SWEEP; ilane++)
+	{
+		if (((SweepBitMask >> (ilane * 8)) & 0xFF) == 0xFF)
+			continue;
+
+		if (SweepType == SWEEP_OUT_DM)
+		{
+			REG_WRITE(PHY_LANE_SEL, ilane * DQS_DLY_WIDTH + 0x800);
+			REG_WRITE(OP_DQ_DM_DQS_BITWISE_TRIM, 0x180 | (0x7F & NewTrimReg));
+		}
+		else
+		{
+			for (ibit = 0; ibit < 8; ibit++)
+			{
+				if (((SweepBitMask >> (ilane * 8 + ibit)) & 0x1) == 0x1)
+					continue;
+
+				REG_WRITE(PHY_LANE_SEL, (ilane * DQS_DLY_WIDTH) + (ibit << 8));
+				if (SweepType == SWEEP_IN_DQ)
+					REG_WRITE(IP_DQ_DQS_BITWISE_TRIM, 0x80 | (0x7F & NewTrimReg));
+				else if (SweepType == SWEEP_OUT_DQ)
+					REG_WRITE(OP_DQ_DM_DQS_BITWISE_TRIM, 0x180 | (0x7F & NewTrimReg));
+			}
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        Sweep_DQS_Set_l                                                                        */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  SweepType -                                                                            */
+/*                  samplePoint -                                                                          */
+/*                  SweepBitMask -                                                                         */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine writes the DQS (or TRIM_2) trim of all swept lanes                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static void Sweep_DQS_Set_l (int SweepType, int samplePoint, UINT16 SweepBitMask)
+{
+	UINT32 ilane;
+	UINT32 NewTrimReg = (UINT32)samplePoint;
+
+	for (ilane = 0; ilane < NUM_OF_LANES_TEST_SWEEP; ilane++)
+	{
+		if (((SweepBitMask >> (ilane * 8)) & 0xFF) == 0xFF)
+			continue;
+
+		if (SweepType == SWEEP_OUT_DQS)
+		{
+			REG_WRITE(PHY_LANE_SEL, ilane * DQS_DLY_WIDTH + 0x900);
+			REG_WRITE(OP_DQ_DM_DQS_BITWISE_TRIM, 0x180 | (0x3F & NewTrimReg));
+		}
+		else if (SweepType == SWEEP_IN_DQS)
+		{
+			REG_WRITE(PHY_LANE_SEL, ilane * DQS_DLY_WIDTH + 0x800);
+			REG_WRITE(IP_DQ_DQS_BITWISE_TRIM, 0x80 | (0x3F & NewTrimReg));
+		}
+		else if (SweepType == SWEEP_OUT_LANE)
+		{
+			REG_WRITE(PHY_LANE_SEL, ilane * SLV_DLY_WIDTH);
+			SET_REG_FIELD(PHY_DLL_TRIM_2, PHY_DLL_TRIM_2_dlls_trim_2, 0x3F & NewTrimReg);
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        Sweep_Eyes_l                                                                           */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  BitStatus -     bitwise ber per point, from startScan                                  */
+/*                  points -        tested points                                                          */
+/*                  startScan -     value of point 0, for the prints                                       */
+/*                  report -        bits to report                                                         */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:    sets g_Table_Y_Eye, g_Table_Y_BestTrim_EyeCenter (from point 0) and EyeSize            */
+/* Description:                                                                                            */
+/*                  This routine finds the eyes of a sweep (mc_drv_eye.c) and warns about the ones that    */
+/*                  are clipped by the sweep range, have soft edges or a secondary eye                     */
+/*---------------------------------------------------------------------------------------------------------*/
+static void Sweep_Eyes_l (const UINT16 *BitStatus, int points, int startScan, UINT16 report)
+{
+	const MC_EYE_T *eye;
+	UINT32         ibit;
+
+	MC_EYE_Find_l(BitStatus, points, g_Table_Y_Eye);
+
+	for (ibit = 0; ibit < 16; ibit++)
+	{
+		eye = &g_Table_Y_Eye[ibit];
+		g_Table_Y_BestTrim_EyeCenter[ibit] = eye->center;
+		g_Table_Y_BestTrim_EyeSize[ibit] = eye->size;
+
+		if (((report & MASK_BIT(ibit)) == 0) || ((eye->flags & ~MC_EYE_NONE) == 0))
+			continue;
+
+		HAL_PRINT_DBG(KYEL " lane= %u; bit= %u; eye= %d..%d; edges= %u/%u; eyes= %u; second= %u;%s%s%s\n" KNRM,
+			      ibit / 8, ibit % 8, eye->left + startScan, eye->right + startScan, eye->edge[0], eye->edge[1],
+			      eye->eyes, eye->second, (eye->flags & MC_EYE_CLIPPED) ? " clipped;" : "",
+			      (eye->flags & MC_EYE_SOFT_EDGE) ? " soft edge;" : "",
+			      (eye->flags & MC_EYE_SECONDARY) ? " secondary eye;" : "");
+	}
+}
+
 /*---------------------------------------------------------------------------------------------------------*/
 /* Function:        Sweep_DQn_Trim_l                                                                       */
 /*                                                                                                         */
@@ -92,7 +244,7 @@ DEFS_STATUS Sweep_DQn_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 {
 	int samplePoint = 0;
 	UINT32 ilane, ibit, ind;
-	UINT32 NewTrimReg;
+	UINT32 tests;
 
 	int startScan = ((int)-62);
 	int stopScan = ((int)62);
@@ -127,11 +279,12 @@ DEFS_STATUS Sweep_DQn_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 		break;
 
 	default:
-		HAL_PRINT_DBG(KRED "Sweep_DQn_Trim_l ERROR: invalid sweep type. 0x%X\n" KNRM, SweepType);
+		HAL_PRINT_ERR(KRED "Sweep_DQn_Trim_l ERROR: invalid sweep type. 0x%X\n" KNRM, SweepType);
 		return DEFS_STATUS_FAIL;
 	}
 
 	HAL_PRINT_DBG(" (SweepBitMask=0x%04X)\n", SweepBitMask);
+	BOOT_TRACE_Begin(BOOT_TRACE_DDR_SWEEP, SweepType);
 
 	/*---------------------------------------------------------------------------------------------------------*/
 	/*      Get default values (of all lanes)                                                                  */
@@ -163,48 +316,12 @@ DEFS_STATUS Sweep_DQn_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 	/*---------------------------------------------------------------------------------------------------------*/
 	/*      Sweep                                                                                              */
 	/*---------------------------------------------------------------------------------------------------------*/
-	for (samplePoint = startScan; samplePoint <= stopScan; samplePoint++)
-	{
-		NewTrimReg = TWOS_COMP_7BIT_VALUE_TO_REG(samplePoint);
-
-		// Update trim value into DQn and DM as needed
-		for (ilane = 0; ilane < NUM_OF_LANES_TEST_SWEEP; ilane++)
-		{
-			if (((SweepBitMask >> (ilane * 8)) & 0xFF) == 0xFF)
-				continue;
-
-			if (SweepType == SWEEP_OUT_DM)
-			{
-				REG_WRITE(PHY_LANE_SEL, ilane * DQS_DLY_WIDTH + 0x800);
-				REG_WRITE(OP_DQ_DM_DQS_BITWISE_TRIM, 0x180 | (0x7F & NewTrimReg));
-			}
-			else
-			{
-				for (ibit = 0; ibit < 8; ibit++)
-				{
-					if (((SweepBitMask >> (ilane * 8 + ibit)) & 0x1) == 0x1)
-						continue;
-
-					REG_WRITE(PHY_LANE_SEL, (ilane * DQS_DLY_WIDTH) + (ibit << 8));
-					if (SweepType == SWEEP_IN_DQ)
-						REG_WRITE(IP_DQ_DQS_BITWISE_TRIM, 0x80 | (0x7F & NewTrimReg));
-					else if (SweepType == SWEEP_OUT_DQ)
-						REG_WRITE(OP_DQ_DM_DQS_BITWISE_TRIM, 0x180 | (0x7F & NewTrimReg));
-				}
-			}
-		}
-
-		// dummy accsess to DDR
-		IOW32(0x1000, IOR32(0x1000));
-		REG_WRITE(PHY_LANE_SEL, 0);
-
-		g_fail_rate_0 = 0; // Uncomment to check failure rate
-		g_fail_rate_1 = 0; // Uncomment to check failure rate
-		UINT16 ber = MC_MemStressTestLong(FALSE, FALSE, SweepBitMask, FALSE);
-		g_Table_Y_BitStatus[(samplePoint - startScan) % MC_DQ_DQS_BITWISE_TRIM_SAMPLING_POINTS_TEST] = ber;
-		// if ((g_fail_rate_0 < 100) || (g_fail_rate_1 < 100) )
-		//	HAL_PRINT_DBG(" val= %3d; ber=%04X; faliure rate: lane1= %u, lane0= %u \n", samplePoint,  ber, g_fail_rate_1, g_fail_rate_0);
-	}
+	if (g_SweepEye[SweepType].track)
+		tests = Sweep_Track_l(Sweep_DQn_Set_l, SweepType, startScan, stopScan, SweepBitMask, g_Table_Y_BitStatus, &g_SweepEye[SweepType]);
+	else
+		tests = Sweep_Run_l(Sweep_DQn_Set_l, SweepType, startScan, stopScan, SweepBitMask, g_Table_Y_BitStatus);
+	g_SweepTests += tests;
+	HAL_PRINT_DBG(" %u of %d points tested\n", tests, stopScan - startScan + 1);
 
 	//-------------------------------------
 	HAL_PRINT_DBG("                                   lane1     lane0    \n");
@@ -226,7 +343,16 @@ DEFS_STATUS Sweep_DQn_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 	}
 	//-------------------------------------
 
-	FindMidBiggestEyeBitwise_l(g_Table_Y_BitStatus, ARRAY_SIZE(g_Table_Y_BitStatus), g_Table_Y_BestTrim_EyeCenter, g_Table_Y_BestTrim_EyeSize, 16);
+	Sweep_Eyes_l(g_Table_Y_BitStatus, stopScan - startScan + 1, startScan, (UINT16)~SweepBitMask);
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Keep the eyes for the next tracked sweep                                                            */
+	/*-----------------------------------------------------------------------------------------------------*/
+	for (ibit = 0; ibit < 16; ibit++)
+	{
+		g_SweepEye[SweepType].left[ibit] = g_Table_Y_Eye[ibit].left;
+		g_SweepEye[SweepType].right[ibit] = g_Table_Y_Eye[ibit].right;
+	}
 
 	/*-----------------------------------------------------------------------------------------------------*/
 	/* Add startScan as on offset to best trim (if the step is different than 1 need to change this too)   */
@@ -262,7 +388,7 @@ DEFS_STATUS Sweep_DQn_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 			/*---------------------------------------------------------------------------------------------*/
 			if (g_Table_Y_BestTrim_EyeSize[ibit] < 4) // NTIL: changed 5 to 4 for ATE
 			{
-				HAL_PRINT(KRED " eye center= %3d (Error: no eye center or eye size too small, use the origin value %3d)" KNRM, ilane, (ibit % 8), g_Table_Y_BestTrim_EyeSize[ibit], (TWOS_COMP_7BIT_REG_TO_VALUE(g_PresetTrim[ilane][ibit % 8])));
+				HAL_PRINT_ERR(KRED " eye center= %3d (Error: no eye center or eye size too small, use the origin value %3d)" KNRM, ilane, (ibit % 8), g_Table_Y_BestTrim_EyeSize[ibit], (TWOS_COMP_7BIT_REG_TO_VALUE(g_PresetTrim[ilane][ibit % 8])));
 				g_Table_Y_BestTrim_EyeCenter[ibit] = (TWOS_COMP_7BIT_REG_TO_VALUE(g_PresetTrim[ilane][ibit % 8]));
 				status = DEFS_STATUS_HARDWARE_ERROR;
 			}
@@ -287,7 +413,7 @@ DEFS_STATUS Sweep_DQn_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 				ind = ilane * 8 + ibit;
 				if (g_Table_Y_BestTrim_EyeSize[ind] < 10)
 				{
-					HAL_PRINT_DBG(KRED "ERROR:   in DQn lane %d bit %d eye size %3d \n" KNRM, ilane, ibit, g_Table_Y_BestTrim_EyeSize[ind]);
+					HAL_PRINT_ERR(KRED "ERROR:   in DQn lane %d bit %d eye size %3d \n" KNRM, ilane, ibit, g_Table_Y_BestTrim_EyeSize[ind]);
 #ifdef _SORT_
 					status = DEFS_STATUS_HARDWARE_ERROR;
 #endif
@@ -325,7 +451,7 @@ DEFS_STATUS Sweep_DQn_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 				ind = (ilane * 8 + ibit) % 16;
 				if (g_Table_Y_BestTrim_EyeSize[ind] < 10)
 				{
-					HAL_PRINT_DBG(KRED "ERROR:   out DQn lane %d bit %d eye size %3d \n" KNRM, ilane, ibit, g_Table_Y_BestTrim_EyeSize[ind]);
+					HAL_PRINT_ERR(KRED "ERROR:   out DQn lane %d bit %d eye size %3d \n" KNRM, ilane, ibit, g_Table_Y_BestTrim_EyeSize[ind]);
 				}
 				else if (g_Table_Y_BestTrim_EyeSize[ind] >= 12)
 				{
@@ -377,6 +503,8 @@ DEFS_STATUS Sweep_DQn_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 	IOW32(0x1000, IOR32(0x1000));
 	REG_WRITE(PHY_LANE_SEL, 0);
 
+	BOOT_TRACE_End(BOOT_TRACE_DDR_SWEEP, SweepType);
+
 	return status;
 }
 
@@ -384,7 +512,7 @@ DEFS_STATUS Sweep_DQS_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 {
 	int samplePoint = 0;
 	UINT32 ilane, ibit;
-	UINT32 NewTrimReg;
+	UINT32 tests;
 
 	int startScan = ((int)0);
 	int stopScan = ((int)63);
@@ -417,11 +545,12 @@ DEFS_STATUS Sweep_DQS_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 			break;
 
 		default:
-			HAL_PRINT_DBG(KRED "ERROR: invalid sweep type\n" KNRM);
+			HAL_PRINT_ERR(KRED "ERROR: invalid sweep type\n" KNRM);
 			return DEFS_STATUS_FAIL;
 	}
 
 	HAL_PRINT_DBG("(SweepBitMask=0x%04X)\n", SweepBitMask);
+	BOOT_TRACE_Begin(BOOT_TRACE_DDR_SWEEP, SweepType);
 
 	mc_init_sweep_arrays();
 
@@ -462,41 +591,12 @@ DEFS_STATUS Sweep_DQS_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 	/*---------------------------------------------------------------------------------------------------------*/
 	/*      Sweep                                                                                              */
 	/*---------------------------------------------------------------------------------------------------------*/
+	tests = Sweep_Run_l(Sweep_DQS_Set_l, SweepType, startScan, stopScan, SweepBitMask, g_Table_Y_BitStatus);
+	HAL_PRINT_DBG(" %u of %d points tested\n", tests, stopScan - startScan + 1);
+
 	for (samplePoint = startScan; samplePoint <= stopScan; samplePoint++)
 	{
-		NewTrimReg = (UINT32)samplePoint;
-
-		// Update trim value into DQn and DM as needed
-		for (ilane = 0; ilane < NUM_OF_LANES_TEST_SWEEP; ilane++)
-		{
-			if (((SweepBitMask >> (ilane * 8)) & 0xFF) == 0xFF)
-				continue;
-
-			if (SweepType == SWEEP_OUT_DQS)
-			{
-				REG_WRITE(PHY_LANE_SEL, ilane * DQS_DLY_WIDTH + 0x900);
-				REG_WRITE(OP_DQ_DM_DQS_BITWISE_TRIM, 0x180 | (0x3F & NewTrimReg));
-			}
-			else if (SweepType == SWEEP_IN_DQS)
-			{
-				REG_WRITE(PHY_LANE_SEL, ilane * DQS_DLY_WIDTH + 0x800);
-				REG_WRITE(IP_DQ_DQS_BITWISE_TRIM, 0x80 | (0x3F & NewTrimReg));
-			}
-			else if (SweepType == SWEEP_OUT_LANE)
-			{
-				REG_WRITE(PHY_LANE_SEL, ilane * SLV_DLY_WIDTH);
-				SET_REG_FIELD(PHY_DLL_TRIM_2, PHY_DLL_TRIM_2_dlls_trim_2, 0x3F & NewTrimReg);
-			}
-		}
-
-		// dummy accsess to DDR
-		IOW32(0x1000, IOR32(0x1000));
-		REG_WRITE(PHY_LANE_SEL, 0);
-
-		g_fail_rate_0 = 0; // NTIL: Meir want to check failure rate
-		g_fail_rate_1 = 0; // NTIL: Meir want to check failure rate
-		UINT16 ber = MC_MemStressTestLong(FALSE, FALSE, SweepBitMask, FALSE);
-		g_Table_Y_BitStatus[(samplePoint - startScan) % MC_DQ_DQS_BITWISE_TRIM_SAMPLING_POINTS_TEST] = ber;
+		UINT16 ber = g_Table_Y_BitStatus[(samplePoint - startScan) % MC_DQ_DQS_BITWISE_TRIM_SAMPLING_POINTS_TEST];
 
 		// Output DQS, Input DQS and TRIM2 delays are set per lane and not per DQ therefore combine (merge) ber restouls of DQ0 to DQ7 and DQ8 to DQ15
 		if ((ber & 0x00FF) != 0)
@@ -504,9 +604,6 @@ DEFS_STATUS Sweep_DQS_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 		if ((ber & 0xFF00) != 0)
 			ber |= 0xFF00; // one for all. if one DQ bit in lane1 fail, mark all lane1 DQ as fail.
 		g_Table_Y_LaneStatus[(samplePoint - startScan) % MC_DQ_DQS_BITWISE_TRIM_SAMPLING_POINTS_TEST] = ber;
-
-		// if ((g_fail_rate_0 < 100) || (g_fail_rate_1 < 100) )
-		//	HAL_PRINT_DBG(" val= %3d; ber=%04X; faliure rate: lane1= %u, lane0= %u \n", samplePoint,  ber, g_fail_rate_1, g_fail_rate_0);
 	}
 
 	//-------------------------------------
@@ -529,7 +626,7 @@ DEFS_STATUS Sweep_DQS_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 	}
 	//-------------------------------------
 
-	FindMidBiggestEyeBitwise_l(g_Table_Y_LaneStatus, ARRAY_SIZE(g_Table_Y_LaneStatus), g_Table_Y_BestTrim_EyeCenter, g_Table_Y_BestTrim_EyeSize, 16);
+	Sweep_Eyes_l(g_Table_Y_LaneStatus, stopScan - startScan + 1, startScan, (UINT16)~SweepBitMask & 0x0101);
 
 	/*-----------------------------------------------------------------------------------------------------*/
 	/* Add startScan as on offset to best trim (if the step is different than 1 need to change this too)   */
@@ -559,7 +656,7 @@ DEFS_STATUS Sweep_DQS_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 			/*---------------------------------------------------------------------------------------------*/
 			if (g_Table_Y_BestTrim_EyeSize[8 * ilane] < 15)
 			{
-				HAL_PRINT(KRED " eye center= %3d (Error: no eye center or eye size too small. Use the origin value %3d).\n" KNRM, g_Table_Y_BestTrim_EyeCenter[8 * ilane], g_PresetTrim[ilane][0]);
+				HAL_PRINT_ERR(KRED " eye center= %3d (Error: no eye center or eye size too small. Use the origin value %3d).\n" KNRM, g_Table_Y_BestTrim_EyeCenter[8 * ilane], g_PresetTrim[ilane][0]);
 				g_Table_Y_BestTrim_EyeCenter[8 * ilane] = ((g_PresetTrim[ilane][0]));
 				status = DEFS_STATUS_HARDWARE_ERROR;
 			}
@@ -604,7 +701,7 @@ DEFS_STATUS Sweep_DQS_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 
 			if (g_Table_Y_BestTrim_EyeSize[8 * ilane] < 20)
 			{
-				HAL_PRINT_DBG(KRED "ERROR:   DQS lane%d eye size %3d \n" KNRM, ilane, g_Table_Y_BestTrim_EyeSize[8 * ilane]);
+				HAL_PRINT_ERR(KRED "ERROR:   DQS lane%d eye size %3d \n" KNRM, ilane, g_Table_Y_BestTrim_EyeSize[8 * ilane]);
 			}
 			else if (g_Table_Y_BestTrim_EyeSize[8 * ilane] >= 28)
 			{
@@ -632,7 +729,7 @@ DEFS_STATUS Sweep_DQS_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 
 			if (g_Table_Y_BestTrim_EyeSize[8 * ilane] < 20)
 			{
-				HAL_PRINT_DBG(KRED "ERROR:   TRIM2 lane%d eye size %3d \n" KNRM, ilane, g_Table_Y_BestTrim_EyeSize[8 * ilane]);
+				HAL_PRINT_ERR(KRED "ERROR:   TRIM2 lane%d eye size %3d \n" KNRM, ilane, g_Table_Y_BestTrim_EyeSize[8 * ilane]);
 			}
 			else if (g_Table_Y_BestTrim_EyeSize[8 * ilane] >= 30)
 			{
@@ -656,6 +753,8 @@ DEFS_STATUS Sweep_DQS_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 	IOW32(0x1000, IOR32(0x1000));
 	REG_WRITE(PHY_LANE_SEL, 0);
 
+	BOOT_TRACE_End(BOOT_TRACE_DDR_SWEEP, SweepType);
+
 	return status;
 }
 
@@ -663,384 +762,19 @@ DEFS_STATUS Sweep_DQS_Trim_l (DDR_Setup *ddr_setup, int SweepType, BOOLEAN DoCen
 /* Function:        MC_MemStressTestLong                                                                   */
 /*                                                                                                         */
 /* Parameters:                                                                                             */
-/*                  abort_on_error -                                                                       */
-/*                  bECC -                                                                                 */
-/*                  bQuick -                                                                               */
-/*                  SweepBitMask -                                                                         */
+/*                  abort_on_error - not used, the test stops once all the bits fail                       */
+/*                  bECC -           check the ECC status instead of the data                              */
+/*                  bQuick -         byte lane and two fixed patterns only                                 */
+/*                  SweepBitMask -   bits that are not of interest, reported as fail                       */
 /*                                                                                                         */
-/* Returns:                                                                                                */
+/* Returns:         bitwise ber (1 = fail)                                                                 */
 /* Side effects:                                                                                           */
 /* Description:                                                                                            */
-/*                  This routine performs...                                                               */
+/*                  This routine does memory test with a list of patterns (mc_drv_ptrn.c)                  */
 /*---------------------------------------------------------------------------------------------------------*/
 UINT16 MC_MemStressTestLong (BOOLEAN bECC, BOOLEAN bQuick, UINT16 SweepBitMask, BOOLEAN abort_on_error)
 {
-	UINT16 ber = 0;
-
-	ber = SweepBitMask; // bits that are not of our interest, mark as fail so test will be complete faster
-
-	const UINT32 aPtrn[] = {0x00FFFF00, 0xFF0000FF, 0xFFFF0000, 0x0000FFFF};
-	const UINT32 iPtrnSize = 0x100;
-	const UINT iWalkers = 0x10; // NTIL - there is no point to shift 0x0001 more then 16 steps (0 to 15);
-
-	UINT32 iCnt1 = 0;
-	UINT32 iCnt2 = 0;
-
-	extern UINT32 BOOTBLOCK_IMAGE_START;
-	extern UINT32 BOOTBLOCK_IMAGE_END;
-
-	volatile UINT8 *dstAddrStart_U8 = (UINT8 *)0x1000;
-	volatile UINT16 *dstAddrStart_U16 = (UINT16 *)0x1000;
-	volatile UINT32 *dstAddrStart_U32 = (UINT32 *)0x1000;
-
-	// dummy access to DRAM:
-	IOW32(0x1000, IOR32(0x1000));
-	REG_WRITE(PHY_LANE_SEL, 0);
-
-	// clear all interrupt status bits:
-	REG_WRITE(DENALI_CTL_145, 0xFFFFFFFF);
-	REG_WRITE(DENALI_CTL_145, 0);
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*                    Write Byte accsess test                                                          */
-	/*-----------------------------------------------------------------------------------------------------*/
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*  Write pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U8 = (UINT8 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iPtrnSize; iCnt2++)
-	{
-		*dstAddrStart_U8 = 0xFF;
-		dstAddrStart_U8++;
-		*dstAddrStart_U8 = 0x00;
-		dstAddrStart_U8++;
-		*dstAddrStart_U8 = 0x00;
-		dstAddrStart_U8++;
-		*dstAddrStart_U8 = 0xFF;
-		dstAddrStart_U8++;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Verify pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U32 = (UINT32 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iPtrnSize; iCnt2++)
-	{
-		UINT32 tmp_ber = *dstAddrStart_U32 ^ 0xFF0000FF;
-		ber |= (UINT16)(tmp_ber >> 0);
-		ber |= (UINT16)(tmp_ber >> 16);
-		dstAddrStart_U32++;
-
-		if (tmp_ber & 0x00FF)
-			g_fail_rate_0++; // counter is 256 if it fail all the time
-
-		if (tmp_ber & 0xFF00)
-			g_fail_rate_1++; // counter is 256 if it fail all the time
-	}
-
-	if (ber == 0xFFFF)
-	{
-		return ber;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*                    Fixed pattern test                                                               */
-	/*-----------------------------------------------------------------------------------------------------*/
-	for (iCnt1 = 0; iCnt1 < ARRAY_SIZE(aPtrn); iCnt1++)
-	{
-		/*----------------------------------------------------------------------------------------------------*/
-		/*  Write pattern                                                                                     */
-		/*----------------------------------------------------------------------------------------------------*/
-		// memset((void *)dstAddrStart, (UINT8)aPtrn[iCnt1], iPtrnSize);
-		dstAddrStart_U32 = (UINT32 *)0x1000;
-		for (iCnt2 = 0; iCnt2 < iPtrnSize; iCnt2 += 4)
-		{
-			*dstAddrStart_U32 = aPtrn[iCnt1];
-			dstAddrStart_U32++;
-		}
-
-		/*-----------------------------------------------------------------------------------------------------*/
-		/* Verify pattern                                                                                      */
-		/*-----------------------------------------------------------------------------------------------------*/
-		// NTIL: removed GetECCSyndrom. There was a bug in the origin code !!! the bug seen when changing aPtrn data from 0xFFFFFFFF to 0xFFFF0000
-		dstAddrStart_U32 = (UINT32 *)0x1000;
-		for (iCnt2 = 0; iCnt2 < iPtrnSize; iCnt2 += 4)
-		{
-			UINT32 tmp_ber = *dstAddrStart_U32 ^ aPtrn[iCnt1];
-			ber |= (UINT16)(tmp_ber >> 0);
-			ber |= (UINT16)(tmp_ber >> 16);
-
-			dstAddrStart_U32++;
-		}
-
-		if ((iCnt1 == 1) && (bQuick == TRUE))
-		{
-			return ber;
-		}
-
-		if (ber == 0xFFFF)
-		{
-			return ber;
-		}
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Walking-1 pattern test                                                                              */
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*  Write pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U16 = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		*dstAddrStart_U16 = (0x0001 << (iCnt2));
-		dstAddrStart_U16++;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Verify pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U16 = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		if (bECC == TRUE)
-		{
-			ber |= GetECCSyndrom(*dstAddrStart_U16);
-		}
-		else
-		{
-			ber |= *dstAddrStart_U16 ^ (0x0001 << (iCnt2));
-		}
-		dstAddrStart_U16++;
-	}
-	if (ber == 0xFFFF)
-	{
-		return ber;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Walking-0 pattern test                                                                              */
-	/*-----------------------------------------------------------------------------------------------------*/
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*  Write pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U16 = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		*dstAddrStart_U16 = 0xFFFF - (0x0001 << (iCnt2));
-		dstAddrStart_U16++;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Verify pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U16 = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
-	{
-		if (bECC == TRUE)
-		{
-			ber |= GetECCSyndrom(*dstAddrStart_U16);
-		}
-		else
-		{
-			ber |= *dstAddrStart_U16 ^ (0xFFFF - (0x0001 << (iCnt2)));
-		}
-		dstAddrStart_U16++;
-	}
-	if (ber == 0xFFFF)
-	{
-		return ber;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*                   Walking dead pattern test                                                         */
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*  Write pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U16 = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < (iWalkers * 2); iCnt2++)
-	{
-		if ((iCnt2 % 2) == 0)
-		{
-			*dstAddrStart_U16 = 0xFFFF - (0x0001 << (iCnt2 / 2));
-		}
-		else
-		{
-			*dstAddrStart_U16 = (0x0001 << (iCnt2 / 2));
-		}
-		dstAddrStart_U16++;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Verify pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U16 = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < (iWalkers * 2); iCnt2++)
-	{
-		if (bECC == TRUE)
-		{
-			ber |= GetECCSyndrom(*dstAddrStart_U16);
-		}
-		else
-		{
-			if ((iCnt2 % 2) == 0)
-			{
-				ber |= *dstAddrStart_U16 ^ (0xFFFF - (0x0001 << (iCnt2 / 2)));
-			}
-			else
-			{
-				ber |= *dstAddrStart_U16 ^ (0x0001 << (iCnt2 / 2));
-			}
-		}
-		dstAddrStart_U16++;
-	}
-	if (ber == 0xFFFF)
-	{
-		return ber;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*                    Walking dead1 pattern test                                                       */
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*  Write pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U16 = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < (iWalkers * 2); iCnt2++)
-	{
-		if ((iCnt2 % 2) == 0)
-		{
-			*dstAddrStart_U16 = 0xFFFF;
-		}
-		else
-		{
-			*dstAddrStart_U16 = (0x0001 << (iCnt2 / 2));
-		}
-		dstAddrStart_U16++;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Verify pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U16 = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < (iWalkers * 2); iCnt2++)
-	{
-		if (bECC == TRUE)
-		{
-			ber |= GetECCSyndrom(*dstAddrStart_U16);
-		}
-		else
-		{
-			if ((iCnt2 % 2) == 0)
-			{
-				ber |= *dstAddrStart_U16 ^ 0xFFFF;
-			}
-			else
-			{
-				ber |= *dstAddrStart_U16 ^ (0x0001 << (iCnt2 / 2));
-			}
-		}
-
-		dstAddrStart_U16++;
-	}
-	if (ber == 0xFFFF)
-	{
-		return ber;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*                     Walking dead2 pattern test                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*  Write pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U16 = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < (iWalkers * 2); iCnt2++)
-	{
-		if ((iCnt2 % 2) == 0)
-		{
-			*dstAddrStart_U16 = 0xFFFF - (0x0001 << (iCnt2 / 2));
-		}
-		else
-		{
-			*dstAddrStart_U16 = 0;
-		}
-		dstAddrStart_U16++;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Verify pattern                                                                                      */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U16 = (UINT16 *)0x1000;
-	for (iCnt2 = 0; iCnt2 < (iWalkers * 2); iCnt2++)
-	{
-		if (bECC == TRUE)
-		{
-			ber |= GetECCSyndrom(*dstAddrStart_U16);
-		}
-		else
-		{
-			if ((iCnt2 % 2) == 0)
-			{
-				ber |= *dstAddrStart_U16 ^ (0xFFFF - (0x0001 << (iCnt2 / 2)));
-			}
-			else
-			{
-				ber |= *dstAddrStart_U16 ^ 0;
-			}
-		}
-		dstAddrStart_U16++;
-	}
-	if (ber == 0xFFFF)
-	{
-		return ber;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*                     Copy bootblock code from SRAM to DRAM                                           */
-	/*-----------------------------------------------------------------------------------------------------*/
-
-	// NTIL: move bootblock test to last test since this test take too much time (first it copy then it check)
-	/*-----------------------------------------------------------------------------------------------------*/
-	/*  Use RAM2 as a pseudo random pattern to test the DDR                                                */
-	/*  Copy BB code segment to the DDR                                                                    */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U16 = (UINT16 *)0x1000;
-
-	for (iCnt2 = 0; iCnt2 < 0x10000 /* (&(UINT32)BOOTBLOCK_IMAGE_END - RAM2_MEMORY_SIZE)*/; iCnt2 += sizeof(UINT16))
-	{
-		*dstAddrStart_U16 = *(UINT16 *)(RAM2_BASE_ADDR + iCnt2);
-		dstAddrStart_U16++;
-	}
-
-	/*-----------------------------------------------------------------------------------------------------*/
-	/* Compare BB code segment to the DDR                                                                  */
-	/*-----------------------------------------------------------------------------------------------------*/
-	dstAddrStart_U16 = (UINT16 *)0x1000;
-
-	for (iCnt2 = 0; iCnt2 < 0x10000 /* (&(UINT32)BOOTBLOCK_IMAGE_END - RAM2_MEMORY_SIZE)  */; iCnt2 += sizeof(UINT16))
-	{
-		if (bECC == TRUE)
-		{
-			ber |= GetECCSyndrom(*(UINT16 *)(RAM2_BASE_ADDR + iCnt2));
-		}
-		else
-		{
-			ber |= *dstAddrStart_U16 ^ *(UINT16 *)(RAM2_BASE_ADDR + iCnt2);
-		}
-
-		// NTIL: save time and return as soos as posiable when there is total bits error (don't wait to verify to complete)
-		if (ber == 0xFFFF)
-			return ber;
-
-		dstAddrStart_U16++;
-	}
-
-	return ber;
+	return MC_PTRN_Run_l((bQuick == TRUE) ? &mc_ptrn_set_long_quick : &mc_ptrn_set_long, bECC, SweepBitMask);
 }
 
 /*---------------------------------------------------------------------------------------------------------*/
@@ -1123,8 +857,9 @@ DEFS_STATUS Sweep_adrctrl_ma_l (void)
 	ber = MC_MemStressTestLong(FALSE, FALSE, 0, TRUE);
 	if (ber != 0)
 	{
-		HAL_PRINT_DBG(KRED " DRAM state before sweep: PHY_DLL_RECALIB = 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, REG_READ(PHY_DLL_RECALIB), ber, g_fail_rate_1, g_fail_rate_0);
-		HAL_PRINT_DBG(KRED "DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		HAL_PRINT_ERR(KRED " DRAM state before sweep: PHY_DLL_RECALIB = 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, REG_READ(PHY_DLL_RECALIB), ber, g_fail_rate_1, g_fail_rate_0);
+		HAL_PRINT_ERR(KRED "DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		serial_printf_flush();
 		while (1)
 			;
 	}
@@ -1180,8 +915,9 @@ DEFS_STATUS Sweep_adrctrl_ma_l (void)
 			HAL_PRINT_DBG(KRED "after fail 1 \n" KNRM );
 			MC_PrintPhy();
 #endif
-		HAL_PRINT_DBG(KRED "DRAM state after sweep: PHY_DLL_RECALIB = 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, REG_READ(PHY_DLL_RECALIB), ber, g_fail_rate_1, g_fail_rate_0);
-		HAL_PRINT_DBG(KRED "DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		HAL_PRINT_ERR(KRED "DRAM state after sweep: PHY_DLL_RECALIB = 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, REG_READ(PHY_DLL_RECALIB), ber, g_fail_rate_1, g_fail_rate_0);
+		HAL_PRINT_ERR(KRED "DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		serial_printf_flush();
 		while (1)
 			;
 	}
@@ -1237,8 +973,9 @@ DEFS_STATUS Sweep_adrctrl_ma_l (void)
 	if (ber != 0)
 	{
 		HAL_PRINT_DBG(KRED "after fail 2 \n" KNRM);
-		HAL_PRINT_DBG(KRED "DRAM state after sweep: PHY_DLL_RECALIB = 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, REG_READ(PHY_DLL_RECALIB), ber, g_fail_rate_1, g_fail_rate_0);
-		HAL_PRINT_DBG(KRED "DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		HAL_PRINT_ERR(KRED "DRAM state after sweep: PHY_DLL_RECALIB = 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, REG_READ(PHY_DLL_RECALIB), ber, g_fail_rate_1, g_fail_rate_0);
+		HAL_PRINT_ERR(KRED "DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		serial_printf_flush();
 		while (1)
 			;
 	}
@@ -1257,7 +994,11 @@ DEFS_STATUS Sweep_adrctrl_ma_l (void)
 /* Returns:                                                                                                */
 /* Side effects:                                                                                           */
 /* Description:                                                                                            */
-/*                  This routine performs...                                                               */
+/*                  This routine walks PHY_DLL_ADRCTRL up, then down, from the trained value one step at a */
+/*                  time and stops on the first failing step. It does not use the coarse to fine engine of */
+/*                  Sweep_Run_l: a command / address failure can hang the DRAM, so the walk must not step  */
+/*                  past the edge, and it ends there; a coarse step would only skip pass points it has to  */
+/*                  confirm anyway                                                                         */
 /*---------------------------------------------------------------------------------------------------------*/
 DEFS_STATUS Sweep_adrctrl_l (void)
 {
@@ -1274,8 +1015,9 @@ DEFS_STATUS Sweep_adrctrl_l (void)
 	ber = MC_MemStressTestLong(FALSE, FALSE, 0, FALSE);
 	if (ber != 0)
 	{
-		HAL_PRINT_DBG(KRED " DRAM state before sweep: PHY_DLL_ADRCTRL = 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, REG_READ(PHY_DLL_ADRCTRL), ber, g_fail_rate_1, g_fail_rate_0);
-		HAL_PRINT_DBG(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		HAL_PRINT_ERR(KRED " DRAM state before sweep: PHY_DLL_ADRCTRL = 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, REG_READ(PHY_DLL_ADRCTRL), ber, g_fail_rate_1, g_fail_rate_0);
+		HAL_PRINT_ERR(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		serial_printf_flush();
 		while (1)
 			;
 	}
@@ -1327,8 +1069,9 @@ DEFS_STATUS Sweep_adrctrl_l (void)
 	ber = MC_MemStressTestLong(FALSE, FALSE, 0, FALSE);
 	if (ber != 0)
 	{
-		HAL_PRINT_DBG(KRED " DRAM state after sweep: PHY_DLL_ADRCTRL = 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, REG_READ(PHY_DLL_ADRCTRL), ber, g_fail_rate_1, g_fail_rate_0);
-		HAL_PRINT_DBG(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		HAL_PRINT_ERR(KRED " DRAM state after sweep: PHY_DLL_ADRCTRL = 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, REG_READ(PHY_DLL_ADRCTRL), ber, g_fail_rate_1, g_fail_rate_0);
+		HAL_PRINT_ERR(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		serial_printf_flush();
 		while (1)
 			;
 	}
@@ -1373,8 +1116,9 @@ DEFS_STATUS Sweep_adrctrl_l (void)
 	ber = MC_MemStressTestLong(FALSE, FALSE, 0, FALSE);
 	if (ber != 0)
 	{
-		HAL_PRINT_DBG(KRED " DRAM state after sweep: PHY_DLL_ADRCTRL = 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, REG_READ(PHY_DLL_ADRCTRL), ber, g_fail_rate_1, g_fail_rate_0);
-		HAL_PRINT_DBG(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		HAL_PRINT_ERR(KRED " DRAM state after sweep: PHY_DLL_ADRCTRL = 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, REG_READ(PHY_DLL_ADRCTRL), ber, g_fail_rate_1, g_fail_rate_0);
+		HAL_PRINT_ERR(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		serial_printf_flush();
 		while (1)
 			;
 	}
@@ -1384,6 +1128,56 @@ DEFS_STATUS Sweep_adrctrl_l (void)
 #endif // ADRCTL_SWEEP
 
 #define TRIM_2_SWEEP
+#if defined(TRIM_2_SWEEP) || defined(VREF_SWEEP) || defined(DRAM_SWEEP)
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        Sweep_Eye2D_l                                                                          */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  table -         2-D sweep status, [delay point][Y step]                                */
+/*                  x -             trained delay point in table                                           */
+/*                  points -        Y steps                                                                */
+/*                  base -          Y value of step 0                                                      */
+/*                  trained -       trained Y value                                                        */
+/*                  mask -          status bits that fail the eye (a DQ, or a whole lane for DM)           */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine prints the eye along Y (VREF or TRIM_2) at the trained delay              */
+/*---------------------------------------------------------------------------------------------------------*/
+static void Sweep_Eye2D_l (volatile UINT16 (*table)[74], int x, int points, int base, int trained, UINT16 mask)
+{
+	UINT16   column[ARRAY_SIZE(g_Table_Z_BitStatus[0])];
+	MC_EYE_T eye[MC_EYE_BITS];
+	int      y;
+
+	if ((x < 0) || (x >= (int)ARRAY_SIZE(g_Table_Z_BitStatus)))
+	{
+		HAL_PRINT_DBG(KYEL "\n trained delay out of the eye mask\n" KNRM);
+		return;
+	}
+
+	points = MIN(points, (int)ARRAY_SIZE(column));
+	for (y = 0; y < points; y++)
+		column[y] = ((table[x][y] & mask) != 0) ? 0xFFFF : 0;
+
+	MC_EYE_Find_l(column, points, eye);
+
+	if (eye[0].size == 0)
+	{
+		HAL_PRINT_DBG(KRED "\n no eye at the trained delay\n" KNRM);
+		return;
+	}
+
+	HAL_PRINT_DBG("%s\n eye at the trained delay: %d..%d (%d steps); center= %d; trained= %d;%s%s%s\n" KNRM,
+		      ((trained < eye[0].left + base) || (trained > eye[0].right + base)) ? KRED : KCYN,
+		      eye[0].left + base, eye[0].right + base, eye[0].size, eye[0].center + base, trained,
+		      (eye[0].flags & MC_EYE_CLIPPED) ? " clipped;" : "",
+		      (eye[0].flags & MC_EYE_SOFT_EDGE) ? " soft edge;" : "",
+		      (eye[0].flags & MC_EYE_SECONDARY) ? " secondary eye;" : "");
+}
+#endif
+
 #ifdef TRIM_2_SWEEP
 /*---------------------------------------------------------------------------------------------------------*/
 /* Function:        Sweep_trim2_lane_l                                                                     */
@@ -1415,8 +1209,8 @@ DEFS_STATUS Sweep_trim2_lane_l (UINT16 TRIM2_ilane)
 	if (ber != 0)
 	{
 		REG_WRITE(PHY_LANE_SEL, (TRIM2_ilane * SLV_DLY_WIDTH));
-		HAL_PRINT_DBG(KRED " DRAM state before sweep:  lane= %u; PHY_DLL_TRIM_2= 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, TRIM2_ilane, REG_READ(PHY_DLL_TRIM_2), ber, g_fail_rate_1, g_fail_rate_0);
-		HAL_PRINT_DBG(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		HAL_PRINT_ERR(KRED " DRAM state before sweep:  lane= %u; PHY_DLL_TRIM_2= 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, TRIM2_ilane, REG_READ(PHY_DLL_TRIM_2), ber, g_fail_rate_1, g_fail_rate_0);
+		HAL_PRINT_ERR(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
 	}
 
 	// Get the origin value
@@ -1537,6 +1331,7 @@ DEFS_STATUS Sweep_trim2_lane_l (UINT16 TRIM2_ilane)
 				}
 			}
 		}
+		Sweep_Eye2D_l(g_Table_Z_BitStatus, center_point_x, 64, 0, center_point_y, (UINT16)MASK_BIT(ibit));
 	}
 	HAL_PRINT_DBG(KNRM "\n");
 	//----------------------------------------------------------------------------------------
@@ -1549,8 +1344,8 @@ DEFS_STATUS Sweep_trim2_lane_l (UINT16 TRIM2_ilane)
 	if (ber != 0)
 	{
 		REG_WRITE(PHY_LANE_SEL, (TRIM2_ilane * SLV_DLY_WIDTH));
-		HAL_PRINT_DBG(KRED " DRAM state after sweep: lane= %u; PHY_DLL_TRIM_2= 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, TRIM2_ilane, REG_READ(PHY_DLL_TRIM_2), ber, g_fail_rate_1, g_fail_rate_0);
-		HAL_PRINT_DBG(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		HAL_PRINT_ERR(KRED " DRAM state after sweep: lane= %u; PHY_DLL_TRIM_2= 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, TRIM2_ilane, REG_READ(PHY_DLL_TRIM_2), ber, g_fail_rate_1, g_fail_rate_0);
+		HAL_PRINT_ERR(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
 	}
 	//---------------------------------------------------------------------------------------------
 }
@@ -1565,7 +1360,7 @@ DEFS_STATUS Sweep_trim2_lane_l (UINT16 TRIM2_ilane)
 /* Returns:                                                                                                */
 /* Side effects:                                                                                           */
 /* Description:                                                                                            */
-/*                  This routine performs...                                                               */
+/*                  This routine sweeps BMC VREF and the input DQn eyes                                    */
 /*---------------------------------------------------------------------------------------------------------*/
 DEFS_STATUS Sweep_VREF_l (void)
 {
@@ -1593,9 +1388,24 @@ DEFS_STATUS Sweep_VREF_l (void)
 		Origin_BMC_VREF[ilane] = READ_REG_FIELD(VREF_TRAINING, VREF_TRAINING_vref_value);
 	}
 
-	// Sweep ...
-	for (UINT32 current_vref = 51; current_vref <= 124; current_vref++)
+	// Sweep from the trained VREF up and then down, each step tracks the eyes of the step before
+	MC_SWEEP_EYE_T start_eye;
+	UINT32 start_vref = MIN(MAX((Origin_BMC_VREF[0] + Origin_BMC_VREF[1] + 1) / 2, 51), 124);
+	g_SweepEye[SWEEP_IN_DQ].track = FALSE;
+	g_SweepTests = 0;
+
+	for (UINT32 step = 0; step <= 124 - 51; step++)
 	{
+		UINT32 current_vref = Sweep_Walk_l(step, 124, start_vref);
+		if (step == 1)
+		{
+			g_SweepEye[SWEEP_IN_DQ].track = TRUE;
+			start_eye = g_SweepEye[SWEEP_IN_DQ];
+		}
+		else if (current_vref + 1 == start_vref)
+		{
+			g_SweepEye[SWEEP_IN_DQ] = start_eye;
+		}
 
 		// Change UVREF trim code for each lane by programming VREF_TRAINING register
 		for (ilane = 0; ilane < MEM_STRB_WIDTH; ilane++)
@@ -1631,6 +1441,8 @@ DEFS_STATUS Sweep_VREF_l (void)
 		g_Table_MinEyeSize[current_vref - 51][0] = DQ_min_eyesize_lane0;
 		g_Table_MinEyeSize[current_vref - 51][1] = DQ_min_eyesize_lane1;
 	}
+	g_SweepEye[SWEEP_IN_DQ].track = FALSE;
+	HAL_PRINT_DBG(KCYN " > %u memory tests (full sweep: %u) \n" KNRM, g_SweepTests, (124 - 51 + 1) * 125);
 
 	//-----------------------------------
 	// restore origin BMC VREF from SCL
@@ -1722,6 +1534,7 @@ DEFS_STATUS Sweep_VREF_l (void)
 				}
 			}
 		}
+		Sweep_Eye2D_l(g_Table_Z_BitStatus, center_point_x, 124 - 51 + 1, 51, center_point_y, (UINT16)MASK_BIT(ibit));
 	}
 	HAL_PRINT_DBG(KNRM "\n");
 	//--------------------------------------------------------------
@@ -1739,7 +1552,7 @@ DEFS_STATUS Sweep_VREF_l (void)
 /* Returns:                                                                                                */
 /* Side effects:                                                                                           */
 /* Description:                                                                                            */
-/*                  This routine performs...                                                               */
+/*                  This routine sweeps DRAM VREF and the output DM/DQn eyes                               */
 /*---------------------------------------------------------------------------------------------------------*/
 DEFS_STATUS Sweep_DRAM_l(DDR_Setup *ddr_setup)
 {
@@ -1764,14 +1577,36 @@ DEFS_STATUS Sweep_DRAM_l(DDR_Setup *ddr_setup)
 	ber = MC_MemStressTestLong(FALSE, FALSE, 0, FALSE);
 	if (ber != 0)
 	{
-		HAL_PRINT_DBG(KRED " DRAM state before sweep:  ber=%04X \n", ber);
-		HAL_PRINT_DBG(KRED " DRAM state is not functional at this point. Restart boot-block. \n");
+		HAL_PRINT_ERR(KRED " DRAM state before sweep:  ber=%04X \n" KNRM, ber);
+		HAL_PRINT_ERR(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		serial_printf_flush();
 		while (1)
 			;
 	}
 
-	for (UINT32 current_vref = 0; current_vref <= 73; current_vref++)
+	// Sweep from the trained VREF up and then down, each step tracks the eyes of the step before
+	MC_SWEEP_EYE_T start_eye[2];
+	UINT32 start_vref = MIN(ddr_setup->SaveDRAMVref, 73);
+	g_SweepEye[SWEEP_OUT_DM].track = FALSE;
+	g_SweepEye[SWEEP_OUT_DQ].track = FALSE;
+	g_SweepTests = 0;
+
+	for (UINT32 step = 0; step <= 73; step++)
 	{
+		UINT32 current_vref = Sweep_Walk_l(step, 73, start_vref);
+		if (step == 1)
+		{
+			g_SweepEye[SWEEP_OUT_DM].track = TRUE;
+			g_SweepEye[SWEEP_OUT_DQ].track = TRUE;
+			start_eye[0] = g_SweepEye[SWEEP_OUT_DM];
+			start_eye[1] = g_SweepEye[SWEEP_OUT_DQ];
+		}
+		else if (current_vref + 1 == start_vref)
+		{
+			g_SweepEye[SWEEP_OUT_DM] = start_eye[0];
+			g_SweepEye[SWEEP_OUT_DQ] = start_eye[1];
+		}
+
 		UINT32 new_value = ddr_setup->MR6_DATA & 0xFF00;
 		new_value |= 1 << 7; // VREF Calibration Enable
 		if (current_vref > 22)
@@ -1833,6 +1668,9 @@ DEFS_STATUS Sweep_DRAM_l(DDR_Setup *ddr_setup)
 		g_Table_MinEyeSize[current_vref][0] = DQ_min_eyesize_lane0;
 		g_Table_MinEyeSize[current_vref][1] = DQ_min_eyesize_lane1;
 	}
+	g_SweepEye[SWEEP_OUT_DM].track = FALSE;
+	g_SweepEye[SWEEP_OUT_DQ].track = FALSE;
+	HAL_PRINT_DBG(KCYN " > %u memory tests (full sweep: %u) \n" KNRM, g_SweepTests, (73 + 1) * 125 * 2);
 
 	//-----------------------------------
 	// restore origin DRAM VREF from SCL
@@ -1933,6 +1771,7 @@ DEFS_STATUS Sweep_DRAM_l(DDR_Setup *ddr_setup)
 				}
 			}
 		}
+		Sweep_Eye2D_l(g_Table_Z_BitStatus, center_point_x, 73 + 1, 0, center_point_y, (UINT16)MASK_BIT(ibit));
 	}
 	HAL_PRINT_DBG(KNRM "\n");
 	//--------------------------------------------------------------
@@ -1981,6 +1820,7 @@ DEFS_STATUS Sweep_DRAM_l(DDR_Setup *ddr_setup)
 				}
 			}
 		}
+		Sweep_Eye2D_l(g_Table_Z2_BitStatus, center_point_x, 73 + 1, 0, center_point_y, (UINT16)(0xFF << (ilane * 8)));
 	}
 	HAL_PRINT_DBG(KNRM "\n");
 	//--------------------------------------------------------------
@@ -1990,8 +1830,9 @@ DEFS_STATUS Sweep_DRAM_l(DDR_Setup *ddr_setup)
 	ber = MC_MemStressTestLong(FALSE, FALSE, 0, FALSE);
 	if (ber != 0)
 	{
-		HAL_PRINT_DBG(KRED " DRAM state after sweep:  ber=%04X \n" KNRM, ber);
-		HAL_PRINT_DBG(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		HAL_PRINT_ERR(KRED " DRAM state after sweep:  ber=%04X \n" KNRM, ber);
+		HAL_PRINT_ERR(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		serial_printf_flush();
 		while (1)
 			;
 	}
@@ -2038,8 +1879,9 @@ DEFS_STATUS Sweep_IP_DQS_l (void)
 	ber = MC_MemStressTestLong(FALSE, FALSE, 0, FALSE);
 	if (ber != 0)
 	{
-		HAL_PRINT_DBG(KRED " DRAM state before sweep:  lane= %u; IP_DQS= %u; ber= %04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, IP_DQS_ilane, stored_IP_DQS[IP_DQS_ilane], ber, g_fail_rate_1, g_fail_rate_0);
-		HAL_PRINT_DBG(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		HAL_PRINT_ERR(KRED " DRAM state before sweep:  lane= %u; IP_DQS= %u; ber= %04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, IP_DQS_ilane, stored_IP_DQS[IP_DQS_ilane], ber, g_fail_rate_1, g_fail_rate_0);
+		HAL_PRINT_ERR(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		serial_printf_flush();
 		while (1)
 			;
 	}
@@ -2170,8 +2012,9 @@ DEFS_STATUS Sweep_IP_DQS_l (void)
 	if (ber != 0)
 	{
 		REG_WRITE(PHY_LANE_SEL, (IP_DQS_ilane * DQS_DLY_WIDTH) + 0x800);
-		HAL_PRINT_DBG(KRED " DRAM state after sweep:  lane= %u; IP_DQS= 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, IP_DQS_ilane, REG_READ(IP_DQ_DQS_BITWISE_TRIM), ber, g_fail_rate_1, g_fail_rate_0);
-		HAL_PRINT_DBG(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		HAL_PRINT_ERR(KRED " DRAM state after sweep:  lane= %u; IP_DQS= 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, IP_DQS_ilane, REG_READ(IP_DQ_DQS_BITWISE_TRIM), ber, g_fail_rate_1, g_fail_rate_0);
+		HAL_PRINT_ERR(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		serial_printf_flush();
 		while (1)
 			;
 	}
@@ -2217,8 +2060,9 @@ DEFS_STATUS Sweep_OP_DQS_l (void)
 	ber = MC_MemStressTestLong(FALSE, FALSE, 0, FALSE);
 	if (ber != 0)
 	{
-		HAL_PRINT_DBG(KRED " DRAM state before sweep:  lane= %u; OP_DQS= %u; ber= %04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, OP_DQS_ilane, stored_OP_DQS[OP_DQS_ilane], ber, g_fail_rate_1, g_fail_rate_0);
-		HAL_PRINT_DBG(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		HAL_PRINT_ERR(KRED " DRAM state before sweep:  lane= %u; OP_DQS= %u; ber= %04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, OP_DQS_ilane, stored_OP_DQS[OP_DQS_ilane], ber, g_fail_rate_1, g_fail_rate_0);
+		HAL_PRINT_ERR(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		serial_printf_flush();
 		while (1)
 			;
 	}
@@ -2346,8 +2190,9 @@ DEFS_STATUS Sweep_OP_DQS_l (void)
 	if (ber != 0)
 	{
 		REG_WRITE(PHY_LANE_SEL, (OP_DQS_ilane * DQS_DLY_WIDTH) + 0x900);
-		HAL_PRINT_DBG(KRED " DRAM state after sweep:  lane= %u; OP_DQS= 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, OP_DQS_ilane, REG_READ(OP_DQ_DM_DQS_BITWISE_TRIM), ber, g_fail_rate_1, g_fail_rate_0);
-		HAL_PRINT_DBG(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		HAL_PRINT_ERR(KRED " DRAM state after sweep:  lane= %u; OP_DQS= 0x%08lx; ber=%04X; fail_rate: lane1= %u, lane0= %u \n" KNRM, OP_DQS_ilane, REG_READ(OP_DQ_DM_DQS_BITWISE_TRIM), ber, g_fail_rate_1, g_fail_rate_0);
+		HAL_PRINT_ERR(KRED " DRAM state is not functional at this point. Restart boot-block. \n" KNRM);
+		serial_printf_flush();
 		while (1)
 			;
 	}
@@ -0,0 +1,209 @@
+/*----------------------------------------------------------------------------*/
+/* SPDX-License-Identifier: GPL-2.0                                           */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mc_drv_train_cache.c                                                     */
+/*        This file contains save and restore of the trained PHY state        */
+/*        (included from mc_drv.c)                                            */
+/* Project:                                                                   */
+/*        SWC HAL                                                             */
+/*----------------------------------------------------------------------------*/
+
+#ifdef BOOTBLOCK_DDR_TRAINING_CACHE
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_SaveTraining_l                                                                      */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  ddr_setup - MC training context                                                        */
+/*                  data -      filled with the trained state                                              */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine reads the bitwise trims, TRIM_2 and VREF after a full training            */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_SaveTraining_l (DDR_Setup *ddr_setup, MC_TRAINING_DATA_T *data)
+{
+	UINT32 ilane, ibit;
+
+	memset(data, 0, sizeof(MC_TRAINING_DATA_T));
+
+	for (ilane = 0; ilane < MC_TRAINING_LANES; ilane++)
+	{
+		for (ibit = 0; ibit < MC_TRAINING_IP_TRIMS; ibit++)
+		{
+			REG_WRITE(PHY_LANE_SEL, (ilane * DQS_DLY_WIDTH) + (ibit << 8));
+			data->ip_trim[ilane][ibit] = (UINT16)(REG_READ(IP_DQ_DQS_BITWISE_TRIM) & 0x7F);
+		}
+
+		for (ibit = 0; ibit < MC_TRAINING_OP_TRIMS; ibit++)
+		{
+			REG_WRITE(PHY_LANE_SEL, (ilane * DQS_DLY_WIDTH) + (ibit << 8));
+			data->op_trim[ilane][ibit] = (UINT16)(REG_READ(OP_DQ_DM_DQS_BITWISE_TRIM) & 0x7F);
+		}
+
+		REG_WRITE(PHY_LANE_SEL, ilane * SLV_DLY_WIDTH);
+		data->dlls_trim_2[ilane] = (UINT8)READ_REG_FIELD(PHY_DLL_TRIM_2, PHY_DLL_TRIM_2_dlls_trim_2);
+
+		REG_WRITE(PHY_LANE_SEL, ilane * VREF_WIDTH);
+		data->vref_training[ilane] = REG_READ(VREF_TRAINING);
+	}
+
+	data->vref_dram = (UINT8)ddr_setup->SaveDRAMVref;
+
+	REG_WRITE(PHY_LANE_SEL, 0);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_RestoreVref_l                                                                       */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  ddr_setup - MC training context                                                        */
+/*                  data -      saved trained state                                                        */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine replaces vref_dq_training_ddr4: sets the PHY VREF and the DRAM VREF       */
+/*                  (MR6, with VrefDQ training mode on and off) to the saved values                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_RestoreVref_l (DDR_Setup *ddr_setup, const MC_TRAINING_DATA_T *data)
+{
+	UINT32 ilane;
+	UINT32 orig_cs_config;
+
+	HAL_PRINT("restore VREF: phy %#010lx %#010lx dram %u\n", data->vref_training[0], data->vref_training[1], data->vref_dram);
+
+	for (ilane = 0; ilane < MC_TRAINING_LANES; ilane++)
+	{
+		REG_WRITE(PHY_LANE_SEL, ilane * VREF_WIDTH);
+		REG_WRITE(VREF_TRAINING, data->vref_training[ilane]);
+	}
+	REG_WRITE(PHY_LANE_SEL, 0);
+
+	orig_cs_config = set_scl_all_cs();
+	setup_vref_training_registers_(ddr_setup, data->vref_dram);
+	setup_vref_training_registers(ddr_setup, data->vref_dram, 2);
+	restore_scl_cs(orig_cs_config);
+
+	ddr_setup->SaveDRAMVref = data->vref_dram;
+
+	REG_WRITE(BIT_LVL_CONFIG, ((BIT_LEVEL_SAMPLE_BOTH << 4) | BIT_LVL_SAMPLE_QTY));
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_RestoreTrim_l                                                                       */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  data -      saved trained state                                                        */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine replaces the main flow sweeps: writes TRIM_2 and the bitwise trims        */
+/*                  (with override) the sweeps found                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+static void MC_RestoreTrim_l (const MC_TRAINING_DATA_T *data)
+{
+	UINT32 ilane, ibit;
+
+	for (ilane = 0; ilane < MC_TRAINING_LANES; ilane++)
+	{
+		REG_WRITE(PHY_LANE_SEL, ilane * SLV_DLY_WIDTH);
+		SET_REG_FIELD(PHY_DLL_TRIM_2, PHY_DLL_TRIM_2_dlls_trim_2, 0x3F & data->dlls_trim_2[ilane]);
+
+		for (ibit = 0; ibit < MC_TRAINING_OP_TRIMS; ibit++)
+		{
+			REG_WRITE(PHY_LANE_SEL, (ilane * DQS_DLY_WIDTH) + (ibit << 8));
+			REG_WRITE(OP_DQ_DM_DQS_BITWISE_TRIM, 0x180 | (0x7F & data->op_trim[ilane][ibit]));
+		}
+
+		for (ibit = 0; ibit < MC_TRAINING_IP_TRIMS; ibit++)
+		{
+			REG_WRITE(PHY_LANE_SEL, (ilane * DQS_DLY_WIDTH) + (ibit << 8));
+			REG_WRITE(IP_DQ_DQS_BITWISE_TRIM, 0x80 | (0x7F & data->ip_trim[ilane][ibit]));
+		}
+	}
+
+	// dummy accsess to DDR
+	IOW32(0x1000, IOR32(0x1000));
+	REG_WRITE(PHY_LANE_SEL, 0);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_RejectTraining_l                                                                    */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         TRUE if the DDR must be trained again: the failing training was restored               */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Called on a failure of the training check or of a later DDR test. The training is not  */
+/*                  saved, and a restored one is dropped (MC_TrainingDataRejected) for a full training     */
+/*---------------------------------------------------------------------------------------------------------*/
+static BOOLEAN MC_RejectTraining_l (void)
+{
+	mc_training_valid = FALSE;
+
+	if (mc_training_restore == NULL)
+		return FALSE;
+
+	HAL_PRINT(KYEL "saved training failed, run full training\n" KNRM);
+	mc_training_restore = NULL;
+	mc_training_rejected = TRUE;
+
+	return TRUE;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_SetTrainingData                                                                     */
+/*                                                                                                         */
+/* Parameters:      data - trained state to restore on the next MC_ConfigureDDR. NULL: run full training   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Select the state MC_ConfigureDDR restores instead of training                          */
+/*---------------------------------------------------------------------------------------------------------*/
+void MC_SetTrainingData (const MC_TRAINING_DATA_T *data)
+{
+	mc_training_restore = data;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_GetTrainingData                                                                     */
+/*                                                                                                         */
+/* Parameters:      data - filled with the trained state                                                   */
+/* Returns:         TRUE if the last MC_ConfigureDDR ran a full training that passed the DDR tests         */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Returns the state to save for the next boots                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+BOOLEAN MC_GetTrainingData (MC_TRAINING_DATA_T *data)
+{
+	if (mc_training_valid == FALSE)
+		return FALSE;
+
+	memcpy(data, &mc_training_data, sizeof(MC_TRAINING_DATA_T));
+
+	return TRUE;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_TrainingDataRejected                                                                */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         TRUE if the state of MC_SetTrainingData failed a DDR test in the last MC_ConfigureDDR  */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  The saved state must not be restored again                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+BOOLEAN MC_TrainingDataRejected (void)
+{
+	return mc_training_rejected;
+}
+
+#endif // BOOTBLOCK_DDR_TRAINING_CACHE
@@ -158,12 +158,13 @@ typedef enum
 /* Bit Fields to be used by mc_config  (Values returned from BOOTBLOCK_Get_MC_config)  */
 /*-------------------------------------------------------------------------------------*/
 #define MC_CAPABILITY_ECC_ENABLE                        MASK_BIT(0)
-// #define MC_CAPABILITY_ENAHANCED_SWEEP                MASK_BIT(1)
+#define MC_CAPABILITY_MEM_TEST_QUICK                    MASK_BIT(1)     // quick test of the whole DRAM
 #define MC_CAPABILITY_DRAM_CLOCK_TYPE                   MASK_BIT(2)
 #define MC_CAPABILITY_3_SEC_DELAY                       MASK_BIT(3)
 #define MC_CAPABILITY_SWEEP_ENABLE                      MASK_BIT(4)
 #define MC_CAPABILITY_PRINT_ENABLE                      MASK_BIT(5)
 #define MC_CAPABILITY_DDP_DRAM                          MASK_BIT(6)
+#define MC_CAPABILITY_MEM_TEST_FULL                     MASK_BIT(7)     // full DRAM test instead of the quick one
 
 
 /*---------------------------------------------------------------------------------------------------------*/
@@ -329,6 +330,61 @@ void MC_PrintRegs (void);
 /*---------------------------------------------------------------------------------------------------------*/
 void MC_PrintVersion (void);
 
+#ifdef BOOTBLOCK_DDR_TRAINING_CACHE
+/*---------------------------------------------------------------------------------------------------------*/
+/* Trained PHY state: result of VREF training and of the main flow sweeps. Saved by the bootblock after a   */
+/* full training and restored on the next boots instead of training again                                  */
+/*---------------------------------------------------------------------------------------------------------*/
+#define MC_TRAINING_LANES               2
+#define MC_TRAINING_IP_TRIMS            9       /* DQ0-7, DQS     */
+#define MC_TRAINING_OP_TRIMS            10      /* DQ0-7, DM, DQS */
+
+typedef struct MC_TRAINING_DATA_tag
+{
+	UINT16   ip_trim[MC_TRAINING_LANES][MC_TRAINING_IP_TRIMS];  // IP_DQ_DQS_BITWISE_TRIM
+	UINT16   op_trim[MC_TRAINING_LANES][MC_TRAINING_OP_TRIMS];  // OP_DQ_DM_DQS_BITWISE_TRIM
+	UINT32   vref_training[MC_TRAINING_LANES];                  // VREF_TRAINING (PHY side VREF)
+	UINT8    dlls_trim_2[MC_TRAINING_LANES];                    // PHY_DLL_TRIM_2
+	UINT8    vref_dram;                                         // DRAM VREF step (MR6)
+	UINT8    reserved;
+} MC_TRAINING_DATA_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_SetTrainingData                                                                     */
+/*                                                                                                         */
+/* Parameters:      data - trained state to restore on the next MC_ConfigureDDR. NULL: run full training   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  MC_ConfigureDDR restores data instead of VREF training and the main flow sweeps,       */
+/*                  checks it with MC_MemStressTest and falls back to full training if the check or one of */
+/*                  the later DDR tests fails. data must stay valid until MC_ConfigureDDR returns          */
+/*---------------------------------------------------------------------------------------------------------*/
+void MC_SetTrainingData (const MC_TRAINING_DATA_T *data);
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_GetTrainingData                                                                     */
+/*                                                                                                         */
+/* Parameters:      data - filled with the trained state                                                   */
+/* Returns:         TRUE if the last MC_ConfigureDDR ran a full training that passed the DDR tests         */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Returns the state to save for the next boots. FALSE if it was restored or failed       */
+/*---------------------------------------------------------------------------------------------------------*/
+BOOLEAN MC_GetTrainingData (MC_TRAINING_DATA_T *data);
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MC_TrainingDataRejected                                                                */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         TRUE if the state of MC_SetTrainingData failed a DDR test in the last MC_ConfigureDDR  */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  The saved copy of the state must be dropped                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+BOOLEAN MC_TrainingDataRejected (void);
+#endif
+
 
 #endif //_MC_IF_H
 
@@ -23,6 +23,14 @@
 #include "shm_drv.h"
 #include "shm_regs.h"
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Prints of this driver are logged as the SHM module (HAL_LOG in hal_cfg.h)                               */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          SHM
+#endif
+
 /*---------------------------------------------------------------------------------------------------------*/
 /* Module Dependencies                                                                                     */
 /*---------------------------------------------------------------------------------------------------------*/
@@ -1342,3 +1350,7 @@ void SHM_PrintVersion (void)
     HAL_PRINT("SHM         = %X\n", MODULE_VERSION(SHM_MODULE_TYPE));
 }
 
+#ifdef HAL_LOG_MODULE
+#undef  HAL_LOG_MODULE
+#define HAL_LOG_MODULE          HAL
+#endif
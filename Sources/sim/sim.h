@@ -0,0 +1,123 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   sim.h                                                                    */
+/*            This file contains API of the host simulation of the bootblock */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+
+#ifndef _SIM_H_
+#define _SIM_H_
+
+#include <stdio.h>
+#include "hal.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Memory map of the simulation. The bootblock uses the physical addresses as pointers, so the memories    */
+/* are mapped in the host process at the same addresses (mmap MAP_FIXED)                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+#define SIM_DRAM_BASE                   0x00000000UL
+#define SIM_DRAM_WINDOW                 0x80000000UL    /* the device is aliased over the window        */
+#define SIM_FLASH_BASE                  SPI0CS0_BASE_ADDR
+#define SIM_FLASH_SIZE                  SPI0CS0_SIZE
+#define SIM_IO_BASE                     0xF0000000UL    /* registers, RAM2, ROM, mailbox up to 4GB      */
+#define SIM_IO_SIZE                     0x10000000UL
+#define SIM_IO_PAGE_SHIFT               12
+#define SIM_IO_PAGES                    (SIM_IO_SIZE >> SIM_IO_PAGE_SHIFT)
+
+#define SIM_OTP_SIZE                    1024
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Virtual time: every register access costs SIM_MMIO_COST_NS, a read of the clock counters costs          */
+/* SIM_POLL_COST_NS (one iteration of a busy wait). Deterministic, so the boot trace is reproducible       */
+/*---------------------------------------------------------------------------------------------------------*/
+#define SIM_MMIO_COST_NS                50
+#define SIM_POLL_COST_NS                1000
+#define SIM_DRAM_COST_NS                32      // 64 bytes of a DRAM test block (MarchBlock64), 2 GB/s
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* End of a run                                                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef enum
+{
+	SIM_EXIT_JUMP = 0,              /* jump to BL31                                                        */
+	SIM_EXIT_RESET,                 /* SW reset (SWRSTR) or watchdog reset (FSWCR, WTCR)                   */
+	SIM_EXIT_HANG,                  /* wall clock timeout                                                  */
+	SIM_EXIT_FAULT,                 /* access outside of the simulated memories                            */
+	SIM_EXIT_ERROR,                 /* setup error                                                         */
+} SIM_EXIT_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Peripheral model. read gets the register file content and returns the value seen by the bootblock,     */
+/* write gets the value written and returns the value kept in the register file. NULL: plain register     */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct SIM_PERIPH_tag
+{
+	const char     *name;
+	UINT64          base;
+	UINT64          size;
+	UINT64        (*read)  (struct SIM_PERIPH_tag *periph, UINT32 offset, UINT size, UINT64 val);
+	UINT64        (*write) (struct SIM_PERIPH_tag *periph, UINT32 offset, UINT size, UINT64 val);
+	UINT64          reads;
+	UINT64          writes;
+} SIM_PERIPH_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Options of a run (sim_main.c)                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct
+{
+	const char     *flash_file;     /* NULL: synthetic flash (sim_flash.c)                                 */
+	const char     *otp_file;       /* NULL: OTP is blank                                                  */
+	const char     *uart_file;      /* NULL: stdout                                                        */
+	UINT64          dram_size;
+	UINT32          timeout_sec;    /* wall clock                                                          */
+	BOOLEAN         ecc;
+	UINT8           mc_config;      /* synthetic header: mc_config bits added to the ECC one                */
+	BOOLEAN         image_dir;      /* synthetic flash: image directory in the bootblock code              */
+	BOOLEAN         quiet;
+} SIM_CONFIG_T;
+
+extern SIM_CONFIG_T     sim_config;
+extern UINT64           sim_time_ns;
+extern FILE            *sim_uart_out;
+extern UINT8            sim_otp[SIM_OTP_SIZE];
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* sim_mmio.c                                                                                              */
+/*---------------------------------------------------------------------------------------------------------*/
+int         SIM_MMIO_Init (void);
+void        SIM_MMIO_Register (SIM_PERIPH_T *periph);
+void        SIM_MMIO_Report (FILE *out);
+UINT64      SIM_MMIO_Peek (UINT64 addr, UINT size);
+void        SIM_MMIO_Poke (UINT64 addr, UINT size, UINT64 val);
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* sim_periph.c                                                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+void        SIM_PERIPH_Init (void);
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* sim_core.c: host versions of the assembly routines                                                      */
+/*---------------------------------------------------------------------------------------------------------*/
+void           *CopyBlock64 (void *dstPtr, const void *srcPtr, unsigned long nBytes);
+unsigned int    Crc32Update (unsigned int crc, const void *bufPtr, unsigned long nBytes);
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* sim_flash.c                                                                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+int         SIM_FLASH_Init (void);
+int         SIM_FLASH_CheckImages (UINT64 entry);
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* sim_main.c                                                                                              */
+/*---------------------------------------------------------------------------------------------------------*/
+void        SIM_Exit (SIM_EXIT_T reason, UINT64 arg);
+
+#endif /* _SIM_H_ */
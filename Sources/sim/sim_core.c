@@ -0,0 +1,169 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   sim_core.c                                                               */
+/*            This file contains host versions of the assembly routines      */
+/*            (v8_utils.S, v8_aarch64.S) and of the linker symbols            */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+#include "sim.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Linker symbols (bootblock_NOTIP.ld). Only their address is used: scratchpad registers and the stack    */
+/* profiler                                                                                                */
+/*---------------------------------------------------------------------------------------------------------*/
+unsigned long           _ram_start;
+unsigned long           _ram_end;
+unsigned long           _stack_end;
+unsigned long           _stack_start;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        CopyBlock64                                                                            */
+/*                                                                                                         */
+/* Parameters:      dstPtr - destination, 16 bytes aligned                                                 */
+/*                  srcPtr - source, 16 bytes aligned                                                      */
+/*                  nBytes - multiple of 64 bytes                                                          */
+/* Returns:         pointer to just after the copied block, NULL if the parameters are incompatible        */
+/*---------------------------------------------------------------------------------------------------------*/
+void *CopyBlock64 (void *dstPtr, const void *srcPtr, unsigned long nBytes)
+{
+	if ((nBytes & 0x3F) || (((uintptr_t)dstPtr | (uintptr_t)srcPtr) & 0xF))
+	{
+		return NULL;
+	}
+
+	memcpy(dstPtr, srcPtr, nBytes);
+
+	return (UINT8 *)dstPtr + nBytes;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        XorOrBlock64                                                                           */
+/*                                                                                                         */
+/* Parameters:      dataPtr - data read back, 16 bytes aligned                                             */
+/*                  ptrnPtr - expected pattern, 16 bytes aligned                                           */
+/*                  nBytes  - multiple of 64 bytes                                                         */
+/* Returns:         OR of the 64 bit words of data XOR pattern, 0 if they are equal                        */
+/*---------------------------------------------------------------------------------------------------------*/
+unsigned long XorOrBlock64 (const void *dataPtr, const void *ptrnPtr, unsigned long nBytes)
+{
+	const volatile UINT64 *data = (const volatile UINT64 *)dataPtr;
+	const UINT64          *ptrn = (const UINT64 *)ptrnPtr;
+	UINT64                 diff = 0;
+
+	for (; nBytes >= sizeof(UINT64); nBytes -= sizeof(UINT64))
+	{
+		diff |= *data++ ^ *ptrn++;
+	}
+
+	return diff;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MarchBlock64                                                                           */
+/*                                                                                                         */
+/* Parameters:      addr   - block start, 16 bytes aligned                                                 */
+/*                  nBytes - multiple of 64 bytes                                                          */
+/*                  rdData - expected 64 bit word                                                          */
+/*                  wrData - written 64 bit word                                                           */
+/*                  flags  - MARCH_READ (1), MARCH_WRITE (2), MARCH_DOWN (4), MARCH_ADDR (8)               */
+/* Returns:         bytes left, 0 if all the data matched                                                  */
+/* Side effects:    advances the virtual time by SIM_DRAM_COST_NS per 64 bytes                             */
+/*---------------------------------------------------------------------------------------------------------*/
+unsigned long MarchBlock64 (void *addr, unsigned long nBytes, unsigned long rdData, unsigned long wrData,
+			    unsigned long flags)
+{
+	volatile UINT64 *block = (volatile UINT64 *)addr;
+	long             step  = 8;
+	UINT64           mask;
+	UINT32           i;
+
+	if (flags & 0x4)
+	{
+		block = (volatile UINT64 *)((UINT8 *)addr + nBytes - 64);
+		step  = -8;
+	}
+
+	for (; nBytes > 0; nBytes -= 64, block += step)
+	{
+		sim_time_ns += SIM_DRAM_COST_NS;
+
+		for (i = 0; (flags & 0x1) && (i < 8); i++)
+		{
+			mask = (flags & 0x8) ? (UINT64)(uintptr_t)&block[i] : 0;
+			if (block[i] != (rdData ^ mask))
+				return nBytes;
+		}
+
+		for (i = 0; (flags & 0x2) && (i < 8); i++)
+		{
+			mask = (flags & 0x8) ? (UINT64)(uintptr_t)&block[i] : 0;
+			block[i] = wrData ^ mask;
+		}
+	}
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        Crc32Update                                                                            */
+/*                                                                                                         */
+/* Parameters:      crc    - running CRC value                                                             */
+/*                  bufPtr - data                                                                          */
+/*                  nBytes - data size, in bytes                                                           */
+/* Returns:         updated CRC value                                                                      */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  CRC32 (IEEE 802.3, reflected), same as the CRC32 instructions. Pre and post inversion  */
+/*                  are left to the caller                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+unsigned int Crc32Update (unsigned int crc, const void *bufPtr, unsigned long nBytes)
+{
+	static UINT32 table[256];
+	const UINT8  *p = (const UINT8 *)bufPtr;
+	UINT32        c;
+	UINT32        i;
+	UINT32        k;
+
+	if (table[1] == 0)
+	{
+		for (i = 0; i < 256; i++)
+		{
+			c = i;
+			for (k = 0; k < 8; k++)
+				c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+			table[i] = c;
+		}
+	}
+
+	while (nBytes--)
+	{
+		crc = table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+	}
+
+	return crc;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Caches and MMU (BOOTBLOCK_CACHED_BOOT): the host memory is coherent, nothing to do                     */
+/*---------------------------------------------------------------------------------------------------------*/
+void DisableCaches (void)           {}
+void InvalidateUDCaches (void)      {}
+void CleanInvalidateUDCaches (void) {}
+void EnableMMUEL3 (void *ttbr0)     { (void)ttbr0; }
+void DisableMMUEL3 (void)           {}
+void InvalidateTLBEL3 (void)        {}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Cores: only the primary core runs, the jobs given to the other cores are taken back after a timeout     */
+/* (image_mp_wait, the DRAM test and the DRAM init of the MC driver)                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+unsigned int GetCPUID (void)        { return 0; }
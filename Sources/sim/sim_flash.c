@@ -0,0 +1,262 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   sim_flash.c                                                              */
+/*            This file contains the flash content of the host simulation:    */
+/*            a flash image file or a synthetic one (bootblock header, BL31,  */
+/*            OPTEE and UBOOT), and the check of the images copied to DRAM    */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+#include "sim.h"
+#include "boot.h"
+#include "images.h"
+
+extern const uint8_t    bb_header_tag[8];
+extern const uint8_t    bl31_header_tag[8];
+extern const uint8_t    optee_header_tag[8];
+extern const uint8_t    uboot_header_tag[8];
+extern const uint8_t    image_dir_tag[8];
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Synthetic flash layout, same as the OpenBMC flash layout of Arbel                                      */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct
+{
+	const char     *name;
+	const uint8_t  *tag;
+	UINT32          offset;         /* in flash                                                            */
+	UINT32          destAddr;       /* header destination in DRAM, the code is 0x200 above                 */
+	UINT32          codeSize;
+} SIM_FLASH_IMAGE_T;
+
+static const SIM_FLASH_IMAGE_T sim_flash_images[] =
+{
+	{ "BL31",  bl31_header_tag,  0x000C0000, 0x0001FE00, 0x0001C000 },
+	{ "OPTEE", optee_header_tag, 0x000E0000, 0x05FFFE00, 0x0001E000 },
+	{ "UBOOT", uboot_header_tag, 0x00100000, 0x07FFFE00, 0x000B0123 },   /* not a multiple of 64 bytes  */
+};
+
+#define SIM_FLASH_PTR(offset)           ((UINT8 *)(uintptr_t)(SIM_FLASH_BASE + (offset)))
+#define SIM_FLASH_DIR_OFFSET            0x1000          /* image directory, in the bootblock code              */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        sim_flash_header_l                                                                     */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Bootblock header of an EB: every optional parameter is 0xFF (use the default)         */
+/*---------------------------------------------------------------------------------------------------------*/
+static void sim_flash_header_l (void)
+{
+	BOOTBLOCK_HEADER_T *bb = (BOOTBLOCK_HEADER_T *)SIM_FLASH_PTR(0);
+
+	memset(bb, 0xFF, sizeof(*bb));
+	memcpy(bb->header.startTag, bb_header_tag, sizeof(bb->header.startTag));
+	memset(bb->header.signature, 0, sizeof(bb->header.signature));
+
+	bb->header.version               = 0x00010000;
+	bb->header.vendor                = VENDOR_NUVOTON;
+	bb->header.board_type            = BOARD_EB;
+	bb->header.mc_freq               = 1066;
+	bb->header.cpu_freq              = 1000;
+	bb->header.soc_drive             = 48;
+	bb->header.soc_odt               = 48;
+	bb->header.dram_drive            = 48;
+	bb->header.dram_odt              = 48;
+	bb->header.NoECC_Region_0_Start  = 0;
+	bb->header.NoECC_Region_0_End    = 0;
+	bb->header.NoECC_Region_1_Start  = 0;
+	bb->header.NoECC_Region_1_End    = 0;
+	bb->header.dram_max_size         = (UINT32)SIM_DRAM_WINDOW;
+	bb->header.mc_config             = sim_config.mc_config | (sim_config.ecc ? MC_CAPABILITY_ECC_ENABLE : 0);
+	bb->header.host_if               = HOST_IF_UNKNOWN_0;
+	bb->header.mc_sweep_debug        = 0;
+	bb->header.mc_sweep_main_flow    = 0;
+	bb->header.destAddr              = 0;
+	bb->header.codeSize              = 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        sim_flash_image_l                                                                      */
+/*                                                                                                         */
+/* Parameters:      img  - image to build                                                                  */
+/*                  seed - of the pseudo random code                                                       */
+/* Returns:         none                                                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static void sim_flash_image_l (const SIM_FLASH_IMAGE_T *img, UINT32 seed)
+{
+	HEADER_GENERAL_T *header = (HEADER_GENERAL_T *)SIM_FLASH_PTR(img->offset);
+	UINT8            *code = (UINT8 *)(header + 1);
+	UINT32            i;
+
+	memset(header, 0, sizeof(*header));
+	memcpy(header->header.startTag, img->tag, sizeof(header->header.startTag));
+	header->header.destAddr = img->destAddr;
+	header->header.codeSize = img->codeSize;
+
+	/* xorshift32, so a shifted or truncated copy does not compare equal */
+	for (i = 0; i < img->codeSize; i++)
+	{
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		code[i] = (UINT8)seed;
+	}
+
+	header->header.img_crc = ~Crc32Update(0xFFFFFFFF, (UINT8 *)header + IMAGE_CRC_START_OFFSET,
+					      img->codeSize + sizeof(*header) - IMAGE_CRC_START_OFFSET);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        sim_flash_dir_l                                                                        */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Image directory of the synthetic images. The bootblock code size is extended over it,  */
+/*                  as the image tool does to get it signed with the bootblock                             */
+/*---------------------------------------------------------------------------------------------------------*/
+static void sim_flash_dir_l (void)
+{
+	BOOTBLOCK_HEADER_T *bb = (BOOTBLOCK_HEADER_T *)SIM_FLASH_PTR(0);
+	IMAGE_DIR_T        *dir = (IMAGE_DIR_T *)SIM_FLASH_PTR(SIM_FLASH_DIR_OFFSET);
+	UINT32              i;
+
+	memset(dir, 0xFF, sizeof(*dir));
+	memcpy(dir->startTag, image_dir_tag, sizeof(dir->startTag));
+	dir->version = IMAGE_DIR_VERSION;
+	dir->count   = ARRAY_SIZE(sim_flash_images);
+
+	for (i = 0; i < ARRAY_SIZE(sim_flash_images); i++)
+	{
+		memcpy(dir->entry[i].tag, sim_flash_images[i].tag, sizeof(dir->entry[i].tag));
+		dir->entry[i].offset   = sim_flash_images[i].offset;
+		dir->entry[i].size     = sim_flash_images[i].codeSize + sizeof(HEADER_GENERAL_T);
+		dir->entry[i].destAddr = sim_flash_images[i].destAddr;
+		dir->entry[i].reserved = 0;
+	}
+	dir->crc = ~Crc32Update(0xFFFFFFFF, dir->entry, dir->count * sizeof(IMAGE_DIR_ENTRY_T));
+
+	bb->header.img_dir_offset = SIM_FLASH_DIR_OFFSET;
+	bb->header.codeSize       = SIM_FLASH_DIR_OFFSET + sizeof(*dir) - sizeof(*bb);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        SIM_FLASH_Init                                                                         */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         0 on success                                                                           */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Load sim_config.flash_file to the flash, or build the synthetic flash                  */
+/*---------------------------------------------------------------------------------------------------------*/
+int SIM_FLASH_Init (void)
+{
+	FILE  *f;
+	size_t len;
+	UINT32 i;
+
+	if (sim_config.flash_file != NULL)
+	{
+		f = fopen(sim_config.flash_file, "rb");
+		if (f == NULL)
+		{
+			perror(sim_config.flash_file);
+			return -1;
+		}
+		len = fread(SIM_FLASH_PTR(0), 1, SIM_FLASH_SIZE, f);
+		fclose(f);
+		if (len < sizeof(BOOTBLOCK_HEADER_T))
+		{
+			fprintf(stderr, "sim: %s: too short\n", sim_config.flash_file);
+			return -1;
+		}
+		return 0;
+	}
+
+	sim_flash_header_l();
+	for (i = 0; i < ARRAY_SIZE(sim_flash_images); i++)
+	{
+		sim_flash_image_l(&sim_flash_images[i], 0x2545F491 + i);
+	}
+	if (sim_config.image_dir)
+	{
+		sim_flash_dir_l();
+	}
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        SIM_FLASH_CheckImages                                                                  */
+/*                                                                                                         */
+/* Parameters:      entry - address the bootblock jumped to                                                */
+/* Returns:         0 if BL31, OPTEE and UBOOT are in DRAM and entry is the code of BL31                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  The images are found by their tag, as images.c does, so this works with a flash file  */
+/*                  too                                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+int SIM_FLASH_CheckImages (UINT64 entry)
+{
+	HEADER_GENERAL_T *header;
+	UINT32            offset;
+	UINT32            size;
+	UINT32            i;
+	int               found;
+	int               ret = 0;
+
+	for (i = 0; i < ARRAY_SIZE(sim_flash_images); i++)
+	{
+		found = 0;
+		for (offset = 0; offset < SIM_FLASH_SIZE; offset += 0x1000)
+		{
+			header = (HEADER_GENERAL_T *)SIM_FLASH_PTR(offset);
+			if (memcmp(header->header.startTag, sim_flash_images[i].tag, sizeof(header->header.startTag)) == 0)
+			{
+				found = 1;
+				break;
+			}
+		}
+
+		if (!found)
+		{
+			fprintf(stderr, "sim: %-5s not in flash\n", sim_flash_images[i].name);
+			ret = -1;
+			continue;
+		}
+
+		size = header->header.codeSize + sizeof(*header);
+		if ((header->header.destAddr == 0) || ((UINT64)header->header.destAddr + size > SIM_DRAM_WINDOW))
+		{
+			fprintf(stderr, "sim: %-5s bad destination %#x\n", sim_flash_images[i].name, header->header.destAddr);
+			ret = -1;
+			continue;
+		}
+
+		found = (memcmp((void *)(uintptr_t)header->header.destAddr, header, size) == 0);
+		fprintf(stderr, "sim: %-5s flash %#010x -> DRAM %#010x, %#9x bytes: %s\n", sim_flash_images[i].name,
+			(UINT32)(SIM_FLASH_BASE + offset), header->header.destAddr, size, found ? "OK" : "MISMATCH");
+		if (!found)
+			ret = -1;
+
+		if ((i == 0) && (entry != (UINT64)header->header.destAddr + sizeof(*header)))
+		{
+			fprintf(stderr, "sim: entry %#lx is not the BL31 code\n", (unsigned long)entry);
+			ret = -1;
+		}
+	}
+
+	return ret;
+}
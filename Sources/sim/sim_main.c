@@ -0,0 +1,238 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   sim_main.c                                                               */
+/*            This file contains the entry point of the host simulation:     */
+/*            runs bootblock_main until the jump to BL31, a reset or a hang   */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <unistd.h>
+#include "sim.h"
+
+extern void bootblock_main (void);
+
+SIM_CONFIG_T            sim_config =
+{
+	.dram_size   = 0x40000000,
+	.timeout_sec = 60,
+};
+
+static sigjmp_buf       sim_exit_env;
+static SIM_EXIT_T       sim_exit_reason;
+static UINT64           sim_exit_arg;
+
+static const char      *sim_exit_names[] = { "jump to BL31", "reset", "hang", "fault", "error" };
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        SIM_Exit                                                                               */
+/*                                                                                                         */
+/* Parameters:      reason - end of the run                                                                */
+/*                  arg    - entry address, reset register value or fault address                          */
+/* Returns:         does not return                                                                        */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Called by the models (reset) and by the signal handlers (jump, fault, hang)           */
+/*---------------------------------------------------------------------------------------------------------*/
+void SIM_Exit (SIM_EXIT_T reason, UINT64 arg)
+{
+	sim_exit_reason = reason;
+	sim_exit_arg = arg;
+	siglongjmp(sim_exit_env, 1);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        sim_segv_l                                                                             */
+/*                                                                                                         */
+/* Description:                                                                                            */
+/*                  DRAM is mapped without execute permission: a permission fault inside the DRAM window  */
+/*                  is the instruction fetch of the jump to BL31 (data accesses there never fault)        */
+/*---------------------------------------------------------------------------------------------------------*/
+static void sim_segv_l (int sig, siginfo_t *info, void *context)
+{
+	UINT64 addr = (UINT64)(uintptr_t)info->si_addr;
+
+	(void)context;
+
+	if ((sig == SIGSEGV) && (info->si_code == SEGV_ACCERR) && (addr < SIM_DRAM_BASE + SIM_DRAM_WINDOW))
+	{
+		SIM_Exit(SIM_EXIT_JUMP, addr);
+	}
+
+	SIM_Exit(SIM_EXIT_FAULT, addr);
+}
+
+static void sim_alarm_l (int sig)
+{
+	(void)sig;
+	SIM_Exit(SIM_EXIT_HANG, sim_time_ns);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        sim_signals_l                                                                          */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         0 on success                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+static int sim_signals_l (void)
+{
+	static UINT8     altstack[64 * 1024];
+	stack_t          ss;
+	struct sigaction sa;
+
+	ss.ss_sp = altstack;
+	ss.ss_size = sizeof(altstack);
+	ss.ss_flags = 0;
+	if (sigaltstack(&ss, NULL) != 0)
+	{
+		perror("sim: sigaltstack");
+		return -1;
+	}
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_sigaction = sim_segv_l;
+	sa.sa_flags = SA_SIGINFO | SA_ONSTACK;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGSEGV, &sa, NULL);
+	sigaction(SIGBUS, &sa, NULL);
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = sim_alarm_l;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGALRM, &sa, NULL);
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        sim_load_otp_l                                                                         */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         0 on success                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+static int sim_load_otp_l (void)
+{
+	FILE *f;
+
+	if (sim_config.otp_file == NULL)
+		return 0;
+
+	f = fopen(sim_config.otp_file, "rb");
+	if (f == NULL)
+	{
+		perror(sim_config.otp_file);
+		return -1;
+	}
+	(void)fread(sim_otp, 1, sizeof(sim_otp), f);
+	fclose(f);
+
+	return 0;
+}
+
+static void sim_usage_l (const char *prog)
+{
+	fprintf(stderr,
+		"usage: %s [-f flash.bin] [-o otp.bin] [-u uart.txt] [-d dram_MB] [-t timeout_sec] [-e] [-m mc_config] [-i] [-q]\n"
+		"  -f  flash image at offset 0 of SPI0 CS0 (default: synthetic bootblock header, BL31, OPTEE, UBOOT)\n"
+		"  -o  OTP content, byte per fuse byte address (default: blank)\n"
+		"  -u  UART0 output file (default: stdout)\n"
+		"  -d  DRAM device size in MB, power of 2 from 128 to 2048 (default 1024)\n"
+		"  -t  wall clock timeout, reported as a hang (default 60)\n"
+		"  -e  synthetic header: enable ECC\n"
+		"  -m  synthetic header: mc_config bits, e.g. 0x02 quick or 0x80 full DRAM test (default 0)\n"
+		"  -i  synthetic flash: image directory in the signed bootblock code\n"
+		"  -q  no register access report\n", prog);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        main                                                                                   */
+/*                                                                                                         */
+/* Returns:         0 if the bootblock jumped to BL31 with BL31, OPTEE and UBOOT in DRAM, 1 otherwise,    */
+/*                  2 on setup error                                                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+int main (int argc, char *argv[])
+{
+	unsigned long mb;
+	int           opt;
+	int           ret;
+
+	while ((opt = getopt(argc, argv, "f:o:u:d:t:em:iqh")) != -1)
+	{
+		switch (opt)
+		{
+			case 'f': sim_config.flash_file = optarg;                       break;
+			case 'o': sim_config.otp_file = optarg;                         break;
+			case 'u': sim_config.uart_file = optarg;                        break;
+			case 't': sim_config.timeout_sec = (UINT32)strtoul(optarg, NULL, 0); break;
+			case 'e': sim_config.ecc = TRUE;                                break;
+			case 'm': sim_config.mc_config = (UINT8)strtoul(optarg, NULL, 0); break;
+			case 'i': sim_config.image_dir = TRUE;                          break;
+			case 'q': sim_config.quiet = TRUE;                              break;
+			case 'd':
+				mb = strtoul(optarg, NULL, 0);
+				if ((mb < 128) || (mb > 2048) || (mb & (mb - 1)))
+				{
+					sim_usage_l(argv[0]);
+					return 2;
+				}
+				sim_config.dram_size = (UINT64)mb << 20;
+				break;
+			default:
+				sim_usage_l(argv[0]);
+				return 2;
+		}
+	}
+
+	sim_uart_out = stdout;
+	if (sim_config.uart_file != NULL)
+	{
+		sim_uart_out = fopen(sim_config.uart_file, "w");
+		if (sim_uart_out == NULL)
+		{
+			perror(sim_config.uart_file);
+			return 2;
+		}
+	}
+
+	if ((SIM_MMIO_Init() != 0) || (sim_load_otp_l() != 0) || (SIM_FLASH_Init() != 0) || (sim_signals_l() != 0))
+	{
+		return 2;
+	}
+	SIM_PERIPH_Init();
+
+	if (sigsetjmp(sim_exit_env, 1) == 0)
+	{
+		alarm(sim_config.timeout_sec);
+		bootblock_main();
+	}
+	alarm(0);
+
+	fflush(sim_uart_out);
+	fprintf(stderr, "\nsim: %s (%#lx) after %llu.%03llu ms of virtual time\n", sim_exit_names[sim_exit_reason],
+		(unsigned long)sim_exit_arg, (unsigned long long)(sim_time_ns / 1000000),
+		(unsigned long long)((sim_time_ns / 1000) % 1000));
+
+	ret = 1;
+	if ((sim_exit_reason == SIM_EXIT_JUMP) && (SIM_FLASH_CheckImages(sim_exit_arg) == 0))
+	{
+		ret = 0;
+	}
+
+	if (!sim_config.quiet)
+	{
+		SIM_MMIO_Report(stderr);
+	}
+
+	return ret;
+}
@@ -0,0 +1,245 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   sim_mmio.c                                                               */
+/*            This file contains the memory map and the MMIO dispatch of the  */
+/*            host simulation                                                 */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "sim.h"
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE             0x100000
+#endif
+
+UINT64                  sim_time_ns;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Peripheral of each 4KB page of the IO window, NULL: plain memory (RAM2, mailbox, unmodeled registers)   */
+/*---------------------------------------------------------------------------------------------------------*/
+static SIM_PERIPH_T    *sim_io_map[SIM_IO_PAGES];
+static SIM_PERIPH_T    *sim_periphs[32];
+static UINT32           sim_periphs_num;
+static UINT64           sim_io_reads;
+static UINT64           sim_io_writes;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        sim_map_l                                                                              */
+/*                                                                                                         */
+/* Parameters:      addr  - address in the host process, same as on the chip                               */
+/*                  size  - size of the mapping                                                            */
+/*                  fd    - memory file, -1 for anonymous memory                                           */
+/*                  name  - for the error message                                                          */
+/* Returns:         0 on success                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+static int sim_map_l (UINT64 addr, UINT64 size, int fd, const char *name)
+{
+	int   flags = MAP_FIXED_NOREPLACE | MAP_NORESERVE | ((fd < 0) ? (MAP_PRIVATE | MAP_ANONYMOUS) : MAP_SHARED);
+	void *p = mmap((void *)(uintptr_t)addr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+
+	if (p != (void *)(uintptr_t)addr)
+	{
+		fprintf(stderr, "sim: can't map %s at %#lx (%#lx bytes)%s\n", name, (unsigned long)addr,
+			(unsigned long)size, (addr == 0) ? ": run as root or set vm.mmap_min_addr=0" : "");
+		if (p != MAP_FAILED)
+			munmap(p, size);
+		return -1;
+	}
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        SIM_MMIO_Init                                                                          */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         0 on success                                                                           */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Map DRAM, flash and the IO window. The DRAM device (sim_config.dram_size) is mapped    */
+/*                  again and again over the DRAM window, so it wraps around like the real device and     */
+/*                  MC_CheckDramSize finds its size                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+int SIM_MMIO_Init (void)
+{
+	UINT64 addr;
+	int    fd;
+
+	fd = memfd_create("sim_dram", 0);
+	if ((fd < 0) || (ftruncate(fd, sim_config.dram_size) != 0))
+	{
+		perror("sim: dram");
+		return -1;
+	}
+
+	for (addr = SIM_DRAM_BASE; addr < SIM_DRAM_BASE + SIM_DRAM_WINDOW; addr += sim_config.dram_size)
+	{
+		if (sim_map_l(addr, sim_config.dram_size, fd, "DRAM") != 0)
+			return -1;
+	}
+	close(fd);
+
+	if ((sim_map_l(SIM_FLASH_BASE, SIM_FLASH_SIZE, -1, "flash") != 0) ||
+	    (sim_map_l(SIM_IO_BASE, SIM_IO_SIZE, -1, "IO") != 0))
+	{
+		return -1;
+	}
+
+	memset((void *)(uintptr_t)SIM_FLASH_BASE, 0xFF, SIM_FLASH_SIZE);
+
+	return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        SIM_MMIO_Register                                                                      */
+/*                                                                                                         */
+/* Parameters:      periph - peripheral model, base and size 4KB aligned                                   */
+/* Returns:         none                                                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+void SIM_MMIO_Register (SIM_PERIPH_T *periph)
+{
+	UINT64 page;
+
+	for (page = (periph->base - SIM_IO_BASE) >> SIM_IO_PAGE_SHIFT;
+	     page < (periph->base + periph->size - SIM_IO_BASE) >> SIM_IO_PAGE_SHIFT; page++)
+	{
+		sim_io_map[page] = periph;
+	}
+
+	if (sim_periphs_num < ARRAY_SIZE(sim_periphs))
+		sim_periphs[sim_periphs_num++] = periph;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        SIM_MMIO_Peek / SIM_MMIO_Poke                                                          */
+/*                                                                                                         */
+/* Description:                                                                                            */
+/*                  Access the register file and the memories without the models (for the models)         */
+/*---------------------------------------------------------------------------------------------------------*/
+UINT64 SIM_MMIO_Peek (UINT64 addr, UINT size)
+{
+	switch (size)
+	{
+		case 1:  return *(volatile UINT8  *)(uintptr_t)addr;
+		case 2:  return *(volatile UINT16 *)(uintptr_t)addr;
+		case 4:  return *(volatile UINT32 *)(uintptr_t)addr;
+		default: return *(volatile UINT64 *)(uintptr_t)addr;
+	}
+}
+
+void SIM_MMIO_Poke (UINT64 addr, UINT size, UINT64 val)
+{
+	switch (size)
+	{
+		case 1:  *(volatile UINT8  *)(uintptr_t)addr = (UINT8)val;  break;
+		case 2:  *(volatile UINT16 *)(uintptr_t)addr = (UINT16)val; break;
+		case 4:  *(volatile UINT32 *)(uintptr_t)addr = (UINT32)val; break;
+		default: *(volatile UINT64 *)(uintptr_t)addr = val;         break;
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        SIM_MMIO_Read                                                                          */
+/*                                                                                                         */
+/* Parameters:      addr - physical address                                                                */
+/*                  size - 1, 2, 4 or 8 bytes                                                              */
+/* Returns:         value read                                                                             */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Target of MEMR8..MEMR64 in the simulation build (defs_core_arm.h)                      */
+/*---------------------------------------------------------------------------------------------------------*/
+UINT64 SIM_MMIO_Read (UINT64 addr, UINT size)
+{
+	SIM_PERIPH_T *periph;
+	UINT64        val;
+
+	val = SIM_MMIO_Peek(addr, size);
+
+	if (addr - SIM_IO_BASE >= SIM_IO_SIZE)
+	{
+		return val;
+	}
+
+	sim_time_ns += SIM_MMIO_COST_NS;
+	sim_io_reads++;
+
+	periph = sim_io_map[(addr - SIM_IO_BASE) >> SIM_IO_PAGE_SHIFT];
+	if (periph != NULL)
+	{
+		periph->reads++;
+		if (periph->read != NULL)
+			val = periph->read(periph, (UINT32)(addr - periph->base), size, val);
+	}
+
+	return val;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        SIM_MMIO_Write                                                                         */
+/*                                                                                                         */
+/* Parameters:      addr - physical address                                                                */
+/*                  size - 1, 2, 4 or 8 bytes                                                              */
+/*                  val  - value to write                                                                  */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Target of MEMW8..MEMW64 in the simulation build (defs_core_arm.h)                      */
+/*---------------------------------------------------------------------------------------------------------*/
+void SIM_MMIO_Write (UINT64 addr, UINT size, UINT64 val)
+{
+	SIM_PERIPH_T *periph;
+
+	if (addr - SIM_IO_BASE < SIM_IO_SIZE)
+	{
+		sim_time_ns += SIM_MMIO_COST_NS;
+		sim_io_writes++;
+
+		periph = sim_io_map[(addr - SIM_IO_BASE) >> SIM_IO_PAGE_SHIFT];
+		if (periph != NULL)
+		{
+			periph->writes++;
+			if (periph->write != NULL)
+				val = periph->write(periph, (UINT32)(addr - periph->base), size, val);
+		}
+	}
+
+	SIM_MMIO_Poke(addr, size, val);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        SIM_MMIO_Report                                                                        */
+/*                                                                                                         */
+/* Parameters:      out - report file                                                                      */
+/* Returns:         none                                                                                   */
+/* Description:                                                                                            */
+/*                  Register accesses per peripheral model                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+void SIM_MMIO_Report (FILE *out)
+{
+	UINT64 reads = sim_io_reads;
+	UINT64 writes = sim_io_writes;
+	UINT32 i;
+
+	fprintf(out, "%-10s %12s %12s\n", "registers", "reads", "writes");
+	for (i = 0; i < sim_periphs_num; i++)
+	{
+		fprintf(out, "%-10s %12llu %12llu\n", sim_periphs[i]->name,
+			(unsigned long long)sim_periphs[i]->reads, (unsigned long long)sim_periphs[i]->writes);
+		reads -= sim_periphs[i]->reads;
+		writes -= sim_periphs[i]->writes;
+	}
+	fprintf(out, "%-10s %12llu %12llu\n", "other", (unsigned long long)reads, (unsigned long long)writes);
+	fprintf(out, "%-10s %12llu %12llu\n", "total", (unsigned long long)sim_io_reads,
+		(unsigned long long)sim_io_writes);
+}
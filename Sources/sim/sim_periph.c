@@ -0,0 +1,296 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   sim_periph.c                                                             */
+/*            This file contains the peripheral models of the host simulation */
+/*            (UART, clocks and counters, TMC, FUSE, MC and PHY)              */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+#include "sim.h"
+#include "hal_regs.h"
+
+UINT8                   sim_otp[SIM_OTP_SIZE];
+FILE                   *sim_uart_out;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Register offsets of the models, from the HAL register definitions                                       */
+/*---------------------------------------------------------------------------------------------------------*/
+#define SIM_REG_ADDR(reg)               _GET_REG_ADDR(reg)
+#define SIM_REG_OFFSET(base, reg)       ((UINT32)((_GET_REG_ADDR(reg)) - (base)))
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Reset values of the PLLs: PLL0 1000MHz (CPU), PLL1 800MHz (MC), PLL2 960MHz                            */
+/*---------------------------------------------------------------------------------------------------------*/
+#define SIM_PLLCON(indv, fbdv, otdv1, otdv2)    (((fbdv) << 16) | ((otdv2) << 13) | ((otdv1) << 8) | (indv))
+#define SIM_PLLCON0_RESET               SIM_PLLCON(1, 80, 2, 1)
+#define SIM_PLLCON1_RESET               SIM_PLLCON(1, 64, 2, 1)
+#define SIM_PLLCON2_RESET               SIM_PLLCON(5, 192, 1, 1)
+#define SIM_PLLCONG_RESET               SIM_PLLCON(1, 64, 2, 1)
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                                  UART                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 sim_uart_read (SIM_PERIPH_T *periph, UINT32 offset, UINT size, UINT64 val)
+{
+	if (offset == SIM_REG_OFFSET(periph->base, LSR(0)))
+	{
+		/* transmitter always empty, nothing received */
+		val = MASK_FIELD(LSR_THRE) | MASK_FIELD(LSR_TE);
+	}
+
+	return val;
+}
+
+static UINT64 sim_uart_write (SIM_PERIPH_T *periph, UINT32 offset, UINT size, UINT64 val)
+{
+	UINT8 lcr = (UINT8)SIM_MMIO_Peek(SIM_REG_ADDR(LCR(0)), 1);
+
+	if ((offset == SIM_REG_OFFSET(periph->base, THR(0))) && (READ_VAR_FIELD(lcr, LCR_DLAB) == 0))
+	{
+		fputc((int)(val & 0xFF), sim_uart_out);
+	}
+
+	return val;
+}
+
+static SIM_PERIPH_T sim_uart = { "UART0", UART0_BASE_ADDR, 0x1000, sim_uart_read, sim_uart_write, 0, 0 };
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                      CLK: PLLs, counters and SW reset                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 sim_clk_read (SIM_PERIPH_T *periph, UINT32 offset, UINT size, UINT64 val)
+{
+	if ((offset == SIM_REG_OFFSET(periph->base, PLLCON0)) || (offset == SIM_REG_OFFSET(periph->base, PLLCON1)) ||
+	    (offset == SIM_REG_OFFSET(periph->base, PLLCON2)) || (offset == SIM_REG_OFFSET(periph->base, PLLCONG)))
+	{
+		/* locked as soon as configured */
+		val |= MASK_FIELD(PLLCONn_LOKI);
+	}
+	else if (offset == SIM_REG_OFFSET(periph->base, SECCNT))
+	{
+		sim_time_ns += SIM_POLL_COST_NS;
+		val = sim_time_ns / 1000000000ULL;
+	}
+	else if (offset == SIM_REG_OFFSET(periph->base, CNTR25M))
+	{
+		/* 25MHz, updated every 640ns (the 4 LSB are 0) */
+		sim_time_ns += SIM_POLL_COST_NS;
+		val = (((sim_time_ns % 1000000000ULL) * EXT_CLOCK_FREQUENCY_MHZ) / 1000) & ~0xFULL;
+	}
+
+	return val;
+}
+
+static UINT64 sim_clk_write (SIM_PERIPH_T *periph, UINT32 offset, UINT size, UINT64 val)
+{
+	if ((offset == SIM_REG_OFFSET(periph->base, SWRSTR)) && (val != 0))
+	{
+		SIM_Exit(SIM_EXIT_RESET, val);
+	}
+
+	return val;
+}
+
+static SIM_PERIPH_T sim_clk = { "CLK", CLK_PHYS_BASE_ADDR, 0x1000, sim_clk_read, sim_clk_write, 0, 0 };
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                       TMC and FSW: watchdog resets                                      */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 sim_wd_write (SIM_PERIPH_T *periph, UINT32 offset, UINT size, UINT64 val)
+{
+	/* WTCR and FSWCR: enabled watchdog with reset, the boot is over */
+	if ((offset == 0x1C) && READ_VAR_FIELD((UINT32)val, WTCR_WTE) && READ_VAR_FIELD((UINT32)val, WTCR_WTRE))
+	{
+		SIM_Exit(SIM_EXIT_RESET, val);
+	}
+
+	return val;
+}
+
+static SIM_PERIPH_T sim_tmc0 = { "TMC0", TMR0_PHYS_BASE_ADDR, 0x1000, NULL, sim_wd_write, 0, 0 };
+static SIM_PERIPH_T sim_tmc1 = { "TMC1", TMR1_PHYS_BASE_ADDR, 0x1000, NULL, sim_wd_write, 0, 0 };
+static SIM_PERIPH_T sim_tmc2 = { "TMC2", TMR2_PHYS_BASE_ADDR, 0x1000, NULL, sim_wd_write, 0, 0 };
+static SIM_PERIPH_T sim_fsw  = { "FSW",  FSW_PHYS_BASE_ADDR,  0x1000, NULL, sim_wd_write, 0, 0 };
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*                                 FUSE: OTP read cycles from sim_otp                                      */
+/*---------------------------------------------------------------------------------------------------------*/
+#define SIM_FUSE_READ_INIT              0x02
+
+static UINT64 sim_fuse_read (SIM_PERIPH_T *periph, UINT32 offset, UINT size, UINT64 val)
+{
+	if (offset == SIM_REG_OFFSET(periph->base, FST))
+	{
+		val |= MASK_FIELD(FST_RDY);
+	}
+
+	return val;
+}
+
+static UINT64 sim_fuse_write (SIM_PERIPH_T *periph, UINT32 offset, UINT size, UINT64 val)
+{
+	UINT32 addr;
+
+	if ((offset == SIM_REG_OFFSET(periph->base, FCTL)) && (val == SIM_FUSE_READ_INIT))
+	{
+		addr = READ_VAR_FIELD((UINT32)SIM_MMIO_Peek(SIM_REG_ADDR(FADDR), 4), FADDR_BYTEADDR);
+		SIM_MMIO_Poke(SIM_REG_ADDR(FDATA), 4, (addr < SIM_OTP_SIZE) ? sim_otp[addr] : 0);
+	}
+	else if (offset == SIM_REG_OFFSET(periph->base, FST))
+	{
+		/* RDST is write 1 to clear, RDY is read only */
+		val &= ~(MASK_FIELD(FST_RDST) | MASK_FIELD(FST_RDY));
+	}
+
+	return val;
+}
+
+static SIM_PERIPH_T sim_fuse = { "FUSE", FUSE_PHYS_BASE_ADDR, 0x1000, sim_fuse_read, sim_fuse_write, 0, 0 };
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*         MC (Denali controller): initialization, mode register writes and ZQ calibration complete at once.*/
+/*         BIST memory initialization fills DRAM and completes after SIM_MC_BIST_BYTES_PER_NS              */
+/*---------------------------------------------------------------------------------------------------------*/
+#define SIM_MC_BIST_BYTES_PER_NS        4               /* x16 DDR4-2133                                */
+
+static BOOLEAN          sim_mc_bist_busy;
+static UINT64           sim_mc_bist_done_ns;
+
+static void sim_mc_bist_l (void)
+{
+	UINT64  start = SIM_MMIO_Peek(SIM_REG_ADDR(DENALI_CTL_84), 4) |
+			(SIM_MMIO_Peek(SIM_REG_ADDR(DENALI_CTL_85), 4) << 32);
+	UINT64  size = 1ULL << READ_VAR_FIELD((UINT32)SIM_MMIO_Peek(SIM_REG_ADDR(DENALI_CTL_83), 4), DENALI_CTL_83_ADDR_SPACE);
+	UINT64  pattern = SIM_MMIO_Peek(SIM_REG_ADDR(DENALI_CTL_88), 4) |
+			  (SIM_MMIO_Peek(SIM_REG_ADDR(DENALI_CTL_89), 4) << 32);
+	UINT64 *p;
+	UINT64 *end;
+
+	/* the DRAM device is aliased over the window, one pass over it is enough */
+	if (size > sim_config.dram_size)
+		size = sim_config.dram_size;
+	if (start + size <= SIM_DRAM_WINDOW)
+	{
+		p = (UINT64 *)(uintptr_t)start;
+		end = (UINT64 *)(uintptr_t)(start + size);
+		while (p < end)
+			*p++ = pattern;
+	}
+
+	sim_mc_bist_busy = TRUE;
+	sim_mc_bist_done_ns = sim_time_ns + size / SIM_MC_BIST_BYTES_PER_NS;
+}
+
+static UINT64 sim_mc_read (SIM_PERIPH_T *periph, UINT32 offset, UINT size, UINT64 val)
+{
+	if (offset == SIM_REG_OFFSET(periph->base, DENALI_CTL_135))
+	{
+		val |= MASK_FIELD(DENALI_CTL_135_Init);
+	}
+	else if (offset == SIM_REG_OFFSET(periph->base, DENALI_CTL_124))
+	{
+		val &= ~MASK_FIELD(DENALI_CTL_124_ZQ_REQ_PENDING);
+	}
+	else if (offset == SIM_REG_OFFSET(periph->base, DENALI_CTL_143))
+	{
+		/* INT_STATUS_MODE bit 3: mode register write done */
+		val |= MASK_BIT(3);
+	}
+	else if ((offset == SIM_REG_OFFSET(periph->base, DENALI_CTL_141)) && sim_mc_bist_busy &&
+		 (sim_time_ns >= sim_mc_bist_done_ns))
+	{
+		/* INT_STATUS_BIST bit 0: BIST done */
+		sim_mc_bist_busy = FALSE;
+		val |= MASK_BIT(0);
+		SIM_MMIO_Poke(SIM_REG_ADDR(DENALI_CTL_141), 4, val);
+	}
+
+	return val;
+}
+
+static UINT64 sim_mc_write (SIM_PERIPH_T *periph, UINT32 offset, UINT size, UINT64 val)
+{
+	if ((offset == SIM_REG_OFFSET(periph->base, DENALI_CTL_82)) && READ_VAR_FIELD((UINT32)val, DENALI_CTL_82_BIST_GO) &&
+	    !READ_VAR_FIELD((UINT32)SIM_MMIO_Peek(SIM_REG_ADDR(DENALI_CTL_82), 4), DENALI_CTL_82_BIST_GO))
+	{
+		sim_mc_bist_l();
+	}
+	else if (offset == SIM_REG_OFFSET(periph->base, DENALI_CTL_148))
+	{
+		SIM_MMIO_Poke(SIM_REG_ADDR(DENALI_CTL_141), 4, SIM_MMIO_Peek(SIM_REG_ADDR(DENALI_CTL_141), 4) &
+			      ~(UINT64)READ_VAR_FIELD((UINT32)val, DENALI_CTL_148_INT_ACK_BIST));
+	}
+
+	return val;
+}
+
+static SIM_PERIPH_T sim_mc = { "MC", MC_BASE, 0x2000, sim_mc_read, sim_mc_write, 0, 0 };
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*       PHY: calibrations, DLL lock and SCL complete at once and pass on every lane. The data eye is not  */
+/*       modeled, the DRAM is ideal                                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 sim_phy_read (SIM_PERIPH_T *periph, UINT32 offset, UINT size, UINT64 val)
+{
+	if (offset == SIM_REG_OFFSET(periph->base, UNIQUIFY_IO_1))
+	{
+		val |= MASK_FIELD(UNIQUIFY_IO_1_done_tx_seen) | MASK_FIELD(UNIQUIFY_IO_1_done_rx_seen);
+	}
+	else if (offset == SIM_REG_OFFSET(periph->base, UNQ_ANALOG_DLL_2))
+	{
+		val |= MASK_FIELD(UNQ_ANALOG_DLL_2_analog_dll_lock);
+	}
+	else if (offset == SIM_REG_OFFSET(periph->base, SCL_START))
+	{
+		val |= MASK_FIELD(SCL_START_cuml_scl_rslt);
+	}
+
+	return val;
+}
+
+static UINT64 sim_phy_write (SIM_PERIPH_T *periph, UINT32 offset, UINT size, UINT64 val)
+{
+	if (offset == SIM_REG_OFFSET(periph->base, SCL_START))
+	{
+		val &= ~MASK_FIELD(SCL_START_set_ddr_scl_go_done);
+	}
+
+	return val;
+}
+
+static SIM_PERIPH_T sim_phy = { "PHY", PHY_BASE, 0x1000, sim_phy_read, sim_phy_write, 0, 0 };
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        SIM_PERIPH_Init                                                                        */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Register the models and set the reset values that are not 0                           */
+/*---------------------------------------------------------------------------------------------------------*/
+void SIM_PERIPH_Init (void)
+{
+	SIM_MMIO_Register(&sim_uart);
+	SIM_MMIO_Register(&sim_clk);
+	SIM_MMIO_Register(&sim_tmc0);
+	SIM_MMIO_Register(&sim_tmc1);
+	SIM_MMIO_Register(&sim_tmc2);
+	SIM_MMIO_Register(&sim_fsw);
+	SIM_MMIO_Register(&sim_fuse);
+	SIM_MMIO_Register(&sim_mc);
+	SIM_MMIO_Register(&sim_phy);
+
+	SIM_MMIO_Poke(SIM_REG_ADDR(PLLCON0), 4, SIM_PLLCON0_RESET);
+	SIM_MMIO_Poke(SIM_REG_ADDR(PLLCON1), 4, SIM_PLLCON1_RESET);
+	SIM_MMIO_Poke(SIM_REG_ADDR(PLLCON2), 4, SIM_PLLCON2_RESET);
+	SIM_MMIO_Poke(SIM_REG_ADDR(PLLCONG), 4, SIM_PLLCONG_RESET);
+}
@@ -18,6 +18,7 @@
 #include "hal_regs.h"
 #include "boot.h"
 #include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -32,6 +33,35 @@ UART_DEV_T gUartLog = UART_MAX_DEV;
 #define SERIAL_PRINTF_BUFFER_SIZE _2KB_
 #endif
 
+#if defined(BOOTBLOCK_LOG_RING) && (defined(DEBUG_LOG) || defined(DEV_LOG))
+#define SERIAL_PRINTF_RING
+#endif
+
+#ifdef SERIAL_PRINTF_RING
+/*---------------------------------------------------------------------------------------------------------*/
+/* Log ring size, must be a power of 2                                                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef SERIAL_PRINTF_RING_SIZE
+#define SERIAL_PRINTF_RING_SIZE _8KB_
+#endif
+#define SERIAL_PRINTF_TX_FIFO_SIZE  16
+#endif
+
+#ifdef BOOTBLOCK_LOG_BINARY
+/*---------------------------------------------------------------------------------------------------------*/
+/* Binary log: RAM copy size and UART copy (see serial_log_bin)                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef SERIAL_LOG_BIN_BUF_SIZE
+#define SERIAL_LOG_BIN_BUF_SIZE     _16KB_
+#endif
+#ifndef SERIAL_LOG_BIN_UART
+#define SERIAL_LOG_BIN_UART         1
+#endif
+#define SERIAL_LOG_BIN_ARGS_MAX     16
+#define SERIAL_LOG_BIN_TEXT_MAX     8       /* format without arguments up to this size is sent as text     */
+#define SERIAL_LOG_BIN_REC_MAX      (2 + 4 + 5 + (SERIAL_LOG_BIN_ARGS_MAX * 10))
+#endif
+
 /*---------------------------------------------------------------------------------------------------------*/
 /* Local defines                                                                                           */
 /*---------------------------------------------------------------------------------------------------------*/
@@ -53,6 +83,217 @@ UART_DEV_T gUartLog = UART_MAX_DEV;
 /*---------------------------------------------------------------------------------------------------------*/
 static char buf[SERIAL_PRINTF_BUFFER_SIZE] = {0};
 
+#ifdef SERIAL_PRINTF_RING
+/*---------------------------------------------------------------------------------------------------------*/
+/* Single producer (serial_puts) / single consumer (serial_ring_drain) ring. Free running indexes: each    */
+/* side writes only its own index, so no lock is needed. A record (one serial_puts) that does not fit is   */
+/* dropped and counted in serial_printf_ring_lost, read with the debugger                                  */
+/*---------------------------------------------------------------------------------------------------------*/
+static char             log_ring[SERIAL_PRINTF_RING_SIZE];
+static volatile UINT32  log_ring_head = 0;
+static volatile UINT32  log_ring_tail = 0;
+static const char       log_ring_lost_msg[] = "\r\n<log ring full, records lost>\r\n";
+UINT32                  serial_printf_ring_lost = 0;
+static BOOLEAN          log_ring_lost = FALSE;
+static UINT32           log_ring_sync = 0;
+#endif
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Runtime log level of the HAL modules (HAL_LOG_ID_T), see HAL_LOG in hal_cfg.h                           */
+/*---------------------------------------------------------------------------------------------------------*/
+UINT8 hal_log_level[HAL_LOG_NUM_OF_MODULES] =
+{
+	HAL_LOG_LEVEL_HAL,
+	HAL_LOG_LEVEL_MC,
+	HAL_LOG_LEVEL_PHY,
+	HAL_LOG_LEVEL_FIU,
+	HAL_LOG_LEVEL_CLK,
+	HAL_LOG_LEVEL_ESPI,
+	HAL_LOG_LEVEL_SHM,
+	HAL_LOG_LEVEL_FUSE,
+};
+
+#ifdef BOOTBLOCK_LOG_BINARY
+/*---------------------------------------------------------------------------------------------------------*/
+/* RAM copy of the binary log, read with the debugger (serial_log_bin_buf, serial_log_bin_size)            */
+/*---------------------------------------------------------------------------------------------------------*/
+UINT8                   serial_log_bin_buf[SERIAL_LOG_BIN_BUF_SIZE];
+UINT32                  serial_log_bin_size = 0;
+UINT32                  serial_log_bin_lost = 0;
+static UINT32           log_bin_time = 0;
+#endif
+
+
+#ifdef SERIAL_PRINTF_RING
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        serial_ring_drain                                                                      */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  wait - TRUE: wait for the UART until the ring is empty                                 */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine moves the ring to the UART: a burst of up to a full TX FIFO each time     */
+/*                  the FIFO is empty (THRE). Without wait it returns as soon as the FIFO is busy          */
+/*---------------------------------------------------------------------------------------------------------*/
+static void serial_ring_drain (BOOLEAN wait)
+{
+	UINT32 tail = log_ring_tail;
+	UINT32 n;
+
+	if (gUartLog == UART_MAX_DEV)
+	{
+		return;
+	}
+
+	while (tail != log_ring_head)
+	{
+		if (UART_TestTX(gUartLog))
+		{
+			if (wait == FALSE)
+			{
+				break;
+			}
+			continue;
+		}
+
+		for (n = 0; (n < SERIAL_PRINTF_TX_FIFO_SIZE) && (tail != log_ring_head); n++)
+		{
+			UART_PutC_NB(gUartLog, log_ring[tail & (SERIAL_PRINTF_RING_SIZE - 1)]);
+			tail++;
+		}
+		log_ring_tail = tail;
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        serial_ring_put                                                                        */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  c - char to add to the ring                                                            */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine appends a char to the log ring, in the room taken by serial_ring_reserve  */
+/*---------------------------------------------------------------------------------------------------------*/
+static void serial_ring_put (char c)
+{
+	UINT32 head = log_ring_head;
+
+	log_ring[head & (SERIAL_PRINTF_RING_SIZE - 1)] = c;
+	log_ring_head = head + 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        serial_ring_reserve                                                                    */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  size - chars of the record                                                             */
+/*                                                                                                         */
+/* Returns:         TRUE if the record fits in the ring                                                    */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine does not wait for the UART: a record that does not fit is dropped and     */
+/*                  counted. The next record that fits is preceded by a lost records mark.                 */
+/*                  Between serial_printf_sync(TRUE) and serial_printf_sync(FALSE) it waits for room       */
+/*---------------------------------------------------------------------------------------------------------*/
+static BOOLEAN serial_ring_reserve (UINT32 size)
+{
+	UINT32 i;
+
+	serial_ring_drain(FALSE);
+
+	if (log_ring_lost)
+	{
+		size += sizeof(log_ring_lost_msg) - 1;
+	}
+
+	if ((log_ring_sync != 0) && ((SERIAL_PRINTF_RING_SIZE - (log_ring_head - log_ring_tail)) < size))
+	{
+		serial_ring_drain(TRUE);
+	}
+
+	if ((SERIAL_PRINTF_RING_SIZE - (log_ring_head - log_ring_tail)) < size)
+	{
+		serial_printf_ring_lost++;
+		log_ring_lost = TRUE;
+		return FALSE;
+	}
+
+	if (log_ring_lost)
+	{
+		for (i = 0; i < (sizeof(log_ring_lost_msg) - 1); i++)
+		{
+			serial_ring_put(log_ring_lost_msg[i]);
+		}
+		log_ring_lost = FALSE;
+	}
+
+	return TRUE;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        serial_printf_poll                                                                     */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine sends the next log chars if the UART TX FIFO is empty. Non blocking,      */
+/*                  called from serial_printf and from busy waits (CLK_Delay_MicroSec)                     */
+/*---------------------------------------------------------------------------------------------------------*/
+void serial_printf_poll (void)
+{
+	serial_ring_drain(FALSE);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        serial_printf_flush                                                                    */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine sends all the log and waits until the UART transmitter is empty.          */
+/*                  Call before the UART clock changes, before reset and before the jump to BL31           */
+/*---------------------------------------------------------------------------------------------------------*/
+void serial_printf_flush (void)
+{
+	if (gUartLog == UART_MAX_DEV)
+	{
+		return;
+	}
+
+	serial_ring_drain(TRUE);
+
+	while (READ_REG_FIELD(LSR(gUartLog), LSR_TE) == 0);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        serial_printf_sync                                                                     */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  sync - TRUE: the prints wait for room in the ring, FALSE: back to dropping             */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine is for prints that must not be lost (register dumps). Calls nest          */
+/*---------------------------------------------------------------------------------------------------------*/
+void serial_printf_sync (BOOLEAN sync)
+{
+	if (sync)
+	{
+		log_ring_sync++;
+	}
+	else if (log_ring_sync != 0)
+	{
+		log_ring_sync--;
+	}
+}
+#endif // SERIAL_PRINTF_RING
 
 /*---------------------------------------------------------------------------------------------------------*/
 /* Function:        serial_puts                                                                            */
@@ -64,29 +305,94 @@ static char buf[SERIAL_PRINTF_BUFFER_SIZE] = {0};
 /* Side effects:                                                                                           */
 /* Description:                                                                                            */
 /*                  This routine writes complete string to UART                                            */
+/*                  (to the log ring with BOOTBLOCK_LOG_RING)                                              */
 /*---------------------------------------------------------------------------------------------------------*/
+#ifdef SERIAL_PRINTF_RING
+#define SERIAL_PUTC(c)  serial_ring_put(c)
+#else
+#define SERIAL_PUTC(c)  UART_PutC(gUartLog, (c))
+#endif
+
 static void serial_puts (const char *s)
 {
 	int max_len = SERIAL_PRINTF_BUFFER_SIZE - 1;
+
+#ifdef SERIAL_PRINTF_RING
+	const char *p;
+	UINT32      size = 0;
+
+	for (p = s; (*p != 0) && (p < (s + max_len)); p++)
+	{
+		size += (*p == '\n') ? 2 : 1;
+	}
+
+	if (serial_ring_reserve(size) == FALSE)
+	{
+		return;
+	}
+#endif
+
 	while (*s)
 	{
 		if (*s == '\n')
 		{
-			UART_PutC(gUartLog, '\r');
+			SERIAL_PUTC('\r');
 		}
 
 		// Puting the char to serial
-		UART_PutC(gUartLog, *s );
+		SERIAL_PUTC(*s);
 
 		s++;
 		max_len--;
 		if (max_len == 0)
 		{
-			return;
+			break;
 		}
 	}
+
+#ifdef SERIAL_PRINTF_RING
+	serial_ring_drain(FALSE);
+#endif
 }
 
+#ifdef BOOTBLOCK_LOG_BINARY
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        serial_write                                                                           */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  data - bytes to send                                                                   */
+/*                  size - number of bytes                                                                 */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine writes binary data to UART, without '\n' translation                      */
+/*---------------------------------------------------------------------------------------------------------*/
+static void serial_write (const UINT8 *data, UINT32 size)
+{
+	if (gUartLog == UART_MAX_DEV)
+	{
+		return;
+	}
+
+#ifdef SERIAL_PRINTF_RING
+	if (serial_ring_reserve(size) == FALSE)
+	{
+		return;
+	}
+#endif
+
+	while (size--)
+	{
+		SERIAL_PUTC(*data++);
+	}
+
+#ifdef SERIAL_PRINTF_RING
+	serial_ring_drain(FALSE);
+#endif
+}
+#endif // BOOTBLOCK_LOG_BINARY
+
 /*---------------------------------------------------------------------------------------------------------*/
 /* Function:        serial_strnlen                                                                         */
 /*                                                                                                         */
@@ -522,6 +828,7 @@ int str_printf (char *buf, const char *fmt, ...)
 
 void serial_printf_stop ()
 {
+	serial_printf_flush();
 	gUartLog = UART_MAX_DEV;
 }
 
@@ -569,6 +876,226 @@ int serial_printf(const char *fmt, ...)
 }
 #endif
 
+#ifdef BOOTBLOCK_LOG_BINARY
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        log_bin_leb128                                                                         */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  p -   output pointer                                                                   */
+/*                  val - value to encode                                                                  */
+/*                                                                                                         */
+/* Returns:         output pointer after the value                                                         */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Unsigned LEB128: 7 bits per byte, bit 7 set on all the bytes but the last              */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT8 * log_bin_leb128 (UINT8 *p, UINT64 val)
+{
+	while (val >= 0x80)
+	{
+		*p++ = (UINT8)(val | 0x80);
+		val >>= 7;
+	}
+	*p++ = (UINT8)val;
+
+	return p;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        log_bin_emit                                                                           */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  data - record or text                                                                  */
+/*                  size - number of bytes                                                                 */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Keeps a copy in serial_log_bin_buf (until full) and sends it to UART                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static void log_bin_emit (const UINT8 *data, UINT32 size)
+{
+	if ((serial_log_bin_size + size) <= SERIAL_LOG_BIN_BUF_SIZE)
+	{
+		memcpy(&serial_log_bin_buf[serial_log_bin_size], data, size);
+		serial_log_bin_size += size;
+	}
+	else
+	{
+		serial_log_bin_lost++;
+	}
+
+#if (SERIAL_LOG_BIN_UART == 1)
+	serial_write(data, size);
+#endif
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        serial_log_bin                                                                         */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  fmt - format string (must be in the image: its address is the record ID)               */
+/*                                                                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine logs a record instead of formatting the string:                           */
+/*                      SERIAL_LOG_BIN_MARKER, length of the rest (1 byte),                                */
+/*                      fmt address (4 bytes, little endian),                                              */
+/*                      usec since the previous record (LEB128),                                           */
+/*                      one LEB128 per argument: zigzag for %d / %i, address for %s                        */
+/*                  tools/log_decode.py gets the format strings (and %s strings) from the ELF file and     */
+/*                  prints the text. Text around the records (serial_printf) is passed as is.              */
+/*                  Short formats without arguments (progress dots) and formats with too many arguments    */
+/*                  are sent as text.                                                                      */
+/*---------------------------------------------------------------------------------------------------------*/
+void serial_log_bin (const char *fmt, ...)
+{
+	UINT8       rec[SERIAL_LOG_BIN_REC_MAX];
+	UINT8      *p = &rec[2];
+	const char *f;
+	UINT32      ts[2];
+	UINT32      now;
+	UINT32      nargs = 0;
+	int         qualifier;
+	long        num;
+	va_list     args;
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Header                                                                                              */
+	/*-----------------------------------------------------------------------------------------------------*/
+	CLK_GetTimeStamp(ts);
+	now = (ts[1] * 1000000) + (ts[0] / EXT_CLOCK_FREQUENCY_MHZ);
+
+	*p++ = (UINT8)((uintptr_t)fmt);
+	*p++ = (UINT8)((uintptr_t)fmt >> 8);
+	*p++ = (UINT8)((uintptr_t)fmt >> 16);
+	*p++ = (UINT8)((uintptr_t)fmt >> 24);
+	p = log_bin_leb128(p, now - log_bin_time);
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Arguments: same conversions and qualifiers as serial_vsprintf, without formatting                  */
+	/*-----------------------------------------------------------------------------------------------------*/
+	va_start(args, fmt);
+	for (f = fmt; *f; ++f)
+	{
+		if (*f != '%')
+		{
+			continue;
+		}
+
+		++f;
+		while ((*f == '-') || (*f == '+') || (*f == ' ') || (*f == '#') || (*f == '0'))
+			++f;
+
+		if (*f == '*')
+		{
+			++f;
+			p = log_bin_leb128(p, (UINT32)va_arg(args, int));
+			nargs++;
+		}
+		while (is_digit(*f))
+			++f;
+
+		if (*f == '.')
+		{
+			++f;
+			if (*f == '*')
+			{
+				++f;
+				p = log_bin_leb128(p, (UINT32)va_arg(args, int));
+				nargs++;
+			}
+			while (is_digit(*f))
+				++f;
+		}
+
+		qualifier = -1;
+		if ((*f == 'h') || (*f == 'l') || (*f == 'L') || (*f == 'Z') || (*f == 'z') || (*f == 't') || (*f == 'q'))
+		{
+			qualifier = *f;
+			if ((qualifier == 'l') && (*(f + 1) == 'l'))
+			{
+				qualifier = 'q';
+				++f;
+			}
+			++f;
+		}
+
+		switch (*f)
+		{
+		case '\0':
+			--f;
+			continue;
+
+		case 'c':
+			num = (unsigned char)va_arg(args, int);
+			break;
+
+		case 's':
+		case 'p':
+			num = (long)(uintptr_t)va_arg(args, void *);
+			break;
+
+		case 'n':
+			(void)va_arg(args, void *);
+			continue;
+
+		case 'd':
+		case 'i':
+			if (qualifier == 'l')
+				num = (long)va_arg(args, unsigned long);
+			else if (qualifier == 'h')
+				num = (short)va_arg(args, int);
+			else
+				num = va_arg(args, int);
+			num = (long)(((unsigned long)num << 1) ^ (unsigned long)(num >> 63));
+			break;
+
+		case 'o':
+		case 'x':
+		case 'X':
+		case 'u':
+			if (qualifier == 'l')
+				num = va_arg(args, unsigned long);
+			else if (qualifier == 'h')
+				num = (unsigned short)va_arg(args, int);
+			else
+				num = va_arg(args, unsigned int);
+			break;
+
+		default:
+			continue;
+		}
+
+		if (++nargs > SERIAL_LOG_BIN_ARGS_MAX)
+		{
+			break;
+		}
+		p = log_bin_leb128(p, (unsigned long)num);
+	}
+	va_end(args);
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Text fallback                                                                                       */
+	/*-----------------------------------------------------------------------------------------------------*/
+	if ((nargs > SERIAL_LOG_BIN_ARGS_MAX) || ((nargs == 0) && ((f - fmt) <= SERIAL_LOG_BIN_TEXT_MAX)))
+	{
+		va_start(args, fmt);
+		num = serial_vsprintf((char *)buf, fmt, args);
+		va_end(args);
+		log_bin_emit((const UINT8 *)buf, (UINT32)num);
+		return;
+	}
+
+	rec[0] = SERIAL_LOG_BIN_MARKER;
+	rec[1] = (UINT8)(p - &rec[2]);
+	log_bin_time = now;
+
+	log_bin_emit(rec, (UINT32)(p - rec));
+}
+#endif // BOOTBLOCK_LOG_BINARY
+
 void serial_printf_init (void)
 {
 	/* If STRAP5 is active (low), set MFSEL4 bit BSPASEL (Select BMC debug Serial Port (BSP) on Serial Interface 2), using UART0.
@@ -59,6 +59,28 @@ int             serial_printf(const char *fmt, ...);
 
 #endif // DEBUG_LOG
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Log ring: serial_printf does not wait for the UART. poll sends what the TX FIFO takes, flush sends all, */
+/* sync makes the prints wait for room instead of being dropped                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+#if defined(BOOTBLOCK_LOG_RING) && (defined(DEBUG_LOG) || defined(DEV_LOG))
+void            serial_printf_poll (void);
+void            serial_printf_flush (void);
+void            serial_printf_sync (BOOLEAN sync);
+#else
+#define         serial_printf_poll()                   (void)0
+#define         serial_printf_flush()                  (void)0
+#define         serial_printf_sync(sync)               (void)0
+#endif
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Binary log: records instead of text, decoded on the host with tools/log_decode.py                       */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifdef BOOTBLOCK_LOG_BINARY
+#define         SERIAL_LOG_BIN_MARKER                  0xB1
+void            serial_log_bin (const char *fmt, ...);
+#endif
+
 void serial_printf_init (void);
 
 void serial_printf_stop ();
@@ -167,8 +167,10 @@ typedef union BOOTBLOCK_HEADER_tag
 		UINT32  NoECC_Region_7_Start;          // 0x190       4
 		UINT32  NoECC_Region_7_End;            // 0x194       4
 		UINT32  pll0_override;                 // 0x198       4
+		UINT32  img_dir_offset;                // 0x19C       4           NO_TIP: flash offset of the image directory (0/0xFFFFFFFF: none)
 		
-		UINT8   reservedSigned3[0x5C];         // 0x202       0x5C        Reserved for future use, signed.
+		UINT32  ddr_cache_offset;              // 0x1A0       4           flash offset of the 4KB DDR training cache sector (0/0xFFFFFFFF: none)
+		UINT8   reservedSigned3[0x54];         // 0x1A4       0x54        Reserved for future use, signed.
 
  		UINT32  destAddr;                      // 0x1F8
  		UINT32  codeSize;                      // 0x1FC
@@ -248,6 +250,10 @@ HOST_IF_T       BOOTBLOCK_Get_host_if (void);
 UINT8           BOOTBLOCK_Get_SPI_clk_divider (UINT spi);
 UINT8           BOOTBLOCK_Get_i3c_RC_clk_divider (void);
 UINT32          BOOTBLOCK_Get_pll0_override (void);
+UINT32          BOOTBLOCK_Get_img_dir_offset (void);
+UINT32          BOOTBLOCK_Get_signed_end (void);
+UINT32          BOOTBLOCK_Get_ddr_cache_offset (void);
+UINT32          BOOTBLOCK_Get_DDR_Setup_CRC (void);
 UART_BAUDRATE_T BOOTBLOCK_GetUartBaud (void);
 UINT32          BOOTBLOCK_Get_FIU_DRD_CFG (UINT32 fiu);
 
@@ -0,0 +1,203 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   boot_trace.c                                                             */
+/*            This file contains the boot phases timing table                 */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+#ifdef BOOTBLOCK_BOOT_TRACE
+#include <stdint.h>
+#include <string.h>
+#include "hal.h"
+#include "../SWC_HAL/hal_regs.h"
+#include "boot_trace.h"
+#include "mailbox.h"
+#include "apps/serial_printf/serial_printf.h"
+
+#ifndef BOOT_TRACE_TABLE_ADDR
+#define BOOT_TRACE_TABLE_ADDR   ((ROM_STATUS_MSG_ADDR - sizeof(BOOT_TRACE_TABLE_T)) & ~0xFUL)
+#endif
+
+static BOOT_TRACE_TABLE_T * const boot_trace = (BOOT_TRACE_TABLE_T *)BOOT_TRACE_TABLE_ADDR;
+
+static const char * const boot_trace_names[BOOT_TRACE_NUM_OF_IDS] =
+{
+	"clocks",
+	"fiu cfg",
+	"ddr",
+	"phy cfg1",
+	"mc init",
+	"mr write",
+	"phy cfg2",
+	"sweep",
+	"size detect",
+	"mem test",
+	"dram init",
+	"host release",
+	"tip wait",
+	"image scan",
+	"image copy",
+};
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        boot_trace_clock                                                                       */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         usec from VSB power up, 64 bits                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 boot_trace_clock (void)
+{
+	UINT32 ts[2];
+
+	CLK_GetTimeStamp(ts);
+
+	return ((UINT64)ts[1] * 1000000) + (ts[0] / EXT_CLOCK_FREQUENCY_MHZ);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        boot_trace_now                                                                         */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         usec from BOOT_TRACE_Init, 1 or more                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 boot_trace_now (void)
+{
+	return (UINT32)(boot_trace_clock() - boot_trace->base);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        BOOT_TRACE_Init                                                                        */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Clear the table in the PCI mailbox and take the time base. Time 0 is 1 usec before     */
+/*                  now, so no entry ends at 0                                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+void BOOT_TRACE_Init (void)
+{
+	memset(boot_trace, 0, sizeof(BOOT_TRACE_TABLE_T));
+	boot_trace->base = boot_trace_clock() - 1;
+	boot_trace->version = BOOT_TRACE_VERSION;
+	boot_trace->magic = BOOT_TRACE_MAGIC;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        BOOT_TRACE_Begin                                                                       */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  id  - boot phase                                                                       */
+/*                  arg - instance of the phase (sweep type, image type)                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Add a phase to the table                                                               */
+/*---------------------------------------------------------------------------------------------------------*/
+void BOOT_TRACE_Begin (BOOT_TRACE_ID_T id, UINT32 arg)
+{
+	BOOT_TRACE_ENTRY_T *entry;
+
+	if (boot_trace->magic != BOOT_TRACE_MAGIC)
+	{
+		return;
+	}
+
+	if (boot_trace->count >= BOOT_TRACE_MAX_ENTRIES)
+	{
+		boot_trace->lost++;
+		return;
+	}
+
+	entry = &boot_trace->entry[boot_trace->count];
+	entry->id = (UINT16)id;
+	entry->arg = (UINT16)arg;
+	entry->end = 0;
+	entry->start = boot_trace_now();
+	boot_trace->count++;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        BOOT_TRACE_End                                                                         */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  id  - boot phase                                                                       */
+/*                  arg - instance of the phase, as in BOOT_TRACE_Begin                                    */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  End the last open entry of the phase                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+void BOOT_TRACE_End (BOOT_TRACE_ID_T id, UINT32 arg)
+{
+	UINT32 now;
+	UINT32 i;
+
+	if (boot_trace->magic != BOOT_TRACE_MAGIC)
+	{
+		return;
+	}
+
+	now = boot_trace_now();
+
+	for (i = boot_trace->count; i > 0; i--)
+	{
+		BOOT_TRACE_ENTRY_T *entry = &boot_trace->entry[i - 1];
+
+		if ((entry->id == (UINT16)id) && (entry->arg == (UINT16)arg) && (entry->end == 0))
+		{
+			entry->end = now;
+			return;
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        BOOT_TRACE_Print                                                                       */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:    the table is marked complete (total)                                                   */
+/* Description:                                                                                            */
+/*                  Print the phases, nested phases are indented                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+void BOOT_TRACE_Print (void)
+{
+	UINT32 i, j, depth;
+
+	if (boot_trace->magic != BOOT_TRACE_MAGIC)
+	{
+		return;
+	}
+
+	boot_trace->total = boot_trace_now();
+
+	serial_printf(KCYN "\nboot trace at %#010lx: %d phases, %d lost, from %lu us after power up\n" KNRM,
+		      (UINT32)(uintptr_t)boot_trace, boot_trace->count, boot_trace->lost, boot_trace->base);
+
+	for (i = 0; i < boot_trace->count; i++)
+	{
+		const BOOT_TRACE_ENTRY_T *entry = &boot_trace->entry[i];
+
+		depth = 0;
+		for (j = 0; j < i; j++)
+		{
+			if ((boot_trace->entry[j].end == 0) || (boot_trace->entry[j].end >= entry->start))
+				depth++;
+		}
+
+		serial_printf("%*s%-14s %3d  at %8d us  %8d us\n", (int)(depth * 2), "",
+			      (entry->id < BOOT_TRACE_NUM_OF_IDS) ? boot_trace_names[entry->id] : "?",
+			      entry->arg, entry->start, (entry->end != 0) ? (entry->end - entry->start) : 0);
+	}
+
+	serial_printf(KCYN "boot time %d us\n" KNRM, boot_trace->total);
+}
+
+#endif // BOOTBLOCK_BOOT_TRACE
@@ -0,0 +1,89 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   boot_trace.h                                                             */
+/*            This file contains API of the boot phases timing table          */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+
+#ifndef _BOOT_TRACE_H_
+#define _BOOT_TRACE_H_
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Boot phases. Keep boot_trace_names (boot_trace.c) in the same order                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef enum
+{
+	BOOT_TRACE_CLOCKS = 0,          /* bootblock_ChangeClocks                                              */
+	BOOT_TRACE_FIU_CFG,             /* bootblock_set_fiu_cfg_drd                                           */
+	BOOT_TRACE_DDR,                 /* MC_ConfigureDDR                                                     */
+	BOOT_TRACE_DDR_PHY_CFG1,        /* ddr_phy_cfg1                                                        */
+	BOOT_TRACE_DDR_MC_INIT,         /* MC_Init_l                                                           */
+	BOOT_TRACE_DDR_MR,              /* mode registers write and ZQ                                         */
+	BOOT_TRACE_DDR_PHY_CFG2,        /* ddr_phy_cfg2 (leveling, VREF)                                       */
+	BOOT_TRACE_DDR_SWEEP,           /* one sweep, arg: SweepType                                           */
+	BOOT_TRACE_DDR_SIZE,            /* MC_CheckDramSize                                                    */
+	BOOT_TRACE_DDR_MEM_TEST,        /* MC_mem_test_long, arg: test number                                  */
+	BOOT_TRACE_DDR_BIST_INIT,       /* DRAM init (MC_BIST_Init_DRAM_mem or ECC init)                       */
+	BOOT_TRACE_HOST_RELEASE,        /* eSPI / LPC host interface release                                   */
+	BOOT_TRACE_TIP_WAIT,            /* wait for TIP to copy the images                                     */
+	BOOT_TRACE_IMAGE_SCAN,          /* look for an image in flash, arg: IMG_TYPE_E                         */
+	BOOT_TRACE_IMAGE_COPY,          /* copy (and check) an image, arg: IMG_TYPE_E, 0 for multi-core copy   */
+	BOOT_TRACE_NUM_OF_IDS
+} BOOT_TRACE_ID_T;
+
+#ifdef BOOTBLOCK_BOOT_TRACE
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Table in the PCI mailbox SRAM, below the TIP ROM status message. BL31, U-Boot and the PCIe host read    */
+/* it after the boot. Times are usec from BOOT_TRACE_Init, from 1 (0 marks an open phase). base is the     */
+/* time of BOOT_TRACE_Init in usec from VSB power up (CLK_GetTimeStamp): the seconds counter is not reset  */
+/* by a warm reset, so a 32 bits time from power up would wrap after 71 minutes                            */
+/*---------------------------------------------------------------------------------------------------------*/
+#define BOOT_TRACE_MAGIC                0x43525442      /* "BTRC" */
+#define BOOT_TRACE_VERSION              2
+#define BOOT_TRACE_MAX_ENTRIES          64
+
+typedef struct BOOT_TRACE_ENTRY_tag
+{
+	UINT16  id;                     /* BOOT_TRACE_ID_T                                                 */
+	UINT16  arg;
+	UINT32  start;
+	UINT32  end;                    /* 0 until the phase ends                                          */
+} BOOT_TRACE_ENTRY_T;
+
+typedef struct BOOT_TRACE_TABLE_tag
+{
+	UINT32              magic;
+	UINT16              version;
+	UINT16              count;      /* used entries                                                    */
+	UINT32              lost;       /* phases not recorded, table full                                 */
+	UINT32              total;      /* end of the bootblock, before BL31 starts, 0 until then          */
+	UINT64              base;       /* usec from VSB power up of time 0                                */
+	BOOT_TRACE_ENTRY_T  entry[BOOT_TRACE_MAX_ENTRIES];
+} BOOT_TRACE_TABLE_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Boot trace exported functions                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+void BOOT_TRACE_Init (void);
+void BOOT_TRACE_Begin (BOOT_TRACE_ID_T id, UINT32 arg);
+void BOOT_TRACE_End (BOOT_TRACE_ID_T id, UINT32 arg);
+void BOOT_TRACE_Print (void);
+
+#else
+
+#define BOOT_TRACE_Init()               (void)0
+#define BOOT_TRACE_Begin(id, arg)       (void)0
+#define BOOT_TRACE_End(id, arg)         (void)0
+#define BOOT_TRACE_Print()              (void)0
+
+#endif // BOOTBLOCK_BOOT_TRACE
+
+#endif /* _BOOT_TRACE_H_ */
@@ -362,5 +362,82 @@ UINT32   BOOTBLOCK_Get_pll0_override (void)
 	return val_header;
 }
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        BOOTBLOCK_Get_img_dir_offset                                                           */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                                                                                                         */
+/* Returns:        flash offset of the image directory. 0 if there is no directory (scan the flash)       */
+/*---------------------------------------------------------------------------------------------------------*/
+UINT32   BOOTBLOCK_Get_img_dir_offset (void)
+{
+	UINT32 val_header = 0;
+
+	BOOTBLOCK_HEADER_T *bootBlockHeader = (BOOTBLOCK_HEADER_T*)BOOTBLOCK_HEADER_ADDR;
+
+	val_header = bootBlockHeader->header.img_dir_offset;
+
+	if (val_header == 0xFFFFFFFF)
+	{
+		val_header = 0;
+	}
+
+	return val_header;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        BOOTBLOCK_Get_signed_end                                                               */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                                                                                                         */
+/* Returns:        offset from the header of the end of the signed area (header and code)                  */
+/*---------------------------------------------------------------------------------------------------------*/
+UINT32   BOOTBLOCK_Get_signed_end (void)
+{
+	BOOTBLOCK_HEADER_T *bootBlockHeader = (BOOTBLOCK_HEADER_T*)BOOTBLOCK_HEADER_ADDR;
+
+	return sizeof(BOOTBLOCK_HEADER_T) + bootBlockHeader->header.codeSize;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        BOOTBLOCK_Get_ddr_cache_offset                                                         */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                                                                                                         */
+/* Returns:        flash offset of the DDR training cache sector. 0 if there is none (always train)        */
+/*---------------------------------------------------------------------------------------------------------*/
+UINT32   BOOTBLOCK_Get_ddr_cache_offset (void)
+{
+	UINT32 val_header = 0;
+
+	BOOTBLOCK_HEADER_T *bootBlockHeader = (BOOTBLOCK_HEADER_T*)BOOTBLOCK_HEADER_ADDR;
+
+	val_header = bootBlockHeader->header.ddr_cache_offset;
+
+	if (val_header == 0xFFFFFFFF)
+	{
+		val_header = 0;
+	}
+
+	return val_header;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        BOOTBLOCK_Get_DDR_Setup_CRC                                                            */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                                                                                                         */
+/* Returns:        CRC32 of the DDR parameters in the header (mc_freq to mc_sweep_main_flow)               */
+/*---------------------------------------------------------------------------------------------------------*/
+UINT32   BOOTBLOCK_Get_DDR_Setup_CRC (void)
+{
+	extern unsigned int Crc32Update (unsigned int crc, const void *buf, unsigned long size);
+
+	BOOTBLOCK_HEADER_T *bootBlockHeader = (BOOTBLOCK_HEADER_T*)BOOTBLOCK_HEADER_ADDR;
+
+	return ~Crc32Update(0xFFFFFFFF, &bootBlockHeader->header.mc_freq,
+			    (UINT8 *)&bootBlockHeader->header.fiu0_divider - (UINT8 *)&bootBlockHeader->header.mc_freq);
+}
+
 #undef BOOT_C
 
@@ -21,6 +21,7 @@
 #include "../SWC_HAL/hal_regs.h"
 #include "boot.h"
 #include "mailbox.h"
+#include "mmio_prof.h"
 #include "cfg.h"
 #include <string.h>
 #include "apps/serial_printf/serial_printf.h"
@@ -31,6 +32,14 @@
 #include "images.h"
 #endif
 
+#ifdef BOOTBLOCK_CACHED_BOOT
+#include "mmu.h"
+#endif
+
+#if defined(BOOTBLOCK_DDR_TRAINING_CACHE) && defined(_NOTIP_)
+#include "ddr_cache.h"
+#endif
+
 
 extern void asm_jump_to_address (UINT32 address);
 extern void disable_highvecs (void);
@@ -115,6 +124,7 @@ void errHandler (void)
 	uint64_t far[3];
 	int i;
 
+#ifndef BOOTBLOCK_SIM
 	__asm__ __volatile__("mrs %0, elr_el1\n" : "=r"(lr[0])::);
 	__asm__ __volatile__("mrs %0, elr_el2\n" : "=r"(lr[1])::);
 	__asm__ __volatile__("mrs %0, elr_el3\n" : "=r"(lr[2])::);
@@ -164,6 +174,14 @@ void errHandler (void)
 	__asm__ __volatile__("mov %0, x28" : "=r"(regs[28])::);
 	__asm__ __volatile__("mov %0, x29" : "=r"(regs[29])::);
 	__asm__ __volatile__("mov %0, x30" : "=r"(regs[30])::);
+#else
+	memset(regs, 0, sizeof(regs));
+	memset(lr, 0, sizeof(lr));
+	memset(esr, 0, sizeof(esr));
+	memset(far, 0, sizeof(far));
+	memset(scltr, 0, sizeof(scltr));
+	sp = 0;
+#endif
 
 	serial_printf_init();
 	serial_printf(KRED "\n\nA35 Bootblock: trap error handler\n" KBLU);
@@ -204,6 +222,7 @@ void errHandler (void)
 	MC_ClearInterrupts();
 
 	serial_printf(KRED "\n ===============   RESTART BOOTBLOCK AFTER PANIC   ================== \n" KNRM);
+	serial_printf_flush();
 
 	CLK_Delay_Sec(5);
 
@@ -314,6 +333,9 @@ static void bootblock_ChangeClocks (DDR_Setup *ddr_setup)
 
 	straps = TIP_ROM_StrapCKFRQ();
 
+	// UART clock may change: send the log with the current clock
+	serial_printf_flush();
+
 	// in skip init or fast skip init need to start the PLLs first
 	if ((straps == 5) || (straps == 1))
 	{
@@ -436,8 +458,10 @@ static void bootblock_ChangeClocks (DDR_Setup *ddr_setup)
 		cntfrq_val = DIV_ROUND(cpuFreq, 4);
 
 		serial_printf("Set cntfrq_val to %d cpufreq %d\n", cntfrq_val, cpuFreq);
+#ifndef BOOTBLOCK_SIM
 		__asm__ __volatile__("ISB\n");
 		__asm__ __volatile__("msr cntfrq_el0, %0\n" :: "r"(cntfrq_val));
+#endif
 	}
 
 	return;
@@ -586,6 +610,7 @@ static void bootblock_set_fiu_cfg_drd (void)
 static void platform_reset()
 {
 	serial_printf(KRED "\n\n==========    RESET BMC %#010lx ==========\n" KNRM);
+	serial_printf_flush();
 	/* Reset everything.*/
 	REG_WRITE(SWRSTC3, 0xFFFFFFFF);
 	REG_WRITE(SWRSTC3B, 0xFFFFFFFF);
@@ -606,6 +631,13 @@ static void platform_reset()
 #define ADC_CAL_INT_PROPERTY            40,         8,          FUSE_ECC_NIBBLE_PARITY
 #define ADC_CAL_EXT_PROPERTY            48,         8,          FUSE_ECC_NIBBLE_PARITY
 
+static const FUSE_WRPR_RANGE_T bootblock_fuse_ranges[] =
+{
+	{ DIE_INFORMATION_ALL },
+	{ ADC_CAL_INT_PROPERTY },
+	{ ADC_CAL_EXT_PROPERTY },
+};
+
 /*----------------------------------------------------------------------------*/
 /* Function:        bootblock_main                                            */
 /*                                                                            */
@@ -641,6 +673,16 @@ __attribute__((noreturn)) void bootblock_main (void)
 	for (int i = 4; i <= 9; i++)
 		REG_WRITE(SCRPAD_10_41(i), 0);
 
+	BOOT_TRACE_Init();
+
+#ifdef BOOTBLOCK_CACHED_BOOT
+	/*--------------------------------------------------------------------*/
+	/* Flash, ROM and RAM2 are cached from here. DRAM is Device until     */
+	/* trained                                                            */
+	/*--------------------------------------------------------------------*/
+	MMU_Init();
+#endif
+
 	bootblock_PrintLogo();
 #ifdef BOOTBLOCK_STACK_PROFILER
 	stack_profiler ();
@@ -652,6 +694,11 @@ __attribute__((noreturn)) void bootblock_main (void)
 	TMC_StopWatchDog(1);
 	TMC_StopWatchDog(2);
 
+	/*--------------------------------------------------------------------*/
+	/* Read all the OTP values in one pass, decoded below from the shadow */
+	/*--------------------------------------------------------------------*/
+	FUSE_WRPR_Load(bootblock_fuse_ranges, ARRAY_SIZE(bootblock_fuse_ranges));
+
 	/*--------------------------------------------------------------------*/
 	/* Read Die information and send to OPTEE (HUK)                       */
 	/*--------------------------------------------------------------------*/
@@ -736,18 +783,36 @@ __attribute__((noreturn)) void bootblock_main (void)
 		CLK_Delay_MicroSec(3 * 1000 * 1000);
 	}
 
+	BOOT_TRACE_Begin(BOOT_TRACE_CLOCKS, 0);
 	bootblock_ChangeClocks(&ddr_setup);
+	BOOT_TRACE_End(BOOT_TRACE_CLOCKS, 0);
 
 	/*--------------------------------------------------------------------*/
 	/* init FIU_DRD_CFG according to bootblock header                     */
 	/*--------------------------------------------------------------------*/
+	BOOT_TRACE_Begin(BOOT_TRACE_FIU_CFG, 0);
 	bootblock_set_fiu_cfg_drd();
+	BOOT_TRACE_End(BOOT_TRACE_FIU_CFG, 0);
 
 	bootblock_PrintClocks();
 
 	MC_Init_DDR_Setup(&ddr_setup);
 	MC_Init_DDR_Setup_re_calc(&ddr_setup);
+#if defined(BOOTBLOCK_DDR_TRAINING_CACHE) && defined(_NOTIP_)
+	/*--------------------------------------------------------------------*/
+	/* The cache sector is erased and programmed by the A35 through FIU0  */
+	/* UMA: NO_TIP mode only, in TIP mode TIP owns the SPI0 flash         */
+	/*--------------------------------------------------------------------*/
+	DDR_CACHE_Load(&ddr_setup);
+#endif
+	BOOT_TRACE_Begin(BOOT_TRACE_DDR, 0);
 	status = MC_ConfigureDDR(&ddr_setup);
+	BOOT_TRACE_End(BOOT_TRACE_DDR, 0);
+
+#if defined(BOOTBLOCK_DDR_TRAINING_CACHE) && defined(_NOTIP_)
+	/* also on failure, before the FSW reset: a rejected record is erased */
+	DDR_CACHE_Save();
+#endif
 
 	if (status == DEFS_STATUS_SYSTEM_NOT_INITIALIZED)
 	{
@@ -769,6 +834,17 @@ __attribute__((noreturn)) void bootblock_main (void)
 
 	serial_printf(KNRM "A35 Bootblock: configure DDR done \n");
 
+#if defined(BOOTBLOCK_CACHED_BOOT) && defined(_NOTIP_)
+	/*--------------------------------------------------------------------*/
+	/* Images are copied to DRAM by the A35 only in NO_TIP mode. In TIP   */
+	/* mode TIP writes DRAM, so keep it uncached on this side             */
+	/*--------------------------------------------------------------------*/
+	if (status == DEFS_STATUS_OK)
+	{
+		MMU_MapDDR(ddr_setup.ddr_size);
+	}
+#endif
+
 	/*-----------------------------------------------------------------------------------------------------*/
 	/* eSPI HOST INDEPENDENCE Register write 0x0001_111F  ()                                               */
 	/* set:  AUTO_SBLD, AUTO_FCARDY, AUTO_OOBCRDY, AUTO_VWCRDY,AUTO_PCRDY, AUTO_HS[1:3[]                   */
@@ -780,6 +856,7 @@ __attribute__((noreturn)) void bootblock_main (void)
 	/*-----------------------------------------------------------------------------------------------------*/
 	eHostIf = BOOTBLOCK_Get_host_if();
 
+	BOOT_TRACE_Begin(BOOT_TRACE_HOST_RELEASE, eHostIf);
 	if (READ_REG_FIELD(INTCR2, INTCR2_HOST_INIT) == 0)
 	{
 		if (eHostIf == HOST_IF_ESPI)
@@ -846,6 +923,7 @@ __attribute__((noreturn)) void bootblock_main (void)
 
 		SET_REG_FIELD(INTCR2, INTCR2_HOST_INIT, 1);
 	}
+	BOOT_TRACE_End(BOOT_TRACE_HOST_RELEASE, eHostIf);
 
 
 
@@ -865,7 +943,10 @@ __attribute__((noreturn)) void bootblock_main (void)
 	}
 
 	// wait for TIP to copy UBOOT:
-	while(REG_READ(CP2BST2) == 0);
+	BOOT_TRACE_Begin(BOOT_TRACE_TIP_WAIT, 0);
+	while(REG_READ(CP2BST2) == 0)
+		serial_printf_poll();
+	BOOT_TRACE_End(BOOT_TRACE_TIP_WAIT, 0);
 
 	REG_WRITE(CP2BST2, 0xFFFFFFFF);
 
@@ -880,7 +961,28 @@ __attribute__((noreturn)) void bootblock_main (void)
 		platform_reset();
 	}
 	serial_printf(KGRN "=============\nA35 BOOTBLOCK succeeded to load images \n===============\n\n" KNRM);
+#endif
+
+#ifdef BOOTBLOCK_STACK_PROFILER
+	stack_profiler ();
+#endif
+
+	// no OTP content is left in RAM for the next stages, cores 1-3 included
+	FUSE_WRPR_Scrub();
+
+	// the last prints and the boot trace end: cores 1-3 run BL31 from the wake below
+	BOOT_TRACE_Print();
+	MMIO_PROF_Report(MMIO_PROF_TOP);
+
+	// the log ring is not sent after the jump
+	serial_printf_flush();
+
+#ifdef BOOTBLOCK_CACHED_BOOT
+	/* other cores and BL31 run with MMU off: clean the images to DRAM first */
+	MMU_Disable();
+#endif
 
+#ifdef _NOTIP_
 	/* wake core 1: */
 	CLK_Delay_MicroSec(5);
 	REG_WRITE(SCRPAD_10_41(5), 0);
@@ -903,10 +1005,6 @@ __attribute__((noreturn)) void bootblock_main (void)
 
 #endif
 
-#ifdef BOOTBLOCK_STACK_PROFILER
-	stack_profiler ();
-#endif
-
 	// Go to BL31
 	((jumpFunction)(uint64_t)addr64)();
 
@@ -0,0 +1,285 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   core_job.c                                                               */
+/*            This file contains the dispatch of jobs to cores 1-3            */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "hal.h"
+#include "../SWC_HAL/hal_regs.h"
+#include "core_job.h"
+
+#define CORE_JOB_ADDR(cpu)              SCRPAD_10_41(((cpu) * 2) + 2)
+#define CORE_JOB_ARG(cpu)               SCRPAD_10_41(((cpu) * 2) + 3)
+#define CORE_JOB_TAKE_BACK_US           10
+#define CORE_JOB_PARK_US                1000
+
+extern unsigned int GetCPUID (void);
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        CORE_JOB_Barrier                                                                       */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Orders the job data in RAM before the SCRPAD write that publishes it                   */
+/*---------------------------------------------------------------------------------------------------------*/
+void CORE_JOB_Barrier (void)
+{
+#ifdef BOOTBLOCK_SIM
+	__sync_synchronize();
+#else
+	__asm__ __volatile__ ("dsb sy" : : : "memory");
+#endif
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        CORE_JOB_Dispatch                                                                      */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  cpu    -  core 1-3, waiting in el3_secondary                                           */
+/*                  worker -  job, called from the wait loop of the core                                   */
+/*                  arg    -  job argument, CORE_JOB_ARG_MASK bits                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  The argument is written first: the core runs the worker as soon as it sees the address */
+/*---------------------------------------------------------------------------------------------------------*/
+void CORE_JOB_Dispatch (UINT32 cpu, CORE_JOB_WORKER_T worker, UINT32 arg)
+{
+	REG_WRITE(CORE_JOB_ARG(cpu), arg & CORE_JOB_ARG_MASK);
+	CORE_JOB_Barrier();
+	REG_WRITE(CORE_JOB_ADDR(cpu), (UINT32)(uintptr_t)worker);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        CORE_JOB_Ack                                                                           */
+/*                                                                                                         */
+/* Parameters:      cpu -  this core                                                                       */
+/* Returns:         job argument                                                                           */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Called by the worker first: from here the job cannot be taken back                     */
+/*---------------------------------------------------------------------------------------------------------*/
+UINT32 CORE_JOB_Ack (UINT32 cpu)
+{
+	UINT32 arg = REG_READ(CORE_JOB_ARG(cpu)) & CORE_JOB_ARG_MASK;
+
+	REG_WRITE(CORE_JOB_ARG(cpu), arg | CORE_JOB_ACK);
+
+	return arg;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        CORE_JOB_Done                                                                          */
+/*                                                                                                         */
+/* Parameters:      cpu -  this core                                                                       */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Called by the worker last. The address is cleared before the job is marked done, so    */
+/*                  that the primary never writes the next address before it is cleared                    */
+/*---------------------------------------------------------------------------------------------------------*/
+void CORE_JOB_Done (UINT32 cpu)
+{
+	CORE_JOB_Barrier();
+	REG_WRITE(CORE_JOB_ADDR(cpu), 0);
+	CORE_JOB_Barrier();
+	REG_WRITE(CORE_JOB_ARG(cpu), REG_READ(CORE_JOB_ARG(cpu)) | CORE_JOB_DONE);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        CORE_JOB_IsTaken                                                                       */
+/*                                                                                                         */
+/* Parameters:      cpu -  core 1-3                                                                        */
+/* Returns:         TRUE if the core acknowledged its job                                                  */
+/*---------------------------------------------------------------------------------------------------------*/
+BOOLEAN CORE_JOB_IsTaken (UINT32 cpu)
+{
+	return (REG_READ(CORE_JOB_ARG(cpu)) & CORE_JOB_ACK) != 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        CORE_JOB_IsDone                                                                        */
+/*                                                                                                         */
+/* Parameters:      cpu -  core 1-3                                                                        */
+/* Returns:         TRUE if the core finished its job and is back in its wait loop                         */
+/*---------------------------------------------------------------------------------------------------------*/
+BOOLEAN CORE_JOB_IsDone (UINT32 cpu)
+{
+	return (REG_READ(CORE_JOB_ARG(cpu)) & CORE_JOB_DONE) != 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        CORE_JOB_TakeBack                                                                      */
+/*                                                                                                         */
+/* Parameters:      cpu -  core 1-3                                                                        */
+/* Returns:         TRUE if the job was taken back, FALSE if the core took it meanwhile                    */
+/* Side effects:    the address is cleared, the core does not get the job (or returns to its wait loop)    */
+/* Description:                                                                                            */
+/*                  A core that reads the address just before it is cleared acknowledges in a few cycles   */
+/*---------------------------------------------------------------------------------------------------------*/
+BOOLEAN CORE_JOB_TakeBack (UINT32 cpu)
+{
+	REG_WRITE(CORE_JOB_ADDR(cpu), 0);
+	CORE_JOB_Barrier();
+	CLK_Delay_MicroSec(CORE_JOB_TAKE_BACK_US);
+
+	return !CORE_JOB_IsTaken(cpu);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        CORE_JOB_Wait                                                                          */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  cpu        -  core 1-3, its job was dispatched                                         */
+/*                  ack_us     -  time for the core to take the job                                        */
+/*                  timeout_us -  time for the core to finish the job, from the acknowledge                */
+/*                                                                                                         */
+/* Returns:         DEFS_STATUS_OK               - the core did the job                                    */
+/*                  DEFS_STATUS_NO_CONNECTION    - the job was taken back, the caller runs it              */
+/*                  DEFS_STATUS_RESPONSE_TIMEOUT - the core took the job and did not finish it: the job    */
+/*                                                 result is not known and the core may still write it     */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  The core is not to be used again after an error                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+DEFS_STATUS CORE_JOB_Wait (UINT32 cpu, UINT32 ack_us, UINT32 timeout_us)
+{
+	UINT32 us;
+
+	for (us = 0; !CORE_JOB_IsTaken(cpu); us++)
+	{
+		if ((us >= ack_us) && CORE_JOB_TakeBack(cpu))
+		{
+			return DEFS_STATUS_NO_CONNECTION;
+		}
+		CLK_Delay_MicroSec(1);
+	}
+
+	for (us = 0; !CORE_JOB_IsDone(cpu); us++)
+	{
+		if (us >= timeout_us)
+		{
+			REG_WRITE(CORE_JOB_ADDR(cpu), 0);
+			return DEFS_STATUS_RESPONSE_TIMEOUT;
+		}
+		CLK_Delay_MicroSec(1);
+	}
+
+	CORE_JOB_Barrier();
+
+	return DEFS_STATUS_OK;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        core_job_park_worker                                                                   */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Runs on cores 1-3 from RAM2. CORE_JOB_PARKED is set from RAM2, after the last code     */
+/*                  fetch from flash, and the core spins in RAM2 until CORE_JOB_Release clears it          */
+/*---------------------------------------------------------------------------------------------------------*/
+static BOOTBLOCK_RAMFUNC void core_job_park_worker (void)
+{
+	UINT32 cpu = GetCPUID();
+
+	CORE_JOB_Ack(cpu);
+
+	IOW32(REG_ADDR(CORE_JOB_ARG(cpu)), CORE_JOB_ACK | CORE_JOB_PARKED);
+	while (IOR32(REG_ADDR(CORE_JOB_ARG(cpu))) & CORE_JOB_PARKED)
+	{
+	}
+
+	CORE_JOB_Done(cpu);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        CORE_JOB_Park                                                                          */
+/*                                                                                                         */
+/* Parameters:      parked -  cores parked, bitwise, for CORE_JOB_Release                                  */
+/* Returns:         DEFS_STATUS_OK if no core runs from flash                                              */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Moves cores 1-3 out of their el3_secondary wait loop, that runs in place from flash    */
+/*                  in NO_TIP mode. A core that does not take the job is taken back: it is not in its wait */
+/*                  loop. On error the caller releases the parked cores and does not write the flash       */
+/*---------------------------------------------------------------------------------------------------------*/
+DEFS_STATUS CORE_JOB_Park (UINT32 *parked)
+{
+	UINT32 cpu;
+	UINT32 us;
+
+	*parked = 0;
+
+	for (cpu = 1; cpu < CORE_JOB_CORES; cpu++)
+	{
+		CORE_JOB_Dispatch(cpu, core_job_park_worker, 0);
+	}
+
+	for (cpu = 1; cpu < CORE_JOB_CORES; cpu++)
+	{
+		for (us = 0; (REG_READ(CORE_JOB_ARG(cpu)) & CORE_JOB_PARKED) == 0; us++)
+		{
+			if (!CORE_JOB_IsTaken(cpu))
+			{
+				if ((us >= CORE_JOB_ACK_US) && CORE_JOB_TakeBack(cpu))
+				{
+					break;
+				}
+			}
+			else if (us >= CORE_JOB_PARK_US)
+			{
+				return DEFS_STATUS_RESPONSE_TIMEOUT;
+			}
+			CLK_Delay_MicroSec(1);
+		}
+
+		if (REG_READ(CORE_JOB_ARG(cpu)) & CORE_JOB_PARKED)
+		{
+			*parked |= MASK_BIT(cpu);
+		}
+	}
+
+	return DEFS_STATUS_OK;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        CORE_JOB_Release                                                                       */
+/*                                                                                                         */
+/* Parameters:      parked -  cores parked, bitwise, from CORE_JOB_Park                                    */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Returns the parked cores to their wait loop, ready for the next job                    */
+/*---------------------------------------------------------------------------------------------------------*/
+void CORE_JOB_Release (UINT32 parked)
+{
+	UINT32 cpu;
+
+	for (cpu = 1; cpu < CORE_JOB_CORES; cpu++)
+	{
+		if (parked & MASK_BIT(cpu))
+		{
+			REG_WRITE(CORE_JOB_ARG(cpu), CORE_JOB_ACK);
+		}
+	}
+
+	for (cpu = 1; cpu < CORE_JOB_CORES; cpu++)
+	{
+		if (parked & MASK_BIT(cpu))
+		{
+			CORE_JOB_Wait(cpu, 0, CORE_JOB_PARK_US);
+		}
+	}
+}
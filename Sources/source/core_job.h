@@ -0,0 +1,48 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   core_job.h                                                               */
+/*            This file contains API of the jobs of cores 1-3 (SCRPAD_10_41)  */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+
+#ifndef _CORE_JOB_H_
+#define _CORE_JOB_H_
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Cores 1-3 wait in el3_secondary (startup.S) for an address in SCRPAD_10_41(cpu * 2 + 2). A job is that  */
+/* address and an argument in SCRPAD_10_41(cpu * 2 + 3). The worker sets CORE_JOB_ACK in the argument      */
+/* when it takes the job. When done it clears the address, so that the next one (the BL31 entry) is never  */
+/* lost, then sets CORE_JOB_DONE. A job that is not acknowledged in time is taken back by clearing the     */
+/* address: the core never runs it                                                                         */
+/*---------------------------------------------------------------------------------------------------------*/
+#define CORE_JOB_CORES                  4
+#define CORE_JOB_ACK                    MASK_BIT(31)
+#define CORE_JOB_DONE                   MASK_BIT(30)
+#define CORE_JOB_ARG_MASK               (CORE_JOB_DONE - 1)
+#define CORE_JOB_ACK_US                 100
+#define CORE_JOB_PARKED                 MASK_BIT(29)    /* argument of a parked core, see CORE_JOB_Park */
+
+typedef void (*CORE_JOB_WORKER_T) (void);
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Core job exported functions                                                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+void        CORE_JOB_Barrier (void);
+void        CORE_JOB_Dispatch (UINT32 cpu, CORE_JOB_WORKER_T worker, UINT32 arg);
+UINT32      CORE_JOB_Ack (UINT32 cpu);
+void        CORE_JOB_Done (UINT32 cpu);
+BOOLEAN     CORE_JOB_IsTaken (UINT32 cpu);
+BOOLEAN     CORE_JOB_IsDone (UINT32 cpu);
+BOOLEAN     CORE_JOB_TakeBack (UINT32 cpu);
+DEFS_STATUS CORE_JOB_Wait (UINT32 cpu, UINT32 ack_us, UINT32 timeout_us);
+DEFS_STATUS CORE_JOB_Park (UINT32 *parked);
+void        CORE_JOB_Release (UINT32 parked);
+
+#endif /* _CORE_JOB_H_ */
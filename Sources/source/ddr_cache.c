@@ -0,0 +1,473 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   ddr_cache.c                                                              */
+/* This file contains the DDR training cache: the trained PHY state is kept   */
+/* in a flash sector and restored on the next boots instead of training       */
+/* NO_TIP mode only: in TIP mode TIP owns the SPI0 flash                      */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+#if defined(BOOTBLOCK_DDR_TRAINING_CACHE) && defined(_NOTIP_)
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "hal.h"
+#include "../SWC_HAL/hal_regs.h"
+#include "boot.h"
+#include "ddr_cache.h"
+#include "apps/serial_printf/serial_printf.h"
+
+extern const BOOTBLOCK_Version_T bb_version;
+extern unsigned int Crc32Update (unsigned int crc, const void *buf, unsigned long size);
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* SPI flash commands (sector erase and page program, 3 or 4 bytes address as set in FIU_DWR_CFG)          */
+/*---------------------------------------------------------------------------------------------------------*/
+#define DDR_CACHE_SPI_WREN              0x06
+#define DDR_CACHE_SPI_RDSR              0x05
+#define DDR_CACHE_SPI_PP                0x02
+#define DDR_CACHE_SPI_SE_4KB            0x20
+#define DDR_CACHE_SPI_SR_WIP            0x01
+#define DDR_CACHE_SPI_SR_WEL            0x02
+#define DDR_CACHE_SPI_SR_BP             0x7C            /* BP0-BP3, TB / SEC: a block protection is set */
+
+#define DDR_CACHE_FIU_LOOPS             100000          /* UMA transaction done polls, > 10 ms          */
+#define DDR_CACHE_FLASH_TIMEOUT_SEC     3               /* SECCNT, sector erase (2 s max) or program     */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* The erase and program run from RAM2 (BOOTBLOCK_RAMFUNC): the bootblock runs in place from the flash     */
+/* they write, that cannot be read until the flash is ready again. The UMA register values are computed in */
+/* flash as the FIU driver does (FIU_UMA_Read, FIU_UMA_Write, FIU_PageWrite); the RAM2 code only writes    */
+/* them and polls, with direct register accesses (not profiled by BOOTBLOCK_MMIO_PROFILE). Cores 1-3 are   */
+/* parked in RAM2 meanwhile, and the interrupts are masked from reset (startup.S never unmasks them)       */
+/*---------------------------------------------------------------------------------------------------------*/
+#define DDR_CACHE_REG_READ(reg)         IOR32(_GET_REG_ADDR(reg))
+#define DDR_CACHE_REG_WRITE(reg, val)   IOW32(_GET_REG_ADDR(reg), (val))
+#define DDR_CACHE_UMA_WORDS             (FIU_MAX_UMA_DATA_SIZE / sizeof(UINT32))
+#define DDR_CACHE_DATA_WORDS            ((sizeof(DDR_CACHE_RECORD_T) + FIU_MAX_UMA_DATA_SIZE - 1) / sizeof(UINT32))
+
+typedef struct DDR_CACHE_FLASH_OP_tag
+{
+	UINT32  cfg_cmd;                /* UMA_CFG: command only                                           */
+	UINT32  cfg_rdsr;               /* command, 1 byte read                                            */
+	UINT32  cfg_erase;              /* command and address                                             */
+	UINT32  cfg_pp;                 /* command, address and the first data bytes                       */
+	UINT32  cfg_data;               /* data bytes only, the chip select is held by SW_CS               */
+	UINT32  cts;                    /* UMA_CTS: CS0, RDYST cleared, EXEC_DONE set                      */
+	UINT32  offset;                 /* flash offset of the cache sector                                */
+	UINT32  size;                   /* bytes to program, 0 to erase only                               */
+	UINT32  data[DDR_CACHE_DATA_WORDS];
+	UINT32  sr;                     /* last flash status register                                      */
+} DDR_CACHE_FLASH_OP_T;
+
+static DDR_CACHE_RECORD_T   ddr_cache_record;
+static DDR_CACHE_FLASH_OP_T ddr_cache_op;
+static UINT32               ddr_cache_offset;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        ddr_cache_temp_bucket                                                                  */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         temperature range of the die                                                           */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  There is no thermal sensor driver in the HAL: all boots are in bucket 0. A saved       */
+/*                  training that does not hold at the current temperature fails the check and retrains    */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 ddr_cache_temp_bucket (void)
+{
+	return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        ddr_cache_crc                                                                          */
+/*                                                                                                         */
+/* Parameters:      record - cache record                                                                  */
+/* Returns:         CRC32 of the record, without the crc field                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 ddr_cache_crc (const DDR_CACHE_RECORD_T *record)
+{
+	return ~Crc32Update(0xFFFFFFFF, record, offsetof(DDR_CACHE_RECORD_T, crc));
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        ddr_cache_ram_uma                                                                      */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  cfg  - FIU_UMA_CFG                                                                     */
+/*                  cmd  - SPI command                                                                     */
+/*                  addr - flash address                                                                   */
+/*                  dw   - 4 words of data to write, NULL if none                                          */
+/*                  cts  - FIU_UMA_CTS, starts the transaction                                             */
+/* Returns:         TRUE when the transaction is done                                                      */
+/* Side effects:    runs from RAM2                                                                         */
+/*---------------------------------------------------------------------------------------------------------*/
+static BOOTBLOCK_RAMFUNC BOOLEAN ddr_cache_ram_uma (UINT32 cfg, UINT32 cmd, UINT32 addr, const UINT32 *dw, UINT32 cts)
+{
+	UINT32 loops;
+
+	DDR_CACHE_REG_WRITE(FIU_UMA_CFG(FIU_MODULE_0), cfg);
+	DDR_CACHE_REG_WRITE(FIU_UMA_CMD(FIU_MODULE_0), cmd);
+	DDR_CACHE_REG_WRITE(FIU_UMA_ADDR(FIU_MODULE_0), addr);
+	if (dw != NULL)
+	{
+		DDR_CACHE_REG_WRITE(FIU_UMA_DW(FIU_MODULE_0, 0), dw[0]);
+		DDR_CACHE_REG_WRITE(FIU_UMA_DW(FIU_MODULE_0, 1), dw[1]);
+		DDR_CACHE_REG_WRITE(FIU_UMA_DW(FIU_MODULE_0, 2), dw[2]);
+		DDR_CACHE_REG_WRITE(FIU_UMA_DW(FIU_MODULE_0, 3), dw[3]);
+	}
+	DDR_CACHE_REG_WRITE(FIU_UMA_CTS(FIU_MODULE_0), cts);
+
+	for (loops = 0; loops < DDR_CACHE_FIU_LOOPS; loops++)
+	{
+		if (READ_VAR_FIELD(DDR_CACHE_REG_READ(FIU_UMA_CTS(FIU_MODULE_0)), FIU_UMA_CTS_EXEC_DONE) == 0)
+		{
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        ddr_cache_ram_sr                                                                       */
+/*                                                                                                         */
+/* Parameters:      op - flash operation, op->sr is set                                                    */
+/* Returns:         DEFS_STATUS_OK on success                                                              */
+/* Side effects:    runs from RAM2                                                                         */
+/*---------------------------------------------------------------------------------------------------------*/
+static BOOTBLOCK_RAMFUNC DEFS_STATUS ddr_cache_ram_sr (DDR_CACHE_FLASH_OP_T *op)
+{
+	if (!ddr_cache_ram_uma(op->cfg_rdsr, DDR_CACHE_SPI_RDSR, 0, NULL, op->cts))
+	{
+		return DEFS_STATUS_RESPONSE_TIMEOUT;
+	}
+	op->sr = DDR_CACHE_REG_READ(FIU_UMA_DR0(FIU_MODULE_0)) & 0xFF;
+
+	return DEFS_STATUS_OK;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        ddr_cache_ram_wait                                                                     */
+/*                                                                                                         */
+/* Parameters:      op - flash operation                                                                   */
+/* Returns:         DEFS_STATUS_OK when the flash is ready                                                 */
+/* Side effects:    runs from RAM2                                                                         */
+/* Description:                                                                                            */
+/*                  Poll the flash status register until the erase / program is done. The timeout is on    */
+/*                  the seconds counter: CLK_Delay_MicroSec runs from flash                                */
+/*---------------------------------------------------------------------------------------------------------*/
+static BOOTBLOCK_RAMFUNC DEFS_STATUS ddr_cache_ram_wait (DDR_CACHE_FLASH_OP_T *op)
+{
+	UINT32 start = DDR_CACHE_REG_READ(SECCNT);
+
+	do
+	{
+		if (ddr_cache_ram_sr(op) != DEFS_STATUS_OK)
+		{
+			return DEFS_STATUS_RESPONSE_TIMEOUT;
+		}
+		if ((op->sr & DDR_CACHE_SPI_SR_WIP) == 0)
+		{
+			return DEFS_STATUS_OK;
+		}
+	} while ((DDR_CACHE_REG_READ(SECCNT) - start) < DDR_CACHE_FLASH_TIMEOUT_SEC);
+
+	return DEFS_STATUS_RESPONSE_TIMEOUT;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        ddr_cache_ram_wren                                                                     */
+/*                                                                                                         */
+/* Parameters:      op - flash operation                                                                   */
+/* Returns:         DEFS_STATUS_OK if the flash accepts the next erase / program                           */
+/* Side effects:    runs from RAM2                                                                         */
+/* Description:                                                                                            */
+/*                  Write enable, then check the status register: a flash with a block protection set      */
+/*                  (BP bits, the boot area is usually protected as a whole) or that did not set WEL       */
+/*                  would ignore the erase / program without an error                                      */
+/*---------------------------------------------------------------------------------------------------------*/
+static BOOTBLOCK_RAMFUNC DEFS_STATUS ddr_cache_ram_wren (DDR_CACHE_FLASH_OP_T *op)
+{
+	if (!ddr_cache_ram_uma(op->cfg_cmd, DDR_CACHE_SPI_WREN, 0, NULL, op->cts) || (ddr_cache_ram_sr(op) != DEFS_STATUS_OK))
+	{
+		return DEFS_STATUS_RESPONSE_TIMEOUT;
+	}
+
+	if ((op->sr & DDR_CACHE_SPI_SR_BP) || ((op->sr & DDR_CACHE_SPI_SR_WEL) == 0))
+	{
+		return DEFS_STATUS_UNSUFFIENT_PRIVILEDGE_LEVEL;
+	}
+
+	return DEFS_STATUS_OK;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        ddr_cache_ram_write                                                                    */
+/*                                                                                                         */
+/* Parameters:      op - flash operation                                                                   */
+/* Returns:         DEFS_STATUS_OK on success                                                              */
+/* Side effects:    runs from RAM2, the flash cannot be read until it returns                              */
+/* Description:                                                                                            */
+/*                  Erase the cache sector and program the record (fits in one flash page). The program    */
+/*                  is one SPI transaction: the chip select is held low by SW_CS between the UMA chunks    */
+/*---------------------------------------------------------------------------------------------------------*/
+static BOOTBLOCK_RAMFUNC DEFS_STATUS ddr_cache_ram_write (DDR_CACHE_FLASH_OP_T *op)
+{
+	DEFS_STATUS status;
+	UINT32      cfg = op->cfg_pp;
+	UINT32      cts = op->cts;
+	UINT32      done;
+	UINT32      chunk;
+
+	DEFS_STATUS_RET_CHECK(ddr_cache_ram_wren(op));
+	if (!ddr_cache_ram_uma(op->cfg_erase, DDR_CACHE_SPI_SE_4KB, op->offset, NULL, op->cts))
+	{
+		return DEFS_STATUS_RESPONSE_TIMEOUT;
+	}
+	DEFS_STATUS_RET_CHECK(ddr_cache_ram_wait(op));
+
+	if (op->size == 0)
+	{
+		return DEFS_STATUS_OK;
+	}
+
+	DEFS_STATUS_RET_CHECK(ddr_cache_ram_wren(op));
+
+	SET_VAR_FIELD(cts, FIU_UMA_CTS_SW_CS, 0);
+	status = DEFS_STATUS_OK;
+	for (done = 0; done < op->size; done += chunk)
+	{
+		chunk = MIN(FIU_MAX_UMA_DATA_SIZE, op->size - done);
+		SET_VAR_FIELD(cfg, FIU_UMA_CFG_WDATSIZ, chunk);
+		if (!ddr_cache_ram_uma(cfg, DDR_CACHE_SPI_PP, op->offset, &op->data[done / sizeof(UINT32)], cts))
+		{
+			status = DEFS_STATUS_RESPONSE_TIMEOUT;
+			break;
+		}
+		cfg = op->cfg_data;
+	}
+
+	// chip select back to default, the flash starts programming
+	DDR_CACHE_REG_WRITE(FIU_UMA_CTS(FIU_MODULE_0), DDR_CACHE_REG_READ(FIU_UMA_CTS(FIU_MODULE_0)) |
+			    MASK_FIELD(FIU_UMA_CTS_SW_CS));
+	DEFS_STATUS_RET_CHECK(status);
+
+	return ddr_cache_ram_wait(op);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        ddr_cache_flash_op_init                                                                */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  op     - flash operation to fill                                                       */
+/*                  offset - flash offset of the cache sector                                              */
+/*                  record - cache record to program, NULL to erase the sector only                        */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  UMA configuration as FIU_UMA_Read / FIU_UMA_Write (bits per clock of the read mode)    */
+/*                  and FIU_PageWrite (address and data bits per clock of FIU_DWR_CFG)                     */
+/*---------------------------------------------------------------------------------------------------------*/
+static void ddr_cache_flash_op_init (DDR_CACHE_FLASH_OP_T *op, UINT32 offset, const DDR_CACHE_RECORD_T *record)
+{
+	FIU_READ_MODE_T read_mode = FIU_GetReadMode(FIU_MODULE_0);
+	UINT32          dwr_cfg = REG_READ(FIU_DWR_CFG(FIU_MODULE_0));
+	UINT32          bits = 0;
+	UINT32          cfg = 0;
+
+	if ((read_mode == FIU_FAST_READ_DUAL_IO) || (read_mode == FIU_FAST_READ_DUAL_OUTPUT))
+	{
+		bits = 1;
+	}
+	if ((read_mode == FIU_FAST_READ_QUAD_IO) || (read_mode == FIU_FAST_READ_SPI_X))
+	{
+		bits = 2;
+	}
+
+	memset(op, 0, sizeof(DDR_CACHE_FLASH_OP_T));
+
+	SET_VAR_FIELD(cfg, FIU_UMA_CFG_CMBPCK, bits);
+	SET_VAR_FIELD(cfg, FIU_UMA_CFG_ADBPCK, bits);
+	SET_VAR_FIELD(cfg, FIU_UMA_CFG_WDBPCK, bits);
+	SET_VAR_FIELD(cfg, FIU_UMA_CFG_RDBPCK, bits);
+	SET_VAR_FIELD(cfg, FIU_UMA_CFG_DBPCK, bits);
+	SET_VAR_FIELD(cfg, FIU_UMA_CFG_CMDSIZ, 1);
+	op->cfg_cmd = cfg;
+
+	op->cfg_rdsr = cfg;
+	SET_VAR_FIELD(op->cfg_rdsr, FIU_UMA_CFG_RDATSIZ, FIU_UMA_DATA_SIZE_1);
+
+	op->cfg_erase = cfg;
+	SET_VAR_FIELD(op->cfg_erase, FIU_UMA_CFG_ADDSIZ, (READ_VAR_FIELD(dwr_cfg, FIU_DWR_CFG_ADDSIZ) == 0) ? 3 : 4);
+
+	cfg = 0;
+	SET_VAR_FIELD(cfg, FIU_UMA_CFG_ADBPCK, READ_VAR_FIELD(dwr_cfg, FIU_DWR_CFG_ABPCK));
+	SET_VAR_FIELD(cfg, FIU_UMA_CFG_WDBPCK, READ_VAR_FIELD(dwr_cfg, FIU_DWR_CFG_DBPCK));
+	op->cfg_data = cfg;
+
+	SET_VAR_FIELD(cfg, FIU_UMA_CFG_CMDSIZ, 1);
+	SET_VAR_FIELD(cfg, FIU_UMA_CFG_ADDSIZ, (READ_VAR_FIELD(dwr_cfg, FIU_DWR_CFG_ADDSIZ) == 0) ? 3 : 4);
+	op->cfg_pp = cfg;
+
+	op->cts = REG_READ(FIU_UMA_CTS(FIU_MODULE_0));
+	SET_VAR_FIELD(op->cts, FIU_UMA_CTS_RDYIE, 0);
+	SET_VAR_FIELD(op->cts, FIU_UMA_CTS_RDYST, 1);
+	SET_VAR_FIELD(op->cts, FIU_UMA_CTS_EXEC_DONE, 1);
+	SET_VAR_FIELD(op->cts, FIU_UMA_CTS_DEV_NUM, FIU_CS_0);
+	SET_VAR_FIELD(op->cts, FIU_UMA_CTS_SW_CS, 1);
+
+	op->offset = offset;
+	if (record != NULL)
+	{
+		op->size = sizeof(DDR_CACHE_RECORD_T);
+		memcpy(op->data, record, sizeof(DDR_CACHE_RECORD_T));
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        ddr_cache_flash_write                                                                  */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  offset - flash offset of the cache sector                                              */
+/*                  record - cache record to program, NULL to erase the sector only                        */
+/* Returns:         DEFS_STATUS_OK on success                                                              */
+/* Side effects:    the whole 4KB sector is erased                                                         */
+/* Description:                                                                                            */
+/*                  Park cores 1-3 in RAM2, run the erase / program from RAM2 and print its result once    */
+/*                  the flash is readable again                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+static DEFS_STATUS ddr_cache_flash_write (UINT32 offset, const DDR_CACHE_RECORD_T *record)
+{
+	DEFS_STATUS status;
+	UINT32      parked;
+
+	ddr_cache_flash_op_init(&ddr_cache_op, offset, record);
+
+	status = CORE_JOB_Park(&parked);
+	if (status == DEFS_STATUS_OK)
+	{
+		status = ddr_cache_ram_write(&ddr_cache_op);
+	}
+	CORE_JOB_Release(parked);
+
+	if (status == DEFS_STATUS_UNSUFFIENT_PRIVILEDGE_LEVEL)
+	{
+		serial_printf(KYEL "DDR cache: flash is write protected, status %#04x\n" KNRM, ddr_cache_op.sr);
+	}
+
+	return status;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        DDR_CACHE_Load                                                                         */
+/*                                                                                                         */
+/* Parameters:      ddr_setup - MC training context (after MC_Init_DDR_Setup_re_calc)                      */
+/* Returns:         none                                                                                   */
+/* Side effects:    MC_ConfigureDDR restores the saved training if it is valid for this boot               */
+/* Description:                                                                                            */
+/*                  Build the key of this boot and look for a matching record in the cache sector          */
+/*---------------------------------------------------------------------------------------------------------*/
+void DDR_CACHE_Load (const DDR_Setup *ddr_setup)
+{
+	const DDR_CACHE_RECORD_T *flash;
+	DDR_CACHE_KEY_T *key = &ddr_cache_record.key;
+
+	MC_SetTrainingData(NULL);
+
+	ddr_cache_offset = BOOTBLOCK_Get_ddr_cache_offset();
+	if ((ddr_cache_offset == 0) || (ddr_cache_offset & (DDR_CACHE_SECTOR_SIZE - 1)) ||
+	    (ddr_cache_offset > SPI0CS0_SIZE - DDR_CACHE_SECTOR_SIZE))
+	{
+		ddr_cache_offset = 0;
+		return;
+	}
+
+	memset(&ddr_cache_record, 0, sizeof(ddr_cache_record));
+	key->bootblock_version = bb_version.BootblockVersion;
+	key->board = ((UINT32)BOOTBLOCK_GetVendorType() << 16) | ((UINT32)BOOTBLOCK_GetBoardType() & 0xFFFF);
+	key->die[0] = REG_READ(SCRPAD_32_63(30));
+	key->die[1] = REG_READ(SCRPAD_32_63(31));
+	key->mc_clk = ddr_setup->mc_clk;
+	key->ddr_setup_crc = BOOTBLOCK_Get_DDR_Setup_CRC();
+	key->temp_bucket = ddr_cache_temp_bucket();
+
+	flash = (const DDR_CACHE_RECORD_T *)(uintptr_t)(SPI0CS0_BASE_ADDR + ddr_cache_offset);
+
+	if ((flash->magic != DDR_CACHE_MAGIC) || (flash->version != DDR_CACHE_VERSION) ||
+	    (flash->size != sizeof(DDR_CACHE_RECORD_T)))
+	{
+		serial_printf("DDR cache: empty\n");
+		return;
+	}
+
+	if (ddr_cache_crc(flash) != flash->crc)
+	{
+		serial_printf(KRED "DDR cache: bad CRC\n" KNRM);
+		return;
+	}
+
+	if (memcmp(&flash->key, key, sizeof(DDR_CACHE_KEY_T)) != 0)
+	{
+		serial_printf(KYEL "DDR cache: key mismatch, train\n" KNRM);
+		return;
+	}
+
+	serial_printf(KGRN "DDR cache: restore training from %#010lx\n" KNRM, (UINT32)(uintptr_t)flash);
+	MC_SetTrainingData(&flash->data);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        DDR_CACHE_Save                                                                         */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:    the cache sector is erased and programmed                                              */
+/* Description:                                                                                            */
+/*                  After MC_ConfigureDDR, passed or not: save the result of a full training that passed   */
+/*                  the DDR tests. A restored training that failed a DDR test is erased, also when the     */
+/*                  full training that followed failed too. Nothing is written when the saved training was */
+/*                  restored and passed, so the sector is erased only on retrain                           */
+/*---------------------------------------------------------------------------------------------------------*/
+void DDR_CACHE_Save (void)
+{
+	DEFS_STATUS status;
+
+	if (ddr_cache_offset == 0)
+	{
+		return;
+	}
+
+	if (MC_GetTrainingData(&ddr_cache_record.data) == FALSE)
+	{
+		if (MC_TrainingDataRejected())
+		{
+			status = ddr_cache_flash_write(ddr_cache_offset, NULL);
+			serial_printf(KYEL "DDR cache: saved training rejected, erase %s\n" KNRM,
+				      (status == DEFS_STATUS_OK) ? "done" : "fail");
+		}
+		return;
+	}
+
+	ddr_cache_record.magic = DDR_CACHE_MAGIC;
+	ddr_cache_record.version = DDR_CACHE_VERSION;
+	ddr_cache_record.size = sizeof(DDR_CACHE_RECORD_T);
+	ddr_cache_record.crc = ddr_cache_crc(&ddr_cache_record);
+
+	status = ddr_cache_flash_write(ddr_cache_offset, &ddr_cache_record);
+	if (status != DEFS_STATUS_OK)
+	{
+		serial_printf(KRED "DDR cache: flash write fail %#x\n" KNRM, status);
+		return;
+	}
+
+	serial_printf(KGRN "DDR cache: training saved at %#010lx\n" KNRM, SPI0CS0_BASE_ADDR + ddr_cache_offset);
+}
+
+#endif // BOOTBLOCK_DDR_TRAINING_CACHE && _NOTIP_
@@ -0,0 +1,64 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   ddr_cache.h                                                              */
+/*            This file contains API of the DDR training cache in flash       */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+
+#ifndef _DDR_CACHE_H_
+#define _DDR_CACHE_H_
+
+#include "hal.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* NO_TIP mode only: the A35 erases and programs SPI0 flash through FIU0 UMA. In TIP mode TIP owns the     */
+/* flash and may access it at the same time                                                                */
+/*---------------------------------------------------------------------------------------------------------*/
+#if defined(BOOTBLOCK_DDR_TRAINING_CACHE) && defined(_NOTIP_)
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Cache record, at the start of a 4KB flash sector (header offset 0x1A0)                                  */
+/*---------------------------------------------------------------------------------------------------------*/
+#define DDR_CACHE_MAGIC                 0x43524444      /* "DDRC" */
+#define DDR_CACHE_VERSION               1
+#define DDR_CACHE_SECTOR_SIZE           _4KB_
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* The saved training is used only if every field of the key matches the current boot                     */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct DDR_CACHE_KEY_tag
+{
+	UINT32  bootblock_version;      /* training code                                                   */
+	UINT32  board;                  /* board type, vendor                                              */
+	UINT32  die[2];                 /* DIE_INFORMATION_ALL fuses                                       */
+	UINT32  mc_clk;                 /* MC frequency                                                    */
+	UINT32  ddr_setup_crc;          /* DDR parameters of the header (drive, ODT, trims, VREF, size)    */
+	UINT32  temp_bucket;            /* die temperature range                                           */
+} DDR_CACHE_KEY_T;
+
+typedef struct DDR_CACHE_RECORD_tag
+{
+	UINT32              magic;
+	UINT16              version;
+	UINT16              size;       /* sizeof(DDR_CACHE_RECORD_T)                                      */
+	DDR_CACHE_KEY_T     key;
+	MC_TRAINING_DATA_T  data;
+	UINT32              crc;        /* CRC32 of all the fields above                                   */
+} DDR_CACHE_RECORD_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* DDR cache exported functions                                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+void DDR_CACHE_Load (const DDR_Setup *ddr_setup);
+void DDR_CACHE_Save (void);
+
+#endif // BOOTBLOCK_DDR_TRAINING_CACHE && _NOTIP_
+
+#endif /* _DDR_CACHE_H_ */
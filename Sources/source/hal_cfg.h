@@ -138,7 +138,15 @@
 #define ESPI_CAPABILITY_HOST_STATUS
 #define ESPI_FATAL_ERROR_ERRATA_ISSUE
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* Code that runs from RAM2 while the SPI0 CS0 flash is written (NO_TIP: the bootblock runs in place from  */
+/* that flash). While the flash is busy it must not call code out of .ramfunc nor read const data          */
+/*---------------------------------------------------------------------------------------------------------*/
+#define BOOTBLOCK_RAMFUNC               __attribute__((section(".ramfunc"), noinline))
+
 #include "./apps/serial_printf/serial_printf.h"
+#include "./boot_trace.h"
+#include "./core_job.h"
 
 /*---------------------------------------------------------------------------------------------------------*/
 /* Print function                                                                                          */
@@ -146,12 +154,112 @@
 #define HAL_PRINT_CAPABILITY
 
 /*---------------------------------------------------------------------------------------------------------*/
-/* Full debug. Used for Nuvoton.                                                                           */
+/* Log levels. HAL_PRINT_ERR logs at HAL_LOG_ERR (failures: training, sweep, size detection), HAL_PRINT at */
+/* HAL_LOG_INFO and HAL_PRINT_DBG at HAL_LOG_DBG, as the module set by                                     */
+/* HAL_LOG_MODULE in the driver. A print above the compile time level of its module                        */
+/* (HAL_LOG_LEVEL_<module>, from OPTIONAL_FLAGS) is removed with its arguments and string. Otherwise it    */
+/* costs one compare with the runtime level of the module (HAL_LOG_SetLevel).                              */
+/*---------------------------------------------------------------------------------------------------------*/
+#define HAL_LOG_NONE            0
+#define HAL_LOG_ERR             1
+#define HAL_LOG_INFO            2
+#define HAL_LOG_DBG             3
+
+typedef enum
+{
+	HAL_LOG_ID_HAL = 0,             /* chip and the other drivers                                          */
+	HAL_LOG_ID_MC,                  /* MC init, mode registers, size detection, memory tests               */
+	HAL_LOG_ID_PHY,                 /* PHY configuration, leveling and sweeps                              */
+	HAL_LOG_ID_FIU,
+	HAL_LOG_ID_CLK,
+	HAL_LOG_ID_ESPI,
+	HAL_LOG_ID_SHM,
+	HAL_LOG_ID_FUSE,
+	HAL_LOG_NUM_OF_MODULES
+} HAL_LOG_ID_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Full debug (Nuvoton) and lite logging print all the levels. BOOTBLOCK_LOG_BINARY keeps the MC and PHY   */
+/* prints as binary records also without them                                                              */
 /*---------------------------------------------------------------------------------------------------------*/
+#ifndef HAL_LOG_LEVEL_DEFAULT
 #if   defined(DEBUG_LOG) || defined(DEV_LOG)
-#define HAL_PRINT(fmt,args...)   serial_printf(fmt ,##args)
+#define HAL_LOG_LEVEL_DEFAULT   HAL_LOG_DBG
+#else
+#define HAL_LOG_LEVEL_DEFAULT   HAL_LOG_NONE
+#endif
+#endif
+
+#ifdef BOOTBLOCK_LOG_BINARY
+#define HAL_LOG_LEVEL_TRAINING  HAL_LOG_DBG
 #else
-#define         HAL_PRINT(x,...)                   (void)0
+#define HAL_LOG_LEVEL_TRAINING  HAL_LOG_LEVEL_DEFAULT
+#endif
+
+#ifndef HAL_LOG_LEVEL_HAL
+#define HAL_LOG_LEVEL_HAL       HAL_LOG_LEVEL_DEFAULT
+#endif
+#ifndef HAL_LOG_LEVEL_MC
+#define HAL_LOG_LEVEL_MC        HAL_LOG_LEVEL_TRAINING
+#endif
+#ifndef HAL_LOG_LEVEL_PHY
+#define HAL_LOG_LEVEL_PHY       HAL_LOG_LEVEL_TRAINING
+#endif
+#ifndef HAL_LOG_LEVEL_FIU
+#define HAL_LOG_LEVEL_FIU       HAL_LOG_LEVEL_DEFAULT
+#endif
+#ifndef HAL_LOG_LEVEL_CLK
+#define HAL_LOG_LEVEL_CLK       HAL_LOG_LEVEL_DEFAULT
+#endif
+#ifndef HAL_LOG_LEVEL_ESPI
+#define HAL_LOG_LEVEL_ESPI      HAL_LOG_LEVEL_DEFAULT
+#endif
+#ifndef HAL_LOG_LEVEL_SHM
+#define HAL_LOG_LEVEL_SHM       HAL_LOG_LEVEL_DEFAULT
+#endif
+#ifndef HAL_LOG_LEVEL_FUSE
+#define HAL_LOG_LEVEL_FUSE      HAL_LOG_LEVEL_DEFAULT
+#endif
+
+/* Runtime levels, in serial_printf.c. Initialized to the compile time levels                              */
+extern UINT8 hal_log_level[HAL_LOG_NUM_OF_MODULES];
+
+#define HAL_LOG_SetLevel(module, level)     (hal_log_level[HAL_LOG_ID_##module] = (UINT8)(level))
+
+/* Output of the prints. mc_drv.c sends it to serial_log_bin with BOOTBLOCK_LOG_BINARY                     */
+#define HAL_LOG_OUT             serial_printf
+
+/* Drivers set their module after their includes, and set it back to HAL at the end of the file            */
+#define HAL_LOG_MODULE          HAL
+
+/* HAL_LOG_ERR prints are synchronous with the log ring: sent before the next statement (a hang, a reset)  */
+#define HAL_LOG_L(module, level, fmt, args...)                                                      \
+	do {                                                                                            \
+		if (((level) <= HAL_LOG_LEVEL_##module) &&                                                  \
+		    ((level) <= hal_log_level[HAL_LOG_ID_##module]))                                        \
+		{                                                                                           \
+			if ((level) == HAL_LOG_ERR)                                                             \
+				serial_printf_sync(TRUE);                                                           \
+			HAL_LOG_OUT(fmt ,##args);                                                               \
+			if ((level) == HAL_LOG_ERR)                                                             \
+			{                                                                                       \
+				serial_printf_sync(FALSE);                                                          \
+				serial_printf_flush();                                                              \
+			}                                                                                       \
+		}                                                                                           \
+	} while (0)
+
+#define HAL_LOG(module, level, fmt, args...)    HAL_LOG_L(module, level, fmt ,##args)
+
+#define HAL_PRINT_ERR(fmt, args...)             HAL_LOG(HAL_LOG_MODULE, HAL_LOG_ERR, fmt ,##args)
+#define HAL_PRINT(fmt, args...)                 HAL_LOG(HAL_LOG_MODULE, HAL_LOG_INFO, fmt ,##args)
+#define HAL_PRINT_DBG(fmt, args...)             HAL_LOG(HAL_LOG_MODULE, HAL_LOG_DBG, fmt ,##args)
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Send the log ring while CLK_Delay_MicroSec waits                                                        */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifdef BOOTBLOCK_LOG_RING
+#define CLK_DELAY_POLL_HOOK()    serial_printf_poll()
 #endif
 
 #endif // _BOOTBLOCK_HAL_CFG_H_
@@ -20,6 +20,7 @@
 #include "../SWC_HAL/hal_regs.h"
 #include "boot.h"
 #include "images.h"
+#include "mmu.h"
 
 /**
  * start tag of all possible images
@@ -34,6 +35,7 @@ const uint8_t bb_header_tag[8] = { 0x0A, 0x50, 0x08, 0x55, 0xAA, 0x54, 0x4F, 0x4
 const uint8_t uboot_header_tag[8] = { 0x0A, 0x55, 0x42, 0x4F, 0x4F, 0x54, 0x42, 0x4C }; __attribute__ ((aligned (16)))
 const uint8_t bl31_header_tag[8] = { 0x0A, 0x42, 0x4C, 0x33, 0x31, 0x4E, 0x50, 0x43 }; __attribute__ ((aligned (16)))
 const uint8_t optee_header_tag[8] = { 0x0A, 0x54, 0x45, 0x45, 0x5F, 0x4E, 0x50, 0x43 }; __attribute__ ((aligned (16)))
+const uint8_t image_dir_tag[8] = { 0x0A, 0x49, 0x4D, 0x47, 0x44, 0x49, 0x52, 0x0A }; __attribute__ ((aligned (16)))
 
 static int firmware_image_load_func (struct tip_firmware_image *tip_fw_im, uint32_t base_addr);
 static int firmware_image_scan_flash (struct tip_firmware_image *tip_fw_im);
@@ -43,52 +45,167 @@ static int component_start (struct tip_firmware_image	*fw,
 						 int					*start_offset);
 
 /**
- * Copy data from flash to memory via direct read. Only working on aligned data.
+ * Copy chunk between progress prints
+ */
+#define IMAGE_COPY_CHUNK	_64KB_
+
+extern void *CopyBlock64 (void *dst, const void *src, unsigned long size);
+extern unsigned int Crc32Update (unsigned int crc, const void *buf, unsigned long size);
+
+/**
+ * CRC32 of the bytes [crc_done, copied) that are beyond IMAGE_CRC_START_OFFSET.
+ * Run on the destination right after each chunk is copied, while it is still in the cache.
+ */
+static uint32_t image_crc_update (uint32_t crc, uint32_t dst_addr, uint32_t *crc_done, uint32_t copied)
+{
+	uint32_t from = MAX (*crc_done, IMAGE_CRC_START_OFFSET);
+
+	if (copied > from) {
+		crc = Crc32Update (crc, (const void *) (uintptr_t) (dst_addr + from), copied - from);
+	}
+	*crc_done = copied;
+
+	return crc;
+}
+
+/**
+ * FIU0 read burst is shared by all cores: set once per copy (or per multi-core load).
+ *
+ * @param sixteen If true set 16 bytes read bursts
+ * @return The read burst to restore with image_fiu_burst_restore
+ */
+static uint32_t image_fiu_burst_set (_Bool sixteen)
+{
+	uint32_t r_burst = READ_REG_FIELD (FIU_DRD_CFG (FIU_MODULE_0), FIU_DRD_CFG_R_BURST);
+
+	if (sixteen) {
+		FIU_ConfigBurstSize (FIU_MODULE_0, FIU_R_BURST_SIXTEEN_BYTE,
+			(FIU_W_BURST_T) READ_REG_FIELD (FIU_DWR_CFG (FIU_MODULE_0), FIU_DWR_CFG_W_BURST));
+	}
+
+	return r_burst;
+}
+
+static void image_fiu_burst_restore (uint32_t r_burst)
+{
+	FIU_ConfigBurstSize (FIU_MODULE_0, (FIU_R_BURST_T) r_burst,
+		(FIU_W_BURST_T) READ_REG_FIELD (FIU_DWR_CFG (FIU_MODULE_0), FIU_DWR_CFG_W_BURST));
+}
+
+/**
+ * Copy loop of image_memcpy, without touching the FIU. Safe to run on several cores at once.
  *
  * @param dst_addr Destination address
  * @param src_flash_addr  The flash data
  * @param src_size The size of data to be copy
- * @param dram If 1 destination address is DRAM
- * @param print If 1 debug prints enabled
- * @return The number of bytes copied
+ * @param print If 1 print a dot per chunk
+ * @param crc If not NULL, returns the CRC32 of the copied image
+ * @return The number of bytes copied, less than src_size if CopyBlock64 rejects a block (crc is not set)
  */
-uint32_t image_memcpy (uint32_t dst_addr, uint32_t src_flash_addr, uint32_t src_size, _Bool print)
+static uint32_t image_copy (uint32_t dst_addr, uint32_t src_flash_addr, uint32_t src_size, _Bool print,
+							uint32_t *crc)
 {
-	uint32_t		  cnt;
-	uint32_t		  block_cnt;
-	uint32_t		  size = 0;
-	uint32_t		  src_cnt = 0;
-	uint32_t		  cs;
-	uint32_t		  fiu;
-	uint32_t		  spi;
-	uint32_t		  offset;
-	
-	/* Align the address. */
-	dst_addr &= 0xFFFFFFFC;
-	src_flash_addr &= 0xFFFFFFFC;
+	volatile uint8_t	*dst = (volatile uint8_t *) (uintptr_t) dst_addr;
+	volatile uint8_t	*src = (volatile uint8_t *) (uintptr_t) src_flash_addr;
+	uint32_t		  copied = 0;
+	uint32_t		  chunk;
+	uint32_t		  align;
+	uint32_t		  crc_val = 0xFFFFFFFF;
+	uint32_t		  crc_done = 0;
+
+	/* common alignment of source and destination: 16, 4 or 1 bytes */
+	if (((dst_addr ^ src_flash_addr) & 0xF) == 0)
+		align = 16;
+	else if (((dst_addr ^ src_flash_addr) & 0x3) == 0)
+		align = 4;
+	else
+		align = 1;
+
+	/* head */
+	while ((copied < src_size) && ((src_flash_addr + copied) & (align - 1))) {
+		dst[copied] = src[copied];
+		copied++;
+	}
+
+	/* bulk */
+	while ((align > 1) && (src_size - copied >= align * 4)) {
+		chunk = MIN (src_size - copied, IMAGE_COPY_CHUNK);
+
+		if (align == 16) {
+			chunk &= ~63;
+			if (CopyBlock64 ((void *) (dst + copied), (const void *) (src + copied), chunk) == NULL)
+				return copied;
+		}
+		else {
+			chunk &= ~3;
+			for (uint32_t cnt = 0; cnt < chunk; cnt += 4)
+				*(volatile uint32_t *) (dst + copied + cnt) = *(volatile uint32_t *) (src + copied + cnt);
+		}
+		copied += chunk;
+
+		if (crc != NULL)
+			crc_val = image_crc_update (crc_val, dst_addr, &crc_done, copied);
+
+		if (print)
+			serial_printf (".");
+	}
+
+	/* tail (or everything if no common alignment) */
+	while (copied < src_size) {
+		dst[copied] = src[copied];
+		copied++;
+	}
 
-	/* Align the size. */
-	if (src_size & 0x3) {
-		src_size += 4 - (src_size & 0x3);
+	if (crc != NULL) {
+		crc_val = image_crc_update (crc_val, dst_addr, &crc_done, copied);
+		*crc = ~crc_val;
 	}
 
+	return copied;
+}
+
+/**
+ * Copy data from flash to memory via direct read.
+ *
+ * Unaligned head and tail bytes are copied one by one. When source and
+ * destination share the same 16 bytes alignment the bulk is copied with
+ * 64 bytes NEON blocks while FIU0 issues 16 bytes read bursts, otherwise
+ * with 32 bit words (or bytes if not even 4 bytes alignment is shared).
+ *
+ * If crc is not NULL the CRC32 of the copied data, starting at IMAGE_CRC_START_OFFSET,
+ * is computed chunk by chunk along the copy.
+ *
+ * @param dst_addr Destination address
+ * @param src_flash_addr  The flash data
+ * @param src_size The size of data to be copy
+ * @param print If 1 debug prints enabled
+ * @param crc If not NULL, returns the CRC32 of the copied image
+ * @return The number of bytes copied, less than src_size on error
+ */
+uint32_t image_memcpy (uint32_t dst_addr, uint32_t src_flash_addr, uint32_t src_size, _Bool print,
+					   uint32_t *crc)
+{
+	uint32_t		  copied;
+	uint32_t		  r_burst;
+
 	if (print) {
 		serial_printf ("\ncopy     %#010lx ", src_flash_addr);
 		serial_printf ("size  %#010lx ", src_size);
 		serial_printf ("to    %#010lx \t", dst_addr);
 	}
-	
-	/* direct mapping, assuming GLBLEN is set. */
-	for (cnt = 0; cnt < src_size; cnt += 4) {
-		*(uint32_t *) (dst_addr + cnt) = *(uint32_t *) (src_flash_addr + cnt);
-		if ((cnt % 1024 == 0) && print)
-			serial_printf (".");
-	}
+
+	/* read bursts of 16 bytes for the bulk copy, restored on exit */
+	r_burst = image_fiu_burst_set (((dst_addr ^ src_flash_addr) & 0xF) == 0);
+
+	copied = image_copy (dst_addr, src_flash_addr, src_size, print, crc);
+
+	image_fiu_burst_restore (r_burst);
+
 	if (print) {
 		serial_printf ("\n");
 	}
 
-	return size;
+	return copied;
 }
 
 
@@ -138,32 +255,29 @@ char *image_firmware_get_fw_name (IMG_TYPE_E img)
 
 	
 /**
- * Update the image referenced by an instance.
+ * Check the image header of an instance: size and destination range by image type.
  *
- * @param fw The firmware image instance to update.
- * @param flash The flash device that contains the firmware image.
- * @param base_addr The starting address of the new firmware image.
+ * @param tip_fw_im The firmware image instance to check.
+ * @param src_flash_addr Returns the flash address of the image (header included).
+ * @param dst_addr Returns the RAM address to copy the image to.
+ * @param src_size Returns the image size (header included).
  *
- * @return 0 if the image reference was updated successfully or an error code.
+ * @return 0 if the image can be copied or an error code.
  */
-int firmware_image_load_func (struct tip_firmware_image *tip_fw_im, uint32_t			 base_addr)
+static int firmware_image_check (struct tip_firmware_image *tip_fw_im, uint32_t *src_flash_addr,
+								 uint32_t *dst_addr, uint32_t *src_size)
 {
-	
-	uint32_t				   src_flash_addr = 0;
-	uint32_t				   src_size = -1;
-	uint32_t				   dst_addr = -1;
 	uint32_t				   addr_min = 0;
 	uint32_t				   addr_max = 0xFFFFFFFF; 
 	uint32_t				   size_max = _2GB_;
 
-	
 	if (tip_fw_im == NULL) {
 		return -1;
 	}
 
-	src_size = tip_fw_im->header->header_flash->header.codeSize + sizeof (HEADER_GENERAL_T);
-	dst_addr = tip_fw_im->header->header_flash->header.destAddr;
-	src_flash_addr = (uint32_t) (uint8_t *) tip_fw_im->header->header_flash;
+	*src_size = tip_fw_im->header->header_flash->header.codeSize + sizeof (HEADER_GENERAL_T);
+	*dst_addr = tip_fw_im->header->header_flash->header.destAddr;
+	*src_flash_addr = (uint32_t) (uint8_t *) tip_fw_im->header->header_flash;
 
 	switch (tip_fw_im->img_type) {
 
@@ -186,30 +300,95 @@ int firmware_image_load_func (struct tip_firmware_image *tip_fw_im, uint32_t
 
 	size_max = addr_max - addr_min;
 
-	if ((src_size < sizeof (HEADER_GENERAL_T)) || (src_size > size_max)) {
+	if ((*src_size < sizeof (HEADER_GENERAL_T)) || (*src_size > size_max)) {
 		serial_printf (
 			KRED
 			"image size is invalid, flash addr=%#010lx	dst=%#010lx, size=%#010lx" NEWLINE KNRM,
-			src_flash_addr, dst_addr, src_size);
+			*src_flash_addr, *dst_addr, *src_size);
 		return FIRMWARE_IMAGE_INVALID_FORMAT;
 	}
 
-	if ((dst_addr == 0xFFFFFFFF) || (dst_addr == 0) || (dst_addr < addr_min) ||
-		(dst_addr + src_size) > addr_max) {
+	if ((*dst_addr == 0xFFFFFFFF) || (*dst_addr == 0) || (*dst_addr < addr_min) ||
+		(*dst_addr + *src_size) > addr_max) {
 		serial_printf (KRED "image out of range  %#010lx : %#010lx" NEWLINE KNRM, addr_min,
 						 addr_max);
 
 		return FIRMWARE_IMAGE_LOAD_FAILED;
 	}
 
+	return 0;
+}
+
+#ifdef BOOTBLOCK_IMAGE_CRC
+/**
+ * Compare the CRC32 calculated on the copy with img_crc of the flash header.
+ *
+ * @param tip_fw_im The firmware image instance.
+ * @param crc The calculated CRC32.
+ *
+ * @return 0 if equal or FIRMWARE_IMAGE_BAD_CHECKSUM.
+ */
+static int firmware_image_crc_check (struct tip_firmware_image *tip_fw_im, uint32_t crc)
+{
+	uint32_t img_crc = tip_fw_im->header->header_flash->header.img_crc;
+
+	if (crc != img_crc) {
+		serial_printf (KRED "image CRC mismatch: header %#010lx calculated %#010lx" NEWLINE KNRM,
+						 img_crc, crc);
+		return FIRMWARE_IMAGE_BAD_CHECKSUM;
+	}
+	serial_printf ("image CRC %#010lx OK" NEWLINE, crc);
+
+	return 0;
+}
+#endif
+
+/**
+ * Update the image referenced by an instance.
+ *
+ * @param fw The firmware image instance to update.
+ * @param flash The flash device that contains the firmware image.
+ * @param base_addr The starting address of the new firmware image.
+ *
+ * @return 0 if the image reference was updated successfully or an error code.
+ */
+int firmware_image_load_func (struct tip_firmware_image *tip_fw_im, uint32_t			 base_addr)
+{
+	
+	uint32_t				   src_flash_addr = 0;
+	uint32_t				   src_size = -1;
+	uint32_t				   dst_addr = -1;
+	uint32_t				   copied;
+	int						   status;
+#ifdef BOOTBLOCK_IMAGE_CRC
+	uint32_t				   crc = 0;
+#endif
+
+	status = firmware_image_check (tip_fw_im, &src_flash_addr, &dst_addr, &src_size);
+	if (status != 0) {
+		return status;
+	}
+
 	serial_printf (KMAG NEWLINE "bootblock: copy fw %#010lx size %#010lx to %#010lx" NEWLINE KNRM,
 					 src_flash_addr, src_size, dst_addr);
 
 	/* copy the image from flash to RAM */
-	image_memcpy (dst_addr, src_flash_addr, src_size, true);
-
+#ifdef BOOTBLOCK_IMAGE_CRC
+	copied = image_memcpy (dst_addr, src_flash_addr, src_size, true, &crc);
+#else
+	copied = image_memcpy (dst_addr, src_flash_addr, src_size, true, NULL);
+#endif
+	if (copied != src_size) {
+		serial_printf (KRED "%s copy stopped after %#010lx bytes" NEWLINE KNRM,
+						 image_firmware_get_fw_name (tip_fw_im->img_type), copied);
+		return FIRMWARE_IMAGE_LOAD_FAILED;
+	}
 
+#ifdef BOOTBLOCK_IMAGE_CRC
+	return firmware_image_crc_check (tip_fw_im, crc);
+#else
 	return 0;
+#endif
 }
 
 
@@ -344,25 +523,309 @@ void update_reset_indication (void)
 	serial_printf ("RESSR    =  %#010lx\n", REG_READ (RESSR));
 }
 
+/**
+ * Image directory, validated once on first use.
+ */
+static const IMAGE_DIR_T	*image_dir = NULL;
+static _Bool				 image_dir_checked = false;
+
+/**
+ *  @function   image_dir_get
+ *
+ *  @return     the image directory in flash, or NULL if the header has none or it is not valid
+ *
+ *  @details    check that the directory pointed by the bootblock header is in the signed area of the
+ *              bootblock, then check its tag, version, count and CRC.
+ */
+static const IMAGE_DIR_T *image_dir_get (void)
+{
+	const IMAGE_DIR_T	*dir;
+	uint32_t			 offset;
+	uint32_t			 crc;
+
+	if (image_dir_checked) {
+		return image_dir;
+	}
+	image_dir_checked = true;
+
+	offset = BOOTBLOCK_Get_img_dir_offset ();
+	if ((offset == 0) || (offset > SPI0CS0_SIZE - sizeof (IMAGE_DIR_T)) || (offset & 0x7)) {
+		return NULL;
+	}
+
+	/* the bootblock header is at the start of SPI0: the table must be in the signed code after it */
+	if ((offset < sizeof (BOOTBLOCK_HEADER_T)) || (offset + sizeof (IMAGE_DIR_T) > BOOTBLOCK_Get_signed_end ())) {
+		serial_printf (KRED "image directory at %#010lx is not signed, scan the flash" NEWLINE KNRM, offset);
+		return NULL;
+	}
+
+	dir = (const IMAGE_DIR_T *) (uintptr_t) (SPI0CS0_BASE_ADDR + offset);
+
+	if (!COMPARE_START_TAG (dir->startTag, image_dir_tag)) {
+		serial_printf (KRED "image directory not found at %#010lx, scan the flash" NEWLINE KNRM, (uint32_t) (uintptr_t) dir);
+		return NULL;
+	}
+
+	if ((dir->version != IMAGE_DIR_VERSION) || (dir->count == 0) || (dir->count > IMAGE_DIR_MAX_ENTRIES)) {
+		serial_printf (KRED "image directory version %d count %d not supported" NEWLINE KNRM, dir->version, dir->count);
+		return NULL;
+	}
+
+	crc = ~Crc32Update (0xFFFFFFFF, dir->entry, dir->count * sizeof (IMAGE_DIR_ENTRY_T));
+	if (crc != dir->crc) {
+		serial_printf (KRED "image directory bad CRC %#010lx (expected %#010lx)" NEWLINE KNRM, crc, dir->crc);
+		return NULL;
+	}
+
+	serial_printf (KGRN "image directory at %#010lx, %d entries" NEWLINE KNRM, (uint32_t) (uintptr_t) dir, dir->count);
+	image_dir = dir;
+
+	return image_dir;
+}
+
+/**
+ *  @function   image_dir_lookup
+ *
+ *  @param [in]  tip_fw_im    - fw handler
+ *  @param [in]  tag          - start tag of the requested image
+ *  @return      0 if the image was found in the directory
+ *
+ *  @details     find the image in the directory, and check that the flash holds a matching header there.
+ */
+static int image_dir_lookup (struct tip_firmware_image *tip_fw_im, const uint8_t *tag)
+{
+	const IMAGE_DIR_T	*dir = image_dir_get ();
+	HEADER_GENERAL_T	*header;
+	uint32_t			 i;
+
+	if (dir == NULL) {
+		return FIRMWARE_IMAGE_NOT_AVAILABLE;
+	}
+
+	for (i = 0; i < dir->count; i++) {
+		if (!COMPARE_START_TAG (dir->entry[i].tag, tag)) {
+			continue;
+		}
+
+		/* the directory is authoritative: images do not have to be in load order */
+		if (dir->entry[i].offset > SPI0CS0_SIZE - sizeof (HEADER_GENERAL_T)) {
+			continue;
+		}
+
+		header = (HEADER_GENERAL_T *) (uintptr_t) (SPI0CS0_BASE_ADDR + dir->entry[i].offset);
+
+		if (!COMPARE_START_TAG (header->header.startTag, tag) ||
+			(header->header.destAddr != dir->entry[i].destAddr) ||
+			(header->header.codeSize + sizeof (HEADER_GENERAL_T) != dir->entry[i].size)) {
+			serial_printf (KRED "image directory entry %d does not match the flash" NEWLINE KNRM, i);
+			return FIRMWARE_IMAGE_INVALID_FORMAT;
+		}
+
+		tip_fw_im->header->header_flash = header;
+		tip_fw_im->header->header_ram = (HEADER_GENERAL_T *) (uintptr_t) dir->entry[i].destAddr;
+		tip_fw_im->offset_minimum = dir->entry[i].offset;
+		tip_fw_im->size = dir->entry[i].size;
+
+		serial_printf (KGRN "%s %s found in directory addr %#010lx dst %#010lx " NEWLINE KNRM, __func__,
+						 image_firmware_get_fw_name (tip_fw_im->img_type), (uint32_t) (uintptr_t) header,
+						 dir->entry[i].destAddr);
+		return 0;
+	}
+
+	return FIRMWARE_IMAGE_NOT_AVAILABLE;
+}
+
+/**
+ * All known start tags, compared as one 64 bit word per 4KB flash page.
+ */
+static const struct
+{
+	const uint8_t	*tag;
+	IMG_TYPE_E		 img_type;
+} image_scan_tags[] =
+{
+	{ kmt_header_tag,			IMG_KMT },
+	{ kmt_header_tag_crc,		IMG_KMT },
+	{ tip_fw_l0_header_tag,		IMG_TFT_L0 },
+	{ tip_fw_l0_header_tag_crc,	IMG_TFT_L0 },
+	{ skmt_header_tag,			IMG_SKMT },
+	{ tip_fw_l1_header_tag,		IMG_TFT_L1 },
+	{ bb_header_tag,			IMG_BOOTBLOCK },
+	{ bl31_header_tag,			IMG_BL31 },
+	{ optee_header_tag,			IMG_OPTEE },
+	{ uboot_header_tag,			IMG_UBOOT },
+};
+
+#define IMAGE_SCAN_TAGS_NUM		ARRAY_SIZE (image_scan_tags)
+#define IMAGE_SCAN_MAX_HITS		16
+#define IMAGE_SCAN_BMC_IMAGES	(IMG_BL31 | IMG_OPTEE | IMG_UBOOT)
+
+/**
+ * Scan results: every tag hit, in flash order.
+ */
+static struct
+{
+	IMG_TYPE_E	img_type;
+	uint32_t	offset;
+} image_scan_hits[IMAGE_SCAN_MAX_HITS];
+
+static uint32_t	image_scan_hits_num = 0;
+static _Bool	image_scan_done = false;
+static _Bool	image_scan_overflow = false;
+
+/**
+ *  @function   image_tag_to_u64
+ *
+ *  @param [in]  tag    - 8 bytes start tag
+ *  @return      the tag as it is read by a single 64 bit load from the flash
+ */
+static uint64_t image_tag_to_u64 (const uint8_t *tag)
+{
+	uint64_t val = 0;
+	int		 i;
+
+	for (i = 7; i >= 0; i--)
+		val = (val << 8) | tag[i];
+
+	return val;
+}
+
+/**
+ *  @function   image_scan_all
+ *
+ *  @details     one traversal of the flash in 4KB steps, comparing each page against all known tags.
+ *               Stops once BL31, OPTEE and UBOOT were found in this order (the order they are loaded in).
+ *               Reports duplicated images and images that overlap the next one.
+ *               Tags past the first IMAGE_SCAN_MAX_HITS are not kept: image_scan_overflow is set and
+ *               the images after the last hit are searched one by one (image_scan_one).
+ */
+static void image_scan_all (void)
+{
+	uint64_t			 tags[IMAGE_SCAN_TAGS_NUM];
+	uint64_t			 val;
+	uint32_t			 offset;
+	uint32_t			 found = 0;
+	uint32_t			 next_bmc_image = IMG_BL31;
+	uint32_t			 i;
+	uint32_t			 j;
+	HEADER_GENERAL_T	*header;
+
+	if (image_scan_done) {
+		return;
+	}
+	image_scan_done = true;
+
+	for (i = 0; i < IMAGE_SCAN_TAGS_NUM; i++)
+		tags[i] = image_tag_to_u64 (image_scan_tags[i].tag);
+
+	serial_printf ("scan all tags from %#010lx to %#010lx" NEWLINE, SPI0CS0_BASE_ADDR,
+					 SPI0CS0_BASE_ADDR + SPI0CS0_SIZE);
+
+	for (offset = 0; offset < SPI0CS0_SIZE; offset += 0x1000) {
+		val = *(volatile uint64_t *) (uintptr_t) (SPI0CS0_BASE_ADDR + offset);
+
+		for (i = 0; i < IMAGE_SCAN_TAGS_NUM; i++) {
+			if (val != tags[i])
+				continue;
+
+			if (found & image_scan_tags[i].img_type) {
+				serial_printf (KRED "duplicate %s at %#010lx" NEWLINE KNRM,
+								 image_firmware_get_fw_name (image_scan_tags[i].img_type),
+								 SPI0CS0_BASE_ADDR + offset);
+			}
+			found |= image_scan_tags[i].img_type;
+
+			if (image_scan_hits_num < IMAGE_SCAN_MAX_HITS) {
+				image_scan_hits[image_scan_hits_num].img_type = image_scan_tags[i].img_type;
+				image_scan_hits[image_scan_hits_num].offset = offset;
+				image_scan_hits_num++;
+			} else if (!image_scan_overflow) {
+				serial_printf (KRED "more than %d image tags, %s at %#010lx and after are searched per image" NEWLINE KNRM,
+								 IMAGE_SCAN_MAX_HITS, image_firmware_get_fw_name (image_scan_tags[i].img_type),
+								 SPI0CS0_BASE_ADDR + offset);
+				image_scan_overflow = true;
+			}
+			if (image_scan_tags[i].img_type == next_bmc_image)
+				next_bmc_image <<= 1;
+			break;
+		}
+
+		if (next_bmc_image > IMG_UBOOT)
+			break;
+	}
+
+	/* an image that runs into the next header is misplaced (or its codeSize is wrong) */
+	for (j = 0; j + 1 < image_scan_hits_num; j++) {
+		if ((image_scan_hits[j].img_type & IMAGE_SCAN_BMC_IMAGES) == 0)
+			continue;
+
+		header = (HEADER_GENERAL_T *) (uintptr_t) (SPI0CS0_BASE_ADDR + image_scan_hits[j].offset);
+		if (image_scan_hits[j].offset + header->header.codeSize + sizeof (HEADER_GENERAL_T) >
+			image_scan_hits[j + 1].offset) {
+			serial_printf (KRED "%s at %#010lx overlaps %s at %#010lx" NEWLINE KNRM,
+							 image_firmware_get_fw_name (image_scan_hits[j].img_type),
+							 SPI0CS0_BASE_ADDR + image_scan_hits[j].offset,
+							 image_firmware_get_fw_name (image_scan_hits[j + 1].img_type),
+							 SPI0CS0_BASE_ADDR + image_scan_hits[j + 1].offset);
+		}
+	}
+}
+
+/**
+ *  @function   image_scan_one
+ *
+ *  @param [in]  tip_fw_im    - fw handler
+ *  @param [in]  tag          - start tag of the requested image
+ *  @param [in]  offset       - first flash offset to check
+ *  @return      0 if the image was found
+ *
+ *  @details     scan the flash in 4KB steps for a single tag. Used for the part of the flash that is
+ *               past the hits table of image_scan_all.
+ */
+static int image_scan_one (struct tip_firmware_image *tip_fw_im, const uint8_t *tag, uint32_t offset)
+{
+	HEADER_GENERAL_T	*header;
+
+	serial_printf ("tag %c%c%c. scan from %#010lx to %#010lx" NEWLINE, tag[1], tag[2], tag[3],
+					 SPI0CS0_BASE_ADDR + offset, SPI0CS0_BASE_ADDR + SPI0CS0_SIZE);
+
+	for (; offset < SPI0CS0_SIZE; offset += 0x1000) {
+		header = (HEADER_GENERAL_T *) (uintptr_t) (SPI0CS0_BASE_ADDR + offset);
+		if (COMPARE_START_TAG (header->header.startTag, tag)) {
+			tip_fw_im->header->header_flash = header;
+			tip_fw_im->header->header_ram = (HEADER_GENERAL_T *) (uintptr_t) header->header.destAddr;
+			tip_fw_im->offset_minimum = offset;
+			tip_fw_im->size = header->header.codeSize + sizeof (HEADER_GENERAL_T);
+
+			serial_printf (KGRN "%s %s found addr %#010lx dst %#010lx " NEWLINE KNRM, __func__,
+							 image_firmware_get_fw_name (tip_fw_im->img_type),
+							 (uint32_t) (uintptr_t) header, header->header.destAddr);
+			return 0;
+		}
+	}
+
+	return FIRMWARE_IMAGE_NOT_AVAILABLE;
+}
+
 /**
  *  @function   firmware_image_scan_flash
  *
  *  @param [in]  tip_fw_im    - fw handler
  *  @return
  *
- *  @details     scan the flash, searching for start tag.
+ *  @details     find the image in the image directory. If there is none, look for the first
+ *               image of this type (after offset_minimum) found by the single pass flash scan,
+ *               then past the last hit if the scan found more tags than it keeps.
  */
 static int firmware_image_scan_flash (struct tip_firmware_image *tip_fw_im)
 {
 	int						 status = FIRMWARE_IMAGE_NOT_AVAILABLE;
 
 	const uint8_t		*tag = tip_fw_l1_header_tag;
-	TIP_HEADER_STRUCT_T *rom_header;
 	uint32_t			 dst_addr = -1;
 	uint32_t			 addr = 0;
-	uint32_t			 scan_from;
-	uint32_t			 scan_to;
-	uint32_t			base_addr = 0x80000000;
+	uint32_t			 i;
+	uint32_t			base_addr = SPI0CS0_BASE_ADDR;
 
 	switch (tip_fw_im->img_type) {
 		case IMG_BOOTBLOCK:
@@ -388,23 +851,25 @@ static int firmware_image_scan_flash (struct tip_firmware_image *tip_fw_im)
 		tip_fw_im->offset_minimum = 0;
 	}
 
-	scan_from = base_addr + tip_fw_im->offset_minimum;
-	scan_to = base_addr + SPI0CS0_SIZE;
+	/* O(1) lookup if the flash has an image directory, otherwise scan */
+	if (image_dir_lookup (tip_fw_im, tag) == 0) {
+		return 0;
+	}
 
-	serial_printf ("tag %c%c%c. scan from %#010lx to %#010lx" NEWLINE, tag[1], tag[2], tag[3],
-					 scan_from, scan_to);
+	/* single pass over the flash for all tags, then lookup in the hits table */
+	image_scan_all ();
 
-	/* scan the flash, search for tags. */
-	for (addr = scan_from; addr < scan_to; addr += 0x1000) {
-		if (COMPARE_START_TAG (addr, tag)) 
+	for (i = 0; i < image_scan_hits_num; i++) {
+		if ((image_scan_hits[i].img_type == tip_fw_im->img_type) &&
+			(image_scan_hits[i].offset >= tip_fw_im->offset_minimum))
 		{
-			tip_fw_im->header->header_flash = (HEADER_GENERAL_T *) addr;
+			addr = base_addr + image_scan_hits[i].offset;
+			tip_fw_im->header->header_flash = (HEADER_GENERAL_T *) (uintptr_t) addr;
 			dst_addr = tip_fw_im->header->header_flash->header.destAddr;
-			tip_fw_im->header->header_ram = (HEADER_GENERAL_T *) dst_addr;
-			tip_fw_im->offset_minimum = addr - base_addr;
+			tip_fw_im->header->header_ram = (HEADER_GENERAL_T *) (uintptr_t) dst_addr;
+			tip_fw_im->offset_minimum = image_scan_hits[i].offset;
 			tip_fw_im->size =
 				tip_fw_im->header->header_flash->header.codeSize + sizeof (HEADER_GENERAL_T);
-			
 
 			serial_printf (KGRN "%s %s found addr %#010lx dst %#010lx " NEWLINE KNRM, __func__,
 							 image_firmware_get_fw_name (tip_fw_im->img_type), addr, dst_addr);
@@ -414,6 +879,12 @@ static int firmware_image_scan_flash (struct tip_firmware_image *tip_fw_im)
 			return status;
 		}
 	}
+
+	if (image_scan_overflow) {
+		status = image_scan_one (tip_fw_im, tag, MAX (tip_fw_im->offset_minimum,
+					 image_scan_hits[IMAGE_SCAN_MAX_HITS - 1].offset + 0x1000));
+	}
+
 	return status;
 }
 
@@ -445,7 +916,9 @@ int component_start (struct tip_firmware_image	*fw,
 	
 	/* scan for a specific image, if we know what we are*/
 	if ((img_type != IMG_UNKNOWN) && (*start_offset >= 0)) {
+		BOOT_TRACE_Begin (BOOT_TRACE_IMAGE_SCAN, img_type);
 		status_load = firmware_image_scan_flash (fw);
+		BOOT_TRACE_End (BOOT_TRACE_IMAGE_SCAN, img_type);
 		if (status_load) {
 			goto exit;
 		}
@@ -457,7 +930,9 @@ int component_start (struct tip_firmware_image	*fw,
 
 	serial_printf ("==== LOAD %s ====" NEWLINE, image_firmware_get_fw_name (img_type));
 
+	BOOT_TRACE_Begin (BOOT_TRACE_IMAGE_COPY, img_type);
 	status_load = firmware_image_load_func (fw, (uint32_t) fw->header->header_flash);
+	BOOT_TRACE_End (BOOT_TRACE_IMAGE_COPY, img_type);
 
 	if (status_load != 0) {
 		goto exit;
@@ -470,6 +945,271 @@ exit:
 	while(1);
 }
 
+#ifdef BOOTBLOCK_MULTICORE_LOAD
+extern unsigned int GetCPUID (void);
+
+/**
+ * Multi-core load: cores 1-3 are parked in el3_secondary and take the copy job of their mailbox slot
+ * through CORE_JOB_Dispatch (core_job.c). Core 1 copies BL31, core 2 OPTEE and core 3 UBOOT. A large
+ * UBOOT is split in two stripes, the second one is copied by the primary core.
+ */
+#define IMAGE_MP_CORES			CORE_JOB_CORES
+#define IMAGE_MP_STRIPE_MIN		_1MB_
+#define IMAGE_MP_TIMEOUT_US		(10 * 1000 * 1000)
+
+#define IMAGE_MP_BENCH_SIZE		_8MB_
+#define IMAGE_MP_BENCH_DST		0x10000000
+
+/**
+ * Mailbox slot per core, in RAM2. The primary writes the job before the dispatch, the worker writes the
+ * result before CORE_JOB_Done: every field has a single writer at a time, so no lock is needed.
+ */
+typedef struct {
+	uint32_t			dst_addr;
+	uint32_t			src_addr;
+	uint32_t			size;
+	_Bool				crc_on;
+	volatile uint32_t	copied;
+	volatile uint32_t	crc;
+} IMAGE_JOB_T;
+
+static IMAGE_JOB_T image_jobs[IMAGE_MP_CORES];
+
+/**
+ *  @function   image_mp_worker
+ *
+ *  @details     runs on a secondary core, called from the el3_secondary wait loop. Returns to the
+ *               wait loop.
+ */
+static void image_mp_worker (void)
+{
+	uint32_t	 cpu = GetCPUID ();
+	IMAGE_JOB_T	*job = &image_jobs[cpu];
+	uint32_t	 crc = 0;
+
+	CORE_JOB_Ack (cpu);
+
+	job->copied = image_copy (job->dst_addr, job->src_addr, job->size, false, job->crc_on ? &crc : NULL);
+	job->crc = crc;
+
+	CORE_JOB_Done (cpu);
+}
+
+/**
+ *  @function   image_mp_dispatch
+ *
+ *  @param [in]  cpu       - secondary core (1-3)
+ *  @param [in]  dst_addr  - destination address
+ *  @param [in]  src_addr  - flash address
+ *  @param [in]  size      - bytes to copy
+ *  @param [in]  crc_on    - calculate the CRC32 of the copy (from IMAGE_CRC_START_OFFSET)
+ */
+static void image_mp_dispatch (uint32_t cpu, uint32_t dst_addr, uint32_t src_addr, uint32_t size, _Bool crc_on)
+{
+	IMAGE_JOB_T *job = &image_jobs[cpu];
+
+	job->dst_addr = dst_addr;
+	job->src_addr = src_addr;
+	job->size = size;
+	job->crc_on = crc_on;
+	job->copied = 0;
+	job->crc = 0;
+
+	CORE_JOB_Dispatch (cpu, image_mp_worker, 0);
+}
+
+/**
+ *  @function   image_mp_wait
+ *
+ *  @param [in]  cpu       - secondary core (1-3)
+ *  @return      0 when the job is done
+ *  @details     a core that does not take its job in CORE_JOB_ACK_US is taken as absent: the job is taken
+ *               back and the primary core copies it, the result is checked by the caller as for a job done
+ *               by the secondary core. A core that took its job and did not finish it in IMAGE_MP_TIMEOUT_US
+ *               may still write the copy and its mailbox slot, and would miss its BL31 wake up: error.
+ */
+static int image_mp_wait (uint32_t cpu)
+{
+	IMAGE_JOB_T	*job = &image_jobs[cpu];
+	uint32_t	 crc = 0;
+	DEFS_STATUS	 status;
+
+	status = CORE_JOB_Wait (cpu, CORE_JOB_ACK_US, IMAGE_MP_TIMEOUT_US);
+	if (status == DEFS_STATUS_NO_CONNECTION) {
+		serial_printf (KYEL "core %d does not answer, the primary core copies its image" NEWLINE KNRM, cpu);
+
+		job->copied = image_copy (job->dst_addr, job->src_addr, job->size, false, job->crc_on ? &crc : NULL);
+		job->crc = crc;
+	} else if (status != DEFS_STATUS_OK) {
+		serial_printf (KRED "core %d did not finish its copy" NEWLINE KNRM, cpu);
+		return -1;
+	}
+
+	return 0;
+}
+
+#ifdef BOOTBLOCK_MULTICORE_BENCH
+static uint64_t image_mp_time_us (void)
+{
+	UINT32 time_quad[2] __attribute__ ((aligned (8)));
+
+	CLK_GetTimeStamp (time_quad);
+
+	return (uint64_t) time_quad[1] * 1000000 + time_quad[0] / 25;
+}
+
+/**
+ *  @function   image_mp_benchmark
+ *
+ *  @details     copy IMAGE_MP_BENCH_SIZE bytes of SPI0CS0 to DRAM split over 1 to 4 cores and print the
+ *               aggregate throughput. Shows if the FIU / AXI path gains from more than one reader.
+ */
+static void image_mp_benchmark (void)
+{
+	uint32_t cores;
+	uint32_t cpu;
+	uint32_t stripe;
+	uint64_t t0;
+	uint64_t us;
+
+	for (cores = 1; cores <= IMAGE_MP_CORES; cores++) {
+		stripe = (IMAGE_MP_BENCH_SIZE / cores) & ~63;
+
+		t0 = image_mp_time_us ();
+		for (cpu = 1; cpu < cores; cpu++) {
+			image_mp_dispatch (cpu, IMAGE_MP_BENCH_DST + cpu * stripe, SPI0CS0_BASE_ADDR + cpu * stripe,
+							   stripe, false);
+		}
+		image_copy (IMAGE_MP_BENCH_DST, SPI0CS0_BASE_ADDR, stripe, false, NULL);
+		for (cpu = 1; cpu < cores; cpu++) {
+			image_mp_wait (cpu);
+		}
+		us = MAX (image_mp_time_us () - t0, 1);
+
+		serial_printf ("bench: %d cores %d KB in %d us: %d KB/s" NEWLINE, cores, (stripe * cores) / _1KB_,
+						 (uint32_t) us, (uint32_t) (((uint64_t) stripe * cores * 1000000 / _1KB_) / us));
+	}
+}
+#endif
+
+/**
+ *  @function   image_mp_load
+ *
+ *  @param [out] addr64     - BL31 entry point
+ *  @return      0 if all the images were loaded
+ *  @details     find and check BL31, OPTEE and UBOOT on the primary core, then copy (and verify) them
+ *               on the secondary cores in parallel.
+ */
+static int image_mp_load (uint64_t *addr64)
+{
+	struct tip_firmware_image  fw[IMAGE_MP_CORES - 1];
+	struct tip_firmware_header tip_header[IMAGE_MP_CORES - 1];
+	uint32_t				   src_addr[IMAGE_MP_CORES - 1];
+	uint32_t				   dst_addr[IMAGE_MP_CORES - 1];
+	uint32_t				   size[IMAGE_MP_CORES - 1];
+	uint32_t				   len[IMAGE_MP_CORES - 1];
+	uint32_t				   img_type;
+	uint32_t				   i;
+	uint32_t				   r_burst;
+	uint32_t				   copied = 0;
+	int						   start_offset = 0;
+	int						   status = 0;
+#ifdef BOOTBLOCK_IMAGE_CRC
+	const _Bool				   crc_on = true;
+	uint32_t				   crc;
+#else
+	const _Bool				   crc_on = false;
+#endif
+
+	for (i = 0, img_type = IMG_BL31; img_type <= IMG_UBOOT; i++, img_type <<= 1) {
+		fw[i].header = &tip_header[i];
+		fw[i].header->header_ram = 0;
+		fw[i].img_type = (IMG_TYPE_E) img_type;
+		fw[i].offset_minimum = start_offset;
+		fw[i].size = 0;
+
+		BOOT_TRACE_Begin (BOOT_TRACE_IMAGE_SCAN, img_type);
+		status = firmware_image_scan_flash (&fw[i]);
+		BOOT_TRACE_End (BOOT_TRACE_IMAGE_SCAN, img_type);
+		if (status == 0) {
+			status = firmware_image_check (&fw[i], &src_addr[i], &dst_addr[i], &size[i]);
+		}
+		if (status != 0) {
+			serial_printf (KRED "\n%s not started\n\n" NEWLINE KNRM, image_firmware_get_fw_name ((IMG_TYPE_E) img_type));
+			return FIRMWARE_IMAGE_LOAD_FAILED;
+		}
+
+		start_offset = fw[i].offset_minimum + ROUND_UP (fw[i].size, 0x1000);
+		len[i] = size[i];
+
+		serial_printf (KMAG "bootblock: core %d copies fw %#010lx size %#010lx to %#010lx" NEWLINE KNRM,
+						 i + 1, src_addr[i], size[i], dst_addr[i]);
+	}
+
+	/* UBOOT stripes: core 3 copies [0, len), the primary [len, size) */
+	if (size[2] >= IMAGE_MP_STRIPE_MIN) {
+		len[2] = (size[2] / 2) & ~(IMAGE_COPY_CHUNK - 1);
+	}
+
+#ifdef BOOTBLOCK_CACHED_BOOT
+	/* secondary cores run with the MMU off: the mailbox and DRAM must not be cached from here */
+	MMU_Disable ();
+#endif
+
+	r_burst = image_fiu_burst_set (true);
+
+#ifdef BOOTBLOCK_MULTICORE_BENCH
+	image_mp_benchmark ();
+#endif
+
+	BOOT_TRACE_Begin (BOOT_TRACE_IMAGE_COPY, 0);
+
+	for (i = 0; i < IMAGE_MP_CORES - 1; i++) {
+		image_mp_dispatch (i + 1, dst_addr[i], src_addr[i], len[i], crc_on && (len[i] == size[i]));
+	}
+
+	if (len[2] < size[2]) {
+		copied = image_copy (dst_addr[2] + len[2], src_addr[2] + len[2], size[2] - len[2], false, NULL);
+	}
+
+	for (i = 0; i < IMAGE_MP_CORES - 1; i++) {
+		status |= image_mp_wait (i + 1);
+	}
+
+	image_fiu_burst_restore (r_burst);
+	BOOT_TRACE_End (BOOT_TRACE_IMAGE_COPY, 0);
+
+	if (status != 0) {
+		return FIRMWARE_IMAGE_LOAD_FAILED;
+	}
+
+	for (i = 0; i < IMAGE_MP_CORES - 1; i++) {
+		if ((image_jobs[i + 1].copied != len[i]) || ((i == 2) && (copied != size[2] - len[2]))) {
+			serial_printf (KRED "%s copy failed" NEWLINE KNRM, image_firmware_get_fw_name (fw[i].img_type));
+			return FIRMWARE_IMAGE_LOAD_FAILED;
+		}
+
+#ifdef BOOTBLOCK_IMAGE_CRC
+		crc = image_jobs[i + 1].crc;
+		if (len[i] != size[i]) {
+			/* striped: one pass on the copy in DRAM */
+			crc = ~Crc32Update (0xFFFFFFFF, (const void *) (uintptr_t) (dst_addr[i] + IMAGE_CRC_START_OFFSET),
+								size[i] - IMAGE_CRC_START_OFFSET);
+		}
+
+		status = firmware_image_crc_check (&fw[i], crc);
+		if (status != 0) {
+			return status;
+		}
+#endif
+	}
+
+	*addr64 = tip_header[0].header_ram->header.destAddr + sizeof (HEADER_GENERAL_T);
+
+	return 0;
+}
+#endif
+
 int bmc_firmware_init (uint64_t *addr64)
 {
 	struct tip_firmware_image  fw;
@@ -477,10 +1217,14 @@ int bmc_firmware_init (uint64_t *addr64)
 	uint32_t				   img_type;
 	int start_offset = 0;
 	/* status per image */
-	int status[4];
+	int status[4] = { 0 };
 	int i = 0;
 	
 	update_reset_indication();
+
+#ifdef BOOTBLOCK_MULTICORE_LOAD
+	return image_mp_load (addr64);
+#endif
 	
 	/*
 	 * Iterate on the BMC images ( bl31, optee, uboot)
@@ -53,6 +53,36 @@ typedef union HEADER_GENERAL_tag
 #pragma pack(pop)
 
 
+/**
+ * Image directory: optional table in flash, pointed by the bootblock header field
+ * img_dir_offset. Lists the location of every image so no scan is needed.
+ * The table must be inside the bootblock code (up to codeSize), so it is covered by the
+ * bootblock signature that the ROM checks. The CRC only catches a corrupt table.
+ */
+#define IMAGE_DIR_VERSION           1
+#define IMAGE_DIR_MAX_ENTRIES       16
+
+#pragma pack(push, 1)
+typedef struct IMAGE_DIR_ENTRY_tag
+{
+	uint8_t   tag[8];                        /* start tag of the image                                   */
+	uint32_t  offset;                        /* image (header) offset in the flash                       */
+	uint32_t  size;                          /* header + code size                                       */
+	uint32_t  destAddr;                      /* load address, as in the image header                     */
+	uint32_t  reserved;
+} IMAGE_DIR_ENTRY_T;
+
+typedef struct IMAGE_DIR_tag
+{
+	uint8_t   startTag[8];                   /* image_dir_tag                                            */
+	uint16_t  version;                       /* IMAGE_DIR_VERSION                                        */
+	uint16_t  count;                         /* number of valid entries                                  */
+	uint32_t  crc;                           /* CRC32 (IEEE) of entry[0..count-1]                        */
+	IMAGE_DIR_ENTRY_T entry[IMAGE_DIR_MAX_ENTRIES];
+} IMAGE_DIR_T;
+#pragma pack(pop)
+
+
 /**
  * TIP FW image type
  */
@@ -99,6 +129,11 @@ struct tip_firmware_image
 
 int bmc_firmware_init (uint64_t *addr64);
 
+/**
+ * img_crc (BOOTBLOCK_IMAGE_CRC): CRC32 (IEEE, as crc_tip.log) from the signed area to the end of the code
+ */
+#define IMAGE_CRC_START_OFFSET  0x70
+
 #define COMPARE_START_TAG(a, b) \
 	((*(uint32_t *) a == *(uint32_t *) b) && (*((uint32_t *) a + 1) == *((uint32_t *) b + 1)))
 
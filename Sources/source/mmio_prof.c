@@ -0,0 +1,383 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mmio_prof.c                                                              */
+/*            This file contains the register access profiler                 */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+#ifdef BOOTBLOCK_MMIO_PROFILE
+#include <stdint.h>
+#include <string.h>
+#include "hal.h"
+#include "../SWC_HAL/hal_regs.h"
+#include "mmio_prof.h"
+#include "apps/serial_printf/serial_printf.h"
+
+#ifdef BOOTBLOCK_SIM
+extern UINT64 sim_time_ns;
+#endif
+
+MMIO_PROF_T mmio_prof;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* PMU cycle counter control (PMCR_EL0, PMCNTENSET_EL0 / PMCNTENCLR_EL0)                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+#define MMIO_PROF_PMCR_E                MASK_BIT(0)     /* enable the counters                             */
+#define MMIO_PROF_PMCR_C                MASK_BIT(2)     /* reset the cycle counter                         */
+#define MMIO_PROF_PMCR_DP               MASK_BIT(5)     /* stop the cycle counter where events are not     */
+#define MMIO_PROF_PMCR_LC               MASK_BIT(6)     /* 64 bits cycle counter overflow                  */
+#define MMIO_PROF_PMCNTEN_C             MASK_BIT(31)    /* cycle counter enable                            */
+
+static BOOLEAN mmio_prof_started = FALSE;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        mmio_prof_ticks                                                                        */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         CPU cycle counter (virtual time in ns in the host simulation)                          */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  The ISB keeps the counter read in order with the register access. PMCCNTR_EL0 counts   */
+/*                  CPU cycles: a register access is a few hundred ns, a few ticks of the 25MHz generic    */
+/*                  counter                                                                                */
+/*---------------------------------------------------------------------------------------------------------*/
+static inline UINT64 mmio_prof_ticks (void)
+{
+#ifdef BOOTBLOCK_SIM
+	return sim_time_ns;
+#else
+	UINT64 cnt;
+
+	__asm__ __volatile__ ("isb\n\tmrs %0, pmccntr_el0" : "=r" (cnt) : : "memory");
+
+	return cnt;
+#endif
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        mmio_prof_start                                                                        */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:    the PMU of the primary core counts cycles                                              */
+/* Description:                                                                                            */
+/*                  Reset and enable the cycle counter, on the first register access. PMCCFILTR_EL0 = 0    */
+/*                  counts in all the exception levels, EL3 included, and PMCR_EL0.DP = 0 keeps it         */
+/*                  counting in Secure state                                                               */
+/*---------------------------------------------------------------------------------------------------------*/
+static void mmio_prof_start (void)
+{
+#ifndef BOOTBLOCK_SIM
+	UINT64 pmcr;
+
+	__asm__ __volatile__ ("mrs %0, pmcr_el0" : "=r" (pmcr));
+	pmcr = (pmcr & ~(UINT64)MMIO_PROF_PMCR_DP) | MMIO_PROF_PMCR_E | MMIO_PROF_PMCR_C | MMIO_PROF_PMCR_LC;
+	__asm__ __volatile__ ("msr pmccfiltr_el0, %0" : : "r" (0UL));
+	__asm__ __volatile__ ("msr pmcr_el0, %0" : : "r" (pmcr));
+	__asm__ __volatile__ ("msr pmcntenset_el0, %0\n\tisb" : : "r" ((UINT64)MMIO_PROF_PMCNTEN_C) : "memory");
+#endif
+
+	mmio_prof_started = TRUE;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        mmio_prof_counting                                                                     */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         TRUE if the access is counted: primary core, before the report                         */
+/*---------------------------------------------------------------------------------------------------------*/
+static inline BOOLEAN mmio_prof_counting (void)
+{
+#ifndef BOOTBLOCK_SIM
+	UINT64 mpidr;
+
+	__asm__ __volatile__ ("mrs %0, mpidr_el1" : "=r" (mpidr));
+	if (mpidr & 0xFF)
+		return FALSE;
+#endif
+
+	return (mmio_prof.stopped == 0);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        mmio_prof_entry                                                                        */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  table   - reg or site table of mmio_prof                                               */
+/*                  size    - entries in the table, power of 2                                             */
+/*                  key     - register address or call site                                                */
+/*                  evicted - accesses of replaced entries                                                 */
+/* Returns:         entry of the key                                                                       */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Open addressing, linear probing of MMIO_PROF_PROBES entries. If the key is not there   */
+/*                  and there is no free entry, the probed entry with the least ticks is replaced          */
+/*---------------------------------------------------------------------------------------------------------*/
+static MMIO_PROF_ENTRY_T *mmio_prof_entry (MMIO_PROF_ENTRY_T *table, UINT32 size, UINT64 key, UINT32 *evicted)
+{
+	UINT32             i = (UINT32)(((key >> 2) * 0x9E3779B97F4A7C15ULL) >> 32) & (size - 1);
+	MMIO_PROF_ENTRY_T *victim = &table[i];
+	UINT32             n;
+
+	for (n = 0; n < MMIO_PROF_PROBES; n++)
+	{
+		if (table[i].key == key)
+			return &table[i];
+
+		if (table[i].key == 0)
+		{
+			table[i].key = key;
+			return &table[i];
+		}
+
+		if (table[i].ticks < victim->ticks)
+			victim = &table[i];
+
+		i = (i + 1) & (size - 1);
+	}
+
+	*evicted += victim->reads + victim->writes;
+	victim->key = key;
+	victim->reads = 0;
+	victim->writes = 0;
+	victim->ticks = 0;
+
+	return victim;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        mmio_prof_add                                                                          */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  addr  - register address                                                               */
+/*                  site  - return address of MMIO_PROF_Read / MMIO_PROF_Write                             */
+/*                  write - TRUE for a write                                                               */
+/*                  ticks - duration of the access                                                         */
+/* Returns:         none                                                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static void mmio_prof_add (UINT64 addr, UINT64 site, BOOLEAN write, UINT64 ticks)
+{
+	MMIO_PROF_ENTRY_T *entry[2];
+	UINT32             i;
+
+	entry[0] = mmio_prof_entry(mmio_prof.reg, MMIO_PROF_REGS, addr, &mmio_prof.evicted[0]);
+	entry[1] = mmio_prof_entry(mmio_prof.site, MMIO_PROF_SITES, site, &mmio_prof.evicted[1]);
+
+	for (i = 0; i < 2; i++)
+	{
+		if (write)
+			entry[i]->writes++;
+		else
+			entry[i]->reads++;
+		entry[i]->ticks += ticks;
+	}
+
+	if (write)
+		mmio_prof.writes++;
+	else
+		mmio_prof.reads++;
+	mmio_prof.ticks += ticks;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MMIO_PROF_Read                                                                         */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  addr - register address                                                                */
+/*                  size - register size in bits                                                           */
+/* Returns:         register value                                                                         */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  REG_READ with BOOTBLOCK_MMIO_PROFILE                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+UINT64 __attribute__((noinline)) MMIO_PROF_Read (UINT64 addr, UINT32 size)
+{
+	UINT64 site = (UINT64)(uintptr_t)__builtin_extract_return_addr(__builtin_return_address(0));
+	UINT64 start;
+	UINT64 val;
+
+	if ((mmio_prof_started == FALSE) && mmio_prof_counting())
+		mmio_prof_start();
+
+	start = mmio_prof_ticks();
+
+	switch (size)
+	{
+		case 8:  val = MEMR8(addr);  break;
+		case 16: val = MEMR16(addr); break;
+		case 64: val = MEMR64(addr); break;
+		default: val = MEMR32(addr); break;
+	}
+
+	if (mmio_prof_counting())
+	{
+		if (mmio_prof.first == 0)
+			mmio_prof.first = start;
+		mmio_prof_add(addr, site, FALSE, mmio_prof_ticks() - start);
+	}
+
+	return val;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MMIO_PROF_Write                                                                        */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  addr - register address                                                                */
+/*                  size - register size in bits                                                           */
+/*                  val  - value to write                                                                  */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  REG_WRITE with BOOTBLOCK_MMIO_PROFILE. Writes are posted: the time is the issue time,  */
+/*                  a slow write shows up in the next read of the same bus                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+void __attribute__((noinline)) MMIO_PROF_Write (UINT64 addr, UINT32 size, UINT64 val)
+{
+	UINT64 site = (UINT64)(uintptr_t)__builtin_extract_return_addr(__builtin_return_address(0));
+	UINT64 start;
+
+	if ((mmio_prof_started == FALSE) && mmio_prof_counting())
+		mmio_prof_start();
+
+	start = mmio_prof_ticks();
+
+	switch (size)
+	{
+		case 8:  MEMW8(addr, val);  break;
+		case 16: MEMW16(addr, val); break;
+		case 64: MEMW64(addr, val); break;
+		default: MEMW32(addr, val); break;
+	}
+
+	if (mmio_prof_counting())
+	{
+		if (mmio_prof.first == 0)
+			mmio_prof.first = start;
+		mmio_prof_add(addr, site, TRUE, mmio_prof_ticks() - start);
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        mmio_prof_sort                                                                         */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  table - reg or site table of mmio_prof                                                 */
+/*                  size  - entries in the table                                                           */
+/* Returns:         used entries                                                                           */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Move the used entries to the start of the table, most ticks first. The table can not   */
+/*                  be searched by key after this                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 mmio_prof_sort (MMIO_PROF_ENTRY_T *table, UINT32 size)
+{
+	MMIO_PROF_ENTRY_T tmp;
+	UINT32            used = 0;
+	UINT32            i, j;
+
+	for (i = 0; i < size; i++)
+	{
+		if (table[i].key == 0)
+			continue;
+
+		tmp = table[i];
+		table[i].key = 0;
+
+		for (j = used; (j > 0) && (table[j - 1].ticks < tmp.ticks); j--)
+			table[j] = table[j - 1];
+		table[j] = tmp;
+		used++;
+	}
+
+	for (i = used; i < size; i++)
+		memset(&table[i], 0, sizeof(table[i]));
+
+	return used;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        mmio_prof_print                                                                        */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  title - column title of the key                                                        */
+/*                  table - sorted reg or site table                                                       */
+/*                  used  - used entries                                                                   */
+/*                  top   - entries to print                                                               */
+/*                  total - ticks of all the accesses                                                      */
+/* Returns:         none                                                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static void mmio_prof_print (const char *title, const MMIO_PROF_ENTRY_T *table, UINT32 used, UINT32 top,
+			     UINT64 total)
+{
+	UINT64 permille;
+	UINT32 i;
+
+	serial_printf("  %%time        us     reads    writes  %s\n", title);
+
+	for (i = 0; (i < used) && (i < top); i++)
+	{
+		permille = (total != 0) ? ((table[i].ticks * 1000) / total) : 0;
+
+		serial_printf("  %3lu.%lu%% %9lu %9u %9u  %#010lx\n", (unsigned long)(permille / 10),
+			      (unsigned long)(permille % 10),
+			      (unsigned long)((table[i].ticks * 1000000) / mmio_prof.freq),
+			      table[i].reads, table[i].writes, (unsigned long)table[i].key);
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MMIO_PROF_Report                                                                       */
+/*                                                                                                         */
+/* Parameters:      top - registers and call sites to print                                                */
+/* Returns:         none                                                                                   */
+/* Side effects:    counting stops, the tables are sorted                                                  */
+/* Description:                                                                                            */
+/*                  Print the registers and the call sites with the most access time. The cycles are       */
+/*                  turned to usec at the CPU clock of the report, so the accesses made before             */
+/*                  bootblock_ChangeClocks (boot clock) are scaled by the clock ratio. Call sites are      */
+/*                  return addresses: resolve with tools/mmio_prof.py, or addr2line after subtracting      */
+/*                  (ref - address of MMIO_PROF_Report in the ELF)                                         */
+/*---------------------------------------------------------------------------------------------------------*/
+void MMIO_PROF_Report (UINT32 top)
+{
+	UINT32 regs, sites;
+
+	if (mmio_prof.stopped)
+	{
+		return;
+	}
+
+	mmio_prof.last = mmio_prof_ticks();
+	mmio_prof.stopped = 1;
+
+#ifdef BOOTBLOCK_SIM
+	mmio_prof.freq = 1000000000;
+#else
+	__asm__ __volatile__ ("msr pmcntenclr_el0, %0" : : "r" ((UINT64)MMIO_PROF_PMCNTEN_C));
+	mmio_prof.freq = CLK_GetCPUFreq();
+#endif
+	mmio_prof.ref = (UINT64)(uintptr_t)&MMIO_PROF_Report;
+
+	regs = mmio_prof_sort(mmio_prof.reg, MMIO_PROF_REGS);
+	sites = mmio_prof_sort(mmio_prof.site, MMIO_PROF_SITES);
+	mmio_prof.magic = MMIO_PROF_MAGIC;
+
+	serial_printf(KCYN "\nmmio profile at %#010lx: %u reads, %u writes, ref %#lx\n" KNRM,
+		      (unsigned long)(uintptr_t)&mmio_prof, mmio_prof.reads, mmio_prof.writes, (unsigned long)mmio_prof.ref);
+	serial_printf("  %lu us in register accesses, of %lu us (%lu Hz). Replaced entries: %u / %u accesses\n",
+		      (unsigned long)((mmio_prof.ticks * 1000000) / mmio_prof.freq),
+		      (unsigned long)(((mmio_prof.last - mmio_prof.first) * 1000000) / mmio_prof.freq),
+		      (unsigned long)mmio_prof.freq, mmio_prof.evicted[0], mmio_prof.evicted[1]);
+
+	mmio_prof_print("register", mmio_prof.reg, regs, top, mmio_prof.ticks);
+	mmio_prof_print("call site", mmio_prof.site, sites, top, mmio_prof.ticks);
+}
+
+#endif // BOOTBLOCK_MMIO_PROFILE
@@ -0,0 +1,86 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mmio_prof.h                                                              */
+/*            This file contains API of the register access profiler          */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+
+#ifndef _MMIO_PROF_H_
+#define _MMIO_PROF_H_
+
+#ifdef BOOTBLOCK_MMIO_PROFILE
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* REG_READ / REG_WRITE (defs_access.h) call MMIO_PROF_Read / MMIO_PROF_Write, which count the accesses    */
+/* per register address and per call site and add the CPU cycles (PMCCNTR_EL0) of the access.              */
+/* Table sizes are powers of 2. The MC init alone has more than a thousand call sites: a new key that      */
+/* finds no free entry in MMIO_PROF_PROBES entries replaces the one with the least ticks, so the tables    */
+/* keep the hot registers and call sites                                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef MMIO_PROF_REGS
+#define MMIO_PROF_REGS                  256
+#endif
+
+#ifndef MMIO_PROF_SITES
+#define MMIO_PROF_SITES                 512
+#endif
+
+#ifndef MMIO_PROF_PROBES
+#define MMIO_PROF_PROBES                8
+#endif
+
+#ifndef MMIO_PROF_TOP
+#define MMIO_PROF_TOP                   16
+#endif
+
+#define MMIO_PROF_MAGIC                 0x464F5250      /* "PROF" */
+
+typedef struct MMIO_PROF_ENTRY_tag
+{
+	UINT64  key;                    /* register address or call site (return address), 0 if free      */
+	UINT32  reads;
+	UINT32  writes;
+	UINT64  ticks;                  /* CPU cycles spent in the accesses                                */
+} MMIO_PROF_ENTRY_T;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* After MMIO_PROF_Report the tables are sorted, most ticks first, and magic is set: a RAM dump of         */
+/* mmio_prof (JTAG, or BL31 / U-Boot before RAM2 is reused) holds the full report                          */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct MMIO_PROF_tag
+{
+	UINT32              magic;      /* MMIO_PROF_MAGIC once the tables are sorted                      */
+	UINT32              stopped;    /* no more counting                                                */
+	UINT64              freq;       /* ticks per second: CPU clock of the report                       */
+	UINT64              first;      /* tick of the first access                                        */
+	UINT64              last;       /* tick of the report                                              */
+	UINT64              ref;        /* run time address of MMIO_PROF_Report, to relocate the sites    */
+	UINT64              ticks;      /* all the accesses                                                */
+	UINT32              reads;
+	UINT32              writes;
+	UINT32              evicted[2]; /* accesses of the replaced reg / site entries                     */
+	MMIO_PROF_ENTRY_T   reg[MMIO_PROF_REGS];
+	MMIO_PROF_ENTRY_T   site[MMIO_PROF_SITES];
+} MMIO_PROF_T;
+
+extern MMIO_PROF_T mmio_prof;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Register access profiler exported functions                                                             */
+/*---------------------------------------------------------------------------------------------------------*/
+void MMIO_PROF_Report (UINT32 top);
+
+#else
+
+#define MMIO_PROF_Report(top)           (void)0
+
+#endif // BOOTBLOCK_MMIO_PROFILE
+
+#endif /* _MMIO_PROF_H_ */
@@ -0,0 +1,313 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mmu.c                                                                    */
+/* This file contains the EL3 translation tables for the cached boot mode     */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+#ifdef BOOTBLOCK_CACHED_BOOT
+#include "hal.h"
+#include "../SWC_HAL/hal_regs.h"
+#include "boot.h"
+#include "v8_mmu.h"
+#include "mmu.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Assembly helpers (v8_aarch64.S)                                                                         */
+/*---------------------------------------------------------------------------------------------------------*/
+extern void EnableMMUEL3 (void *ttbr0);
+extern void DisableMMUEL3 (void);
+extern void InvalidateTLBEL3 (void);
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Descriptor attributes. EL3 regime has a single VA range: AP[1] is RES1, bit 54 is XN                     */
+/*---------------------------------------------------------------------------------------------------------*/
+#define MMU_XN                  (1ULL << 54)
+#define MMU_ADDR_MASK           0x0000FFFFFFFFF000ULL
+
+#define MMU_ATTR_NORMAL_RW      (TT_S1_ATTR_AF | TT_S1_ATTR_SH_INNER | TT_S1_ATTR_AP_RW_ANY | \
+                                 (MMU_MAIR_NORMAL_WB << TT_S1_ATTR_MATTR_LSB))
+#define MMU_ATTR_NORMAL_RO      (TT_S1_ATTR_AF | TT_S1_ATTR_SH_INNER | TT_S1_ATTR_AP_RO_ANY | \
+                                 (MMU_MAIR_NORMAL_WB << TT_S1_ATTR_MATTR_LSB))
+#define MMU_ATTR_DEVICE         (TT_S1_ATTR_AF | TT_S1_ATTR_AP_RW_ANY | MMU_XN | \
+                                 (MMU_MAIR_DEVICE_nGnRE << TT_S1_ATTR_MATTR_LSB))
+
+#define MMU_FLASH_BASE_ADDR     0x80000000ULL
+#define MMU_IO_BASE_ADDR        0xC0000000ULL
+#define MMU_TOP_BASE_ADDR       0xFFE00000ULL
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Memory regions that are mapped as Normal memory. Everything else in 0xC0000000-0xFFFFFFFF is Device,    */
+/* holes in the flash windows are left unmapped                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct MMU_REGION_T_tag
+{
+	UINT64  base;
+	UINT64  size;
+	UINT64  attr;
+} MMU_REGION_T;
+
+static const MMU_REGION_T mmu_flash_regions[] =
+{
+	{ SPI0CS0_BASE_ADDR, SPI0CS0_SIZE + SPI0CS1_SIZE,                             MMU_ATTR_NORMAL_RO },
+	{ SPI1CS0_BASE_ADDR, SPI1CS0_SIZE + SPI1CS1_SIZE + SPI1CS2_SIZE + SPI1CS3_SIZE, MMU_ATTR_NORMAL_RO },
+	{ SPI3CS0_BASE_ADDR, SPI3CS0_SIZE + SPI3CS1_SIZE + SPI3CS2_SIZE + SPI3CS3_SIZE, MMU_ATTR_NORMAL_RO },
+};
+
+static const MMU_REGION_T mmu_io_regions[] =
+{
+	{ SPIXCS0_BASE_ADDR, SPIXCS0_SIZE + SPIXCS1_SIZE,                             MMU_ATTR_NORMAL_RO },
+};
+
+static const MMU_REGION_T mmu_top_regions[] =
+{
+	{ 0xFFF40000,        _128KB_,                                                  MMU_ATTR_NORMAL_RO },   /* ROMa, ROMb       */
+	{ RAM2_BASE_ADDR,    RAM2_MEMORY_SIZE,                                         MMU_ATTR_NORMAL_RW },   /* RAM2             */
+	{ ROM_BASE_ADDR,     ROM_MEMORY_SIZE,                                          MMU_ATTR_NORMAL_RO },   /* ROM and vectors  */
+};
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Translation tables. Section is NOLOAD, every entry is written by MMU_Init                                */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef struct MMU_TABLES_T_tag
+{
+	UINT64  l2_flash[MMU_TABLE_ENTRIES];    /* 0x80000000 - 0xBFFFFFFF, 2MB blocks          */
+	UINT64  l2_io[MMU_TABLE_ENTRIES];       /* 0xC0000000 - 0xFFFFFFFF, 2MB blocks          */
+	UINT64  l3_top[MMU_TABLE_ENTRIES];      /* 0xFFE00000 - 0xFFFFFFFF, 4KB pages           */
+	UINT64  l2_ddr[MMU_TABLE_ENTRIES];      /* last, partially populated, GB of DRAM        */
+	UINT64  l1[MMU_L1_ENTRIES];             /* 1GB entries, 36 bit VA                       */
+} MMU_TABLES_T;
+
+static MMU_TABLES_T mmu_tables __attribute__((section("ttb0_l1"), aligned(4096)));
+static BOOLEAN      mmu_enabled = FALSE;
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        mmu_fill                                                                               */
+/*                                                                                                         */
+/* Parameters:      table      - translation table                                                         */
+/*                  entries    - number of entries to fill                                                 */
+/*                  table_base - VA covered by entry 0                                                     */
+/*                  shift      - log2 of the size covered by one entry                                     */
+/*                  type       - block / page / fault                                                      */
+/*                  attr       - descriptor attributes                                                     */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Flat (VA == PA) fill of a whole table with the same attributes                         */
+/*---------------------------------------------------------------------------------------------------------*/
+static void mmu_fill (UINT64 *table, UINT32 entries, UINT64 table_base, UINT32 shift, UINT64 type, UINT64 attr)
+{
+	UINT32 i;
+
+	for (i = 0; i < entries; i++)
+	{
+		table[i] = (type == TT_S1_ATTR_FAULT) ? 0 : ((table_base + ((UINT64)i << shift)) | type | attr);
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        mmu_map_regions                                                                        */
+/*                                                                                                         */
+/* Parameters:      table      - translation table                                                         */
+/*                  table_base - VA covered by entry 0                                                     */
+/*                  shift      - log2 of the size covered by one entry                                     */
+/*                  type       - block / page                                                              */
+/*                  regions    - regions to map                                                            */
+/*                  num        - number of regions                                                         */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Flat map a list of regions into a table. Regions are aligned to the entry size         */
+/*---------------------------------------------------------------------------------------------------------*/
+static void mmu_map_regions (UINT64 *table, UINT64 table_base, UINT32 shift, UINT64 type,
+                             const MMU_REGION_T *regions, UINT32 num)
+{
+	UINT64 addr;
+	UINT32 i;
+
+	for (i = 0; i < num; i++)
+	{
+		for (addr = regions[i].base; addr < regions[i].base + regions[i].size; addr += (1ULL << shift))
+		{
+			table[(addr - table_base) >> shift] = addr | type | regions[i].attr;
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        mmu_table_desc                                                                         */
+/*                                                                                                         */
+/* Parameters:      table - next level table                                                               */
+/* Returns:         table descriptor                                                                       */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Build a table descriptor pointing to the next level                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 mmu_table_desc (UINT64 *table)
+{
+	return ((UINT64)table & MMU_ADDR_MASK) | TT_S1_ATTR_TABLE;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MMU_Init                                                                               */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:    MMU, I-cache and D-cache are enabled                                                   */
+/* Description:                                                                                            */
+/*                  Build the flat EL3 map and turn on the MMU:                                            */
+/*                  DRAM (0-2GB, 4GB-6GB)  - Device until trained, see MMU_MapDDR                          */
+/*                  Flash windows, SPIX    - Normal WB, read only                                          */
+/*                  RAM2, ROM              - Normal WB                                                     */
+/*                  MMIO, GIC, SHM, RAM3   - Device-nGnRE                                                  */
+/*---------------------------------------------------------------------------------------------------------*/
+void MMU_Init (void)
+{
+	MMU_TABLES_T *t = &mmu_tables;
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Level 1: DRAM is accessed as Device during training, same as with the MMU off                       */
+	/*-----------------------------------------------------------------------------------------------------*/
+	mmu_fill(t->l1, MMU_L1_ENTRIES, 0, MMU_L1_BLOCK_SHIFT, TT_S1_ATTR_FAULT, 0);
+	mmu_fill(&t->l1[0], 2, SDRAM_BASE_ADDR, MMU_L1_BLOCK_SHIFT, TT_S1_ATTR_BLOCK, MMU_ATTR_DEVICE);
+	mmu_fill(&t->l1[MMU_DDR_HIGH_BASE_ADDR >> MMU_L1_BLOCK_SHIFT], 2, MMU_DDR_HIGH_BASE_ADDR,
+	         MMU_L1_BLOCK_SHIFT, TT_S1_ATTR_BLOCK, MMU_ATTR_DEVICE);
+	t->l1[MMU_FLASH_BASE_ADDR >> MMU_L1_BLOCK_SHIFT] = mmu_table_desc(t->l2_flash);
+	t->l1[MMU_IO_BASE_ADDR >> MMU_L1_BLOCK_SHIFT]    = mmu_table_desc(t->l2_io);
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Level 2: flash windows                                                                              */
+	/*-----------------------------------------------------------------------------------------------------*/
+	mmu_fill(t->l2_flash, MMU_TABLE_ENTRIES, MMU_FLASH_BASE_ADDR, MMU_L2_BLOCK_SHIFT, TT_S1_ATTR_FAULT, 0);
+	mmu_map_regions(t->l2_flash, MMU_FLASH_BASE_ADDR, MMU_L2_BLOCK_SHIFT, TT_S1_ATTR_BLOCK,
+	                mmu_flash_regions, ARRAY_SIZE(mmu_flash_regions));
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Level 2: SHM, GIC, MMIO, SPIX. The last 2MB is split to pages                                       */
+	/*-----------------------------------------------------------------------------------------------------*/
+	mmu_fill(t->l2_io, MMU_TABLE_ENTRIES, MMU_IO_BASE_ADDR, MMU_L2_BLOCK_SHIFT, TT_S1_ATTR_BLOCK, MMU_ATTR_DEVICE);
+	mmu_map_regions(t->l2_io, MMU_IO_BASE_ADDR, MMU_L2_BLOCK_SHIFT, TT_S1_ATTR_BLOCK,
+	                mmu_io_regions, ARRAY_SIZE(mmu_io_regions));
+	t->l2_io[MMU_TABLE_ENTRIES - 1] = mmu_table_desc(t->l3_top);
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Level 3: APB19 (SMB, I2CXM, SHI) stays Device, ROM and RAM2 are Normal                              */
+	/*-----------------------------------------------------------------------------------------------------*/
+	mmu_fill(t->l3_top, MMU_TABLE_ENTRIES, MMU_TOP_BASE_ADDR, MMU_L3_PAGE_SHIFT, TT_S1_ATTR_PAGE, MMU_ATTR_DEVICE);
+	mmu_map_regions(t->l3_top, MMU_TOP_BASE_ADDR, MMU_L3_PAGE_SHIFT, TT_S1_ATTR_PAGE,
+	                mmu_top_regions, ARRAY_SIZE(mmu_top_regions));
+
+	EnableMMUEL3(t->l1);
+	mmu_enabled = TRUE;
+
+	serial_printf("MMU: cached boot, tables at %#010lx\n", (UINT32)(UINT64)t);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        mmu_map_ddr_range                                                                      */
+/*                                                                                                         */
+/* Parameters:      base - start of the range (1GB aligned)                                                */
+/*                  size - populated size                                                                  */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Map populated DRAM as Normal WB. Full GBs use level 1 blocks, a partial GB uses l2_ddr  */
+/*                  so speculative accesses never hit the unpopulated part                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static void mmu_map_ddr_range (UINT64 base, UINT64 size)
+{
+	MMU_TABLES_T *t = &mmu_tables;
+	UINT32 idx = base >> MMU_L1_BLOCK_SHIFT;
+	UINT32 blocks;
+
+	size &= ~((1ULL << MMU_L2_BLOCK_SHIFT) - 1);
+
+	while (size >= _1GB_)
+	{
+		t->l1[idx] = (base & MMU_ADDR_MASK) | TT_S1_ATTR_BLOCK | MMU_ATTR_NORMAL_RW;
+		base += _1GB_;
+		size -= _1GB_;
+		idx++;
+	}
+
+	if (size != 0)
+	{
+		blocks = size >> MMU_L2_BLOCK_SHIFT;
+		mmu_fill(t->l2_ddr, MMU_TABLE_ENTRIES, base, MMU_L2_BLOCK_SHIFT, TT_S1_ATTR_BLOCK, MMU_ATTR_DEVICE);
+		mmu_fill(t->l2_ddr, blocks, base, MMU_L2_BLOCK_SHIFT, TT_S1_ATTR_BLOCK, MMU_ATTR_NORMAL_RW);
+		t->l1[idx] = mmu_table_desc(t->l2_ddr);
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MMU_MapDDR                                                                             */
+/*                                                                                                         */
+/* Parameters:      size - DRAM active size (after ECC reduction)                                          */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  Called after DDR training passed. Remap DRAM as Normal WB (break before make)          */
+/*---------------------------------------------------------------------------------------------------------*/
+void MMU_MapDDR (UINT64 size)
+{
+	MMU_TABLES_T *t = &mmu_tables;
+	UINT64 low  = MIN(size, (UINT64)_2GB_);
+	UINT64 high = size - low;
+
+	if (size == 0)
+	{
+		return;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Only one partially populated GB can exist: low part is the whole 2GB whenever high part exists      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	t->l1[0] = 0;
+	t->l1[1] = 0;
+	t->l1[(MMU_DDR_HIGH_BASE_ADDR >> MMU_L1_BLOCK_SHIFT) + 0] = 0;
+	t->l1[(MMU_DDR_HIGH_BASE_ADDR >> MMU_L1_BLOCK_SHIFT) + 1] = 0;
+	InvalidateTLBEL3();
+
+	mmu_fill(&t->l1[0], 2, SDRAM_BASE_ADDR, MMU_L1_BLOCK_SHIFT, TT_S1_ATTR_BLOCK, MMU_ATTR_DEVICE);
+	mmu_fill(&t->l1[MMU_DDR_HIGH_BASE_ADDR >> MMU_L1_BLOCK_SHIFT], 2, MMU_DDR_HIGH_BASE_ADDR,
+	         MMU_L1_BLOCK_SHIFT, TT_S1_ATTR_BLOCK, MMU_ATTR_DEVICE);
+	mmu_map_ddr_range(SDRAM_BASE_ADDR, low);
+	if (high != 0)
+	{
+		mmu_map_ddr_range(MMU_DDR_HIGH_BASE_ADDR, high);
+	}
+	InvalidateTLBEL3();
+
+	serial_printf("MMU: DRAM %#010lx MB cached\n", (UINT32)(size / _1MB_));
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        MMU_Disable                                                                            */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:    MMU and caches are off                                                                 */
+/* Description:                                                                                            */
+/*                  Clean D-cache to PoC and turn off MMU and caches. Must be called before other cores    */
+/*                  or BL31 (both running with the MMU off) use the images copied to DRAM. Nothing to do   */
+/*                  if the MMU is already off (the multi-core load turns it off before the copy)           */
+/*---------------------------------------------------------------------------------------------------------*/
+void MMU_Disable (void)
+{
+	if (!mmu_enabled)
+	{
+		return;
+	}
+
+	DisableMMUEL3();
+	mmu_enabled = FALSE;
+}
+
+#endif // BOOTBLOCK_CACHED_BOOT
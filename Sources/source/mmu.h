@@ -0,0 +1,52 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mmu.h                                                                    */
+/*            This file contains API of the EL3 MMU and caches (cached boot)  */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+
+#ifndef _MMU_H_
+#define _MMU_H_
+
+#include "hal.h"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Memory attributes index in MAIR_EL3 (programmed in startup.S)                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+#define MMU_MAIR_NORMAL_NC              0
+#define MMU_MAIR_NORMAL_WB              1
+#define MMU_MAIR_DEVICE_nGnRE           2
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Translation tables geometry. TCR_EL3.T0SZ = 28: 36 bit VA, walk starts at level 1 (1GB entries)         */
+/*---------------------------------------------------------------------------------------------------------*/
+#define MMU_L1_ENTRIES                  64
+#define MMU_TABLE_ENTRIES               512
+
+#define MMU_L1_BLOCK_SHIFT              30
+#define MMU_L2_BLOCK_SHIFT              21
+#define MMU_L3_PAGE_SHIFT               12
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Upper DRAM (2GB-4GB of the device) is mapped through 4GB-6GB                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+#define MMU_DDR_HIGH_BASE_ADDR          0x100000000ULL
+
+
+#ifdef BOOTBLOCK_CACHED_BOOT
+/*---------------------------------------------------------------------------------------------------------*/
+/* MMU module exported functions                                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+void MMU_Init (void);
+void MMU_MapDDR (UINT64 size);
+void MMU_Disable (void);
+#endif
+
+#endif /* _MMU_H_ */
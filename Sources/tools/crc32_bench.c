@@ -0,0 +1,299 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   crc32_bench.c                                                            */
+/*            Check and benchmark of the image CRC32 kernel                   */
+/*            (Crc32Update, source/v8_utils.S or sim/sim_core.c)              */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+/*
+ * build and run (from Sources):
+ *   make -f makefile check, the binaries are Images/check/crc32_bench, built with BOOTBLOCK_SIM, and
+ *   Images/check/a64/crc32_bench, on an AArch64 Linux host or with aarch64-linux-gnu-gcc and qemu-aarch64
+ * BOOTBLOCK_SIM checks the C Crc32Update of the simulation (sim/sim_core.c), else the one of v8_utils.S is
+ * linked. The bootblock memcpy, memmove and memset of v8_utils.S are renamed so that they do not replace
+ * the ones of the host libc.
+ *
+ * usage: crc32_bench [iterations] [seed] [<image> <crc log>]...
+ *
+ * Crc32Update is checked against a bit by bit CRC32 (IEEE 802.3, reflected, as zlib and crc_tip.log) on
+ * random lengths and alignments, and an image CRC split in random chunks must match the CRC of the whole
+ * image. The CRC of each image file, whole and in 64KB chunks, must be the value of its log (a hex number,
+ * the released bootblock binaries with ../crc_tip.log and ../crc_no_tip.log). Then it is timed against a table driven CRC32, and the two ways to check a copied image are
+ * timed: a CRC pass over the whole image after the copy, and a CRC of each 64KB chunk right after it is
+ * copied, while it is still in the cache (image_memcpy with BOOTBLOCK_IMAGE_CRC).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "defs.h"
+#include "tool_check.h"
+
+#ifdef BOOTBLOCK_SIM
+UINT64 sim_time_ns;
+
+#include "../sim/sim_core.c"
+#else
+extern unsigned int Crc32Update (unsigned int crc, const void *bufPtr, unsigned long nBytes);
+#endif
+
+#define CRC_BENCH_CHUNK         _64KB_          /* IMAGE_CRC_CHUNK of image_memcpy  */
+#define CRC_BENCH_MAX_IMAGE     _32MB_
+#define CRC_BENCH_MAX_FUZZ      4096
+
+static UINT32 crc_table[256];
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        crc32_bitwise                                                                          */
+/*                                                                                                         */
+/* Parameters:      crc - running CRC, buf - data, size - number of bytes                                  */
+/* Returns:         updated CRC, no pre or post inversion (as Crc32Update)                                 */
+/* Description:                                                                                            */
+/*                  Reference: one bit at a time, polynomial 0xEDB88320                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 crc32_bitwise (UINT32 crc, const UINT8 *buf, UINT32 size)
+{
+	UINT32 bit;
+
+	while (size--)
+	{
+		crc ^= *buf++;
+		for (bit = 0; bit < 8; bit++)
+			crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+	}
+
+	return crc;
+}
+
+static UINT32 crc32_table (UINT32 crc, const void *buf, unsigned long size)
+{
+	const UINT8 *p = (const UINT8 *)buf;
+
+	while (size--)
+		crc = crc_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+
+	return crc;
+}
+
+static UINT32 fuzz (const UINT8 *buf, UINT32 iterations)
+{
+	UINT32 i, size, offset, split, start, crc, errors = 0;
+
+	for (i = 0; i < iterations; i++)
+	{
+		size = tool_rand() % CRC_BENCH_MAX_FUZZ;
+		offset = tool_rand() % 16;
+		split = size ? (tool_rand() % size) : 0;
+		start = tool_rand();
+
+		crc = crc32_bitwise(start, &buf[offset], size);
+		if ((Crc32Update(start, &buf[offset], size) != crc) ||
+		    (Crc32Update(Crc32Update(start, &buf[offset], split), &buf[offset + split], size - split) != crc))
+		{
+			TOOL_ERROR(errors, "Crc32Update: size %u offset %u split %u differs\n", size, offset, split);
+		}
+	}
+
+	return errors;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        check_image                                                                            */
+/*                                                                                                         */
+/* Parameters:      image - image file, crc_log - file with its CRC32, as crc_tip.log                      */
+/* Returns:         number of errors                                                                       */
+/* Description:                                                                                            */
+/*                  The CRC of the whole image and the CRC of its 64KB chunks (image_memcpy) must match    */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 check_image (const char *image, const char *crc_log)
+{
+	FILE   *file;
+	UINT8  *buf;
+	UINT32 size, done, len, expected, crc_whole, crc_chunked = 0xFFFFFFFF;
+	long   file_size;
+	int    found;
+
+	file = fopen(crc_log, "r");
+	found = (file != NULL) ? fscanf(file, "%x", &expected) : 0;
+	if (file != NULL)
+		fclose(file);
+	if (found != 1)
+	{
+		printf("%s: no CRC\n", crc_log);
+		return 1;
+	}
+
+	file = fopen(image, "rb");
+	if (file == NULL)
+	{
+		printf("%s: cannot open\n", image);
+		return 1;
+	}
+	fseek(file, 0, SEEK_END);
+	file_size = ftell(file);
+	rewind(file);
+	size = (file_size > 0) ? (UINT32)file_size : 0;
+	buf = malloc(MAX(size, 1));
+	if ((buf == NULL) || (fread(buf, 1, size, file) != size))
+	{
+		printf("%s: cannot read\n", image);
+		fclose(file);
+		free(buf);
+		return 1;
+	}
+	fclose(file);
+
+	crc_whole = ~Crc32Update(0xFFFFFFFF, buf, size);
+	for (done = 0; done < size; done += len)
+	{
+		len = MIN(CRC_BENCH_CHUNK, size - done);
+		crc_chunked = Crc32Update(crc_chunked, &buf[done], len);
+	}
+	crc_chunked = ~crc_chunked;
+	free(buf);
+
+	printf("%s: %u bytes, CRC %#010x, 64KB chunks %#010x, %s %#010x\n", image, size, crc_whole, crc_chunked,
+	       crc_log, expected);
+
+	if ((crc_whole != expected) || (crc_chunked != expected))
+	{
+		printf("%s: CRC differs from %s\n", image, crc_log);
+		return 1;
+	}
+
+	return 0;
+}
+
+static double elapsed_ns (const struct timespec *t0, const struct timespec *t1)
+{
+	return (t1->tv_sec - t0->tv_sec) * 1e9 + (t1->tv_nsec - t0->tv_nsec);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        bench_crc                                                                              */
+/*                                                                                                         */
+/* Parameters:      crc32 - kernel, buf - data, size - bytes per call, loops - number of calls             */
+/* Returns:         MB/s                                                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static double bench_crc (UINT32 (*crc32)(UINT32, const void *, unsigned long), const UINT8 *buf, UINT32 size,
+			 UINT32 loops)
+{
+	struct timespec t0, t1;
+	volatile UINT32 sink = 0;
+	UINT32 i;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (i = 0; i < loops; i++)
+		sink += crc32(0xFFFFFFFF, buf, size);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	return ((double)size * loops / _1MB_) / (elapsed_ns(&t0, &t1) / 1e9);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        bench_copy                                                                             */
+/*                                                                                                         */
+/* Parameters:      dst, src - image, size - image size, chunked - CRC each chunk after its copy,          */
+/*                  crc_out - CRC32 of the copy                                                            */
+/* Returns:         MB/s of copy and check                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static double bench_copy (UINT8 *dst, const UINT8 *src, UINT32 size, int chunked, UINT32 *crc_out)
+{
+	struct timespec t0, t1;
+	UINT32 done, len, crc = 0xFFFFFFFF;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	if (chunked)
+	{
+		for (done = 0; done < size; done += len)
+		{
+			len = MIN(CRC_BENCH_CHUNK, size - done);
+			memcpy(&dst[done], &src[done], len);
+			crc = Crc32Update(crc, &dst[done], len);
+		}
+	}
+	else
+	{
+		memcpy(dst, src, size);
+		crc = Crc32Update(crc, dst, size);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	*crc_out = ~crc;
+	return ((double)size / _1MB_) / (elapsed_ns(&t0, &t1) / 1e9);
+}
+
+int main (int argc, char *argv[])
+{
+	UINT32 iterations = (argc > 1) ? (UINT32)strtoul(argv[1], NULL, 0) : 100000;
+	UINT32 i, k, c, size, errors = 0, crc_whole, crc_chunked;
+	UINT8  *src = malloc(CRC_BENCH_MAX_IMAGE);
+	UINT8  *dst = malloc(CRC_BENCH_MAX_IMAGE);
+
+	tool_seed(argc, argv, 2);
+
+	if ((src == NULL) || (dst == NULL))
+	{
+		printf("out of memory\n");
+		return 1;
+	}
+
+	for (i = 0; i < 256; i++)
+	{
+		for (c = i, k = 0; k < 8; k++)
+			c = (c >> 1) ^ (0xEDB88320 & (0 - (c & 1)));
+		crc_table[i] = c;
+	}
+
+	for (i = 0; i < CRC_BENCH_MAX_IMAGE; i++)
+		src[i] = (UINT8)tool_rand();
+
+	/* check value of the CRC-32/ISO-HDLC catalog entry */
+	if (~Crc32Update(0xFFFFFFFF, "123456789", 9) != 0xCBF43926)
+	{
+		printf("Crc32Update: check value %#010x\n", ~Crc32Update(0xFFFFFFFF, "123456789", 9));
+		errors++;
+	}
+
+	errors += fuzz(src, iterations);
+	printf("%u iterations, %u errors\n", iterations, errors);
+
+	for (i = 3; i + 1 < (UINT32)argc; i += 2)
+		errors += check_image(argv[i], argv[i + 1]);
+
+	printf("%10s %14s %14s\n", "size", "Crc32Update", "table");
+	for (size = _1KB_; size <= CRC_BENCH_MAX_IMAGE; size *= 8)
+	{
+		UINT32 loops = MAX(1, _256MB_ / size);
+
+		printf("%10u %9.0f MB/s %9.0f MB/s\n", size, bench_crc(Crc32Update, src, size, loops),
+		       bench_crc(crc32_table, src, size, MAX(1, loops / 8)));
+	}
+
+	printf("%10s %14s %14s\n", "image", "copy + CRC", "64KB chunks");
+	for (size = _1MB_; size <= CRC_BENCH_MAX_IMAGE; size *= 2)
+	{
+		double whole = bench_copy(dst, src, size, 0, &crc_whole);
+		double chunked = bench_copy(dst, src, size, 1, &crc_chunked);
+
+		printf("%10u %9.0f MB/s %9.0f MB/s\n", size, whole, chunked);
+		if (crc_whole != crc_chunked)
+		{
+			printf("chunked CRC %#010x differs from %#010x\n", crc_chunked, crc_whole);
+			errors++;
+		}
+	}
+
+	free(src);
+	free(dst);
+
+	return (errors != 0);
+}
@@ -0,0 +1,296 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   fuse_model.c                                                             */
+/*            Host model of the fuse array, to fuzz and benchmark the fuse    */
+/*            ECC decoders (SWC_HAL/ModuleDrivers/fuse/2/fuse_ecc.c)          */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+/*
+ * build and run (from Sources):
+ *   make -f makefile check, the binary is Images/check/fuse_model
+ *
+ * usage: fuse_model [iterations] [seed]
+ *
+ * The model is a 1KB OTP array: programming can only blow bits (0 -> 1). Faults are injected as bits that
+ * did not blow and as bits that blew by themselves. Every iteration programs a random nibble parity or
+ * majority rule range, injects faults and checks the decoder against the injected faults:
+ *   - nibble parity: one bad bit in an encoded byte is corrected. Two bad bits are reported or, as the code
+ *     distance is 3, decoded to a wrong nibble: both are counted, not errors
+ *   - majority rule: a bit bad in only one of the three copies is corrected
+ * The codecs are also compared with the byte by byte ones (tools/fuse_ecc_ref.c): exhaustively on every
+ * encoded nibble parity byte pair and every majority rule byte triple, then on random lengths and buffer
+ * offsets. Then both versions of the decoders are timed on the whole array.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "defs.h"
+#include "tool_check.h"
+#include "../SWC_HAL/ModuleDrivers/fuse/2/fuse_ecc.c"
+#include "fuse_ecc_ref.c"
+
+#define FUSE_MODEL_SIZE         1024
+#define FUSE_MODEL_MAX_RANGE    192             /* encoded bytes, multiple of 2 and 3 */
+
+static UINT8  fuse_array[FUSE_MODEL_SIZE];
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        fuse_model_program                                                                     */
+/*                                                                                                         */
+/* Parameters:      addr - first byte, data - encoded bytes, size - number of bytes                        */
+/* Returns:         none                                                                                   */
+/* Description:                                                                                            */
+/*                  Blank the range and program it: only 0 -> 1 transitions, as the OTP                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static void fuse_model_program (UINT32 addr, const UINT8 *data, UINT32 size)
+{
+	memset(&fuse_array[addr], 0, size);
+	while (size--)
+	{
+		fuse_array[addr++] |= *data++;
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        fuse_model_fault                                                                       */
+/*                                                                                                         */
+/* Parameters:      addr - byte, bit - bit in the byte                                                     */
+/* Returns:         none                                                                                   */
+/* Description:                                                                                            */
+/*                  A blown bit that reads 0 or a blank bit that reads 1                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static void fuse_model_fault (UINT32 addr, UINT32 bit)
+{
+	fuse_array[addr] ^= (UINT8)(1 << bit);
+}
+
+static UINT32 fuzz_nibble (UINT32 addr, UINT32 *detected, UINT32 *silent)
+{
+	UINT8  data[FUSE_MODEL_MAX_RANGE / 2], encoded[FUSE_MODEL_MAX_RANGE], decoded[FUSE_MODEL_MAX_RANGE / 2];
+	UINT8  faults[FUSE_MODEL_MAX_RANGE];
+	UINT32 size = 2 * (1 + tool_rand() % (FUSE_MODEL_MAX_RANGE / 2));
+	UINT32 i, two_faults = 0;
+	DEFS_STATUS status;
+
+	for (i = 0; i < size / 2; i++)
+		data[i] = (UINT8)tool_rand();
+
+	FUSE_NibParEccEncode(data, encoded, size);
+	fuse_model_program(addr, encoded, size);
+
+	/* 0, 1 or 2 faults in each encoded byte */
+	for (i = 0; i < size; i++)
+	{
+		UINT32 b0 = tool_rand() % 8, b1 = (b0 + 1 + tool_rand() % 7) % 8;
+
+		faults[i] = (UINT8)(tool_rand() % 8);
+		faults[i] = (faults[i] < 5) ? 0 : (faults[i] < 7) ? 1 : 2;
+		if (faults[i] > 0)
+			fuse_model_fault(addr + i, b0);
+		if (faults[i] > 1)
+			fuse_model_fault(addr + i, b1);
+		two_faults |= (faults[i] > 1);
+	}
+
+	status = FUSE_NibParEccDecode(&fuse_array[addr], decoded, size);
+
+	if (two_faults)
+	{
+		if (status != DEFS_STATUS_OK)
+			(*detected)++;
+		else if (memcmp(data, decoded, size / 2))
+			(*silent)++;
+		return 0;
+	}
+
+	if ((status != DEFS_STATUS_OK) || memcmp(data, decoded, size / 2))
+	{
+		printf("nibble parity: single fault not corrected at %u, size %u\n", addr, size);
+		return 1;
+	}
+
+	return 0;
+}
+
+static UINT32 fuzz_majority (UINT32 addr)
+{
+	UINT8  data[FUSE_MODEL_MAX_RANGE / 3], encoded[FUSE_MODEL_MAX_RANGE], decoded[FUSE_MODEL_MAX_RANGE / 3];
+	UINT32 size = 3 * (1 + tool_rand() % (FUSE_MODEL_MAX_RANGE / 3));
+	UINT32 copy_size = size / 3;
+	UINT32 i, bit;
+
+	for (i = 0; i < copy_size; i++)
+		data[i] = (UINT8)tool_rand();
+
+	FUSE_MajRulEccEncode(data, encoded, size);
+	fuse_model_program(addr, encoded, size);
+
+	/* each bit of the data may be bad in one of the three copies */
+	for (i = 0; i < copy_size; i++)
+	{
+		for (bit = 0; bit < 8; bit++)
+		{
+			if ((tool_rand() % 4) == 0)
+				fuse_model_fault(addr + (tool_rand() % 3) * copy_size + i, bit);
+		}
+	}
+
+	if ((FUSE_MajRulEccDecode(&fuse_array[addr], decoded, size) != DEFS_STATUS_OK) ||
+	    memcmp(data, decoded, copy_size))
+	{
+		printf("majority rule: fault not corrected at %u, size %u\n", addr, size);
+		return 1;
+	}
+
+	return 0;
+}
+
+typedef DEFS_STATUS (*FUSE_CODEC_T)(const UINT8 *, UINT8 *, UINT32);
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        equiv_run                                                                              */
+/*                                                                                                         */
+/* Parameters:      codec, ref - codec and its reference, in - input, size - codec size, out_size - bytes  */
+/*                  written, offset - misalignment of the output                                           */
+/* Returns:         1 if the output bytes or the status differ                                             */
+/* Description:                                                                                            */
+/*                  Both outputs start with the same fill, so the bytes a codec keeps are compared too     */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 equiv_run (FUSE_CODEC_T codec, FUSE_CODEC_T ref, const UINT8 *in, UINT32 size, UINT32 out_size,
+			 UINT32 offset)
+{
+	static UINT8 out[FUSE_MODEL_SIZE + 16], out_ref[FUSE_MODEL_SIZE + 16];
+	DEFS_STATUS status, status_ref;
+
+	memset(out, 0x5A, sizeof(out));
+	memset(out_ref, 0x5A, sizeof(out_ref));
+
+	status = codec(in, out + offset, size);
+	status_ref = ref(in, out_ref + offset, size);
+
+	return (status != status_ref) || memcmp(out, out_ref, out_size + offset + 8);
+}
+
+static UINT32 equiv_check (void)
+{
+	static UINT8 in[3 * FUSE_MODEL_SIZE + 16];
+	UINT32 i, a, size, offset, errors = 0;
+
+	/* every pair of encoded bytes: all corrections and all uncorrectable entries, and the odd size */
+	for (a = 0; a < 0x10000; a++)
+	{
+		in[0] = (UINT8)a;
+		in[1] = (UINT8)(a >> 8);
+		errors += equiv_run(FUSE_NibParEccDecode, REF_FUSE_NibParEccDecode, in, 2, 1, 0);
+		errors += equiv_run(FUSE_NibParEccDecode, REF_FUSE_NibParEccDecode, in, 1, 1, 0);
+	}
+
+	/* every triple of copies */
+	for (a = 0; a < 0x1000000; a++)
+	{
+		in[0] = (UINT8)a;
+		in[1] = (UINT8)(a >> 8);
+		in[2] = (UINT8)(a >> 16);
+		errors += equiv_run(FUSE_MajRulEccDecode, REF_FUSE_MajRulEccDecode, in, 3, 1, 0);
+	}
+
+	/* random lengths (also not multiple of 2 or 3) and offsets, mostly valid code words */
+	for (i = 0; i < 20000; i++)
+	{
+		size = tool_rand() % FUSE_MODEL_SIZE;
+		offset = tool_rand() % 8;
+
+		for (a = 0; a < size + 8; a++)
+			in[a] = (UINT8)tool_rand();
+
+		errors += equiv_run(FUSE_NibParEccEncode, REF_FUSE_NibParEccEncode, in + offset, size, size, offset);
+		errors += equiv_run(FUSE_MajRulEccEncode, REF_FUSE_MajRulEccEncode, in + offset, size, size, offset);
+
+		if (i & 1)
+			REF_FUSE_NibParEccEncode(in + 8, in + offset, size & ~1);
+		errors += equiv_run(FUSE_NibParEccDecode, REF_FUSE_NibParEccDecode, in + offset, size, size / 2 + 1,
+				    (offset + i) % 8);
+
+		if (i & 1)
+			REF_FUSE_MajRulEccEncode(in + 8, in + offset, size - (size % 3));
+		errors += equiv_run(FUSE_MajRulEccDecode, REF_FUSE_MajRulEccDecode, in + offset, size, size / 3,
+				    (offset + i) % 8);
+	}
+
+	if (errors)
+		printf("codecs differ from the reference in %u cases\n", errors);
+
+	return errors;
+}
+
+static double bench_ns_per_byte (FUSE_CODEC_T decode, UINT32 size, UINT32 loops)
+{
+	static UINT8 out[FUSE_MODEL_SIZE];
+	struct timespec t0, t1;
+	UINT32 i;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (i = 0; i < loops; i++)
+	{
+		decode(fuse_array, out, size);
+		__asm__ __volatile__("" : : "r" (out) : "memory");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	return ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / ((double)loops * size);
+}
+
+int main (int argc, char *argv[])
+{
+	UINT32 iterations = (argc > 1) ? (UINT32)strtoul(argv[1], NULL, 0) : 100000;
+	UINT32 i, errors = 0, detected = 0, silent = 0;
+	UINT8  all[256], enc[512], dec[256];
+
+	tool_seed(argc, argv, 2);
+
+	/* round trip of all the byte values */
+	for (i = 0; i < 256; i++)
+		all[i] = (UINT8)i;
+	FUSE_NibParEccEncode(all, enc, 512);
+	if ((FUSE_NibParEccDecode(enc, dec, 512) != DEFS_STATUS_OK) || memcmp(all, dec, 256))
+	{
+		printf("nibble parity: round trip failed\n");
+		errors++;
+	}
+
+	errors += equiv_check();
+
+	for (i = 0; i < iterations; i++)
+	{
+		UINT32 addr = tool_rand() % (FUSE_MODEL_SIZE - FUSE_MODEL_MAX_RANGE);
+
+		if (i & 1)
+			errors += fuzz_majority(addr);
+		else
+			errors += fuzz_nibble(addr, &detected, &silent);
+	}
+
+	printf("%u iterations, %u errors\n", iterations, errors);
+	printf("nibble parity ranges with double faults: %u reported, %u decoded wrong\n", detected, silent);
+
+	for (i = 0; i < FUSE_MODEL_SIZE; i++)
+		fuse_array[i] = (UINT8)tool_rand();
+
+	printf("nibble parity decode: %.2f ns/encoded byte (byte by byte %.2f)\n",
+	       bench_ns_per_byte(FUSE_NibParEccDecode, 1024, 20000),
+	       bench_ns_per_byte(REF_FUSE_NibParEccDecode, 1024, 20000));
+	printf("majority rule decode: %.2f ns/encoded byte (byte by byte %.2f)\n",
+	       bench_ns_per_byte(FUSE_MajRulEccDecode, 1023, 20000),
+	       bench_ns_per_byte(REF_FUSE_MajRulEccDecode, 1023, 20000));
+
+	return (errors != 0);
+}
@@ -0,0 +1,203 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   log_bin_check.c                                                          */
+/*            Host check of the binary log (serial_log_bin) against its       */
+/*            decoder (tools/log_decode.py)                                   */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+/*
+ * build and run (from Sources):
+ *   make -f makefile check, the binary is Images/check/log_bin_check, built with -no-pie, _NOTIP_, DEBUG_LOG
+ *   and BOOTBLOCK_LOG_BINARY
+ * -no-pie: the records keep the low 32 bits of the format address, the decoder reads the strings from the ELF
+ * file at their link address, as for the bootblock.
+ *
+ * usage: log_bin_check <capture> <expected>
+ *        python3 tools/log_decode.py -t log_bin_check <capture> | cmp - <expected>
+ *
+ * serial_printf.c is built with UART and clock stubs: UART_PutC appends to the capture, CLK_GetTimeStamp
+ * advances a model time by a random step. Every conversion, flag and qualifier that serial_log_bin encodes
+ * is logged with edge values, between serial_printf text lines, and the same call is formatted by
+ * serial_vsprintf (str_printf) into the expected text, with the "[usec] " prefix of -t before the records.
+ * The short formats and the formats with too many arguments are sent as text, without prefix.
+ * %lu / %lx values stay under 2^63 and %ld over LONG_MIN: serial_vsprintf divides them as signed longs, so
+ * the bootblock text is wrong there and only the decoder prints them right.
+ * The arguments of CHECK_LOG are evaluated twice, they must not have side effects.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tool_check.h"
+#include "../source/apps/serial_printf/serial_printf.c"
+
+#define CHECK_CAPTURE_SIZE      _64KB_
+
+static UINT8  check_capture[CHECK_CAPTURE_SIZE];
+static UINT32 check_capture_size;
+static char   check_expected[CHECK_CAPTURE_SIZE];
+static UINT32 check_expected_size;
+static UINT32 check_usec;
+/*---------------------------------------------------------------------------------------------------------*/
+/* Stubs of the UART and clock drivers                                                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+DEFS_STATUS UART_PutC (UART_DEV_T devNum, const UINT8 c)
+{
+	if (check_capture_size < CHECK_CAPTURE_SIZE)
+		check_capture[check_capture_size++] = c;
+
+	return DEFS_STATUS_OK;
+}
+
+DEFS_STATUS UART_Init (UART_DEV_T devNum, UART_REDIRECTION_T mode, UART_BAUDRATE_T baudRate)
+{
+	return DEFS_STATUS_OK;
+}
+
+DEFS_STATUS UART_ResetFIFOs (UART_DEV_T devNum, BOOLEAN txFifo, BOOLEAN rxFifo)
+{
+	return DEFS_STATUS_OK;
+}
+
+UINT32 UART_GetBaudrate (UART_DEV_T devNum)
+{
+	return 115200;
+}
+
+UINT32 CLK_ConfigureUartClockEx (UINT8 clkSelect, UINT32 uartDiv)
+{
+	return 24000000;
+}
+
+/* SECCNT / CNTR25M: seconds and 25MHz ticks in the second */
+void CLK_GetTimeStamp (UINT32 time_quad[2])
+{
+	check_usec += tool_rand() % ((tool_rand() & 1) ? 100 : 3000000);
+
+	time_quad[0] = (check_usec % 1000000) * EXT_CLOCK_FREQUENCY_MHZ;
+	time_quad[1] = check_usec / 1000000;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* CHECK_LOG: log a record and append the text serial_printf would print to the expected output            */
+/*---------------------------------------------------------------------------------------------------------*/
+#define CHECK_LOG(fmt, args...)                                                                         \
+	do {                                                                                                \
+		UINT32 start = check_capture_size;                                                              \
+		char   text[SERIAL_PRINTF_BUFFER_SIZE];                                                         \
+		serial_log_bin(fmt, ##args);                                                                    \
+		str_printf(text, fmt, ##args);                                                                  \
+		if ((check_capture_size > start) && (check_capture[start] == SERIAL_LOG_BIN_MARKER))            \
+			check_expect("[%10u] ", check_usec);                                                        \
+		check_expect("%s", text);                                                                       \
+	} while (0)
+
+static void check_expect (const char *fmt, ...)
+{
+	va_list args;
+
+	va_start(args, fmt);
+	check_expected_size += vsnprintf(&check_expected[check_expected_size],
+					 CHECK_CAPTURE_SIZE - check_expected_size, fmt, args);
+	va_end(args);
+}
+
+/* serial_printf text between the records, '\n' is sent as "\r\n" */
+static void check_text (const char *line)
+{
+	const char *p;
+
+	serial_printf("%s\n", line);
+	for (p = line; *p; p++)
+		check_expect("%c", *p);
+	check_expect("\r\n");
+}
+
+static int check_write (const char *path, const void *data, UINT32 size)
+{
+	FILE *f = fopen(path, "wb");
+
+	if ((f == NULL) || (fwrite(data, 1, size, f) != size))
+	{
+		printf("%s: write error\n", path);
+		return 1;
+	}
+	fclose(f);
+
+	return 0;
+}
+
+static const char check_name[] = "DQ";
+
+int main (int argc, char *argv[])
+{
+	static const int  ints[]  = { 0, 1, -1, 63, -64, 64, 8191, -8192, 0x7FFFFFFF, (int)0x80000000 };
+	static const long longs[] = { 0, -1, 0x7FFFFFFFL, -0x80000000L, 0x123456789ABCDEFL, -0x7FFFFFFFFFFFFFFFL };
+	UINT32 i, row, dq;
+	int    ber;
+
+	if (argc != 3)
+	{
+		printf("usage: log_bin_check <capture> <expected>\n");
+		return 1;
+	}
+
+	gUartLog = UART0_DEV;
+
+	check_text("A35 Bootblock: text before the records");
+
+	for (i = 0; i < (sizeof(ints) / sizeof(ints[0])); i++)
+	{
+		CHECK_LOG("d %d i %i u %u x %x X %X o %o\n", ints[i], ints[i], ints[i], ints[i], ints[i], ints[i]);
+		CHECK_LOG("width [%5d] [%-5d] [%05d] [%+d] [% d] [%08x] [%#x] [%#010x] [%-8X|]\n", ints[i], ints[i],
+			  ints[i], ints[i], ints[i], ints[i], ints[i], ints[i], ints[i]);
+		CHECK_LOG("short %hd %hu %hx\n", (short)ints[i], (unsigned short)ints[i], (unsigned short)ints[i]);
+		CHECK_LOG("star [%*d] [%-*x]\n", (int)(i % 12), ints[i], (int)(i % 7), ints[i]);
+	}
+
+	for (i = 0; i < (sizeof(longs) / sizeof(longs[0])); i++)
+	{
+		CHECK_LOG("long %ld %lu %lx %#lx %016lX\n", longs[i], (unsigned long)labs(longs[i]),
+			  (unsigned long)labs(longs[i]), (unsigned long)labs(longs[i]), (unsigned long)labs(longs[i]));
+		check_text("serial_printf line");
+	}
+
+	CHECK_LOG("char [%c] [%3c] [%-3c|]\n", 'A', 'b', '7');
+	CHECK_LOG("string [%s] [%6s] [%-6s|] [%.1s]\n", check_name, check_name, check_name, check_name);
+	CHECK_LOG("literal %s\n", "in .rodata");
+	CHECK_LOG("percent 100%% %d%%\n", 42);
+	CHECK_LOG("no argument, long enough for a record\n");
+	CHECK_LOG(".");
+	CHECK_LOG("%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+		  13, 14, 15, 16, 17);
+	CHECK_LOG(KRED "colored %d" KNRM "\n", -5);
+
+	/* sweep table row, as printed by the MC driver */
+	for (i = 0; i < 64; i++)
+	{
+		row = tool_rand();
+		dq = row & 0xFF;
+		ber = (int)(row % 2000) - 1000;
+		CHECK_LOG("%3d |%s%s| %02x %4d\n", (int)i - 32, (i & 1) ? "#" : ".", (i & 2) ? "*" : " ", dq, ber);
+	}
+
+	check_text("text after the records");
+
+	if (check_capture_size >= CHECK_CAPTURE_SIZE)
+	{
+		printf("capture buffer full\n");
+		return 1;
+	}
+
+	printf("%u bytes of log for %u bytes of text\n", check_capture_size, check_expected_size);
+
+	return check_write(argv[1], check_capture, check_capture_size) |
+	       check_write(argv[2], check_expected, check_expected_size);
+}
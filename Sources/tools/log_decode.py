@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+#---------------------------------------------------------------------------------------------------------#
+# SPDX-License-Identifier: GPL-2.0                                                                        #
+# Copyright (c) 2024 by Nuvoton Technology Corporation                                                    #
+# All rights reserved                                                                                     #
+#---------------------------------------------------------------------------------------------------------#
+# File Contents:                                                                                          #
+#   log_decode.py                                                                                         #
+#            Decode the bootblock binary log (BOOTBLOCK_LOG_BINARY) back to text                          #
+#  Project:  Arbel                                                                                        #
+#---------------------------------------------------------------------------------------------------------#
+#
+# usage: log_decode.py [-t] <bootblock elf> <log file>
+#
+#   log file : UART capture, or a dump of serial_log_bin_buf (serial_log_bin_size bytes)
+#   -t       : print the boot time (usec) before each record
+#
+# Record (see serial_log_bin in source/apps/serial_printf/serial_printf.c):
+#   0xB1, length of the rest, fmt address (4 bytes LE), usec delta (LEB128), arguments (LEB128)
+# Everything else in the log is text and is printed as is.
+#
+
+import re
+import struct
+import sys
+
+MARKER = 0xB1
+
+SPEC = re.compile(rb"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|L|q|Z|z|t)?(.?)", re.S)
+
+
+class Elf:
+    """ALLOC sections of an ELF64 little endian file, to read strings by address"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 2 or data[5] != 1:
+            sys.exit("%s: not an ELF64 little endian file" % path)
+        shoff, = struct.unpack_from("<Q", data, 0x28)
+        shentsize, shnum = struct.unpack_from("<HH", data, 0x3A)
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from("<IIQQQQ", data, shoff + i * shentsize)
+            if (flags & 0x2) and sh_type != 8 and size:          # SHF_ALLOC, not SHT_NOBITS
+                self.sections.append((addr, size, data[offset:offset + size]))
+
+    def string(self, addr):
+        for base, size, blob in self.sections:
+            if base <= addr < base + size:
+                end = blob.find(b"\0", addr - base)
+                return blob[addr - base:end if end >= 0 else size]
+        return None
+
+
+def leb128(rec, pos):
+    val = shift = 0
+    while True:
+        if pos >= len(rec):
+            raise IndexError
+        b = rec[pos]
+        pos += 1
+        val |= (b & 0x7F) << shift
+        shift += 7
+        if not b & 0x80:
+            return val, pos
+
+
+def signed(val, bits):
+    val &= (1 << bits) - 1
+    return val - (1 << bits) if val >> (bits - 1) else val
+
+
+def format_record(elf, fmt, rec, pos):
+    """serial_vsprintf conversions, with the arguments taken from the record"""
+    out = b""
+    last = 0
+    for m in SPEC.finditer(fmt):
+        out += fmt[last:m.start()]
+        last = m.end()
+        flags, width, prec, qual, conv = m.groups()
+        if width == b"*":
+            w, pos = leb128(rec, pos)
+            width = b"%d" % signed(w, 32)
+        if prec == b"*":
+            p, pos = leb128(rec, pos)
+            prec = b"%d" % max(signed(p, 32), 0)
+        spec = b"%" + flags + (width or b"") + (b"." + prec if prec is not None else b"")
+        bits = 64 if qual == b"l" else 16 if qual == b"h" else 32
+
+        if conv == b"%":
+            out += b"%"
+            continue
+        if conv == b"n":
+            continue
+        if conv not in (b"c", b"s", b"p", b"d", b"i", b"o", b"x", b"X", b"u"):
+            out += b"%" + conv
+            continue
+
+        val, pos = leb128(rec, pos)
+        if conv == b"s":
+            s = elf.string(val) if val else b"<NULL>"
+            out += (spec + b"s") % (s if s is not None else b"<%#x>" % val)
+        elif conv == b"c":
+            out += (spec + b"c") % (val & 0xFF)
+        elif conv == b"p":
+            out += b"%016x" % val
+        elif conv in (b"d", b"i"):
+            out += (spec + b"d") % signed((val >> 1) ^ -(val & 1), bits)
+        elif conv == b"u":
+            out += (spec + b"d") % (val & ((1 << bits) - 1))
+        else:
+            out += (spec + conv) % (val & ((1 << bits) - 1))
+    return out + fmt[last:]
+
+
+def decode(elf, log, timestamps):
+    out = sys.stdout.buffer
+    usec = 0
+    i = 0
+    while i < len(log):
+        if log[i] == MARKER and i + 6 <= len(log):
+            rec = log[i + 2:i + 2 + log[i + 1]]
+            fmt = elf.string(struct.unpack_from("<I", rec, 0)[0]) if len(rec) >= 4 else None
+            if fmt is not None:
+                try:
+                    delta, pos = leb128(rec, 4)
+                    text = format_record(elf, fmt, rec, pos)
+                except (IndexError, TypeError, ValueError):
+                    text = None
+                if text is not None:
+                    usec += delta
+                    if timestamps:
+                        out.write(b"[%10d] " % usec)
+                    out.write(text)
+                    i += 2 + len(rec)
+                    continue
+        out.write(log[i:i + 1])
+        i += 1
+
+
+def main(argv):
+    timestamps = "-t" in argv
+    args = [a for a in argv if a != "-t"]
+    if len(args) != 2:
+        sys.exit("usage: log_decode.py [-t] <bootblock elf> <log file>")
+    with open(args[1], "rb") as f:
+        log = f.read()
+    decode(Elf(args[0]), log, timestamps)
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
@@ -0,0 +1,232 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mc_eye_model.c                                                           */
+/*            Host equivalence check of the sweep eye finder                  */
+/*            (MC_EYE_Find_l, SWC_HAL/ModuleDrivers/mc/4/mc_drv_eye.c)        */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+/*
+ * build and run (from Sources):
+ *   make -f makefile check, the binary is Images/check/mc_eye_model
+ *
+ * usage: mc_eye_model [iterations] [seed]
+ *
+ * MC_EYE_Find_l gets the tested points of a sweep, FindMidBiggestEyeBitwise_l (tools/mc_eye_ref.c) got the
+ * whole MC_DQ_DQS_BITWISE_TRIM_SAMPLING_POINTS_TEST buffer, where the points after the tested ones fail:
+ * for every input, the eye center and size of each of the 16 DQs must be the same. The other fields of
+ * MC_EYE_T (edges, edge widths, number of eyes, second eye, flags) are checked against a point by point
+ * scan of the same bit.
+ * Inputs:
+ *   - exhaustive: every pass / fail pattern of 1 to 22 points, 16 patterns per sweep (one per DQ)
+ *   - exhaustive: every pattern of 12 points at every offset of a 125 points sweep, over the 64 bits words
+ *     of the pass bitmaps, with an all fail, all pass or random background
+ *   - random sweeps of 1 to 125 points, with 0 to 7/8 fail points
+ * The sweeps test up to 125 points, so FindMidBiggestEyeBitwise_l always got a failing last point. On a
+ * last point that passes it was off by one (an eye that reaches it is one point smaller): such buffers are
+ * not compared.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "defs.h"
+#include "tool_check.h"
+#include "../SWC_HAL/ModuleDrivers/mc/4/mc_drv_eye.c"
+#include "mc_eye_ref.c"
+
+#define MODEL_BUFF_SIZE         128             /* MC_DQ_DQS_BITWISE_TRIM_SAMPLING_POINTS_TEST     */
+#define MODEL_MAX_POINTS        125             /* DQn sweep, -62 to 62                            */
+#define MODEL_EXHAUSTIVE_POINTS 22
+#define MODEL_WINDOW_POINTS     12
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_scan                                                                             */
+/*                                                                                                         */
+/* Parameters:      buff - sweep status, points - tested points, bit - DQ, eye - result                    */
+/* Returns:         none                                                                                   */
+/* Description:                                                                                            */
+/*                  MC_EYE_T of one DQ, one point at a time                                                */
+/*---------------------------------------------------------------------------------------------------------*/
+static void model_scan (const UINT16 *buff, int points, int bit, MC_EYE_T *eye)
+{
+	int start = -1;
+	int pass;
+	int i;
+
+	memset(eye, 0, sizeof(*eye));
+	eye->left = -1;
+
+	for (i = 0; i <= points; i++)
+	{
+		pass = (i < points) && !READ_VAR_BIT(buff[i], bit);
+		if (pass && (start < 0))
+			start = i;
+		if (!pass && (start >= 0))
+		{
+			eye->eyes++;
+			if (i - start > eye->size)
+			{
+				eye->second = (UINT8)eye->size;
+				eye->size = i - start;
+				eye->left = start;
+			}
+			else if (i - start > eye->second)
+			{
+				eye->second = (UINT8)(i - start);
+			}
+			start = -1;
+		}
+	}
+
+	if (eye->size == 0)
+	{
+		eye->center = -1;
+		eye->right = -1;
+		eye->flags = MC_EYE_NONE;
+		return;
+	}
+
+	eye->right = eye->left + eye->size - 1;
+	eye->center = eye->left + (eye->size / 2);
+
+	for (i = MAX(eye->left - MC_EYE_EDGE_WINDOW, 0); i < eye->left; i++)
+	{
+		if (!READ_VAR_BIT(buff[i], bit))
+		{
+			eye->edge[0] = (UINT8)(eye->left - i);
+			break;
+		}
+	}
+	for (i = MIN(eye->right + MC_EYE_EDGE_WINDOW, points - 1); i > eye->right; i--)
+	{
+		if (!READ_VAR_BIT(buff[i], bit))
+		{
+			eye->edge[1] = (UINT8)(i - eye->right);
+			break;
+		}
+	}
+
+	if ((eye->left == 0) || (eye->right == points - 1))
+		eye->flags |= MC_EYE_CLIPPED;
+	if ((eye->edge[0] != 0) || (eye->edge[1] != 0))
+		eye->flags |= MC_EYE_SOFT_EDGE;
+	if (eye->second >= MC_EYE_SECONDARY_MIN)
+		eye->flags |= MC_EYE_SECONDARY;
+}
+
+static UINT64 model_checks;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_check                                                                            */
+/*                                                                                                         */
+/* Parameters:      buff - sweep status, points - tested points (up to MODEL_MAX_POINTS)                   */
+/* Returns:         number of DQs that differ                                                              */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 model_check (const UINT16 *buff, int points)
+{
+	UINT16       full[MODEL_BUFF_SIZE];
+	volatile int center[16];
+	volatile int size[16];
+	MC_EYE_T     eye[MC_EYE_BITS];
+	MC_EYE_T     scan;
+	UINT32       fail = 0;
+	int          bit;
+
+	memcpy(full, buff, points * sizeof(UINT16));
+	memset(&full[points], 0xFF, (MODEL_BUFF_SIZE - points) * sizeof(UINT16));
+
+	REF_FindMidBiggestEyeBitwise_l(full, MODEL_BUFF_SIZE, center, size, 16);
+	MC_EYE_Find_l(buff, points, eye);
+
+	for (bit = 0; bit < MC_EYE_BITS; bit++)
+	{
+		model_checks++;
+		model_scan(buff, points, bit, &scan);
+
+		if ((eye[bit].center != center[bit]) || (eye[bit].size != size[bit]) ||
+		    (eye[bit].left != scan.left) || (eye[bit].right != scan.right) ||
+		    (eye[bit].edge[0] != scan.edge[0]) || (eye[bit].edge[1] != scan.edge[1]) ||
+		    (eye[bit].eyes != scan.eyes) || (eye[bit].second != scan.second) || (eye[bit].flags != scan.flags))
+		{
+			TOOL_ERROR(fail, "%d points, bit %d: center %d size %d (ref %d %d), eye %d..%d edges %u/%u eyes %u "
+			           "second %u flags %#x (scan %d..%d %u/%u %u %u %#x)\n", points, bit,
+			           eye[bit].center, eye[bit].size, center[bit], size[bit], eye[bit].left, eye[bit].right,
+			           eye[bit].edge[0], eye[bit].edge[1], eye[bit].eyes, eye[bit].second, eye[bit].flags,
+			           scan.left, scan.right, scan.edge[0], scan.edge[1], scan.eyes, scan.second, scan.flags);
+		}
+	}
+
+	return fail;
+}
+
+int main (int argc, char *argv[])
+{
+	UINT32 iterations = (argc > 1) ? (UINT32)strtoul(argv[1], NULL, 0) : 500000;
+	UINT16 buff[MODEL_BUFF_SIZE];
+	UINT32 i, k, pattern, patterns, errors = 0;
+	int    points, offset, background, density;
+
+	tool_seed(argc, argv, 2);
+
+	/* every pattern of the first points: bit k of point i is bit i of pattern + k */
+	for (points = 1; points <= MODEL_EXHAUSTIVE_POINTS; points++)
+	{
+		patterns = 1U << points;
+		for (pattern = 0; pattern < patterns; pattern += MC_EYE_BITS)
+		{
+			for (i = 0; i < (UINT32)points; i++)
+			{
+				buff[i] = 0;
+				for (k = 0; k < MC_EYE_BITS; k++)
+					buff[i] |= (UINT16)((((pattern + k) % patterns) >> i) & 1) << k;
+			}
+			errors += model_check(buff, points);
+		}
+	}
+
+	/* every pattern of a window, at every offset of the sweep */
+	patterns = 1U << MODEL_WINDOW_POINTS;
+	for (background = 0; background < 3; background++)
+	{
+		for (offset = 0; offset <= MODEL_MAX_POINTS - MODEL_WINDOW_POINTS; offset++)
+		{
+			for (pattern = 0; pattern < patterns; pattern += MC_EYE_BITS)
+			{
+				for (i = 0; i < MODEL_MAX_POINTS; i++)
+					buff[i] = (background == 0) ? 0xFFFF : (background == 1) ? 0 : (UINT16)tool_rand();
+				for (i = 0; i < MODEL_WINDOW_POINTS; i++)
+				{
+					buff[offset + i] = 0;
+					for (k = 0; k < MC_EYE_BITS; k++)
+						buff[offset + i] |= (UINT16)(((pattern + k) >> i) & 1) << k;
+				}
+				errors += model_check(buff, MODEL_MAX_POINTS);
+			}
+		}
+	}
+
+	/* random sweeps, sparse to dense fails */
+	for (i = 0; i < iterations; i++)
+	{
+		points = 1 + (int)(tool_rand() % MODEL_MAX_POINTS);
+		density = (int)(tool_rand() % 8);
+		for (offset = 0; offset < points; offset++)
+		{
+			buff[offset] = 0;
+			for (k = 0; k < MC_EYE_BITS; k++)
+				buff[offset] |= (UINT16)(((int)(tool_rand() % 8) < density) << k);
+		}
+		errors += model_check(buff, points);
+	}
+
+	printf("%llu DQ eyes checked, %u errors\n", (unsigned long long)model_checks, errors);
+
+	return (errors != 0);
+}
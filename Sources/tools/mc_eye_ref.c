@@ -0,0 +1,114 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mc_eye_ref.c                                                             */
+/*            FindMidBiggestEyeBitwise_l, as it was in mc_drv.c before        */
+/*            mc_drv_eye.c. Reference of tools/mc_eye_model.c                 */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        REF_FindMidBiggestEyeBitwise_l                                                         */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:                                                                                                */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*          This routine finds the middle of the eye on the array received from MC_MemStressTest           */
+/*---------------------------------------------------------------------------------------------------------*/
+
+// TBD: there was a bug in center calculation when there are several eyes !!!.
+static void REF_FindMidBiggestEyeBitwise_l(const UINT16 *SweepDataBuff, const int BuffSize, volatile int *pEyeCenter, volatile int *pEyeSize, int bits)
+{
+	int start = -1;
+	int stop = -1;
+	int eyeSize = -1;
+
+	int bufInd = 0;
+	int bitInd = 0;
+	int bitStep = 1; // in bitwise sweep find the biggest eye size on every bit.
+	// when sweeping a value that is common to entire lane , like DQS,
+	// use bit zero and bit 8 value of the UINT16 of data buf.
+
+	for (bitInd = 0; bitInd < bits; bitInd += bitStep)
+	{
+		start = -1;
+		stop = -1;
+		eyeSize = -1;
+
+		for (bufInd = 0; bufInd < BuffSize; bufInd++)
+		{
+			if ((SweepDataBuff[bufInd] & ((UINT16)0x0001 << bitInd)) == 0)
+			{ // pass point
+				if (start == (-1))
+				{ // found a good start point
+					start = bufInd;
+					// HAL_PRINT_DBG("[%u",bufInd);
+				}
+			}
+			else
+			{ // fail point
+				if (start != (-1))
+				{ // found fail point (after found a good start point);
+					// HAL_PRINT_DBG("...%u]",bufInd);
+					if ((bufInd - start) > eyeSize)
+					{
+						// new eye size is bigger then last found eye
+						stop = bufInd - 1; // last good point
+						eyeSize = bufInd - start;
+						// HAL_PRINT_DBG("*");
+					}
+					start = -1;
+				}
+			}
+		}
+
+		/*----------------------------------------------------------------------------------------------*/
+		/*      Close an unclosed eyes                                                                  */
+		/*----------------------------------------------------------------------------------------------*/
+		if (start != -1)
+		{
+			// need to close at the end after found a good start point;
+			// HAL_PRINT_DBG("Close the unclosed eyes : bit %u bufInd=%u start=%u\n",bitInd, bufInd, start );
+			if (((BuffSize - 1) - start) > eyeSize)
+			{
+				// new eye size is bigger then last found eye
+				stop = (BuffSize - 1) - 1;
+				eyeSize = (BuffSize - 1) - start;
+				// HAL_PRINT_DBG("*");
+			}
+			start = -1;
+		}
+
+		/*---------------------------------------------------------------------------------------------------------*/
+		/*  write results to pEyeCenter and pEyeSize                                                               */
+		/*---------------------------------------------------------------------------------------------------------*/
+
+		if (eyeSize == (-1))
+		{
+			/*------------------------------------------------------------------------------------------------*/
+			/* No eye                                                                                         */
+			/*------------------------------------------------------------------------------------------------*/
+			// HAL_PRINT(KRED ">lane%u, bit%u: No eye !\n" KNRM , ((bitInd>7)?1:0), (bitInd %8));
+
+			// Clear pEyeCenter and pEyeSize
+			pEyeCenter[bitInd] = -1;
+			pEyeSize[bitInd] = 0;
+		}
+		else
+		{
+			// calculate eye center
+			pEyeSize[bitInd] = eyeSize;
+			pEyeCenter[bitInd] = stop - DIV_CEILING(eyeSize, 2) + 1;
+		}
+		// HAL_PRINT_DBG("\n>lane%u, bit%u: eye=%u center=%u\n", ((bitInd>7)?1:0), (bitInd %8),  pEyeSize[bitInd] , pEyeCenter[bitInd] );
+	}
+
+	return;
+}
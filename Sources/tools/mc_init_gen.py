@@ -0,0 +1,535 @@
+#!/usr/bin/env python3
+#---------------------------------------------------------------------------------------------------------#
+# SPDX-License-Identifier: GPL-2.0                                                                        #
+# Copyright (c) 2024 by Nuvoton Technology Corporation                                                    #
+# All rights reserved                                                                                     #
+#---------------------------------------------------------------------------------------------------------#
+# File Contents:                                                                                          #
+#   mc_init_gen.py                                                                                        #
+#            Fold the MC init register writes of arbel_mc_init.c into register tables                     #
+#  Project:  Arbel                                                                                        #
+#---------------------------------------------------------------------------------------------------------#
+#
+# usage: mc_init_gen.py [-c]
+#
+#   -c : check that arbel_mc_init_tbl.c is up to date, do not write it
+#
+# Reads mc_init_1600 / mc_init_2133 of SWC_HAL/ModuleDrivers/mc/4/arbel_mc_init.c (the MC_INIT_REFERENCE
+# code, with mc_setup_AXI_parameters and mc_setup_AXI_relative_priority inlined) and writes
+# arbel_mc_init_tbl.c next to it, MC_INIT_REG_T tables of one {offset, mask, value} entry per register,
+# sorted by offset:
+#   mc_init_base_<n>      : the registers written the same by all the speed grades
+#   mc_init_<grade>_<n>   : the other registers of each speed grade, mc_init_<grade>_delta for MC_GRADE_T
+#   mc_init_grade         : the code shared by the speed grades, with the setup_<n> tables of the writes of
+#                           ddr_setup values. mc_init_apply_l merges base, grade delta and setup by offset.
+#
+# Statements are classified as:
+#   constant : SET_REG_FIELD / REG_WRITE of a DENALI_CTL register with a value made of numbers and macros
+#   setup    : SET_REG_FIELD of a DENALI_CTL register with a value without calls (ddr_setup fields)
+#   read     : temp_var = REG_READ(reg), dropped if temp_var is not used or only written back as it is
+#   dynamic  : other statements on DENALI_CTL registers (if blocks)
+#   barrier  : anything else (function calls, loops)
+# The writes to different MC registers before START are independent, only the order of the writes to the
+# same register is kept: setup tables are applied over the constant tables, so a constant write after a
+# setup write of the same bits goes to the setup table. A register is folded until the first dynamic
+# statement on it, its later statements stay code. A barrier ends the tables: the next writes go to new
+# ones. The speed grades must differ only in constant writes.
+#
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+MC_DIR = os.path.join(ROOT, "SWC_HAL", "ModuleDrivers", "mc", "4")
+SRC = os.path.join(MC_DIR, "arbel_mc_init.c")
+REGS = os.path.join(MC_DIR, "mc_regs.h")
+OUT = os.path.join(MC_DIR, "arbel_mc_init_tbl.c")
+
+ROOTS = ["mc_init_1600", "mc_init_2133"]
+INLINE = ["mc_setup_AXI_parameters", "mc_setup_AXI_relative_priority"]
+GUARD = {"mc_init_1600": "MC_CAPABILITY_CLK_TYPE_1600"}
+
+REG = r"DENALI_CTL_\d+"
+NUMBER = re.compile(r"\b(0[xX][0-9a-fA-F]+|\d+)[uUlL]*\b")
+FULL = 0xFFFFFFFF
+
+
+def fail(msg):
+    sys.exit("mc_init_gen: " + msg)
+
+
+def strip_comments(text):
+    """Remove comments, keep the line structure"""
+    out = []
+    i = 0
+    while i < len(text):
+        if text.startswith("/*", i):
+            j = text.find("*/", i + 2)
+            if j < 0:
+                fail("unterminated comment")
+            out.append("\n" * text.count("\n", i, j) + " ")
+            i = j + 2
+        elif text.startswith("//", i):
+            j = text.find("\n", i)
+            i = len(text) if j < 0 else j
+        elif text[i] in "\"'":
+            j = i + 1
+            while text[j] != text[i]:
+                j += 2 if text[j] == "\\" else 1
+            out.append(text[i:j + 1])
+            i = j + 1
+        else:
+            out.append(text[i])
+            i += 1
+    return "".join(out)
+
+
+def preprocess(text, defines):
+    """Conditional compilation, with the defines of arbel_mc_init.c and the given ones"""
+
+    def value(d, arg):
+        arg = arg.strip()
+        if d == "ifdef":
+            return arg in defines
+        if d == "ifndef":
+            return arg not in defines
+        m = re.fullmatch(r"(!?)\s*defined\s*\(?\s*(\w+)\s*\)?", arg)
+        if m:
+            return (m.group(2) in defines) != (m.group(1) == "!")
+        if re.fullmatch(r"\d+", arg):
+            return int(arg) != 0
+        if re.fullmatch(r"\w+", arg):
+            return bool(int(defines.get(arg, 0)))
+        fail("unsupported condition #%s %s" % (d, arg))
+
+    out = []
+    stack = []                      # [active, a branch was taken]
+    for line in text.split("\n"):
+        m = re.match(r"\s*#\s*(\w+)\s*(.*)", line)
+        if m and m.group(1) in ("if", "ifdef", "ifndef", "elif", "else", "endif"):
+            d, arg = m.group(1), m.group(2)
+            if d in ("if", "ifdef", "ifndef"):
+                v = value(d, arg)
+                stack.append([v, v])
+            elif d == "elif":
+                v = (not stack[-1][1]) and value(d, arg)
+                stack[-1] = [v, stack[-1][1] or v]
+            elif d == "else":
+                stack[-1] = [not stack[-1][1], True]
+            else:
+                stack.pop()
+            out.append("")
+            continue
+        active = all(s[0] for s in stack)
+        if m and m.group(1) == "define" and active:
+            parts = m.group(2).split(None, 1)
+            defines[parts[0]] = parts[1].strip() if len(parts) > 1 else "1"
+        out.append(line if active else "")
+    return "\n".join(out)
+
+
+def functions(text):
+    """Bodies of the static functions: name -> (parameters, body)"""
+    funcs = {}
+    for m in re.finditer(r"^static\s+void\s+(\w+)\s*\(([^)]*)\)\s*\{", text, re.M):
+        depth = 0
+        i = m.end() - 1
+        while True:
+            if text[i] == "{":
+                depth += 1
+            elif text[i] == "}":
+                depth -= 1
+                if depth == 0:
+                    break
+            i += 1
+        funcs[m.group(1)] = (m.group(2).strip(), text[m.end():i])
+    return funcs
+
+
+def balanced(text, i, open_c, close_c):
+    """End (exclusive) of the balanced group starting at text[i] == open_c"""
+    depth = 0
+    while i < len(text):
+        if text[i] == open_c:
+            depth += 1
+        elif text[i] == close_c:
+            depth -= 1
+            if depth == 0:
+                return i + 1
+        i += 1
+    fail("unbalanced %s" % open_c)
+
+
+def statements(body):
+    """Split a function body into top level statements (if / else chains and blocks are one statement)"""
+    out = []
+    i = 0
+    while True:
+        while i < len(body) and body[i].isspace():
+            i += 1
+        if i >= len(body):
+            return out
+        start = i
+        i = statement_end(body, i)
+        out.append(body[start:i].strip())
+
+
+def statement_end(body, i):
+    while body[i].isspace():
+        i += 1
+    m = re.match(r"(if|while|for|switch)\b\s*", body[i:])
+    if m:
+        i = balanced(body, i + m.end(), "(", ")")
+        i = statement_end(body, i)
+        if m.group(1) == "if":
+            e = re.match(r"\s*else\b", body[i:])
+            if e:
+                i = statement_end(body, i + e.end())
+        return i
+    if body[i] == "{":
+        return balanced(body, i, "{", "}")
+    if re.match(r"do\b", body[i:]):
+        i = statement_end(body, i + 2)
+        return body.index(";", i) + 1
+    depth = 0
+    while True:
+        c = body[i]
+        if c == "(":
+            depth += 1
+        elif c == ")":
+            depth -= 1
+        elif c == ";" and depth == 0:
+            return i + 1
+        i += 1
+
+
+class Regs:
+    """Registers and fields of mc_regs.h"""
+
+    def __init__(self, path):
+        with open(path) as f:
+            text = f.read()
+        self.fields = {m.group(1): (int(m.group(2)), int(m.group(3)))
+                       for m in re.finditer(r"^#define\s+(DENALI_CTL_\d+_\w+)\s+(\d+)\s*,\s*(\d+)", text, re.M)}
+        self.offsets = {m.group(1): int(m.group(2), 16)
+                        for m in re.finditer(r"^#define\s+(DENALI_CTL_\d+)\s+\(MC_BASE\s*\+\s*(0x[0-9a-fA-F]+)\)",
+                                             text, re.M)}
+
+    def mask(self, name):
+        if name not in self.fields:
+            fail("unknown field " + name)
+        pos, size = self.fields[name]
+        return ((1 << size) - 1) << pos
+
+    def offset(self, entry):
+        if entry.reg not in self.offsets:
+            fail("unknown register " + entry.reg)
+        return self.offsets[entry.reg]
+
+
+class Entry:
+    """Folded writes of one register: terms of [remaining mask, field or None, value expression]"""
+
+    def __init__(self, reg, terms=()):
+        self.reg = reg
+        self.terms = [list(t) for t in terms]
+
+    @property
+    def mask(self):
+        mask = 0
+        for t in self.terms:
+            mask |= t[0]
+        return mask
+
+    def add(self, mask, field, expr):
+        for t in self.terms:
+            t[0] &= ~mask
+        self.terms = [t for t in self.terms if t[0]]
+        self.terms.append([mask, field, expr])
+
+    def c(self, regs, tabs=1):
+        vals = []
+        for mask, field, expr in self.terms:
+            if field is None:
+                val = expr if NUMBER.fullmatch(expr) else "(UINT32)(%s)" % expr
+                full = FULL
+            else:
+                val = "BUILD_FIELD_VAL(%s, %s)" % (field, expr)
+                full = regs.mask(field)
+            vals.append(val if mask == full else "(%s & 0x%08X)" % (val, mask))
+        head = "{ %-36s0x%08X, " % ("MC_INIT_OFFSET(%s)," % self.reg, self.mask)
+        sep = " |\n" + "\t" * tabs + " " * len(head)
+        return "\t" * tabs + head + sep.join(vals) + " },\n"
+
+
+class Segment:
+    """Statements of a speed grade up to a barrier"""
+
+    def __init__(self):
+        self.table = {}             # register -> Entry, constant writes
+        self.setup = {}             # register -> Entry, ddr_setup values and the constant writes over them
+        self.code = []              # statements after the tables
+        self.code_regs = set()      # registers with a statement in code
+        self.barrier = None         # statement that ends the segment
+
+    def shared(self):
+        """What all the speed grades must have in common"""
+        return (self.barrier, self.code, sorted((r, e.terms) for r, e in self.setup.items()))
+
+
+def constant(expr):
+    """Numbers and macros (upper case names) only"""
+    rest = NUMBER.sub(" ", expr)
+    return re.fullmatch(r"[\sA-Z0-9_()+\-*/|&~<>]*", rest) is not None
+
+
+def simple(expr):
+    """ddr_setup fields, numbers and macros: no calls, no side effects"""
+    return re.search(r"\w\s*\(|[^=!<>]=(?!=)|\+\+|--|\?", expr) is None
+
+
+def classify(stmt):
+    """('const' or 'setup', reg, field or None, expr), ('read', var, reg), ('dyn', regs), ('decl',) or
+    ('barrier',)"""
+    flat = " ".join(stmt.split())
+    m = re.fullmatch(r"SET_REG_FIELD\s*\(\s*(%s)\s*,\s*(%s_\w+)\s*,\s*(.*)\)\s*;" % (REG, REG), flat)
+    if m and constant(m.group(3)):
+        return ("const", m.group(1), m.group(2), m.group(3).strip())
+    if m and simple(m.group(3)):
+        return ("setup", m.group(1), m.group(2), m.group(3).strip())
+    m = re.fullmatch(r"REG_WRITE\s*\(\s*(%s)\s*,\s*(.*)\)\s*;" % REG, flat)
+    if m and constant(m.group(2)):
+        return ("const", m.group(1), None, m.group(2).strip())
+    m = re.fullmatch(r"(\w+)\s*=\s*REG_READ\s*\(\s*(%s)\s*\)\s*;" % REG, flat)
+    if m:
+        return ("read", m.group(1), m.group(2))
+    if re.fullmatch(r"(UINT\d+|int|unsigned)\s+\w+(\s*=\s*[\w\s]+)?;", flat):
+        return ("decl",)
+    regs = set(re.findall(r"\b(%s)\b(?!_)" % REG, flat))
+    calls = set(re.findall(r"\b(\w+)\s*\(", flat)) - {"if", "SET_REG_FIELD", "REG_WRITE", "REG_READ",
+                                                       "READ_REG_FIELD"}
+    if regs and not calls and not re.search(r"\b(while|for|do|return|goto)\b|\*\s*\(", flat):
+        return ("dyn", regs)
+    return ("barrier",)
+
+
+def expand(funcs, name, depth=0):
+    out = []
+    for stmt in statements(funcs[name][1]):
+        m = re.fullmatch(r"(\w+)\s*\(\s*\)\s*;", stmt)
+        if m and m.group(1) in INLINE:
+            out += expand(funcs, m.group(1), depth + 1)
+        else:
+            out.append(stmt)
+    return out
+
+
+def indent(stmt, tabs=1):
+    lines = [l.rstrip() for l in stmt.split("\n") if l.strip()]
+    common = min(len(l.expandtabs(8)) - len(l.expandtabs(8).lstrip()) for l in lines[1:]) if len(lines) > 1 else 0
+    first = "\t" * tabs + " ".join(lines[0].split())
+    rest = ["\t" * tabs + l.expandtabs(8)[common:].replace("        ", "\t") for l in lines[1:]]
+    return "\n".join([first] + rest) + "\n"
+
+
+def used(var, stmts):
+    """var is read by one of the statements"""
+    return any(re.search(r"\b%s\b(?!\s*=[^=])" % var, " ".join(s.split())) for s in stmts)
+
+
+def analyse(stmts, regs):
+    """Segments of the statements of a speed grade, and the declarations"""
+    segs = [Segment()]
+    decls = []
+    i = 0
+    while i < len(stmts):
+        stmt = stmts[i]
+        kind = classify(stmt)
+        seg = segs[-1]
+        i += 1
+        if kind[0] == "read":
+            var, reg = kind[1], kind[2]
+            back = i < len(stmts) and re.fullmatch(r"REG_WRITE\s*\(\s*%s\s*,\s*%s\s*\)\s*;" % (reg, var),
+                                                   " ".join(stmts[i].split())) is not None
+            if not used(var, stmts[i + back:]):
+                i += back           # value not used, or written back as it is: no register changes
+                continue
+            kind = ("dyn", {reg})
+        if kind[0] in ("const", "setup") and kind[1] not in seg.code_regs:
+            reg = kind[1]
+            mask = regs.mask(kind[2]) if kind[2] else FULL
+            if kind[0] == "setup" or (reg in seg.setup and seg.setup[reg].mask & mask):
+                seg.setup.setdefault(reg, Entry(reg)).add(mask, kind[2], kind[3])
+            else:
+                seg.table.setdefault(reg, Entry(reg)).add(mask, kind[2], kind[3])
+        elif kind[0] in ("const", "setup"):
+            seg.code.append(indent(stmt))
+        elif kind[0] == "dyn":
+            seg.code_regs.update(kind[1])
+            seg.code.append(indent(stmt))
+        elif kind[0] == "decl":
+            decls.append(stmt)
+        elif re.fullmatch(r"return\s*;", stmt) and i == len(stmts):
+            pass
+        else:
+            seg.barrier = indent(stmt)
+            segs.append(Segment())
+    return segs, decls
+
+
+def layers(grades, regs):
+    """Base tables (the registers written the same in all the speed grades) and per grade delta tables (the
+    other registers), per segment. A register is in one of them: one entry per register access"""
+    names = list(grades)
+    first = grades[names[0]]
+    for name in names[1:]:
+        if [s.shared() for s in grades[name]] != [s.shared() for s in first]:
+            fail("%s and %s differ in more than constant register writes" % (names[0], name))
+    base = []
+    delta = {name: [] for name in names}
+    for k in range(len(first)):
+        tables = [grades[name][k].table for name in names]
+        common = [e for reg, e in tables[0].items() if all(reg in tbl and tbl[reg].terms == e.terms
+                                                           for tbl in tables[1:])]
+        base.append(sorted(common, key=regs.offset))
+        for name, tbl in zip(names, tables):
+            ents = [e for reg, e in tbl.items() if reg not in [c.reg for c in common]]
+            delta[name].append(sorted(ents, key=regs.offset))
+    return base, delta
+
+
+def table(name, ents, regs):
+    out = ["static const MC_INIT_REG_T %s[] =\n{\n" % name]
+    out += [e.c(regs) for e in ents]
+    out.append("};\n\n")
+    return "".join(out)
+
+
+def generate(params, segs, decls, base, delta, regs):
+    out = []
+    out.append("/*---------------------------------------------------------------------------------------------------------*/\n")
+    out.append("/* %-103s */\n" % "Base tables: the register writes common to all the speed grades")
+    out.append("/*---------------------------------------------------------------------------------------------------------*/\n")
+    for k, ents in enumerate(base):
+        if ents:
+            out.append(table("mc_init_base_%d" % k, ents, regs))
+
+    for name, tables in delta.items():
+        out.append("/*---------------------------------------------------------------------------------------------------------*/\n")
+        out.append("/* %-103s */\n" % ("%s delta: the register writes that differ from the base tables" % name))
+        out.append("/*---------------------------------------------------------------------------------------------------------*/\n")
+        if name in GUARD:
+            out.append("#ifdef %s\n" % GUARD[name])
+        for k, ents in enumerate(tables):
+            if ents:
+                out.append(table("%s_%d" % (name, k), ents, regs))
+        out.append("static const MC_INIT_LAYER_T %s_delta[] =\n{\n" % name)
+        for k, ents in enumerate(tables):
+            t = "%s_%d" % (name, k)
+            out.append("\t{ %s, ARRAY_SIZE(%s) },\n" % (t, t) if ents else "\t{ NULL, 0 },\n")
+        out.append("};\n")
+        if name in GUARD:
+            out.append("#endif\n")
+        out.append("\n")
+
+    code = "".join(c for s in segs for c in s.code + [s.barrier or ""])
+    if re.search(r"ddr_setup->\w+(\[[^]]*\])*\s*([-+*/%&|^]|<<|>>)?=(?!=)|(\+\+|--)\s*ddr_setup->|"
+                 r"ddr_setup->\w+\s*(\+\+|--)", code):
+        fail("mc_init_grade code writes ddr_setup, the setup tables are filled before it")
+    out.append("static void mc_init_grade (%s, const MC_GRADE_T *grade)\n{\n" % params)
+    out += [indent(d) for d in decls if used(re.match(r"\w+\s+(\w+)", d).group(1), [code])]
+
+    # the tables of all the segments are declared first (C89), the setup values do not change in the code
+    applied = []
+    for k, seg in enumerate(segs):
+        applied.append(bool(base[k] or seg.setup or any(d[k] for d in delta.values())))
+        if not applied[k]:
+            continue
+        ents = sorted(seg.setup.values(), key=regs.offset)
+        if ents:
+            out.append("\tconst MC_INIT_REG_T setup_%d[] =\n\t{\n" % k)
+            out += [e.c(regs, 2) for e in ents]
+            out.append("\t};\n")
+        out.append("\tconst MC_INIT_LAYER_T layers_%d[] =\n\t{\n" % k)
+        if base[k]:
+            out.append("\t\t{ mc_init_base_%d, ARRAY_SIZE(mc_init_base_%d) },\n" % (k, k))
+        out.append("\t\tgrade->delta[%d],\n" % k)
+        if ents:
+            out.append("\t\t{ setup_%d, ARRAY_SIZE(setup_%d) },\n" % (k, k))
+        out.append("\t};\n")
+    out.append("\n")
+
+    for k, seg in enumerate(segs):
+        if applied[k]:
+            if k:
+                out.append("\n")
+            out.append("\tmc_init_apply_l(layers_%d, ARRAY_SIZE(layers_%d));\n" % (k, k))
+        out += seg.code
+        out.append(seg.barrier or "")
+    out.append("}\n")
+    return "".join(out)
+
+
+HEADER = """\
+/*----------------------------------------------------------------------------*/
+/* SPDX-License-Identifier: GPL-2.0                                           */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   arbel_mc_init_tbl.c                                                      */
+/*            This file contains the MC init register tables.                 */
+/*            Generated by tools/mc_init_gen.py from arbel_mc_init.c          */
+/*            (MC_INIT_REFERENCE code), do not edit                           */
+/* Project:                                                                   */
+/*            SWC HAL                                                         */
+/*----------------------------------------------------------------------------*/
+
+"""
+
+
+def main(argv):
+    check = "-c" in argv
+    with open(SRC) as f:
+        text = strip_comments(f.read())
+    text = preprocess(text, {"MC_INIT_REFERENCE": "1", "MC_CAPABILITY_CLK_TYPE_1600": "1"})
+    funcs = functions(text)
+    regs = Regs(REGS)
+
+    grades = {}
+    decls = []
+    params = None
+    stats = []
+    for name in ROOTS:
+        if name not in funcs:
+            fail(name + " not found")
+        if params not in (None, funcs[name][0]):
+            fail(name + " parameters differ")
+        params = funcs[name][0]
+        stmts = expand(funcs, name)
+        grades[name], d = analyse(stmts, regs)
+        decls += [x for x in d if x not in decls]
+        consts = sum(1 for s in stmts if classify(s)[0] == "const")
+        stats.append("%s: %d constant writes" % (name, consts))
+    base, delta = layers(grades, regs)
+    stats.append("base: %d registers" % sum(len(b) for b in base))
+    stats += ["%s delta: %d registers" % (name, sum(len(t) for t in tables)) for name, tables in delta.items()]
+
+    code = generate(params, grades[ROOTS[-1]], decls, base, delta, regs)
+    result = (HEADER + code).rstrip("\n") + "\n"
+
+    if check:
+        with open(OUT) as f:
+            if f.read() != result:
+                fail(os.path.relpath(OUT, ROOT) + " is not up to date, run tools/mc_init_gen.py")
+        return
+    with open(OUT, "w") as f:
+        f.write(result)
+    for s in stats:
+        print(s)
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
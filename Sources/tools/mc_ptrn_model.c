@@ -0,0 +1,437 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mc_ptrn_model.c                                                          */
+/*            Host check of the DRAM pattern kernels against stuck and flaky  */
+/*            DQs (SWC_HAL/ModuleDrivers/mc/4/mc_drv_ptrn.c)                  */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+/*
+ * build and run (from Sources):
+ *   make -f makefile check, the binary is Images/check/mc_ptrn_model, built with BOOTBLOCK_SIM
+ * BOOTBLOCK_SIM sends MEMR / MEMW to SIM_MMIO_Read / SIM_MMIO_Write, the DRAM model below. CopyBlock64 and
+ * XorOrBlock64 (v8_utils.S) are replaced by C loops over the same model.
+ *
+ * usage: mc_ptrn_model [seed]
+ *
+ * The DRAM is 16 bits wide: byte address a is on lane a & 1, so bit k of the byte is DQ (a & 1) * 8 + k. A
+ * DQ may be stuck at 0 or at 1, or flaky: a read of it flips with a given rate. The faults are applied to
+ * every read, of any size.
+ * 1. Every kernel alone, with every DQ stuck at 0 and at 1: the ber must be the DQ when the kernel wrote the
+ *    other value on it, else 0. Only FFFFFFFF and 00000000 (all the DQs) and the 55555555 to 99999999
+ *    patterns (half of the DQs of each level) write one value on a DQ. With all the DQs stuck, a kernel
+ *    that finds them all must stop within MC_PTRN_RAM2_CHUNK bytes.
+ * 2. MC_MemStressTest and MC_MemStressTestLong (quick or not, random SweepBitMask) with random stuck DQs:
+ *    the ber, g_fail_rate_0 / g_fail_rate_1 and the number of kernels run before the early stop must be the
+ *    ones of the old code (tools/mc_ptrn_ref.c), and the last kernel must stop as in 1. With every bit of
+ *    the SweepBitMask set, the new set runs no kernel and returns 0xFFFF, the old one ran the byte lane
+ *    kernel first: only the ber is compared.
+ * 3. The same with flaky DQs: no other bit may fail, and a DQ that flips once in 8 reads must be found by
+ *    both. The DQs found at one flip in 4096 reads are counted for both.
+ * 4. The sweep sets (MC_PTRN_Sweep_l) with stuck and flaky DQs, as in 2 and 3.
+ * The ECC path (bECC, GetECCSyndrom) has no caller and is not checked.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "defs.h"
+#include "tool_check.h"
+
+#define MODEL_DRAM_SIZE         0x11000         /* MC_PTRN_ADDR + MC_PTRN_RAM2_SIZE                */
+#define MODEL_RAM2_SIZE         0x10000
+#define MODEL_FAULTS            500
+#define MODEL_SWEEP_TYPES       6               /* SWEEP_OUT_DQ to SWEEP_OUT_LANE of mc_drv.h      */
+
+#undef  REG_WRITE
+#define REG_WRITE(reg, val)
+#define PHY_LANE_SEL            0
+#define DENALI_CTL_145          0
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* DRAM model                                                                                              */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT8   model_dram[MODEL_DRAM_SIZE];
+static UINT8   model_ram2[MODEL_RAM2_SIZE] __attribute__((aligned(16)));
+static UINT16  model_stuck0;            /* DQs stuck at 0                                                  */
+static UINT16  model_stuck1;            /* DQs stuck at 1                                                  */
+static UINT16  model_flaky;             /* DQs that flip once in model_flaky_rate reads                    */
+static UINT32  model_flaky_rate;
+static UINT16  model_written0;          /* DQs written at 0 / at 1 since model_reset                       */
+static UINT16  model_written1;
+static UINT32  model_kernels;           /* writes at MC_PTRN_ADDR (one per kernel, and the dummy access)   */
+static UINT32  model_reads;             /* bytes read since the last write at MC_PTRN_ADDR                 */
+
+#define RAM2_BASE_ADDR          ((UINT64)model_ram2)
+
+static void model_reset (void)
+{
+	model_written0 = 0;
+	model_written1 = 0;
+	model_kernels = 0;
+	model_reads = 0;
+}
+
+static UINT8 model_read8 (UINT64 addr)
+{
+	UINT32 shift = (addr & 0x1) * 8;
+	UINT8  val;
+	UINT32 ibit;
+
+	if (addr >= MODEL_DRAM_SIZE)
+	{
+		printf("model: read at %#llx\n", (unsigned long long)addr);
+		exit(1);
+	}
+
+	model_reads++;
+	val = model_dram[addr];
+	val |= (UINT8)(model_stuck1 >> shift);
+	val &= (UINT8)~(model_stuck0 >> shift);
+	for (ibit = 0; ibit < 8; ibit++)
+	{
+		if (((model_flaky >> (shift + ibit)) & 0x1) && ((tool_rand() % model_flaky_rate) == 0))
+			val ^= (UINT8)(1 << ibit);
+	}
+
+	return val;
+}
+
+static void model_write8 (UINT64 addr, UINT8 val)
+{
+	UINT32 shift = (addr & 0x1) * 8;
+
+	if (addr >= MODEL_DRAM_SIZE)
+	{
+		printf("model: write at %#llx\n", (unsigned long long)addr);
+		exit(1);
+	}
+
+	model_dram[addr] = val;
+	model_written1 |= (UINT16)(val << shift);
+	model_written0 |= (UINT16)((UINT8)~val << shift);
+}
+
+UINT64 SIM_MMIO_Read (UINT64 addr, UINT size)
+{
+	UINT64 val = 0;
+	UINT   i;
+
+	for (i = 0; i < size; i++)
+		val |= (UINT64)model_read8(addr + i) << (i * 8);
+
+	return val;
+}
+
+void SIM_MMIO_Write (UINT64 addr, UINT size, UINT64 val)
+{
+	UINT i;
+
+	if (addr == 0x1000)
+	{
+		model_kernels++;
+		model_reads = 0;
+	}
+	for (i = 0; i < size; i++)
+		model_write8(addr + i, (UINT8)(val >> (i * 8)));
+}
+
+void *CopyBlock64 (void *dstPtr, const void *srcPtr, unsigned long nBytes)
+{
+	unsigned long i;
+
+	if ((UINT64)dstPtr == 0x1000)
+	{
+		model_kernels++;
+		model_reads = 0;
+	}
+	for (i = 0; i < nBytes; i++)
+		model_write8((UINT64)dstPtr + i, ((const UINT8 *)srcPtr)[i]);
+
+	return dstPtr;
+}
+
+unsigned long XorOrBlock64 (const void *dataPtr, const void *ptrnPtr, unsigned long nBytes)
+{
+	unsigned long diff = 0;
+	unsigned long i;
+
+	for (i = 0; i < nBytes; i += sizeof(UINT64))
+		diff |= SIM_MMIO_Read((UINT64)dataPtr + i, 8) ^ *(const UINT64 *)((const UINT8 *)ptrnPtr + i);
+
+	return diff;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Stubs of mc_drv.c and mc_drv_mem_test.c                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 volatile g_fail_rate_0;
+static UINT32 volatile g_fail_rate_1;
+
+static UINT16 GetECCSyndrom (UINT32 readVal)
+{
+	return 0;
+}
+
+/* stand-in for the golden numbers: a walking bit per lane and its complement */
+#define MODEL_GOLDEN_1(i)       ((0x00010001U << ((i) % 16)) ^ (((i) & 0x1) ? 0xFFFFFFFFU : 0))
+#define MODEL_GOLDEN_4(i)       MODEL_GOLDEN_1(i), MODEL_GOLDEN_1((i) + 1), \
+				MODEL_GOLDEN_1((i) + 2), MODEL_GOLDEN_1((i) + 3)
+#define MODEL_GOLDEN_16(i)      MODEL_GOLDEN_4(i), MODEL_GOLDEN_4((i) + 4), \
+				MODEL_GOLDEN_4((i) + 8), MODEL_GOLDEN_4((i) + 12)
+#define MODEL_GOLDEN_64(i)      MODEL_GOLDEN_16(i), MODEL_GOLDEN_16((i) + 16), \
+				MODEL_GOLDEN_16((i) + 32), MODEL_GOLDEN_16((i) + 48)
+
+const UINT32 Golden_Numbers[256] __attribute__((aligned(16))) =
+{
+	MODEL_GOLDEN_64(0), MODEL_GOLDEN_64(64), MODEL_GOLDEN_64(128), MODEL_GOLDEN_64(192)
+};
+
+#include "../SWC_HAL/ModuleDrivers/mc/4/mc_drv_ptrn.c"
+#include "mc_ptrn_ref.c"
+
+static const char *model_kernel_name[] =
+{
+	"BYTE_LANE", "00FFFF00", "FF0000FF", "FFFF0000", "0000FFFF", "FFFFFFFF", "00000000", "55555555", "AAAAAAAA",
+	"33333333", "99999999", "WALK_1", "WALK_0", "WALK_DEAD", "WALK_DEAD1", "WALK_DEAD2", "PRBS7", "PRBS15", "SSO",
+	"XTALK", "GOLDEN", "RAM2",
+};
+
+typedef struct
+{
+	UINT16 ber;
+	UINT32 fail_rate_0;
+	UINT32 fail_rate_1;
+	UINT32 kernels;
+	UINT32 reads;                   /* by the last kernel                                              */
+} MODEL_RESULT_T;
+
+typedef enum
+{
+	MODEL_TEST_SHORT,               /* MC_MemStressTest                                                */
+	MODEL_TEST_LONG,                /* MC_MemStressTestLong                                            */
+	MODEL_TEST_SWEEP,               /* MC_PTRN_Sweep_l, no reference                                   */
+} MODEL_TEST_T;
+
+static const char *model_test_name[] = { "MC_MemStressTest", "MC_MemStressTestLong", "MC_PTRN_Sweep_l" };
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_run                                                                              */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  test -   MODEL_TEST_T                                                                  */
+/*                  ref -    run the old code                                                              */
+/*                  quick -  bQuick, or the sweep type of MODEL_TEST_SWEEP                                 */
+/*                  mask -   SweepBitMask (not MODEL_TEST_SHORT)                                           */
+/*                  result - ber, counters and kernels run                                                 */
+/* Returns:         none                                                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static void model_run (MODEL_TEST_T test, BOOLEAN ref, int quick, UINT16 mask, MODEL_RESULT_T *result)
+{
+	model_reset();
+	g_fail_rate_0 = 0;
+	g_fail_rate_1 = 0;
+
+	if (test == MODEL_TEST_SHORT)
+		result->ber = ref ? REF_MemStressTest(FALSE, (BOOLEAN)quick) :
+				    MC_PTRN_Run_l(quick ? &mc_ptrn_set_short_quick : &mc_ptrn_set_short, FALSE, 0);
+	else if (test == MODEL_TEST_LONG)
+		result->ber = ref ? REF_MemStressTestLong(FALSE, (BOOLEAN)quick, mask, FALSE) :
+				    MC_PTRN_Run_l(quick ? &mc_ptrn_set_long_quick : &mc_ptrn_set_long, FALSE, mask);
+	else
+		result->ber = MC_PTRN_Sweep_l(quick, mask);
+
+	result->fail_rate_0 = g_fail_rate_0;
+	result->fail_rate_1 = g_fail_rate_1;
+	result->kernels = model_kernels;
+	result->reads = model_reads;
+}
+
+static UINT16 model_random_dqs (void)
+{
+	UINT16 dqs = 0;
+	UINT32 count = 1 + (tool_rand() % 4);
+
+	/* 1 to 4 DQs, sometimes all of them (early stop) */
+	if ((tool_rand() % 16) == 0)
+		return 0xFFFF;
+	while (count--)
+		dqs |= (UINT16)(1 << (tool_rand() % 16));
+
+	return dqs;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_check_kernels                                                                    */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         number of errors: every kernel alone with every DQ stuck at 0 and at 1                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 model_check_kernels (void)
+{
+	MC_PTRN_SET_T set;
+	UINT8         kernel;
+	UINT16        ber, expected;
+	UINT32        errors = 0, untested = 0;
+	int           dq, level;
+
+	set.kernel = &kernel;
+	set.count = 1;
+
+	for (kernel = MC_PTRN_BYTE_LANE; kernel <= MC_PTRN_RAM2; kernel++)
+	{
+		for (dq = 0; dq < 16; dq++)
+		{
+			for (level = 0; level < 2; level++)
+			{
+				model_stuck0 = level ? 0 : (UINT16)(1 << dq);
+				model_stuck1 = level ? (UINT16)(1 << dq) : 0;
+				model_reset();
+				ber = MC_PTRN_Run_l(&set, FALSE, 0);
+				expected = (model_stuck0 & model_written1) | (model_stuck1 & model_written0);
+
+				if (expected == 0)
+					untested++;
+				if (ber != expected)
+				{
+					TOOL_ERROR(errors, "%s: DQ%d stuck at %d: ber %04X, expected %04X\n", model_kernel_name[kernel],
+					           dq, level, ber, expected);
+				}
+			}
+		}
+
+		/* every DQ stuck: the kernel stops at the first compare chunk */
+		model_stuck0 = (UINT16)tool_rand();
+		model_stuck1 = (UINT16)~model_stuck0;
+		model_reset();
+		ber = MC_PTRN_Run_l(&set, FALSE, 0);
+		if ((ber != ((model_stuck0 & model_written1) | (model_stuck1 & model_written0))) ||
+		    ((ber == 0xFFFF) && (model_reads > MC_PTRN_RAM2_CHUNK)))
+		{
+			TOOL_ERROR(errors, "%s: every DQ stuck (%04X at 0): ber %04X, %u bytes read\n", model_kernel_name[kernel],
+			           model_stuck0, ber, model_reads);
+		}
+	}
+	model_stuck0 = 0;
+	model_stuck1 = 0;
+
+	printf("%u kernels x 16 DQs x stuck at 0 / 1: %u errors, %u faults not seen by a one value kernel\n",
+	       (UINT32)ARRAY_SIZE(model_kernel_name), errors, untested);
+
+	return errors;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_check_tests                                                                      */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         number of errors: the stress tests and the sweep sets with random faults               */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 model_check_tests (void)
+{
+	MODEL_RESULT_T result, ref;
+	MODEL_TEST_T   test;
+	UINT32         fail = 0, runs = 0, found_new = 0, found_ref = 0, early = 0;
+	UINT32         i, fault;
+	UINT16         mask, dqs, expected;
+	int            quick;
+	BOOLEAN        compare;
+
+	for (i = 0; i < MODEL_FAULTS; i++)
+	{
+		for (fault = 0; fault < 3; fault++)
+		{
+			/* stuck DQs, flaky DQs at 1 / 8, flaky DQs at 1 / 4096 */
+			dqs = model_random_dqs();
+			model_stuck0 = (fault == 0) ? (UINT16)(dqs & tool_rand()) : 0;
+			model_stuck1 = (fault == 0) ? (UINT16)(dqs & ~model_stuck0) : 0;
+			model_flaky = (fault == 0) ? 0 : dqs;
+			model_flaky_rate = (fault == 1) ? 8 : 4096;
+
+			for (test = MODEL_TEST_SHORT; test <= MODEL_TEST_SWEEP; test++)
+			{
+				quick = (test == MODEL_TEST_SWEEP) ? (int)(tool_rand() % MODEL_SWEEP_TYPES) : (int)(tool_rand() & 0x1);
+				mask = 0;
+				if (test != MODEL_TEST_SHORT)
+					mask = ((tool_rand() % 8) == 0) ? 0xFFFF : (UINT16)(tool_rand() & tool_rand() & tool_rand());
+
+				runs++;
+				model_run(test, FALSE, quick, mask, &result);
+				expected = mask | dqs;
+				if (fault == 0)
+					early += (dqs == 0xFFFF);
+
+				/* stuck and fast flaky DQs are all found, no other bit fails */
+				if ((fault < 2) ? (result.ber != expected) : ((result.ber & ~expected) != 0))
+				{
+					TOOL_ERROR(fail, "%s %d mask %04X, DQs %04X %s: ber %04X\n", model_test_name[test], quick, mask,
+					           dqs, (fault == 0) ? "stuck" : "flaky", result.ber);
+				}
+
+				if (test == MODEL_TEST_SWEEP)
+					continue;
+
+				model_run(test, TRUE, quick, mask, &ref);
+				if (fault == 2)
+				{
+					found_new += __builtin_popcount(result.ber & dqs & ~mask);
+					found_ref += __builtin_popcount(ref.ber & dqs & ~mask);
+					continue;
+				}
+
+				/* the old code reports the same, kernel by kernel for stuck DQs */
+				compare = (fault == 0) && (mask != 0xFFFF);
+				if ((ref.ber != result.ber) || (compare && ((ref.fail_rate_0 != result.fail_rate_0) ||
+				    (ref.fail_rate_1 != result.fail_rate_1) || (ref.kernels != result.kernels))) ||
+				    ((fault == 0) && (result.ber == 0xFFFF) && (result.reads > MC_PTRN_RAM2_CHUNK)))
+				{
+					TOOL_ERROR(fail, "%s %d mask %04X, DQs %04X %s: ber %04X rate %u/%u kernels %u, ref ber %04X rate "
+					           "%u/%u kernels %u\n", model_test_name[test], quick, mask, dqs,
+					           (fault == 0) ? "stuck" : "flaky", result.ber, result.fail_rate_1, result.fail_rate_0,
+					           result.kernels, ref.ber, ref.fail_rate_1, ref.fail_rate_0, ref.kernels);
+				}
+			}
+		}
+	}
+	model_stuck0 = 0;
+	model_stuck1 = 0;
+	model_flaky = 0;
+
+	printf("%u runs with random faults (%u with every DQ stuck), %u errors\n", runs, early, fail);
+	printf("DQs flaky at 1 / 4096 found: %u (old code %u)\n", found_new, found_ref);
+
+	return fail;
+}
+
+int main (int argc, char *argv[])
+{
+	MODEL_RESULT_T result;
+	UINT32         errors = 0;
+	UINT32         i;
+
+	tool_seed(argc, argv, 1);
+
+	for (i = 0; i < MODEL_RAM2_SIZE; i++)
+		model_ram2[i] = (UINT8)tool_rand();
+
+	/* no fault: nothing fails */
+	model_run(MODEL_TEST_LONG, FALSE, FALSE, 0, &result);
+	if ((result.ber != 0) || (result.fail_rate_0 != 0) || (result.fail_rate_1 != 0))
+	{
+		printf("no fault: ber %04X rate %u/%u\n", result.ber, result.fail_rate_1, result.fail_rate_0);
+		errors++;
+	}
+
+	errors += model_check_kernels();
+	errors += model_check_tests();
+
+	printf("%u errors\n", errors);
+
+	return (errors != 0);
+}
@@ -0,0 +1,743 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mc_ptrn_ref.c                                                            */
+/*            MC_MemStressTest and MC_MemStressTestLong, as they were in      */
+/*            mc_drv.c and mc_drv_sweeps.c before mc_drv_ptrn.c, with the     */
+/*            DRAM accesses as MEMR / MEMW. Reference of                      */
+/*            tools/mc_ptrn_model.c                                           */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:    REF_MemStressTest                                                                          */
+/*                                                                                                         */
+/* Parameters:             bECC : if true, mem test is for ECC lane. Can't sweep it directly, must check ber bit*/
+/* Returns:                bitwise error in UINT16 (one UINT8 for each lane)                               */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                        This routine does memory test with a list of patterns. Used for sweep.           */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT16 REF_MemStressTest(BOOLEAN bECC, BOOLEAN bQuick)
+{
+	UINT16 ber = 0;
+
+	const UINT32 aPtrn[6] = {0xFFFFFFFF, 0x00000000, 0x55555555, 0xAAAAAAAA, 0x33333333, 0x99999999};
+	const UINT32 iPtrnSize = 0x100;
+	const UINT iWalkers = 0x10; // NTIL - there is no point to shift 0x0001 more then 16 steps ;
+
+	UINT32 iCnt1 = 0;
+	UINT32 iCnt2 = 0;
+
+	extern UINT32 BOOTBLOCK_IMAGE_START;
+	extern UINT32 BOOTBLOCK_IMAGE_END;
+
+	volatile UINT16 *dstAddrStart = (UINT16 *)0x1000;
+
+	volatile UINT32 *dstAddrStartLong = (UINT32 *)0x1000;
+
+	// dummy access to DRAM:
+	IOW32(0x1000, IOR32(0x1000));
+	REG_WRITE(PHY_LANE_SEL, 0);
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*                    Fixed pattern test                                                               */
+	/*-----------------------------------------------------------------------------------------------------*/
+	for (iCnt1 = 0; iCnt1 < ARRAY_SIZE(aPtrn); iCnt1++)
+	{
+		dstAddrStart = (UINT16 *)0x1000;
+		dstAddrStartLong = (UINT32 *)0x1000;
+		REG_WRITE(DENALI_CTL_145, 0xFFFFFFFF);
+		REG_WRITE(DENALI_CTL_145, 0);
+
+		/*-----------------------------------------------------------------------------------------------------*/
+		/*  Write pattern                                                                                      */
+		/*-----------------------------------------------------------------------------------------------------*/
+		// memset((void *)dstAddrStart, (UINT8)aPtrn[iCnt1], iPtrnSize);
+		for (iCnt2 = 0; iCnt2 < iPtrnSize; iCnt2 += 4)
+		{
+			MEMW32(dstAddrStartLong, (UINT32)aPtrn[iCnt1]);
+
+			// clear all interrupt status bits:
+			REG_WRITE(DENALI_CTL_145, 0xFFFFFFFF);
+			REG_WRITE(DENALI_CTL_145, 0);
+
+			dstAddrStartLong++;
+		}
+
+		dstAddrStart = (UINT16 *)0x1000;
+		dstAddrStartLong = (UINT32 *)0x1000;
+		/*-----------------------------------------------------------------------------------------------------*/
+		/* Verify pattern                                                                                      */
+		/*-----------------------------------------------------------------------------------------------------*/
+		for (iCnt2 = 0; iCnt2 < iPtrnSize; iCnt2 += 2)
+		{
+			if (bECC == TRUE)
+			{
+				ber |= GetECCSyndrom(MEMR16(dstAddrStart));
+			}
+			else
+			{
+				ber |= MEMR16(dstAddrStart) ^ aPtrn[iCnt1];
+			}
+			dstAddrStart++;
+		}
+
+		if ((iCnt1 == 1) && (bQuick == TRUE))
+		{
+			return ber;
+		}
+
+		if (ber == 0xFFFF)
+		{
+			return ber;
+		}
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Walking-1 pattern test                                                                              */
+	/*-----------------------------------------------------------------------------------------------------*/
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*  Write pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		MEMW16(dstAddrStart, (0x0001 << (iCnt2)));
+		dstAddrStart++;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Verify pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		if (bECC == TRUE)
+		{
+			ber |= GetECCSyndrom(MEMR16(dstAddrStart));
+		}
+		else
+		{
+			ber |= MEMR16(dstAddrStart) ^ (0x0001 << (iCnt2));
+		}
+		dstAddrStart++;
+	}
+	if (ber == 0xFFFF)
+	{
+		return ber;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Walking-0 pattern test                                                                              */
+	/*-----------------------------------------------------------------------------------------------------*/
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*  Write pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		MEMW16(dstAddrStart, 0xFFFF - (0x0001 << (iCnt2)));
+		dstAddrStart++;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Verify pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		if (bECC == TRUE)
+		{
+			ber |= GetECCSyndrom(MEMR16(dstAddrStart));
+		}
+		else
+		{
+			ber |= MEMR16(dstAddrStart) ^ (0xFFFF - (0x0001 << (iCnt2)));
+		}
+		dstAddrStart++;
+	}
+	if (ber == 0xFFFF)
+	{
+		return ber;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*                   Walking dead pattern test                                                         */
+	/*-----------------------------------------------------------------------------------------------------*/
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*  Write pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		if ((iCnt2 % 2) == 0)
+		{
+			MEMW16(dstAddrStart, 0xFFFF - (0x0001 << (iCnt2 / 2)));
+		}
+		else
+		{
+			MEMW16(dstAddrStart, (0x0001 << (iCnt2 / 2)));
+		}
+		dstAddrStart++;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Verify pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		if (bECC == TRUE)
+		{
+			ber |= GetECCSyndrom(MEMR16(dstAddrStart));
+		}
+		else
+		{
+			if ((iCnt2 % 2) == 0)
+			{
+				ber |= MEMR16(dstAddrStart) ^ (0xFFFF - (0x0001 << (iCnt2 / 2)));
+			}
+			else
+			{
+				ber |= MEMR16(dstAddrStart) ^ (0x0001 << (iCnt2 / 2));
+			}
+		}
+		dstAddrStart++;
+	}
+	if (ber == 0xFFFF)
+	{
+		return ber;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*                    Walking dead1 pattern test                                                       */
+	/*-----------------------------------------------------------------------------------------------------*/
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*  Write pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		if ((iCnt2 % 2) == 0)
+		{
+			MEMW16(dstAddrStart, 0xFFFF);
+		}
+		else
+		{
+			MEMW16(dstAddrStart, (0x0001 << (iCnt2 / 2)));
+		}
+		dstAddrStart++;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Verify pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		if (bECC == TRUE)
+		{
+			ber |= GetECCSyndrom(MEMR16(dstAddrStart));
+		}
+		else
+		{
+			if ((iCnt2 % 2) == 0)
+			{
+				ber |= MEMR16(dstAddrStart) ^ 0xFFFF;
+			}
+			else
+			{
+				ber |= MEMR16(dstAddrStart) ^ (0x0001 << (iCnt2 / 2));
+			}
+		}
+
+		dstAddrStart++;
+	}
+	if (ber == 0xFFFF)
+	{
+		return ber;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*                     Walking dead2 pattern test                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*  Write pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		if ((iCnt2 % 2) == 0)
+		{
+			MEMW16(dstAddrStart, 0xFFFF - (0x0001 << (iCnt2 / 2)));
+		}
+		else
+		{
+			MEMW16(dstAddrStart, 0);
+		}
+		dstAddrStart++;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Verify pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		if (bECC == TRUE)
+		{
+			ber |= GetECCSyndrom(MEMR16(dstAddrStart));
+		}
+		else
+		{
+			if ((iCnt2 % 2) == 0)
+			{
+				ber |= MEMR16(dstAddrStart) ^ (0xFFFF - (0x0001 << (iCnt2 / 2)));
+			}
+			else
+			{
+				ber |= MEMR16(dstAddrStart) ^ 0;
+			}
+		}
+		dstAddrStart++;
+	}
+	if (ber == 0xFFFF)
+	{
+		return ber;
+	}
+
+	// NTIL: move bootblock test to last test since this test take too much time (first it copy then it check)
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*  Use RAM2 as a pseudo random pattern to test the DDR                                                */
+	/*  Copy BB code segment to the DDR                                                                    */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart = (UINT16 *)0x1000;
+
+	for (iCnt2 = 0; iCnt2 < 0x10000 /* (&(UINT32)BOOTBLOCK_IMAGE_END - RAM2_MEMORY_SIZE)*/; iCnt2 += sizeof(UINT16))
+	{
+		MEMW16(dstAddrStart, *(UINT16 *)(UINT64)(RAM2_BASE_ADDR + iCnt2));
+		dstAddrStart++;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Compare BB code segment to the DDR                                                                  */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart = (UINT16 *)0x1000;
+
+	for (iCnt2 = 0; iCnt2 < 0x10000 /* (&(UINT32)BOOTBLOCK_IMAGE_END - RAM2_MEMORY_SIZE)  */; iCnt2 += sizeof(UINT16))
+	{
+		if (bECC == TRUE)
+		{
+			ber |= GetECCSyndrom(*(UINT16 *)(UINT64)(RAM2_BASE_ADDR + iCnt2));
+		}
+		else
+		{
+			ber |= MEMR16(dstAddrStart) ^ *(UINT16 *)(UINT64)(RAM2_BASE_ADDR + iCnt2);
+		}
+
+		// NTIL: save time and return as soos as posiable when there is total bits error (don't wait to verify to complete)
+		if (ber == 0xFFFF)
+			return ber;
+
+		dstAddrStart++;
+	}
+
+	return ber;
+}
+
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        REF_MemStressTestLong                                                                  */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  abort_on_error -                                                                       */
+/*                  bECC -                                                                                 */
+/*                  bQuick -                                                                               */
+/*                  SweepBitMask -                                                                         */
+/*                                                                                                         */
+/* Returns:                                                                                                */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine performs...                                                               */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT16 REF_MemStressTestLong (BOOLEAN bECC, BOOLEAN bQuick, UINT16 SweepBitMask, BOOLEAN abort_on_error)
+{
+	UINT16 ber = 0;
+
+	ber = SweepBitMask; // bits that are not of our interest, mark as fail so test will be complete faster
+
+	const UINT32 aPtrn[] = {0x00FFFF00, 0xFF0000FF, 0xFFFF0000, 0x0000FFFF};
+	const UINT32 iPtrnSize = 0x100;
+	const UINT iWalkers = 0x10; // NTIL - there is no point to shift 0x0001 more then 16 steps (0 to 15);
+
+	UINT32 iCnt1 = 0;
+	UINT32 iCnt2 = 0;
+
+	extern UINT32 BOOTBLOCK_IMAGE_START;
+	extern UINT32 BOOTBLOCK_IMAGE_END;
+
+	volatile UINT8 *dstAddrStart_U8 = (UINT8 *)0x1000;
+	volatile UINT16 *dstAddrStart_U16 = (UINT16 *)0x1000;
+	volatile UINT32 *dstAddrStart_U32 = (UINT32 *)0x1000;
+
+	// dummy access to DRAM:
+	IOW32(0x1000, IOR32(0x1000));
+	REG_WRITE(PHY_LANE_SEL, 0);
+
+	// clear all interrupt status bits:
+	REG_WRITE(DENALI_CTL_145, 0xFFFFFFFF);
+	REG_WRITE(DENALI_CTL_145, 0);
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*                    Write Byte accsess test                                                          */
+	/*-----------------------------------------------------------------------------------------------------*/
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*  Write pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U8 = (UINT8 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iPtrnSize; iCnt2++)
+	{
+		MEMW8(dstAddrStart_U8, 0xFF);
+		dstAddrStart_U8++;
+		MEMW8(dstAddrStart_U8, 0x00);
+		dstAddrStart_U8++;
+		MEMW8(dstAddrStart_U8, 0x00);
+		dstAddrStart_U8++;
+		MEMW8(dstAddrStart_U8, 0xFF);
+		dstAddrStart_U8++;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Verify pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U32 = (UINT32 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iPtrnSize; iCnt2++)
+	{
+		UINT32 tmp_ber = MEMR32(dstAddrStart_U32) ^ 0xFF0000FF;
+		ber |= (UINT16)(tmp_ber >> 0);
+		ber |= (UINT16)(tmp_ber >> 16);
+		dstAddrStart_U32++;
+
+		if (tmp_ber & 0x00FF)
+			g_fail_rate_0++; // counter is 256 if it fail all the time
+
+		if (tmp_ber & 0xFF00)
+			g_fail_rate_1++; // counter is 256 if it fail all the time
+	}
+
+	if (ber == 0xFFFF)
+	{
+		return ber;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*                    Fixed pattern test                                                               */
+	/*-----------------------------------------------------------------------------------------------------*/
+	for (iCnt1 = 0; iCnt1 < ARRAY_SIZE(aPtrn); iCnt1++)
+	{
+		/*----------------------------------------------------------------------------------------------------*/
+		/*  Write pattern                                                                                     */
+		/*----------------------------------------------------------------------------------------------------*/
+		// memset((void *)dstAddrStart, (UINT8)aPtrn[iCnt1], iPtrnSize);
+		dstAddrStart_U32 = (UINT32 *)0x1000;
+		for (iCnt2 = 0; iCnt2 < iPtrnSize; iCnt2 += 4)
+		{
+			MEMW32(dstAddrStart_U32, aPtrn[iCnt1]);
+			dstAddrStart_U32++;
+		}
+
+		/*-----------------------------------------------------------------------------------------------------*/
+		/* Verify pattern                                                                                      */
+		/*-----------------------------------------------------------------------------------------------------*/
+		// NTIL: removed GetECCSyndrom. There was a bug in the origin code !!! the bug seen when changing aPtrn data from 0xFFFFFFFF to 0xFFFF0000
+		dstAddrStart_U32 = (UINT32 *)0x1000;
+		for (iCnt2 = 0; iCnt2 < iPtrnSize; iCnt2 += 4)
+		{
+			UINT32 tmp_ber = MEMR32(dstAddrStart_U32) ^ aPtrn[iCnt1];
+			ber |= (UINT16)(tmp_ber >> 0);
+			ber |= (UINT16)(tmp_ber >> 16);
+
+			dstAddrStart_U32++;
+		}
+
+		if ((iCnt1 == 1) && (bQuick == TRUE))
+		{
+			return ber;
+		}
+
+		if (ber == 0xFFFF)
+		{
+			return ber;
+		}
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Walking-1 pattern test                                                                              */
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*  Write pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U16 = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		MEMW16(dstAddrStart_U16, (0x0001 << (iCnt2)));
+		dstAddrStart_U16++;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Verify pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U16 = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		if (bECC == TRUE)
+		{
+			ber |= GetECCSyndrom(MEMR16(dstAddrStart_U16));
+		}
+		else
+		{
+			ber |= MEMR16(dstAddrStart_U16) ^ (0x0001 << (iCnt2));
+		}
+		dstAddrStart_U16++;
+	}
+	if (ber == 0xFFFF)
+	{
+		return ber;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Walking-0 pattern test                                                                              */
+	/*-----------------------------------------------------------------------------------------------------*/
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*  Write pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U16 = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		MEMW16(dstAddrStart_U16, 0xFFFF - (0x0001 << (iCnt2)));
+		dstAddrStart_U16++;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Verify pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U16 = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < iWalkers; iCnt2++)
+	{
+		if (bECC == TRUE)
+		{
+			ber |= GetECCSyndrom(MEMR16(dstAddrStart_U16));
+		}
+		else
+		{
+			ber |= MEMR16(dstAddrStart_U16) ^ (0xFFFF - (0x0001 << (iCnt2)));
+		}
+		dstAddrStart_U16++;
+	}
+	if (ber == 0xFFFF)
+	{
+		return ber;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*                   Walking dead pattern test                                                         */
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*  Write pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U16 = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < (iWalkers * 2); iCnt2++)
+	{
+		if ((iCnt2 % 2) == 0)
+		{
+			MEMW16(dstAddrStart_U16, 0xFFFF - (0x0001 << (iCnt2 / 2)));
+		}
+		else
+		{
+			MEMW16(dstAddrStart_U16, (0x0001 << (iCnt2 / 2)));
+		}
+		dstAddrStart_U16++;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Verify pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U16 = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < (iWalkers * 2); iCnt2++)
+	{
+		if (bECC == TRUE)
+		{
+			ber |= GetECCSyndrom(MEMR16(dstAddrStart_U16));
+		}
+		else
+		{
+			if ((iCnt2 % 2) == 0)
+			{
+				ber |= MEMR16(dstAddrStart_U16) ^ (0xFFFF - (0x0001 << (iCnt2 / 2)));
+			}
+			else
+			{
+				ber |= MEMR16(dstAddrStart_U16) ^ (0x0001 << (iCnt2 / 2));
+			}
+		}
+		dstAddrStart_U16++;
+	}
+	if (ber == 0xFFFF)
+	{
+		return ber;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*                    Walking dead1 pattern test                                                       */
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*  Write pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U16 = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < (iWalkers * 2); iCnt2++)
+	{
+		if ((iCnt2 % 2) == 0)
+		{
+			MEMW16(dstAddrStart_U16, 0xFFFF);
+		}
+		else
+		{
+			MEMW16(dstAddrStart_U16, (0x0001 << (iCnt2 / 2)));
+		}
+		dstAddrStart_U16++;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Verify pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U16 = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < (iWalkers * 2); iCnt2++)
+	{
+		if (bECC == TRUE)
+		{
+			ber |= GetECCSyndrom(MEMR16(dstAddrStart_U16));
+		}
+		else
+		{
+			if ((iCnt2 % 2) == 0)
+			{
+				ber |= MEMR16(dstAddrStart_U16) ^ 0xFFFF;
+			}
+			else
+			{
+				ber |= MEMR16(dstAddrStart_U16) ^ (0x0001 << (iCnt2 / 2));
+			}
+		}
+
+		dstAddrStart_U16++;
+	}
+	if (ber == 0xFFFF)
+	{
+		return ber;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*                     Walking dead2 pattern test                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*  Write pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U16 = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < (iWalkers * 2); iCnt2++)
+	{
+		if ((iCnt2 % 2) == 0)
+		{
+			MEMW16(dstAddrStart_U16, 0xFFFF - (0x0001 << (iCnt2 / 2)));
+		}
+		else
+		{
+			MEMW16(dstAddrStart_U16, 0);
+		}
+		dstAddrStart_U16++;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Verify pattern                                                                                      */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U16 = (UINT16 *)0x1000;
+	for (iCnt2 = 0; iCnt2 < (iWalkers * 2); iCnt2++)
+	{
+		if (bECC == TRUE)
+		{
+			ber |= GetECCSyndrom(MEMR16(dstAddrStart_U16));
+		}
+		else
+		{
+			if ((iCnt2 % 2) == 0)
+			{
+				ber |= MEMR16(dstAddrStart_U16) ^ (0xFFFF - (0x0001 << (iCnt2 / 2)));
+			}
+			else
+			{
+				ber |= MEMR16(dstAddrStart_U16) ^ 0;
+			}
+		}
+		dstAddrStart_U16++;
+	}
+	if (ber == 0xFFFF)
+	{
+		return ber;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*                     Copy bootblock code from SRAM to DRAM                                           */
+	/*-----------------------------------------------------------------------------------------------------*/
+
+	// NTIL: move bootblock test to last test since this test take too much time (first it copy then it check)
+	/*-----------------------------------------------------------------------------------------------------*/
+	/*  Use RAM2 as a pseudo random pattern to test the DDR                                                */
+	/*  Copy BB code segment to the DDR                                                                    */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U16 = (UINT16 *)0x1000;
+
+	for (iCnt2 = 0; iCnt2 < 0x10000 /* (&(UINT32)BOOTBLOCK_IMAGE_END - RAM2_MEMORY_SIZE)*/; iCnt2 += sizeof(UINT16))
+	{
+		MEMW16(dstAddrStart_U16, *(UINT16 *)(RAM2_BASE_ADDR + iCnt2));
+		dstAddrStart_U16++;
+	}
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Compare BB code segment to the DDR                                                                  */
+	/*-----------------------------------------------------------------------------------------------------*/
+	dstAddrStart_U16 = (UINT16 *)0x1000;
+
+	for (iCnt2 = 0; iCnt2 < 0x10000 /* (&(UINT32)BOOTBLOCK_IMAGE_END - RAM2_MEMORY_SIZE)  */; iCnt2 += sizeof(UINT16))
+	{
+		if (bECC == TRUE)
+		{
+			ber |= GetECCSyndrom(*(UINT16 *)(RAM2_BASE_ADDR + iCnt2));
+		}
+		else
+		{
+			ber |= MEMR16(dstAddrStart_U16) ^ *(UINT16 *)(RAM2_BASE_ADDR + iCnt2);
+		}
+
+		// NTIL: save time and return as soos as posiable when there is total bits error (don't wait to verify to complete)
+		if (ber == 0xFFFF)
+			return ber;
+
+		dstAddrStart_U16++;
+	}
+
+	return ber;
+}
@@ -0,0 +1,356 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mc_size_model.c                                                          */
+/*            Host check of the DRAM size and geometry probe on SDP and DDP   */
+/*            devices (SWC_HAL/ModuleDrivers/mc/4/mc_drv_size.c)              */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+/*
+ * build and run (from Sources):
+ *   make -f makefile check, the binary is Images/check/mc_size_model, built with BOOTBLOCK_SIM
+ * BOOTBLOCK_SIM sends MEMR64 / MEMW64 to SIM_MMIO_Read / SIM_MMIO_Write, the DRAM model below.
+ *
+ * usage: mc_size_model [seed]
+ *
+ * The DRAM is a model of the cells the probes touch. An SDP device (128MB to 2GB) has one of the bank / row
+ * diff geometries 1 / 1, 0 / 1 and 1 / 0, a DDP device (4GB) the 0 / 0 one (the old code took 0 / 0 at 4GB
+ * only, mc_size_geometry as DDP only). In a geometry that does not match the device, a DRAM address bit may
+ * be dropped (the address aliases the one without the bit): the controller to device pin map is not
+ * described in this tree, so every dropped bit from 128MB to the device size, or none, is modeled in each of
+ * these geometries. The DRAM wraps at the device size, and a DDP device mirrors 0x10 at 0x1010 in every
+ * geometry but its own. The header maximum (max_ddr_size) is 128MB to 8GB. Every device is probed with no
+ * failing cell, with a stuck bit in the base cell (0x8000) and with a stuck bit in another probed cell.
+ * MC_SizeSearch_l must find the device size (up to the header maximum), set a geometry that does not alias
+ * below it and the DDP flag of the device; with a failing base cell or a DDP device under a header maximum
+ * of less than 4GB, no geometry passes and the size is the header maximum. The base cell must be restored.
+ * With a working base cell, the size, geometry and DDP flag must be the ones of MC_CheckWrapAround and
+ * MC_CheckDramSize (tools/mc_size_ref.c), but for a DDP device under a header maximum other than 4GB: the old
+ * code did not detect it above 4GB, and set another geometry when no geometry passed under 4GB.
+ * The DRAM accesses and the geometry settings of both are counted: the signature passes write and read
+ * every probe twice, the old code stopped at the first alias but set the four geometries.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "defs.h"
+#include "tool_check.h"
+
+#define HAL_PRINT(fmt, args...)
+#define HAL_PRINT_DBG(fmt, args...)
+#define HAL_PRINT_ERR(fmt, args...)     model_report(fmt)
+#define KRED                            ""
+#define KYEL                            ""
+#define KMAG                            ""
+#define KNRM                            ""
+
+/* the fields of DDR_Setup (mc_if.h) used by the probe */
+typedef struct
+{
+	UINT64   max_ddr_size;
+	BOOLEAN  ddr_ddp;
+} DDR_Setup;
+
+#define MODEL_CELLS             32
+#define MODEL_SDP_FIRST         27              /* 128MB                                           */
+#define MODEL_SDP_LAST          31              /* 2GB                                             */
+#define MODEL_DDP_LOG           32              /* 4GB                                             */
+#define MODEL_MAX_FIRST         27              /* header maximum 128MB to 8GB                     */
+#define MODEL_MAX_LAST          33
+#define MODEL_BASE_CELL         0x8000ULL
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Device model                                                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+static BOOLEAN model_ddp;
+static UINT64  model_size;
+static int     model_alias[2][2];       /* dropped address bit of each geometry [bank][row], 0 for none    */
+static UINT64  model_stuck_cell;        /* cell with stuck at 1 bits, 0 for none                           */
+static UINT64  model_stuck_mask;
+static int     model_bank;              /* geometry set in the MC                                          */
+static int     model_row;
+static UINT64  model_cell[MODEL_CELLS];
+static UINT64  model_data[MODEL_CELLS];
+static UINT32  model_cells;
+static UINT32  model_accesses;
+static UINT32  model_geometry_sets;
+static UINT32  model_no_geometry;
+
+static void model_report (const char *fmt)
+{
+	if (strstr(fmt, "no geometry") != NULL)
+		model_no_geometry++;
+}
+
+static UINT64 model_cell_of (UINT64 addr)
+{
+	UINT64 offset = (addr >= _4GB_) ? (addr - _2GB_) : addr;
+
+	if (model_ddp && (model_bank || model_row) && (offset < 0x2000))
+		offset &= ~0x1000ULL;
+	if (model_alias[model_bank][model_row] != 0)
+		offset &= ~(1ULL << model_alias[model_bank][model_row]);
+
+	return offset % model_size;
+}
+
+static UINT64 *model_find (UINT64 cell)
+{
+	UINT32 i;
+
+	for (i = 0; i < model_cells; i++)
+	{
+		if (model_cell[i] == cell)
+			return &model_data[i];
+	}
+
+	/* a cell not written yet holds garbage */
+	if (model_cells == MODEL_CELLS)
+	{
+		printf("model: out of cells\n");
+		exit(1);
+	}
+	model_cell[model_cells] = cell;
+	model_data[model_cells] = cell * 0x9E3779B97F4A7C15ULL;
+
+	return &model_data[model_cells++];
+}
+
+UINT64 SIM_MMIO_Read (UINT64 addr, UINT size)
+{
+	UINT64 cell = model_cell_of(addr);
+
+	model_accesses++;
+
+	return *model_find(cell) | ((cell == model_stuck_cell) ? model_stuck_mask : 0);
+}
+
+void SIM_MMIO_Write (UINT64 addr, UINT size, UINT64 val)
+{
+	model_accesses++;
+	*model_find(model_cell_of(addr)) = val;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Stubs of mc_drv.c and mc_drv_mem_test.c                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+void MC_ClearInterrupts (void)
+{
+}
+
+static void MC_ClearOutOfRangeInt (void)
+{
+}
+
+static void MC_SetBankRowCol (int bank_diff, int row_diff, int col_diff)
+{
+	model_bank = bank_diff;
+	model_row = row_diff;
+	model_geometry_sets++;
+}
+
+static UINT64 MC_MemTestAddr_l (UINT64 offset)
+{
+	return (offset < _2GB_) ? offset : (offset + _2GB_);
+}
+
+#include "../SWC_HAL/ModuleDrivers/mc/4/mc_drv_size.c"
+#include "mc_size_ref.c"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_usable                                                                           */
+/*                                                                                                         */
+/* Parameters:      bank, row - geometry                                                                   */
+/* Returns:         DRAM size without alias in this geometry                                               */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 model_usable (int bank, int row)
+{
+	if (model_ddp && (bank || row))
+		return 0;
+	if (model_alias[bank][row] != 0)
+		return 1ULL << model_alias[bank][row];
+
+	return model_size;
+}
+
+typedef struct
+{
+	UINT64  size;
+	int     bank;
+	int     row;
+	BOOLEAN ddp;
+	BOOLEAN restored;
+	UINT32  accesses;
+	UINT32  geometry_sets;
+	UINT32  no_geometry;
+} MODEL_RESULT_T;
+
+static void model_search (UINT64 max_size, UINT64 (*search)(DDR_Setup *), MODEL_RESULT_T *result)
+{
+	DDR_Setup ddr_setup;
+	UINT64    orig = ((UINT64)tool_rand() << 32) | tool_rand();
+	UINT64    stuck;
+
+	ddr_setup.max_ddr_size = max_size;
+	ddr_setup.ddr_ddp = FALSE;
+	model_cells = 0;
+	model_bank = 1;
+	model_row = 1;
+	*model_find(MODEL_BASE_CELL) = orig;
+	model_accesses = 0;
+	model_geometry_sets = 0;
+	model_no_geometry = 0;
+
+	result->size = MIN(search(&ddr_setup), max_size);
+	result->bank = model_bank;
+	result->row = model_row;
+	result->ddp = ddr_setup.ddr_ddp;
+	stuck = (model_stuck_cell == MODEL_BASE_CELL) ? model_stuck_mask : 0;
+	result->restored = ((*model_find(MODEL_BASE_CELL) | stuck) == (orig | stuck));   /* as read back */
+	result->accesses = model_accesses;
+	result->geometry_sets = model_geometry_sets;
+	result->no_geometry = model_no_geometry;
+}
+
+static UINT64 model_checks;
+static UINT64 model_compared;
+static UINT64 model_accesses_new;
+static UINT64 model_accesses_ref;
+static UINT64 model_sets_new;
+static UINT64 model_sets_ref;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_check                                                                            */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         number of failed checks of the device, for every header maximum and failing cell       */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 model_check (void)
+{
+	static const char *stuck_name[] = { "", ", stuck base", ", stuck probe" };
+	MODEL_RESULT_T result, ref;
+	UINT64         max_size, expected;
+	UINT32         fail = 0;
+	int            max_log, stuck, probe;
+	BOOLEAN        select;
+
+	for (stuck = 0; stuck < 3; stuck++)
+	{
+		model_stuck_mask = 1ULL << (tool_rand() % 64);
+		if (stuck == 0)
+		{
+			model_stuck_cell = 0;
+		}
+		else if (stuck == 1)
+		{
+			model_stuck_cell = MODEL_BASE_CELL;
+		}
+		else
+		{
+			/* a probe that is no alias in the device geometry */
+			probe = LOG(model_size / _128MB_);
+			if (probe == 0)
+				continue;
+			model_stuck_cell = (_128MB_ << (tool_rand() % probe)) + MODEL_BASE_CELL;
+		}
+
+		for (max_log = MODEL_MAX_FIRST; max_log <= MODEL_MAX_LAST; max_log++)
+		{
+			max_size = 1ULL << max_log;
+			select = (stuck != 1) && (!model_ddp || (max_size >= _4GB_));
+			expected = select ? MIN(model_size, max_size) : max_size;
+
+			model_checks++;
+			model_search(max_size, MC_SizeSearch_l, &result);
+
+			if ((result.size != expected) || !result.restored || (result.no_geometry != !select) ||
+			    (select && ((model_usable(result.bank, result.row) < expected) || (result.ddp != model_ddp))))
+			{
+				TOOL_ERROR(fail, "%s %#llx max %#llx%s: size %#llx (%#llx) bank%d row%d ddp %d, no geometry %u, "
+				           "restored %d\n", model_ddp ? "DDP" : "SDP", (unsigned long long)model_size,
+				           (unsigned long long)max_size, stuck_name[stuck], (unsigned long long)result.size,
+				           (unsigned long long)expected, result.bank, result.row, result.ddp, result.no_geometry,
+				           result.restored);
+			}
+
+			if ((stuck == 1) || (model_ddp && (max_size != _4GB_)))
+				continue;
+
+			model_compared++;
+			model_search(max_size, REF_CheckDramSize, &ref);
+			model_accesses_new += result.accesses;
+			model_sets_new += result.geometry_sets;
+			model_accesses_ref += ref.accesses;
+			model_sets_ref += ref.geometry_sets;
+
+			if ((result.size != ref.size) || (result.bank != ref.bank) || (result.row != ref.row) ||
+			    (result.ddp != ref.ddp) || !ref.restored)
+			{
+				TOOL_ERROR(fail, "%s %#llx max %#llx%s: size %#llx bank%d row%d ddp %d, ref %#llx bank%d row%d "
+				           "ddp %d\n",
+				           model_ddp ? "DDP" : "SDP", (unsigned long long)model_size,
+				           (unsigned long long)max_size, stuck_name[stuck], (unsigned long long)result.size,
+				           result.bank, result.row, result.ddp, (unsigned long long)ref.size, ref.bank, ref.row,
+				           ref.ddp);
+			}
+		}
+	}
+
+	return fail;
+}
+
+int main (int argc, char *argv[])
+{
+	UINT32 errors = 0;
+	int    size_log, device, choices, k, combination, combinations, g;
+	int    alias[3];
+
+	tool_seed(argc, argv, 1);
+
+	/* device 1 to 3: SDP in geometry bank = device >> 1, row = device & 1, device 0: DDP */
+	for (device = 0; device < 4; device++)
+	{
+		model_ddp = (device == 0);
+		for (size_log = MODEL_SDP_FIRST; size_log <= (model_ddp ? MODEL_DDP_LOG : MODEL_SDP_LAST); size_log++)
+		{
+			if (model_ddp && (size_log != MODEL_DDP_LOG))
+				continue;
+			model_size = 1ULL << size_log;
+
+			/* every dropped bit (or none) in each of the three other geometries */
+			choices = size_log - MODEL_SDP_FIRST + 1;
+			combinations = choices * choices * choices;
+			for (combination = 0; combination < combinations; combination++)
+			{
+				for (k = 0, g = combination; k < 3; k++, g /= choices)
+					alias[k] = (g % choices == 0) ? 0 : (MODEL_SDP_FIRST + (g % choices) - 1);
+
+				for (g = 0, k = 0; g < 4; g++)
+				{
+					if (g == device)
+						model_alias[g >> 1][g & 1] = 0;
+					else
+						model_alias[g >> 1][g & 1] = alias[k++];
+				}
+
+				errors += model_check();
+			}
+		}
+	}
+
+	printf("%llu searches, %llu compared with MC_CheckDramSize\n", (unsigned long long)model_checks,
+	       (unsigned long long)model_compared);
+	printf("compared searches: %.1f DRAM accesses and %.2f geometry settings (MC_CheckDramSize %.1f and %.2f)\n",
+	       (double)model_accesses_new / model_compared, (double)model_sets_new / model_compared,
+	       (double)model_accesses_ref / model_compared, (double)model_sets_ref / model_compared);
+	printf("%u errors\n", errors);
+
+	return (errors != 0);
+}
@@ -0,0 +1,180 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mc_size_ref.c                                                            */
+/*            MC_CheckWrapAround and the geometry selection of                */
+/*            MC_CheckDramSize, as they were in mc_drv.c before               */
+/*            mc_drv_size.c. Reference of tools/mc_size_model.c               */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        REF_CheckWrapAround                                                                    */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  bank_diff -                                                                            */
+/*                  col_diff -                                                                             */
+/*                  ddr_setup -                                                                            */
+/*                  row_diff -                                                                             */
+/*                                                                                                         */
+/* Returns:         size of DRAM or MC_SIZE_FAIL - if there is a wraparound at 0x1000                      */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine checks for wrap around to detect size of DRAM                             */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 REF_CheckWrapAround(DDR_Setup *ddr_setup, int bank_diff, int row_diff, int col_diff)
+{
+	UINT64 shift = 0;		// 1GB value.
+	UINT64 shift_limit = 0; // 1K ==> 2GB value.
+	const UINT64 MEM_CHECK_DATA = 0xFEDCBA987654321LL;
+	const UINT64 MEM_CHECK_ADDR = 0x8000LL;
+
+	volatile UINT64 address = 0;
+	UINT64 orig_data = MEMR64(MEM_CHECK_ADDR);
+	BOOLEAN bFoundWrap = FALSE;
+
+	MC_ClearInterrupts();
+
+	// Set BANK Diff before testing
+	MC_SetBankRowCol(bank_diff, row_diff, col_diff);
+
+	shift_limit = LOG(ddr_setup->max_ddr_size / _128MB_);
+
+	HAL_PRINT_DBG("\n\n>MC: check DRAM size for configuration: BANK diff %d, ROW diff %d, COL diff %d, max_shift %d, max_size %#010lx\n",
+				  bank_diff, row_diff, col_diff, shift_limit, ddr_setup->max_ddr_size);
+
+	// Special case for DDP because the pseudo-wrap is at 4K
+	address = 0x1010;
+	MEMW64(0x10, MEM_CHECK_DATA); // write data
+	HAL_PRINT_DBG("Check if data is mirrored at address %#010lx\n", address);
+
+	// check if the data is mirrored at address
+	if (MEMR64(address) == MEM_CHECK_DATA)
+	{
+		HAL_PRINT_DBG("data is mirrored at address %#010lx\n", address);
+		MEMW64(0x10, ~MEM_CHECK_DATA); // write the reversed data
+
+		// check if the reversed data is mirrored at address
+		if (MEMR64(address) == ~MEM_CHECK_DATA)
+		{
+			HAL_PRINT_DBG("DDP Wrap around shift %u BANK %d, ROW %d, COL %d address %#010lx\n",
+					  shift, bank_diff, row_diff, col_diff, address);
+			MC_ClearOutOfRangeInt();
+			ddr_setup->ddr_ddp = TRUE;
+			return MC_SIZE_FAIL;
+		}
+	}
+
+	for (shift = 0; shift < shift_limit; shift++)
+	{
+		if (shift < 4)
+		{
+			address = (_128MB_ << shift) + MEM_CHECK_ADDR;
+		}
+		else
+		{
+			// Mapping of address 2G-4G is done thorugh 4G-6G
+			address = 0x100000000ULL + MEM_CHECK_ADDR;
+		}
+
+		MEMW64(MEM_CHECK_ADDR, MEM_CHECK_DATA); // write test data
+
+		HAL_PRINT_DBG("Check if data is mirrored at address %#010lx\n", address);
+
+		// check if the data is mirrored at address
+		if (MEMR64(address) == MEM_CHECK_DATA)
+		{
+			MEMW64(MEM_CHECK_ADDR, ~MEM_CHECK_DATA); // write the reversed data
+
+			// check if the reversed data is mirrored at address
+			if (MEMR64(address) == ~MEM_CHECK_DATA)
+			{
+				HAL_PRINT_DBG("Wrap around shift %u BANK %d, ROW %d, COL %d data is mirrored at address %#010lx\n",
+						  shift, bank_diff, row_diff, col_diff, address);
+				bFoundWrap = TRUE;
+				MC_ClearOutOfRangeInt();
+				break;
+			}
+		}
+	}
+
+	// restore original data
+	MEMW64(MEM_CHECK_ADDR, orig_data);
+	MC_ClearInterrupts();
+	if (bFoundWrap == TRUE)
+	{
+		HAL_PRINT_DBG("wrap found size is  %#010lx BANK %d, ROW %d, COL %d:\n", (_128MB_ << shift), bank_diff, row_diff, col_diff);
+		return (_128MB_ << shift);
+	}
+	HAL_PRINT(KRED "Size is greater then %#010lx  BANK %d, ROW %d, COL %d: \n" KNRM, (_128MB_ << shift_limit), bank_diff, row_diff, col_diff);
+	return (_128MB_ << shift);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        REF_CheckDramSize                                                                      */
+/*                                                                                                         */
+/* Parameters:      none                                                                                   */
+/* Returns:         none                                                                                   */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*          measure the DRAM size                                                                          */
+/*          (the geometry selection only: the GMMAP setting that followed is not copied)                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT64 REF_CheckDramSize(DDR_Setup *ddr_setup)
+{
+	UINT64 ddr_size;
+	UINT64 ddr_size_00;
+	UINT64 ddr_size_11;
+	UINT64 ddr_size_01;
+	UINT64 ddr_size_10;
+
+	MC_ClearInterrupts();
+
+	HAL_PRINT_DBG("\n\n>MC: check DRAM size:\n");
+
+	/* try all bank options*/
+	ddr_size_01 = REF_CheckWrapAround(ddr_setup, 0, 1, 2);
+	ddr_size_10 = REF_CheckWrapAround(ddr_setup, 1, 0, 2);
+	ddr_size_00 = REF_CheckWrapAround(ddr_setup, 0, 0, 2);
+	ddr_size_11 = REF_CheckWrapAround(ddr_setup, 1, 1, 2);
+
+	HAL_PRINT_DBG(KMAG "\n\n[bank,row,size] 10 %#010lx; 01 %#010lx; 00 %#010lx; 11 %#010lx\n" KNRM, ddr_size_10, ddr_size_01, ddr_size_00, ddr_size_11);
+
+	if (ddr_size_00 == _4GB_)
+	{
+		ddr_size = ddr_size_00;
+		MC_SetBankRowCol(0, 0, 2);
+		ddr_setup->ddr_ddp = TRUE;
+	}
+	else
+	{
+		ddr_size = MIN(ddr_size_11, ddr_size_00);
+
+		if ((ddr_size_10 != MC_SIZE_FAIL) && (ddr_size_10 >= ddr_size))
+		{
+			ddr_size = MAX(ddr_size_10, ddr_size);
+			MC_SetBankRowCol(1, 0, 2);
+			ddr_setup->ddr_ddp = FALSE;
+		}
+		if ((ddr_size_01 != MC_SIZE_FAIL) && (ddr_size_01 >= ddr_size))
+		{
+			ddr_size = MAX(ddr_size_01, ddr_size);
+			MC_SetBankRowCol(0, 1, 2);
+			ddr_setup->ddr_ddp = FALSE;
+		}
+		if ((ddr_size_11 != MC_SIZE_FAIL) && (ddr_size_11 >= ddr_size))
+		{
+			ddr_size = ddr_size_11;
+			MC_SetBankRowCol(1, 1, 2);
+			ddr_setup->ddr_ddp = FALSE;
+		}
+	}
+
+	return ddr_size;
+}
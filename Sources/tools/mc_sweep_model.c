@@ -0,0 +1,379 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mc_sweep_model.c                                                         */
+/*            Host check of the coarse to fine sweep and of the eye tracking  */
+/*            of the VREF sweeps                                              */
+/*            (SWC_HAL/ModuleDrivers/mc/4/mc_drv_sweep_run.c)                 */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+/*
+ * build and run (from Sources):
+ *   make -f makefile check, the binary is Images/check/mc_sweep_model
+ *
+ * usage: mc_sweep_model [models] [seed]
+ *
+ * 1. Sweep_Run_l alone, on 100 random sweeps per model of 125 points: 16 DQs of close eyes with sharp
+ * edges (plain), one of them with a 1 to 3 point eye instead (narrow) or with one failing point inside its
+ * eye (glitch). The eyes of the sweep (MC_EYE_Find_l, every field) must be the ones of the full sweep. The
+ * sweeps of Sweep_Run_l before the fine pass refined the intervals around the edges (tools/mc_sweep_ref.c)
+ * that differ are counted.
+ * 2. The memory test is replaced by a model of the 16 DQ eyes over the VREF steps (51 to 124) and the 125
+ * trim points (-62 to 62) of Sweep_VREF_l: each bit has one eye, its center drifts with VREF and its width
+ * shrinks away from a random trained VREF, down to no eye. Every model is swept as Sweep_VREF_l does:
+ * coarse to fine sweep (Sweep_Run_l) on the trained VREF, then tracked sweeps (Sweep_Track_l) up to 124
+ * and down from the trained VREF to 51 (Sweep_Walk_l), each from the eyes of the step before. The eye
+ * size and center of every bit (MC_EYE_Find_l) and the min eye size of every lane (g_Table_MinEyeSize)
+ * must match the ones of the full grid, where every point of every step is tested. The memory tests of
+ * the tracked sweeps are counted against the 74 x 125 of the full grid.
+ * The eyes of this model have sharp edges and no glitches: a tracked step assumes one eye per bit. A bit
+ * whose eye closed is not searched again: the eyes of less than MC_SWEEP_COARSE_STEP points that the full
+ * grid sees on some steps after that are counted as missed, not as errors (Sweep_Run_l misses them too).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "defs.h"
+#include "tool_check.h"
+#include "../SWC_HAL/ModuleDrivers/mc/4/mc_drv_eye.c"
+#include "../SWC_HAL/ModuleDrivers/mc/4/mc_drv_sweep_run.c"
+#include "mc_sweep_ref.c"
+
+#define MODEL_VREF_FIRST        51
+#define MODEL_VREF_LAST         124
+#define MODEL_VREF_STEPS        (MODEL_VREF_LAST - MODEL_VREF_FIRST + 1)
+#define MODEL_START_SCAN        (-62)
+#define MODEL_STOP_SCAN         62
+#define MODEL_POINTS            (MODEL_STOP_SCAN - MODEL_START_SCAN + 1)
+#define MODEL_SWEEP_IN_DQ       1               /* SWEEP_IN_DQ of mc_drv.h                          */
+#define MODEL_RUN_SWEEPS        100             /* Sweep_Run_l checks per model                     */
+
+typedef enum
+{
+	MODEL_RUN_PLAIN,
+	MODEL_RUN_NARROW,                       /* one DQ with a 1 to 3 point eye                   */
+	MODEL_RUN_GLITCH,                       /* one DQ with a failing point inside its eye       */
+	MODEL_RUN_KINDS
+} MODEL_RUN_T;
+
+static UINT16  model_grid[MODEL_POINTS];       /* sweep status of the Sweep_Run_l checks           */
+static BOOLEAN model_grid_on;                  /* Sweep_Sample_l reads model_grid                  */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Eye model: center and half width of each bit, in trim points, as a function of VREF                     */
+/*---------------------------------------------------------------------------------------------------------*/
+static double model_center[16];
+static double model_drift[16];         /* center shift per VREF step                                       */
+static double model_width[16];         /* half width on the trained VREF                                   */
+static double model_shrink;            /* half width lost per VREF step                                    */
+static double model_bend;              /* and per square VREF step                                         */
+static int    model_trained;
+static int    model_vref;
+static UINT32 model_tests;
+
+static UINT16 model_status (int vref, int samplePoint)
+{
+	UINT16 status = 0;
+	double d = vref - model_trained;
+	double w, c;
+	int    ibit;
+
+	for (ibit = 0; ibit < 16; ibit++)
+	{
+		c = model_center[ibit] + (model_drift[ibit] * d);
+		w = model_width[ibit] - (model_shrink * ((d < 0) ? -d : d)) - (model_bend * d * d);
+		if (!((w > 0) && (samplePoint >= c - w) && (samplePoint <= c + w)))
+			status |= (UINT16)(1 << ibit);
+	}
+
+	return status;
+}
+
+/* the memory test of the driver */
+static UINT16 Sweep_Sample_l (MC_SWEEP_SET_T set, int SweepType, int samplePoint, UINT16 SweepBitMask)
+{
+	set(SweepType, samplePoint, SweepBitMask);
+	model_tests++;
+
+	if (model_grid_on)
+		return model_grid[samplePoint - MODEL_START_SCAN];
+
+	return model_status(model_vref, samplePoint);
+}
+
+static void model_set (int SweepType, int samplePoint, UINT16 SweepBitMask)
+{
+}
+
+static void model_init (void)
+{
+	int ibit;
+
+	model_trained = MODEL_VREF_FIRST + 10 + (int)(tool_rand() % (MODEL_VREF_STEPS - 20));
+	model_shrink = 0.1 + (tool_rand() % 60) / 100.0;
+	model_bend = (tool_rand() % 40) / 10000.0;
+
+	/* lane skew, then per bit skew, width and drift */
+	for (ibit = 0; ibit < 16; ibit++)
+	{
+		model_center[ibit] = (int)(tool_rand() % 9) - 4 + ((ibit > 7) ? 5 : 0) + (tool_rand() % 100) / 100.0;
+		model_width[ibit] = 10 + (tool_rand() % 12) + (tool_rand() % 100) / 100.0;
+		model_drift[ibit] = ((ibit > 7) ? 0.3 : -0.2) + ((int)(tool_rand() % 21) - 10) / 100.0;
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_grid_init                                                                        */
+/*                                                                                                         */
+/* Parameters:      kind - MODEL_RUN_*                                                                     */
+/* Returns:         none                                                                                   */
+/* Description:                                                                                            */
+/*                  Fills model_grid: 16 DQs of 6 to 45 points around a common center, with lane and bit   */
+/*                  skew, then the narrow eye or the glitch of one DQ                                      */
+/*---------------------------------------------------------------------------------------------------------*/
+static void model_grid_init (MODEL_RUN_T kind)
+{
+	int center = (int)(tool_rand() % 61) + 32;
+	int left[16], right[16];
+	int ibit, i, half, width, dq;
+
+	for (ibit = 0; ibit < 16; ibit++)
+	{
+		half = 3 + (int)(tool_rand() % 20);
+		left[ibit] = center + ((ibit > 7) ? 4 : 0) + (int)(tool_rand() % 7) - 3 - half;
+		right[ibit] = left[ibit] + (2 * half) - (int)(tool_rand() % 2);
+	}
+
+	dq = (int)(tool_rand() % 16);
+	if (kind == MODEL_RUN_NARROW)
+	{
+		width = 1 + (int)(tool_rand() % 3);
+		left[dq] = (int)(tool_rand() % (MODEL_POINTS - width + 1));
+		right[dq] = left[dq] + width - 1;
+	}
+
+	for (i = 0; i < MODEL_POINTS; i++)
+	{
+		model_grid[i] = 0;
+		for (ibit = 0; ibit < 16; ibit++)
+		{
+			if ((i < left[ibit]) || (i > right[ibit]))
+				model_grid[i] |= (UINT16)(1 << ibit);
+		}
+	}
+
+	if (kind == MODEL_RUN_GLITCH)
+		model_grid[left[dq] + 1 + (int)(tool_rand() % (right[dq] - left[dq] - 1))] |= (UINT16)(1 << dq);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_eyes_differ                                                                      */
+/*                                                                                                         */
+/* Parameters:      a, b - eyes of the 16 bits                                                             */
+/* Returns:         number of bits with a different eye, any field                                         */
+/*---------------------------------------------------------------------------------------------------------*/
+static int model_eyes_differ (const MC_EYE_T *a, const MC_EYE_T *b)
+{
+	int differ = 0;
+	int ibit;
+
+	for (ibit = 0; ibit < MC_EYE_BITS; ibit++)
+	{
+		differ += (a[ibit].center != b[ibit].center) || (a[ibit].size != b[ibit].size) ||
+		          (a[ibit].left != b[ibit].left) || (a[ibit].right != b[ibit].right) ||
+		          (a[ibit].edge[0] != b[ibit].edge[0]) || (a[ibit].edge[1] != b[ibit].edge[1]) ||
+		          (a[ibit].eyes != b[ibit].eyes) || (a[ibit].second != b[ibit].second) ||
+		          (a[ibit].flags != b[ibit].flags);
+	}
+
+	return differ;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_check_run                                                                        */
+/*                                                                                                         */
+/* Parameters:      sweeps - per kind of model_grid                                                        */
+/* Returns:         number of sweeps whose eyes differ from the full sweep                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 model_check_run (UINT32 sweeps)
+{
+	static const char *kind_name[MODEL_RUN_KINDS] = { "plain", "narrow", "glitch" };
+	UINT16      BitStatus[MC_EYE_POINTS];
+	MC_EYE_T    full[MC_EYE_BITS];
+	MC_EYE_T    eye[MC_EYE_BITS];
+	UINT32      tests[MODEL_RUN_KINDS] = { 0 }, ref_tests[MODEL_RUN_KINDS] = { 0 };
+	UINT32      ref_differ[MODEL_RUN_KINDS] = { 0 };
+	UINT32      i, errors = 0;
+	MODEL_RUN_T kind;
+
+	model_grid_on = TRUE;
+	for (kind = MODEL_RUN_PLAIN; kind < MODEL_RUN_KINDS; kind++)
+	{
+		for (i = 0; i < sweeps; i++)
+		{
+			model_grid_init(kind);
+			MC_EYE_Find_l(model_grid, MODEL_POINTS, full);
+
+			tests[kind] += Sweep_Run_l(model_set, MODEL_SWEEP_IN_DQ, MODEL_START_SCAN, MODEL_STOP_SCAN, 0,
+			                           BitStatus);
+			MC_EYE_Find_l(BitStatus, MODEL_POINTS, eye);
+			if (model_eyes_differ(eye, full))
+				TOOL_ERROR(errors, "%s sweep %u: the eyes differ from the full sweep\n", kind_name[kind], i);
+
+			ref_tests[kind] += REF_Sweep_Run_l(model_set, MODEL_SWEEP_IN_DQ, MODEL_START_SCAN, MODEL_STOP_SCAN, 0,
+			                                   BitStatus);
+			MC_EYE_Find_l(BitStatus, MODEL_POINTS, eye);
+			ref_differ[kind] += (model_eyes_differ(eye, full) != 0);
+		}
+
+		printf("%u %s sweeps of %d points: %.1f tests (old %.1f), old eyes differ in %u\n", sweeps,
+		       kind_name[kind], MODEL_POINTS, sweeps ? (double)tests[kind] / sweeps : 0.0,
+		       sweeps ? (double)ref_tests[kind] / sweeps : 0.0, ref_differ[kind]);
+	}
+	model_grid_on = FALSE;
+
+	return errors;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_min_eye                                                                          */
+/*                                                                                                         */
+/* Parameters:      size - eye size of the 16 bits, ilane - lane                                           */
+/* Returns:         min eye size of the lane, as in g_Table_MinEyeSize                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+static int model_min_eye (const int *size, int ilane)
+{
+	int min = 255;
+	int ibit;
+
+	for (ibit = ilane * 8; ibit < (ilane + 1) * 8; ibit++)
+		min = MIN(min, size[ibit]);
+
+	return min;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_run                                                                              */
+/*                                                                                                         */
+/* Parameters:      model - number, for the reports                                                        */
+/*                  tracked - memory tests of the tracked sweeps, added                                    */
+/*                  missed - eyes under MC_SWEEP_COARSE_STEP points not seen, added                        */
+/* Returns:         number of bits and lanes that differ from the full grid                                */
+/* Description:                                                                                            */
+/*                  One Sweep_VREF_l on the model. A bit whose eye closed stays closed in the next tracked */
+/*                  steps (unless a probe of the other bits passes on it), as a run of less than           */
+/*                  MC_SWEEP_COARSE_STEP points is not seen by Sweep_Run_l: an eye that small, left after  */
+/*                  the eye closed, is counted as missed and its bit as no eye                             */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 model_run (UINT32 model, UINT32 *tracked, UINT32 *missed)
+{
+	static MC_EYE_T full[MODEL_VREF_STEPS][MC_EYE_BITS];
+	UINT16          BitStatus[MC_EYE_POINTS];
+	MC_EYE_T        eye[MC_EYE_BITS];
+	MC_EYE_T        *expected;
+	MC_SWEEP_EYE_T  track;
+	MC_SWEEP_EYE_T  start_eye;
+	int             size[MC_EYE_BITS];
+	int             expected_size[MC_EYE_BITS];
+	UINT32          step, vref, errors = 0;
+	int             i, ibit, ilane;
+
+	/* full grid */
+	for (vref = MODEL_VREF_FIRST; vref <= MODEL_VREF_LAST; vref++)
+	{
+		for (i = 0; i < MODEL_POINTS; i++)
+			BitStatus[i] = model_status(vref, MODEL_START_SCAN + i);
+		MC_EYE_Find_l(BitStatus, MODEL_POINTS, full[vref - MODEL_VREF_FIRST]);
+	}
+
+	/* Sweep_VREF_l */
+	track.track = FALSE;
+	start_eye.track = FALSE;
+	model_tests = 0;
+	for (step = 0; step < MODEL_VREF_STEPS; step++)
+	{
+		vref = Sweep_Walk_l(step, MODEL_VREF_LAST, model_trained);
+		if (step == 1)
+		{
+			track.track = TRUE;
+			start_eye = track;
+		}
+		else if (vref + 1 == (UINT32)model_trained)
+		{
+			track = start_eye;
+		}
+
+		model_vref = (int)vref;
+		for (i = 0; i < MC_EYE_POINTS; i++)
+			BitStatus[i] = 0xFFFF;
+		if (track.track)
+			Sweep_Track_l(model_set, MODEL_SWEEP_IN_DQ, MODEL_START_SCAN, MODEL_STOP_SCAN, 0, BitStatus, &track);
+		else
+			Sweep_Run_l(model_set, MODEL_SWEEP_IN_DQ, MODEL_START_SCAN, MODEL_STOP_SCAN, 0, BitStatus);
+
+		/* Sweep_Eyes_l, then the eyes kept by Sweep_DQn_Trim_l */
+		MC_EYE_Find_l(BitStatus, MODEL_POINTS, eye);
+		expected = full[vref - MODEL_VREF_FIRST];
+		for (ibit = 0; ibit < 16; ibit++)
+		{
+			track.left[ibit] = eye[ibit].left;
+			track.right[ibit] = eye[ibit].right;
+			size[ibit] = eye[ibit].size;
+			expected_size[ibit] = expected[ibit].size;
+
+			if ((eye[ibit].size == 0) && (expected[ibit].size < MC_SWEEP_COARSE_STEP))
+			{
+				*missed += (expected[ibit].size != 0);
+				expected_size[ibit] = 0;
+			}
+			else if ((eye[ibit].size != expected[ibit].size) || (eye[ibit].center != expected[ibit].center))
+			{
+				TOOL_ERROR(errors, "model %u vref %u bit %d: eye %d size %d, full grid %d size %d\n", model, vref,
+				           ibit, eye[ibit].center, eye[ibit].size, expected[ibit].center, expected[ibit].size);
+			}
+		}
+
+		for (ilane = 0; ilane < 2; ilane++)
+		{
+			if (model_min_eye(size, ilane) != model_min_eye(expected_size, ilane))
+			{
+				TOOL_ERROR(errors, "model %u vref %u lane %d: min eye %d, full grid %d\n", model, vref, ilane,
+				           model_min_eye(size, ilane), model_min_eye(expected_size, ilane));
+			}
+		}
+	}
+
+	*tracked += model_tests;
+
+	return errors;
+}
+
+int main (int argc, char *argv[])
+{
+	UINT32 models = (argc > 1) ? (UINT32)strtoul(argv[1], NULL, 0) : 1000;
+	UINT32 i, errors = 0, tracked = 0, missed = 0, full;
+
+	tool_seed(argc, argv, 2);
+
+	errors += model_check_run(models * MODEL_RUN_SWEEPS);
+
+	for (i = 0; i < models; i++)
+	{
+		model_init();
+		errors += model_run(i, &tracked, &missed);
+	}
+
+	full = models * MODEL_VREF_STEPS * MODEL_POINTS;
+	printf("%u models: %u memory tests, %u for the full grid (%.1fx)\n", models, tracked, full,
+	       tracked ? (double)full / tracked : 0.0);
+	printf("%u eyes under %u points missed\n", missed, MC_SWEEP_COARSE_STEP);
+	printf("%u errors\n", errors);
+
+	return (errors != 0);
+}
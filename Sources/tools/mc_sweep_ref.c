@@ -0,0 +1,102 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mc_sweep_ref.c                                                           */
+/*            Sweep_Run_l, as it was before the fine pass refined the         */
+/*            intervals around the edges. Reference of                        */
+/*            tools/mc_sweep_model.c                                          */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        REF_Sweep_Run_l                                                                        */
+/*                                                                                                         */
+/* Parameters:                                                                                             */
+/*                  set -           routine that writes the trim of the swept lanes/bits                   */
+/*                  SweepType -                                                                            */
+/*                  startScan -                                                                            */
+/*                  stopScan -                                                                             */
+/*                  SweepBitMask -                                                                         */
+/*                  BitStatus -     result, one entry per point from startScan to stopScan                 */
+/*                                                                                                         */
+/* Returns:         number of memory tests                                                                 */
+/* Side effects:                                                                                           */
+/* Description:                                                                                            */
+/*                  This routine runs a coarse to fine sweep with early exit                               */
+/*---------------------------------------------------------------------------------------------------------*/
+static UINT32 REF_Sweep_Run_l (MC_SWEEP_SET_T set, int SweepType, int startScan, int stopScan, UINT16 SweepBitMask, UINT16 *BitStatus)
+{
+	int points = stopScan - startScan + 1;
+	int eyeStart[16];
+	UINT16 closed = 0;
+	UINT16 pass;
+	int failRun = 0;
+	int last = points - 1;
+	int i, j, prev, ibit;
+	UINT32 tests = 0;
+
+	for (ibit = 0; ibit < 16; ibit++)
+		eyeStart[ibit] = -1;
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Coarse pass                                                                                         */
+	/*-----------------------------------------------------------------------------------------------------*/
+	for (i = 0; i < points; i = ((i < points - 1) && (i + MC_SWEEP_COARSE_STEP > points - 1)) ? points - 1 : i + MC_SWEEP_COARSE_STEP)
+	{
+		BitStatus[i] = Sweep_Sample_l(set, SweepType, startScan + i, SweepBitMask);
+		tests++;
+
+		pass = (UINT16)~BitStatus[i];
+		for (ibit = 0; ibit < 16; ibit++)
+		{
+			if (READ_VAR_BIT(pass, ibit))
+			{
+				if (eyeStart[ibit] < 0)
+					eyeStart[ibit] = i;
+			}
+			else if (eyeStart[ibit] >= 0)
+			{
+				if (i - eyeStart[ibit] >= MC_SWEEP_MIN_EYE)
+					closed |= (UINT16)(1 << ibit);
+				eyeStart[ibit] = -1;
+			}
+		}
+
+		failRun = (BitStatus[i] == 0xFFFF) ? failRun + 1 : 0;
+		if (((closed | SweepBitMask) == 0xFFFF) && (failRun >= MC_SWEEP_EXIT_MARGIN))
+		{
+			last = i;
+			break;
+		}
+	}
+
+	for (i = last + 1; i < points; i++)
+		BitStatus[i] = 0xFFFF;
+
+	/*-----------------------------------------------------------------------------------------------------*/
+	/* Fine pass: refine between coarse samples that differ, fill the others                               */
+	/*-----------------------------------------------------------------------------------------------------*/
+	for (prev = 0, i = MIN(MC_SWEEP_COARSE_STEP, last); prev < last; prev = i, i = MIN(i + MC_SWEEP_COARSE_STEP, last))
+	{
+		for (j = prev + 1; j < i; j++)
+		{
+			if (BitStatus[prev] == BitStatus[i])
+			{
+				BitStatus[j] = BitStatus[prev];
+			}
+			else
+			{
+				BitStatus[j] = Sweep_Sample_l(set, SweepType, startScan + j, SweepBitMask);
+				tests++;
+			}
+		}
+	}
+
+	return tests;
+}
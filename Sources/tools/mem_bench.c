@@ -0,0 +1,194 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mem_bench.c                                                              */
+/*            Fuzz test and benchmark of the bootblock memcpy, memmove and    */
+/*            memset (source/v8_utils.S)                                      */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+/*
+ * build and run (from Sources, on an AArch64 Linux host or with aarch64-linux-gnu-gcc and qemu-aarch64):
+ *   make -f makefile check, the binary is Images/check/a64/mem_bench
+ * The bootblock routines are renamed so that they do not replace the ones of the host libc.
+ *
+ * usage: mem_bench [iterations] [seed]
+ *
+ * Every iteration runs memcpy, memmove (both overlap directions) and memset on a random size (0 to 4KB, half
+ * of them under 256 bytes) and random source and destination offsets (0 to 63) in guarded buffers. The
+ * result is compared with a byte loop, the bytes around the destination must not change and the return
+ * value must be the destination. The natural alignment of the accesses (-mstrict-align, MMU off) is not
+ * seen by a Linux host, where unaligned accesses to normal memory do not fault.
+ * Then memcpy and memset are timed from 1B to 1MB, aligned and misaligned, against the byte loops they
+ * replaced (tools/mem_ref.c).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "tool_check.h"
+#include "mem_ref.c"
+
+extern void *v8_memcpy (void *dst, const void *src, size_t n);
+extern void *v8_memmove (void *dst, const void *src, size_t n);
+extern void *v8_memset (void *dst, int c, size_t n);
+
+#define MEM_FUZZ_MAX            4096
+#define MEM_FUZZ_OFFSETS        64
+#define MEM_FUZZ_GUARD          64
+#define MEM_FUZZ_BUF            (MEM_FUZZ_GUARD + MEM_FUZZ_OFFSETS + MEM_FUZZ_MAX + MEM_FUZZ_GUARD)
+#define MEM_FUZZ_FILL           0xA5
+
+#define MEM_BENCH_MAX           (1024 * 1024)
+#define MEM_BENCH_BYTES         (64 * 1024 * 1024)      /* copied per size, bounds the run time          */
+
+static unsigned char src_buf[MEM_FUZZ_BUF] __attribute__((aligned(64)));
+static unsigned char dst_buf[MEM_FUZZ_BUF] __attribute__((aligned(64)));
+static unsigned char exp_buf[MEM_FUZZ_BUF] __attribute__((aligned(64)));
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        fuzz_one                                                                               */
+/*                                                                                                         */
+/* Parameters:      n - size, d, s - destination and source offsets                                        */
+/* Returns:         number of failed checks                                                                */
+/* Description:                                                                                            */
+/*                  memcpy and memset between the two buffers, memmove inside dst_buf                      */
+/*---------------------------------------------------------------------------------------------------------*/
+static unsigned int fuzz_one (size_t n, unsigned int d, unsigned int s)
+{
+	unsigned char *dst = &dst_buf[MEM_FUZZ_GUARD + d];
+	unsigned char *src = &src_buf[MEM_FUZZ_GUARD + s];
+	unsigned int   i, fail = 0;
+	int            c = (int)tool_rand();
+
+	for (i = 0; i < MEM_FUZZ_BUF; i++)
+		src_buf[i] = (unsigned char)tool_rand();
+
+	/* memcpy */
+	memset(dst_buf, MEM_FUZZ_FILL, MEM_FUZZ_BUF);
+	memcpy(exp_buf, dst_buf, MEM_FUZZ_BUF);
+	REF_memcpy(&exp_buf[MEM_FUZZ_GUARD + d], src, n);
+	if ((v8_memcpy(dst, src, n) != dst) || memcmp(dst_buf, exp_buf, MEM_FUZZ_BUF))
+		TOOL_ERROR(fail, "memcpy: size %zu dst offset %u src offset %u differs\n", n, d, s);
+
+	/* memset, only the low byte of c is stored */
+	memset(dst_buf, MEM_FUZZ_FILL, MEM_FUZZ_BUF);
+	memcpy(exp_buf, dst_buf, MEM_FUZZ_BUF);
+	REF_memset(&exp_buf[MEM_FUZZ_GUARD + d], c & 0xFF, n);
+	if ((v8_memset(dst, c, n) != dst) || memcmp(dst_buf, exp_buf, MEM_FUZZ_BUF))
+		TOOL_ERROR(fail, "memset: size %zu dst offset %u src offset %u differs\n", n, d, s);
+
+	/* memmove, overlapping in both directions: dst_buf + d <- dst_buf + s */
+	if (n <= MEM_FUZZ_MAX - MEM_FUZZ_OFFSETS)
+	{
+		memcpy(dst_buf, src_buf, MEM_FUZZ_BUF);
+		memcpy(exp_buf, src_buf, MEM_FUZZ_BUF);
+		memmove(&exp_buf[MEM_FUZZ_GUARD + d], &exp_buf[MEM_FUZZ_GUARD + s], n);
+		dst = &dst_buf[MEM_FUZZ_GUARD + d];
+		if ((v8_memmove(dst, &dst_buf[MEM_FUZZ_GUARD + s], n) != dst) || memcmp(dst_buf, exp_buf, MEM_FUZZ_BUF))
+			TOOL_ERROR(fail, "memmove: size %zu dst offset %u src offset %u differs\n", n, d, s);
+	}
+
+	return fail;
+}
+
+static double elapsed_ns (const struct timespec *t0, const struct timespec *t1)
+{
+	return (t1->tv_sec - t0->tv_sec) * 1e9 + (t1->tv_nsec - t0->tv_nsec);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        bench_copy                                                                             */
+/*                                                                                                         */
+/* Parameters:      copy - memcpy or REF_memcpy, dst, src - buffers, n - size                              */
+/* Returns:         MB/s                                                                                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static double bench_copy (void *(*copy)(void *, const void *, size_t), void *dst, const void *src, size_t n)
+{
+	struct timespec t0, t1;
+	size_t loops = (MEM_BENCH_BYTES / n) + 1;
+	size_t i;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (i = 0; i < loops; i++)
+	{
+		copy(dst, src, n);
+		__asm__ __volatile__("" : : "r" (dst) : "memory");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	return ((double)n * loops / (1024 * 1024)) / (elapsed_ns(&t0, &t1) / 1e9);
+}
+
+static double bench_set (void *(*set)(void *, int, size_t), void *dst, size_t n)
+{
+	struct timespec t0, t1;
+	size_t loops = (MEM_BENCH_BYTES / n) + 1;
+	size_t i;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (i = 0; i < loops; i++)
+	{
+		set(dst, (int)i, n);
+		__asm__ __volatile__("" : : "r" (dst) : "memory");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	return ((double)n * loops / (1024 * 1024)) / (elapsed_ns(&t0, &t1) / 1e9);
+}
+
+int main (int argc, char *argv[])
+{
+	unsigned int iterations = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 0) : 200000;
+	unsigned int i, errors = 0;
+	unsigned char *src = malloc(MEM_BENCH_MAX + 64);
+	unsigned char *dst = malloc(MEM_BENCH_MAX + 64);
+	size_t n;
+
+	tool_seed(argc, argv, 2);
+
+	if ((src == NULL) || (dst == NULL))
+	{
+		printf("out of memory\n");
+		return 1;
+	}
+
+	/* every size and offset pair around the 64 bytes blocks first */
+	for (n = 0; n <= 160; n++)
+	{
+		for (i = 0; i < MEM_FUZZ_OFFSETS * MEM_FUZZ_OFFSETS; i += 7)
+			errors += fuzz_one(n, i % MEM_FUZZ_OFFSETS, i / MEM_FUZZ_OFFSETS);
+	}
+
+	for (i = 0; i < iterations; i++)
+	{
+		n = (tool_rand() & 1) ? (tool_rand() % 256) : (tool_rand() % (MEM_FUZZ_MAX + 1));
+		errors += fuzz_one(n, tool_rand() % MEM_FUZZ_OFFSETS, tool_rand() % MEM_FUZZ_OFFSETS);
+	}
+
+	printf("%u iterations, %u errors\n", iterations, errors);
+
+	memset(src, 0x5A, MEM_BENCH_MAX + 64);
+	printf("%8s %22s %22s %22s %22s\n", "size", "memcpy aligned MB/s", "memcpy +1/+3 MB/s", "memset aligned MB/s",
+	       "memset +1 MB/s");
+	for (n = 1; n <= MEM_BENCH_MAX; n *= 2)
+	{
+		printf("%8zu %10.0f (%9.0f) %10.0f (%9.0f) %10.0f (%9.0f) %10.0f (%9.0f)\n", n,
+		       bench_copy(v8_memcpy, dst, src, n), bench_copy(REF_memcpy, dst, src, n),
+		       bench_copy(v8_memcpy, dst + 1, src + 3, n), bench_copy(REF_memcpy, dst + 1, src + 3, n),
+		       bench_set(v8_memset, dst, n), bench_set(REF_memset, dst, n),
+		       bench_set(v8_memset, dst + 1, n), bench_set(REF_memset, dst + 1, n));
+	}
+	printf("(byte loops of mc_drv.c in parentheses)\n");
+
+	free(src);
+	free(dst);
+
+	return (errors != 0);
+}
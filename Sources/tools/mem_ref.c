@@ -0,0 +1,33 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mem_ref.c                                                                */
+/*            Byte loop memset and memcpy, as they were in mc_drv.c before    */
+/*            v8_utils.S. Reference of tools/mem_bench.c                      */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+
+void *
+REF_memset(void *dest, int val, size_t len)
+{
+	volatile unsigned char *ptr = dest;
+	while (len-- > 0)
+		*ptr++ = val;
+	return dest;
+}
+
+void *
+REF_memcpy(void *dest, const void *src, size_t len)
+{
+	volatile char *d = dest;
+	const char *s = src;
+	while (len--)
+		*d++ = *s++;
+	return dest;
+}
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+#---------------------------------------------------------------------------------------------------------#
+# SPDX-License-Identifier: GPL-2.0                                                                        #
+# Copyright (c) 2024 by Nuvoton Technology Corporation                                                    #
+# All rights reserved                                                                                     #
+#---------------------------------------------------------------------------------------------------------#
+# File Contents:                                                                                          #
+#   mmio_prof.py                                                                                          #
+#            Resolve the call sites of the register access profile (BOOTBLOCK_MMIO_PROFILE)              #
+#  Project:  Arbel                                                                                        #
+#---------------------------------------------------------------------------------------------------------#
+#
+# usage: mmio_prof.py [-l] <bootblock elf> <capture>
+#
+#   capture : UART capture (or sim output) with the "mmio profile" report of MMIO_PROF_Report
+#   -l      : add file:line of each call site (addr2line, or $ADDR2LINE, e.g. aarch64-none-elf-addr2line)
+#
+# Prints the registers, the call sites as function+offset, and the call sites summed per function.
+# The report prints the run time address of MMIO_PROF_Report (ref): the difference to its ELF address
+# relocates the sites of a position independent build (host simulation).
+#
+
+import os
+import re
+import struct
+import subprocess
+import sys
+
+ANSI = re.compile(r"\x1b\[[0-9;]*m")
+HEAD = re.compile(r"mmio profile at (0x[0-9a-f]+):.* ref (0x[0-9a-f]+)")
+TITLE = re.compile(r"^\s*%time\s+us\s+reads\s+writes\s+(register|call site)")
+ROW = re.compile(r"^\s*(\d+\.\d)%\s+(\d+)\s+(\d+)\s+(\d+)\s+(0x[0-9a-f]+)\s*$")
+
+
+class Elf:
+    """Function symbols of an ELF64 little endian file"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 2 or data[5] != 1:
+            sys.exit("%s: not an ELF64 little endian file" % path)
+        shoff, = struct.unpack_from("<Q", data, 0x28)
+        shentsize, shnum = struct.unpack_from("<HH", data, 0x3A)
+        sections = [struct.unpack_from("<IIQQQQII", data, shoff + i * shentsize) for i in range(shnum)]
+        self.funcs = []
+        for _, sh_type, _, _, offset, size, link, _ in sections:
+            if sh_type != 2:                                    # SHT_SYMTAB
+                continue
+            stroff = sections[link][4]
+            for pos in range(offset, offset + size, 24):
+                name, info, _, _, value, symsize = struct.unpack_from("<IBBHQQ", data, pos)
+                if (info & 0xF) == 2 and value:                 # STT_FUNC
+                    end = data.index(b"\0", stroff + name)
+                    self.funcs.append((value, symsize, data[stroff + name:end].decode()))
+        self.funcs.sort()
+        if not self.funcs:
+            sys.exit("%s: no symbols" % path)
+
+    def address(self, name):
+        for value, _, func in self.funcs:
+            if func == name:
+                return value
+        return None
+
+    def function(self, addr):
+        best = None
+        for value, size, func in self.funcs:
+            if value > addr:
+                break
+            if addr < value + max(size, 1):
+                best = (func, addr - value)
+        return best
+
+
+def parse(capture):
+    ref = None
+    tables = {"register": [], "call site": []}
+    table = None
+    for line in capture.splitlines():
+        line = ANSI.sub("", line)
+        m = HEAD.search(line)
+        if m:
+            ref = int(m.group(2), 16)
+            tables = {"register": [], "call site": []}
+            continue
+        m = TITLE.match(line)
+        if m:
+            table = tables[m.group(1)]
+            continue
+        m = ROW.match(line)
+        if m and table is not None:
+            table.append((m.group(1), int(m.group(2)), int(m.group(3)), int(m.group(4)), int(m.group(5), 16)))
+        else:
+            table = None
+    if ref is None:
+        sys.exit("no mmio profile in the capture")
+    return ref, tables
+
+
+def lines(elf_path, addrs):
+    tool = os.environ.get("ADDR2LINE", "addr2line")
+    try:
+        out = subprocess.run([tool, "-e", elf_path] + ["%#x" % a for a in addrs],
+                             capture_output=True, text=True, check=True).stdout.split("\n")
+    except (OSError, subprocess.CalledProcessError):
+        return {}
+    return {a: os.path.basename(l.split(" ")[0]) for a, l in zip(addrs, out)}
+
+
+def main(argv):
+    with_lines = "-l" in argv
+    args = [a for a in argv if a != "-l"]
+    if len(args) != 2:
+        sys.exit("usage: mmio_prof.py [-l] <bootblock elf> <capture>")
+    elf = Elf(args[0])
+    with open(args[1], "r", errors="replace") as f:
+        ref, tables = parse(f.read())
+
+    report = elf.address("MMIO_PROF_Report")
+    bias = ref - report if report is not None else 0
+
+    print("  %time        us     reads    writes  register")
+    for pct, us, reads, writes, addr in tables["register"]:
+        print("  %5s%% %9d %9d %9d  %#010x" % (pct, us, reads, writes, addr))
+
+    # return addresses: the call is the instruction before
+    sites = [(row, row[4] - bias - 1) for row in tables["call site"]]
+    where = lines(args[0], [pc for _, pc in sites]) if with_lines else {}
+    per_func = {}
+
+    print("\n  %time        us     reads    writes  call site")
+    for (pct, us, reads, writes, _), pc in sites:
+        func = elf.function(pc)
+        name = "%s+%#x" % (func[0], func[1] + 1) if func else "%#x" % (pc + 1)
+        if pc in where:
+            name += "  " + where[pc]
+        print("  %5s%% %9d %9d %9d  %s" % (pct, us, reads, writes, name))
+        key = func[0] if func else "?"
+        acc = per_func.setdefault(key, [0.0, 0, 0, 0])
+        acc[0] += float(pct)
+        acc[1] += us
+        acc[2] += reads
+        acc[3] += writes
+
+    print("\n  %time        us     reads    writes  function (printed call sites)")
+    for name, (pct, us, reads, writes) in sorted(per_func.items(), key=lambda kv: -kv[1][1]):
+        print("  %5.1f%% %9d %9d %9d  %s" % (pct, us, reads, writes, name))
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
@@ -0,0 +1,224 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   mmu_model.c                                                              */
+/*            Host check of the EL3 translation tables of the cached boot     */
+/*            mode (source/mmu.c)                                             */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+/*
+ * build and run (from Sources):
+ *   make -f makefile check, the binary is Images/check/mmu_model, built with _NOTIP_ and BOOTBLOCK_CACHED_BOOT
+ *
+ * usage: mmu_model
+ *
+ * The tables are built by MMU_Init and MMU_MapDDR and walked as the A35 does (TCR_EL3.T0SZ = 28, the walk
+ * starts at level 1). Every 4KB page of the 64GB VA space is checked after MMU_Init against the memory map:
+ * flat mapping, memory type, access permission and XN. Then MMU_MapDDR is called for every DRAM size from
+ * 0 to 4GB in 2MB steps and the DRAM windows (0-2GB, 4GB-6GB) are checked at 2MB granularity, with the
+ * break before make: the DRAM entries must be invalid on the first TLB invalidation.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tool_check.h"
+#include "../source/mmu.c"
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Expected mapping of a page                                                                              */
+/*---------------------------------------------------------------------------------------------------------*/
+typedef enum
+{
+	MODEL_FAULT,
+	MODEL_DEVICE,
+	MODEL_NORMAL_RO,
+	MODEL_NORMAL_RW,
+} MODEL_MAP_T;
+
+static const char *model_map_name[] = { "fault", "device", "normal ro", "normal rw" };
+
+static UINT32 model_tlbi_calls;
+static UINT32 model_bbm_errors;
+static void  *model_ttbr0;
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Assembly helpers of the target                                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+void EnableMMUEL3 (void *ttbr0)
+{
+	model_ttbr0 = ttbr0;
+}
+
+void DisableMMUEL3 (void)
+{
+	model_ttbr0 = NULL;
+}
+
+void InvalidateTLBEL3 (void)
+{
+	UINT64 *l1 = (UINT64 *)model_ttbr0;
+	UINT32 high = MMU_DDR_HIGH_BASE_ADDR >> MMU_L1_BLOCK_SHIFT;
+
+	/* MMU_MapDDR invalidates twice: the first time, with the DRAM entries invalid */
+	if (((model_tlbi_calls++ % 2) == 0) && (l1[0] | l1[1] | l1[high] | l1[high + 1]))
+	{
+		printf("MMU_MapDDR: DRAM entries still valid on the TLB invalidation\n");
+		model_bbm_errors++;
+	}
+}
+
+static int in_range (UINT64 va, UINT64 base, UINT64 size)
+{
+	return (va >= base) && (va < base + size);
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_expected                                                                         */
+/*                                                                                                         */
+/* Parameters:      va - page address, ddr_size - size passed to MMU_MapDDR, 0 before training             */
+/* Returns:         expected mapping                                                                       */
+/* Description:                                                                                            */
+/*                  The memory map of the cached boot, written from the chip address map                   */
+/*---------------------------------------------------------------------------------------------------------*/
+static MODEL_MAP_T model_expected (UINT64 va, UINT64 ddr_size)
+{
+	UINT64 cached = ddr_size & ~(_2MB_ - 1ULL);
+
+	/* DRAM: offsets 2GB-4GB of the device at 4GB-6GB */
+	if (va < _2GB_)
+		return (va < cached) ? MODEL_NORMAL_RW : MODEL_DEVICE;
+	if (in_range(va, MMU_DDR_HIGH_BASE_ADDR, _2GB_))
+		return (va - MMU_DDR_HIGH_BASE_ADDR + _2GB_ < cached) ? MODEL_NORMAL_RW : MODEL_DEVICE;
+	if (va >= 0x100000000ULL)
+		return MODEL_FAULT;
+
+	/* flash windows, the holes between them fault */
+	if (va < MMU_IO_BASE_ADDR)
+	{
+		if (in_range(va, SPI0CS0_BASE_ADDR, SPI0CS0_SIZE + SPI0CS1_SIZE) ||
+		    in_range(va, SPI1CS0_BASE_ADDR, SPI1CS0_SIZE + SPI1CS1_SIZE + SPI1CS2_SIZE + SPI1CS3_SIZE) ||
+		    in_range(va, SPI3CS0_BASE_ADDR, SPI3CS0_SIZE + SPI3CS1_SIZE + SPI3CS2_SIZE + SPI3CS3_SIZE))
+			return MODEL_NORMAL_RO;
+		return MODEL_FAULT;
+	}
+
+	if (in_range(va, SPIXCS0_BASE_ADDR, SPIXCS0_SIZE + SPIXCS1_SIZE))
+		return MODEL_NORMAL_RO;
+	if (in_range(va, RAM2_BASE_ADDR, RAM2_MEMORY_SIZE))
+		return MODEL_NORMAL_RW;
+	if (in_range(va, ROM_BASE_ADDR, ROM_MEMORY_SIZE) || in_range(va, 0xFFF40000, _128KB_))
+		return MODEL_NORMAL_RO;
+
+	/* SHM, GIC, MMIO, RAM3, APB19 */
+	return MODEL_DEVICE;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        model_walk                                                                             */
+/*                                                                                                         */
+/* Parameters:      va - address, pa - output address                                                      */
+/* Returns:         mapping of the leaf descriptor, MODEL_FAULT on an invalid one or a bad attribute       */
+/* Description:                                                                                            */
+/*                  Translation table walk from level 1                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+static MODEL_MAP_T model_walk (UINT64 va, UINT64 *pa)
+{
+	UINT64 *table = (UINT64 *)model_ttbr0;
+	UINT64 desc;
+	UINT32 shift = MMU_L1_BLOCK_SHIFT;
+	UINT32 index = (UINT32)(va >> MMU_L1_BLOCK_SHIFT);
+
+	if ((table == NULL) || (index >= MMU_L1_ENTRIES))
+		return MODEL_FAULT;
+
+	for (;;)
+	{
+		desc = table[index];
+		if ((desc & 1) == 0)
+			return MODEL_FAULT;
+
+		/* page on level 3, block or table descriptor on levels 1 and 2 */
+		if (shift == MMU_L3_PAGE_SHIFT)
+		{
+			if ((desc & 2) == 0)
+				return MODEL_FAULT;
+			break;
+		}
+		if ((desc & 2) == 0)
+			break;
+
+		table = (UINT64 *)(desc & MMU_ADDR_MASK);
+		shift -= 9;
+		index = (UINT32)((va >> shift) & (MMU_TABLE_ENTRIES - 1));
+	}
+
+	*pa = (desc & MMU_ADDR_MASK & ~((1ULL << shift) - 1)) | (va & ((1ULL << shift) - 1));
+
+	if ((desc & (TT_S1_ATTR_AF | TT_S1_ATTR_AP_RO_ANY | MMU_XN | (7ULL << TT_S1_ATTR_MATTR_LSB))) ==
+	    (TT_S1_ATTR_AF | TT_S1_ATTR_AP_RW_ANY | MMU_XN | (MMU_MAIR_DEVICE_nGnRE << TT_S1_ATTR_MATTR_LSB)))
+		return MODEL_DEVICE;
+	if (((desc >> TT_S1_ATTR_MATTR_LSB) & 7) != MMU_MAIR_NORMAL_WB || !(desc & TT_S1_ATTR_AF) || (desc & MMU_XN))
+		return MODEL_FAULT;
+
+	return ((desc & TT_S1_ATTR_AP_RO_ANY) == TT_S1_ATTR_AP_RO_ANY) ? MODEL_NORMAL_RO : MODEL_NORMAL_RW;
+}
+
+static UINT32 model_check (UINT64 base, UINT64 end, UINT64 step, UINT64 ddr_size)
+{
+	MODEL_MAP_T expected, found;
+	UINT64 va, pa = 0;
+	UINT32 errors = 0;
+
+	for (va = base; va < end; va += step)
+	{
+		expected = model_expected(va, ddr_size);
+		found = model_walk(va, &pa);
+
+		if ((found != expected) || ((found != MODEL_FAULT) && (pa != va)))
+		{
+			TOOL_ERROR(errors, "ddr %#llx: va %#llx is %s pa %#llx, expected %s\n", (unsigned long long)ddr_size,
+			           (unsigned long long)va, model_map_name[found], (unsigned long long)pa,
+			           model_map_name[expected]);
+		}
+	}
+
+	return errors;
+}
+
+int main (void)
+{
+	UINT32 errors = 0;
+	UINT64 size;
+
+	MMU_Init();
+	errors += model_check(0, (UINT64)MMU_L1_ENTRIES << MMU_L1_BLOCK_SHIFT, _4KB_, 0);
+
+	for (size = 0; size <= _4GB_; size += _2MB_)
+	{
+		MMU_MapDDR(size);
+		errors += model_check(0, _2GB_, _2MB_, size);
+		errors += model_check(MMU_DDR_HIGH_BASE_ADDR, MMU_DDR_HIGH_BASE_ADDR + _2GB_, _2MB_, size);
+	}
+
+	/* a size that is not a multiple of 2MB is rounded down */
+	MMU_MapDDR(_1GB_ + _1MB_);
+	errors += model_check(0, _2GB_, _4KB_, _1GB_ + _1MB_);
+
+	/* the rest of the map is left as it is by MMU_MapDDR */
+	MMU_MapDDR(_4GB_);
+	errors += model_check(_2GB_, MMU_DDR_HIGH_BASE_ADDR, _4KB_, _4GB_);
+
+	MMU_Disable();
+	errors += model_bbm_errors;
+
+	printf("%u errors\n", errors);
+
+	return (errors != 0);
+}
@@ -0,0 +1,65 @@
+/*----------------------------------------------------------------------------*/
+/*   SPDX-License-Identifier: GPL-2.0                                         */
+/*                                                                            */
+/* Copyright (c) 2010-2024 by Nuvoton Technology Corporation                  */
+/* All rights reserved                                                        */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* File Contents:                                                             */
+/*   tool_check.h                                                             */
+/*            Random numbers and error report of the host checks and          */
+/*            benchmarks of tools/ (make check)                               */
+/*  Project:                                                                  */
+/*            Arbel BootBlock A35                                             */
+/*----------------------------------------------------------------------------*/
+
+#ifndef _TOOL_CHECK_H_
+#define _TOOL_CHECK_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* xorshift32: the same seed gives the same run on every host. The seed is an optional argument of each    */
+/* tool, a failure is reproduced with the seed it was found with                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+#define TOOL_SEED                       0x12345678
+#define TOOL_ERROR_PRINTS               8               /* errors printed, the others are only counted     */
+
+static unsigned int tool_rand_state = TOOL_SEED;
+static unsigned int tool_error_prints;
+
+static inline unsigned int tool_rand (void)
+{
+	tool_rand_state ^= tool_rand_state << 13;
+	tool_rand_state ^= tool_rand_state >> 17;
+	tool_rand_state ^= tool_rand_state << 5;
+	return tool_rand_state;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Function:        tool_seed                                                                              */
+/*                                                                                                         */
+/* Parameters:      argc, argv - of main, arg - index of the seed argument                                 */
+/* Returns:         none                                                                                   */
+/* Description:                                                                                            */
+/*                  Seeds tool_rand from argv[arg], TOOL_SEED without it. 0 is not a xorshift state        */
+/*---------------------------------------------------------------------------------------------------------*/
+static inline void tool_seed (int argc, char *argv[], int arg)
+{
+	tool_rand_state = (argc > arg) ? (unsigned int)strtoul(argv[arg], NULL, 0) : TOOL_SEED;
+	if (tool_rand_state == 0)
+		tool_rand_state = 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Counts an error in count, prints the first TOOL_ERROR_PRINTS errors of the run                          */
+/*---------------------------------------------------------------------------------------------------------*/
+#define TOOL_ERROR(count, fmt, args...)                                                                     \
+	do {                                                                                                \
+		(count)++;                                                                                  \
+		if (tool_error_prints++ < TOOL_ERROR_PRINTS)                                                \
+			printf(fmt, ##args);                                                                \
+	} while (0)
+
+#endif /* _TOOL_CHECK_H_ */